@@ -66,6 +66,8 @@ public:
         snapshot.sequence = view.sequence;
         snapshot.data2 = view.data2;
         snapshot.count2 = view.count2;
+        snapshot.prefix_revision = view.prefix_revision;
+        snapshot.stream_revision = view.stream_revision;
 
         if (view.count == 0) {
             return {snapshot, Status::EMPTY};
@@ -65,6 +65,15 @@ struct Benchmark_config {
     std::size_t ring_capacity = 100000;
     std::size_t series_count = 1;
     bool stack_series = false;
+    // Upload samples through streaming Dynamic VBOs
+    // (Plot_config::streaming_sample_buffers).
+    bool streaming_buffers = false;
+    // Batch same-style series into packed draws
+    // (Plot_config::batch_series_draws).
+    bool batch_draws = false;
+    // Scan only appended samples for the GLOBAL auto range
+    // (Plot_config::incremental_global_auto_range).
+    bool incremental_auto_range = false;
     bool extended_metadata = false;
     bool quiet = false;  // Suppress console output during benchmark
     bool show_text = true;  // Text/font rendering (default: on)
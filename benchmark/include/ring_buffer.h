@@ -51,6 +51,8 @@ public:
         const T* data2 = nullptr;
         std::size_t count2 = 0;
         uint64_t sequence = 0;
+        uint64_t prefix_revision = 0;   ///< Changes when samples are overwritten or cleared
+        uint64_t stream_revision = 0;   ///< Changes when the buffer is cleared
         std::shared_ptr<std::shared_lock<std::shared_mutex>> lock;
     };
 
@@ -98,6 +100,7 @@ public:
 
         if (was_full) {
             m_tail.store((t + 1) % cap, std::memory_order_relaxed);
+            publish_next_prefix_revision();
         }
         else {
             const std::size_t new_count = count + 1;
@@ -151,6 +154,9 @@ public:
         m_count.store(occupancy, std::memory_order_relaxed);
         update_high_water(occupancy);
         m_revision.store(revision, std::memory_order_release);
+        if (overwritten > 0) {
+            publish_next_prefix_revision();
+        }
         lock.unlock();
         m_published_samples.fetch_add(count, std::memory_order_relaxed);
         m_overwritten_samples.fetch_add(overwritten, std::memory_order_relaxed);
@@ -170,6 +176,8 @@ public:
         const std::size_t t = m_tail.load(std::memory_order_acquire);
         const std::size_t count = m_count.load(std::memory_order_acquire);
         view.sequence = m_revision.load(std::memory_order_acquire);
+        view.prefix_revision = m_prefix_revision.load(std::memory_order_acquire);
+        view.stream_revision = m_stream_revision.load(std::memory_order_acquire);
 
         if (count == 0) {
             return view;
@@ -247,6 +255,10 @@ public:
         m_tail.store(0, std::memory_order_relaxed);
         m_count.store(0, std::memory_order_relaxed);
         publish_next_revision();
+        publish_next_prefix_revision();
+        m_stream_revision.store(
+            next_revision(m_stream_revision.load(std::memory_order_relaxed)),
+            std::memory_order_release);
     }
 
     Statistics statistics() const {
@@ -294,6 +306,16 @@ private:
         m_revision.store(next_revision(revision), std::memory_order_release);
     }
 
+    /// The prefix revision is the append contract: it stays the same while
+    /// pushes only append, and changes when the oldest samples are
+    /// overwritten (shifting every index) or the buffer is cleared. The
+    /// stream revision, which allows overwriting the oldest samples, only
+    /// changes on clear.
+    void publish_next_prefix_revision() {
+        const std::uint64_t revision = m_prefix_revision.load(std::memory_order_relaxed);
+        m_prefix_revision.store(next_revision(revision), std::memory_order_release);
+    }
+
     void update_high_water(std::size_t occupancy) {
         std::size_t previous = m_high_water_occupancy.load(std::memory_order_relaxed);
         while (previous < occupancy && !m_high_water_occupancy.compare_exchange_weak(
@@ -336,6 +358,8 @@ private:
     std::atomic<std::size_t> m_count{0};
     std::atomic<std::size_t> m_high_water_occupancy{0};
     std::atomic<std::uint64_t> m_revision{1};
+    std::atomic<std::uint64_t> m_prefix_revision{1};
+    std::atomic<std::uint64_t> m_stream_revision{1};
     std::atomic<std::uint64_t> m_published_samples{0};
     std::atomic<std::uint64_t> m_overwritten_samples{0};
     std::atomic<std::uint64_t> m_producer_wait_count{0};
@@ -5,6 +5,7 @@
 #include "path_io.h"
 
 #include <vnm_plot/core/plot_config.h>
+#include <vnm_plot/rhi/offscreen_plot_renderer.h>
 
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -362,6 +363,9 @@ Benchmark_rhi_window::Benchmark_rhi_window(const Benchmark_config& config)
     m_render_config.snap_lines_to_pixels = false;
     m_render_config.line_width_px = m_config.line_width_px;
     m_render_config.point_diameter_px = m_config.point_diameter_px;
+    m_render_config.streaming_sample_buffers = m_config.streaming_buffers;
+    m_render_config.batch_series_draws = m_config.batch_draws;
+    m_render_config.incremental_global_auto_range = m_config.incremental_auto_range;
     m_render_config.font_size_px = k_adjusted_font_px;
     m_render_config.base_label_height_px = k_base_label_height_px;
     m_render_config.preview_height_px = k_adjusted_preview_height;
@@ -529,6 +533,10 @@ void Benchmark_rhi_window::setup_series()
         if (style == "Line") {
             series->style = vnm::plot::Display_style::LINE;
         }
+        else
+        if (style == "Density") {
+            series->style = vnm::plot::Display_style::DENSITY;
+        }
         else {
             series->style = vnm::plot::Display_style::AREA;
         }
@@ -721,6 +729,9 @@ void Benchmark_rhi_offscreen_runner::setup_rendering()
     m_render_config.snap_lines_to_pixels = false;
     m_render_config.line_width_px = m_config.line_width_px;
     m_render_config.point_diameter_px = m_config.point_diameter_px;
+    m_render_config.streaming_sample_buffers = m_config.streaming_buffers;
+    m_render_config.batch_series_draws = m_config.batch_draws;
+    m_render_config.incremental_global_auto_range = m_config.incremental_auto_range;
     m_render_config.font_size_px = k_adjusted_font_px;
     m_render_config.base_label_height_px = k_base_label_height_px;
     m_render_config.preview_height_px = k_adjusted_preview_height;
@@ -757,6 +768,10 @@ void Benchmark_rhi_offscreen_runner::setup_series()
         if (style == "Line") {
             series->style = vnm::plot::Display_style::LINE;
         }
+        else
+        if (style == "Density") {
+            series->style = vnm::plot::Display_style::DENSITY;
+        }
         else {
             series->style = vnm::plot::Display_style::AREA;
         }
@@ -1297,11 +1312,9 @@ bool Benchmark_rhi_offscreen_runner::render_frame(
             error_message = "measure.pixel_readback: QRhi returned no pixel data";
             return false;
         }
-        std::uint64_t checksum = 1'469'598'103'934'665'603ull;
-        for (const unsigned char byte : readback.data) {
-            checksum ^= byte;
-            checksum *= 1'099'511'628'211ull;
-        }
+        const std::uint64_t checksum = vnm::plot::pixel_checksum(
+            reinterpret_cast<const std::uint8_t*>(readback.data.constData()),
+            static_cast<std::size_t>(readback.data.size()));
         m_pixel_checksum = checksum;
         m_pixel_nonuniform_count = 0;
         m_stack_sum_pixel_count = 0;
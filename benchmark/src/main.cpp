@@ -91,7 +91,7 @@ void print_usage(const char* program_name)
               << "  --data-type <type>      bars|trades (default: bars)\n"
               << "  --backend <backend>     qrhi|qrhi-offscreen (default: qrhi-offscreen)\n"
               << "  --graphics-backend <b> native|d3d11|metal|vulkan|opengl|null (default: native)\n"
-              << "  --render-style <style>  dots|line|area (default: dots for trades, area for bars)\n"
+              << "  --render-style <style>  dots|line|area|density (default: dots for trades, area for bars)\n"
               << "  --static                Skip the generator and render a deterministic static window\n"
               << "  --static-samples <n>    Samples per static series (default: 10000)\n"
               << "  --line-px <pixels>      Line thickness for line/area rendering (default: 1.5)\n"
@@ -103,6 +103,9 @@ void print_usage(const char* program_name)
               << "  --ring-size <count>     Ring buffer capacity (default: 100000, min: 100)\n"
               << "  --series-count <count>  Number of ordinary series (default: 1)\n"
               << "  --stack-series          Stack ordinary series in plot order\n"
+              << "  --streaming-buffers     Upload samples through streaming Dynamic VBOs\n"
+              << "  --batch-draws           Batch same-style series into packed draws\n"
+              << "  --incremental-auto-range Scan only appended samples for the GLOBAL auto range\n"
               << "  --extended-metadata     Include benchmark-specific metadata in report\n"
               << "  --quiet                 Suppress progress output (report still written)\n"
               << "  --no-text               Disable text/font rendering\n"
@@ -206,9 +209,13 @@ Parse_result parse_args(int argc, char* argv[])
                 if (style == "area" || style == "Area") {
                     config.style = "Area";
                 }
+                else
+                if (style == "density" || style == "Density") {
+                    config.style = "Density";
+                }
                 else {
                     result.success = false;
-                    result.error_message = "Invalid style '" + style + "'. Use 'dots', 'line', or 'area'.";
+                    result.error_message = "Invalid style '" + style + "'. Use 'dots', 'line', 'area', or 'density'.";
                     return result;
                 }
             }
@@ -257,6 +264,18 @@ Parse_result parse_args(int argc, char* argv[])
                 config.stack_series = true;
             }
             else
+            if (arg == "--streaming-buffers") {
+                config.streaming_buffers = true;
+            }
+            else
+            if (arg == "--batch-draws") {
+                config.batch_draws = true;
+            }
+            else
+            if (arg == "--incremental-auto-range") {
+                config.incremental_auto_range = true;
+            }
+            else
             if (arg == "--extended-metadata") {
                 config.extended_metadata = true;
             }
@@ -581,6 +600,10 @@ int main(int argc, char* argv[])
         meta.reproduction["seed"] = std::to_string(config.seed);
         meta.reproduction["series_count"] = std::to_string(config.series_count);
         meta.reproduction["show_text"] = config.show_text ? "true" : "false";
+        meta.reproduction["streaming_buffers"] = config.streaming_buffers ? "true" : "false";
+        meta.reproduction["batch_draws"] = config.batch_draws ? "true" : "false";
+        meta.reproduction["incremental_auto_range"] =
+            config.incremental_auto_range ? "true" : "false";
         meta.reproduction["static_data"] = config.static_data ? "true" : "false";
         meta.reproduction["static_sample_count"] =
             std::to_string(config.static_sample_count);
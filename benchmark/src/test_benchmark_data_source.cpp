@@ -318,6 +318,50 @@ bool test_current_sequence_metadata() {
     return true;
 }
 
+// Test: Snapshots keep their prefix revision while pushes only append
+bool test_prefix_revision_follows_append_contract() {
+    Ring_buffer<Trade_sample> buffer(4);
+    Benchmark_data_source<Trade_sample> source(buffer);
+
+    Trade_sample trade{};
+    buffer.push(trade);
+    buffer.push(trade);
+    const std::uint64_t appended_revision = source.try_snapshot().snapshot.prefix_revision;
+    TEST_ASSERT(appended_revision != 0, "snapshots should carry an append promise");
+
+    buffer.push(trade);
+    const Trade_sample batch[] = {trade};
+    buffer.push_batch(batch, 1);
+    auto result = source.try_snapshot();
+    TEST_ASSERT(result.snapshot.count == 4 &&
+                result.snapshot.prefix_revision == appended_revision,
+                "appends up to capacity should keep the prefix revision");
+    result = {};  // Release the snapshot's shared lock before pushing again
+
+    const std::uint64_t stream_revision = source.try_snapshot().snapshot.stream_revision;
+    TEST_ASSERT(stream_revision != 0, "snapshots should carry a streaming promise");
+    buffer.push(trade);
+    const std::uint64_t overwritten_revision = source.try_snapshot().snapshot.prefix_revision;
+    TEST_ASSERT(overwritten_revision != 0 && overwritten_revision != appended_revision,
+                "overwriting the oldest sample should change the prefix revision");
+    TEST_ASSERT(source.try_snapshot().snapshot.stream_revision == stream_revision,
+                "overwriting the oldest sample should keep the stream revision");
+
+    buffer.push_batch(batch, 1);
+    TEST_ASSERT(source.try_snapshot().snapshot.prefix_revision != overwritten_revision,
+                "a batch that overwrites should change the prefix revision");
+
+    const std::uint64_t full_revision = source.try_snapshot().snapshot.prefix_revision;
+    buffer.clear();
+    buffer.push(trade);
+    TEST_ASSERT(source.try_snapshot().snapshot.prefix_revision != full_revision,
+                "clear should change the prefix revision");
+    TEST_ASSERT(source.try_snapshot().snapshot.stream_revision != stream_revision,
+                "clear should change the stream revision");
+
+    return true;
+}
+
 // Test: Bar access policy
 bool test_bar_access_policy() {
     auto policy = make_bar_access_policy();
@@ -586,6 +630,7 @@ int main() {
     RUN_TEST(test_sequence_tracking);
     RUN_TEST(test_query_metadata_single_lod_unknown_order);
     RUN_TEST(test_current_sequence_metadata);
+    RUN_TEST(test_prefix_revision_follows_append_contract);
     RUN_TEST(test_bar_access_policy);
     RUN_TEST(test_trade_access_policy);
     RUN_TEST(test_snapshot_live_view);
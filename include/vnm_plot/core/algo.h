@@ -781,5 +781,31 @@ inline std::size_t choose_lod_level(
     return best_level;
 }
 
+// Level selection with hysteresis. Keeps `current_level` while its distance
+// from 1.0 pixels-per-sample is within `hysteresis` of the best level's, so a
+// view near a level boundary does not switch back and forth between frames.
+// A hysteresis of 0 (or an out-of-range current level) selects exactly like
+// choose_lod_level(scales, base_pps).
+inline std::size_t choose_lod_level(
+    const std::vector<std::size_t>&    scales,
+    double                             base_pps,
+    std::size_t                        current_level,
+    double                             hysteresis)
+{
+    const std::size_t best_level = choose_lod_level(scales, base_pps);
+    if (!(hysteresis > 0.0)                ||
+        !(base_pps > 0.0)                  ||
+        current_level >= scales.size()     ||
+        current_level == best_level)
+    {
+        return best_level;
+    }
+
+    constexpr double target_pps    = 1.0;
+    const double     best_error    = std::abs(base_pps * static_cast<double>(scales[best_level])    - target_pps);
+    const double     current_error = std::abs(base_pps * static_cast<double>(scales[current_level]) - target_pps);
+    return current_error - best_error <= hysteresis ? current_level : best_level;
+}
+
 } // namespace detail
 } // namespace vnm::plot
@@ -9,6 +9,7 @@
 #include <vnm_plot/core/lcd.h>
 #include <vnm_plot/core/time_units.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <ctime>
 #include <functional>
@@ -37,12 +38,15 @@ struct value_format_context_t
 // -----------------------------------------------------------------------------
 // Auto V-Range Mode
 // -----------------------------------------------------------------------------
-// Controls how the auto v-range is computed when v_auto is enabled.
+// Controls how the auto v-range is computed when v_auto is enabled. Both
+// global modes answer from the per-LOD ranges a source publishes with its
+// content (Data_source::query_published_v_range) when it has one.
 enum class Auto_v_range_mode
 {
     // Default: global full-resolution range.
     GLOBAL,
-    // Global range using per-LOD min/max caches (fast, may use coarse LOD).
+    // Global range of the coarsest LOD level (fast, may miss extremes a
+    // coarse level drops).
     GLOBAL_LOD,
     // Visible time window only (uses LOD selection for speed).
     VISIBLE
@@ -165,6 +169,95 @@ struct Plot_config
     double                                     point_diameter_px = 1.0;
     // Area fill alpha multiplier (0..1).
     double                                     area_fill_alpha = 0.3;
+    // When true, LINE/AREA windows with four or more samples per pixel column
+    // are reduced to first/min/max/last per column (M4) before upload, so
+    // upload size follows the view width instead of the source density.
+    // Views that also draw DOTS or custom QRhi layers keep every sample.
+    bool                                       m4_decimation = false;
+    // When true, DOTS-only windows with a sample or more per pixel column
+    // keep just the first sample whose dot centre lands in each pixel cell,
+    // so instance count and overdraw follow the plot area instead of the
+    // source density. Merged dots differ from the kept one by less than a
+    // pixel; translucent colors no longer accumulate within a cell.
+    bool                                       dots_pixel_culling = false;
+    // LOD hysteresis in pixels per sample. A view keeps its current LOD level
+    // until another level is closer to 1 px/sample by more than this margin;
+    // 0 (the default) switches exactly at the midpoint between levels.
+    double                                     lod_hysteresis = 0.0;
+    // Target duration, in milliseconds, of the series prepare step (window
+    // planning, staging and uploads) while the view moves; 0 turns adaptive
+    // LOD off. Frames over it bias the LOD choice towards coarser levels, up
+    // to 2^adaptive_lod_max_bias pixels per sample; once the view stops
+    // moving the bias drops by one step per frame back to full detail.
+    double                                     adaptive_lod_budget_ms = 0.0;
+    double                                     adaptive_lod_max_bias  = 3.0;
+    // When true, sample VBOs are Dynamic buffers sized with headroom for live
+    // views. A frame whose window only dropped leading samples and appended
+    // new ones writes just the appended samples and moves the window's first
+    // GPU slot forward; the buffer is compacted in place once the window
+    // reaches its end. Samples already drawn are assumed not to change,
+    // except the last one, which is compared before reuse. Custom QRhi
+    // layers must honour qrhi_series_sample_buffer_t::first_sample.
+    bool                                       streaming_sample_buffers = false;
+    // When true, the main and preview views of a series draw from one sample
+    // VBO whenever they select the same LOD level and sample sequence of the
+    // same data and one window contains the other: the main view uploads the
+    // containing window and the preview view borrows it. Ignored while
+    // streaming_sample_buffers is set.
+    bool                                       share_view_sample_buffers = false;
+    // When true, consecutive built-in LINE or DOTS draws (in draw order) that
+    // share a view, time range, value range and width are packed into one
+    // sample buffer with a per-series color array and recorded as a single
+    // draw, up to 256 series per draw. Stack-sum overlays, AREA and custom
+    // QRhi layers are always drawn per series.
+    bool                                       batch_series_draws = false;
+    // When true, custom QRhi layer states with an async stage
+    // (Qrhi_series_layer_state::has_async_prepare) run prepare_async() for
+    // the frame on one worker thread, started before any series stages its
+    // samples; each prepare() waits for its own stage only. When false the
+    // stage runs on the render thread right before prepare().
+    bool                                       async_layer_prepare = false;
+    // When true, Plot_widget records nothing for a render callback whose
+    // inputs match the last rendered frame: config and series revisions,
+    // view ranges, viewport, every source's current_sequence() at each LOD
+    // level and every custom QRhi layer's revision(). The item keeps showing
+    // its previous texture. Frames with label fades running, and plots with
+    // a source that reports sequence 0, always render. Offscreen_plot_renderer
+    // keys the config by offscreen_view_t::config_revision and returns the
+    // last image instead.
+    bool                                       skip_unchanged_frames = false;
+    // When true, Plot_widget keeps the series layer in an offscreen texture
+    // for live strip charts. A frame whose time window only slid shifts the
+    // previous content by the pixel advance and redraws the newly exposed
+    // strip, plus scroll_blit_margin_px, from the previous frame's last
+    // sample onwards. To keep advances whole pixels, the displayed window is
+    // snapped to the pixel grid (less than one pixel of shift). Zooms,
+    // value-range or config changes, resizes, a changed previously-last
+    // sample and dropped leading samples still on screen redraw the whole
+    // body; edits to older samples show once the series or config changes.
+    // Stacked, DENSITY and custom-layer series always redraw the whole body.
+    // The layer is single sampled; pair with streaming_sample_buffers so the
+    // upload shrinks with the strip as well.
+    bool                                       scroll_blit           = false;
+    double                                     scroll_blit_margin_px = 4.0;
+    // When true, Plot_widget renders the back chrome (preview and label pane
+    // backgrounds, separators, the main grid and the axis ticks) into an
+    // offscreen texture and composites it under the series. The texture is
+    // redrawn only when the layout cache key, the theme inputs (config
+    // revision, window background, LCD order) or the viewport change, or
+    // while label fades run; data-only frames skip the chrome draws and
+    // their uniform uploads. Labels stay in the main pass, where LCD text
+    // blends against the final pixels.
+    bool                                       cache_chrome_layer    = false;
+    // Upper bound, in bytes, on the sample buffers, uniform buffers and
+    // DENSITY textures a series renderer keeps (0 = unlimited). Past it, the
+    // series drawn least recently release theirs and upload again when they
+    // are next drawn; buffers of the current frame's series are never
+    // released, so the frame itself may exceed the budget.
+    std::size_t                                gpu_buffer_budget_bytes  = 0;
+    // A sample buffer that stays at least four times larger than its uploads
+    // for this many frames is reallocated at the upload size (0 = never).
+    std::uint32_t                              gpu_buffer_shrink_frames = 120;
 
     // --- Auto V-Range ---
     // Default is GLOBAL.
@@ -173,6 +266,31 @@ struct Plot_config
     double                                     auto_v_range_extra_scale = 0.0;
     // When true, padding cannot pull a nonnegative auto-computed range below zero.
     bool                                       floor_nonnegative_auto_v_range_at_zero = false;
+    // When true, a GLOBAL auto range the resolver scans itself (the source
+    // publishes no range and does not override Data_source::query_v_range)
+    // remembers the scanned sample count. When the source's sequence changes
+    // and its snapshot is longer and carries the same nonzero
+    // prefix_revision, only the appended samples are scanned and merged into
+    // the cached range; any other change, or a prefix_revision of 0, forces
+    // a full rescan.
+    bool                                       incremental_global_auto_range = false;
+    // When true, VISIBLE auto range keeps a per-series sliding-window
+    // min/max (monotonic deques) for LINEAR series whose source reports
+    // Time_order::ASCENDING. While the window only moves forward, a frame
+    // reads just the samples entering it and drops those leaving it. A new
+    // sequence is slid over only when its snapshot keeps the nonzero
+    // prefix_revision or stream_revision of the last one (the latter also
+    // allows dropped leading samples); any other change, zooming out or
+    // panning back rebuilds from the window. Sources that override
+    // Data_source::query_v_range keep answering themselves.
+    bool                                       sliding_visible_auto_range = false;
+    // When true, series whose auto range is not cached are resolved on
+    // several threads once at least eight distinct sources need a query or
+    // scan; series sharing a source stay on one thread. Results, cache
+    // entries and profiler observations are merged in series order, so the
+    // range matches the sequential result. Sources and access policies must
+    // tolerate being queried concurrently with other sources.
+    bool                                       parallel_auto_range = false;
 
     // --- LCD Rendering ---
     lcd_request_t                              lcd_request = lcd_auto_request();
@@ -3,6 +3,7 @@
 // Qt-free types used by the data and layout interfaces.
 #include <vnm_plot/core/time_units.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -320,6 +321,20 @@ struct data_snapshot_t
     const void*            data2    = nullptr; ///< Optional second segment (wrap)
     size_t                 count2   = 0;       ///< Samples in second segment
     std::shared_ptr<void>  hold;               ///< Optional ownership/lock guard
+    /// Append contract. Nonzero when the source promises that any later
+    /// snapshot of the same LOD level carrying the same prefix_revision holds
+    /// these `count` samples unchanged, at the same indices, followed only by
+    /// appended samples. The source must change it on every other edit
+    /// (rewrite, removal, reorder, clear). 0 makes no promise, so consumers
+    /// treat every sequence change as a full rewrite.
+    uint64_t               prefix_revision = 0;
+    /// Streaming contract, weaker than prefix_revision. Nonzero when the
+    /// source promises that any later snapshot of the same LOD level carrying
+    /// the same stream_revision holds the samples of this one it still has
+    /// unchanged and in order: only leading samples are dropped and new
+    /// samples appended, so indices may shift. A source that keeps
+    /// prefix_revision may report the same value here.
+    uint64_t               stream_revision = 0;
 
     explicit operator bool() const { return is_valid(); }
 
@@ -720,8 +735,40 @@ struct data_query_context_t
     Series_interpolation       interpolation         = Series_interpolation::LINEAR;
     Empty_window_behavior      empty_window_behavior = Empty_window_behavior::HOLD_LAST_FORWARD;
     Nonfinite_sample_policy    nonfinite_policy      = Nonfinite_sample_policy::BREAK_SEGMENT;
+    // Set by callers that scan snapshots incrementally themselves: the
+    // default Data_source::query_v_range() then answers UNSUPPORTED instead
+    // of scanning, so only sources that override it answer.
+    bool                       defer_default_scan    = false;
 };
 
+// Global value range a Data_source computed when it published one LOD
+// level's content (see Data_source::query_published_v_range). The range is
+// only meaningful under the access semantics and nonfinite policy it was
+// computed with.
+struct published_v_range_t
+{
+    std::uint64_t              sequence         = 0;
+    sample_semantics_key_t     semantics_key;
+    Nonfinite_sample_policy    nonfinite_policy = Nonfinite_sample_policy::BREAK_SEGMENT;
+    // READY or EMPTY once computed; UNSUPPORTED when nothing was published.
+    Data_query_status          status           = Data_query_status::UNSUPPORTED;
+    value_range_t              range{};
+
+    // The published range for `query`, or UNSUPPORTED when it was computed
+    // under other semantics or another nonfinite policy.
+    data_query_result_t<value_range_t> answer(const data_query_context_t& query) const;
+};
+
+// Scans `snapshot` once for its global value range under `access`, as
+// GLOBAL auto range would. For sources that publish ranges with their
+// content; the result's sequence is the snapshot's. Access policies without
+// stable semantics (sample_semantics_key_t::conservative) cannot be matched
+// later and yield UNSUPPORTED.
+published_v_range_t compute_published_v_range(
+    const data_snapshot_t&         snapshot,
+    const Data_access_policy&      access,
+    Nonfinite_sample_policy        nonfinite_policy = Nonfinite_sample_policy::BREAK_SEGMENT);
+
 // -----------------------------------------------------------------------------
 // Data_source: Abstract interface for data sources
 // -----------------------------------------------------------------------------
@@ -787,10 +834,30 @@ public:
         std::size_t                    lod,
         const data_query_context_t&    query);
 
+    /// Value range of the samples in `query.time_window`. The default scans
+    /// a snapshot, unless `query.defer_default_scan` is set, in which case it
+    /// answers UNSUPPORTED. The auto-range resolver asks overrides first and
+    /// only scans, possibly incrementally, when they answer UNSUPPORTED.
     virtual data_query_result_t<value_range_t> query_v_range(
         std::size_t                    lod,
         const data_query_context_t&    query);
 
+    /// O(1) global value range of `lod`, ignoring `query.time_window`, from a
+    /// min/max the source computed once when it published that content
+    /// (compute_published_v_range()). Must not scan samples: answer
+    /// UNSUPPORTED (the default) when no published range matches the
+    /// query's semantics and nonfinite policy. READY and EMPTY results carry
+    /// the sequence the range describes. GLOBAL and GLOBAL_LOD auto range
+    /// try this before query_v_range().
+    virtual data_query_result_t<value_range_t> query_published_v_range(
+        std::size_t                    lod,
+        const data_query_context_t&    query) const
+    {
+        (void)lod;
+        (void)query;
+        return {};
+    }
+
 };
 
 // -----------------------------------------------------------------------------
@@ -864,26 +931,28 @@ public:
         }
         if (payload->data.empty()) {
             data_snapshot_t snapshot;
-            snapshot.stride   = sizeof(T);
-            snapshot.sequence = payload->sequence;
-            snapshot.hold     = payload;
+            snapshot.stride          = sizeof(T);
+            snapshot.sequence        = payload->sequence;
+            snapshot.hold            = payload;
+            snapshot.prefix_revision = payload->prefix_revision;
+            snapshot.stream_revision = payload->prefix_revision;
             return {
                 snapshot,
                 snapshot_result_t::Snapshot_status::EMPTY
             };
         }
-        return {
-            data_snapshot_t{
-                payload->data.data(),
-                payload->data.size(),
-                sizeof(T),
-                payload->sequence,
-                nullptr,
-                0,
-                payload
-            },
-            snapshot_result_t::Snapshot_status::READY
+        data_snapshot_t snapshot{
+            payload->data.data(),
+            payload->data.size(),
+            sizeof(T),
+            payload->sequence,
+            nullptr,
+            0,
+            payload
         };
+        snapshot.prefix_revision = payload->prefix_revision;
+        snapshot.stream_revision = payload->prefix_revision;
+        return {snapshot, snapshot_result_t::Snapshot_status::READY};
     }
 
     uint64_t current_sequence(size_t /*lod_level*/ = 0) const override
@@ -894,16 +963,109 @@ public:
 
     size_t sample_stride() const override { return sizeof(T); }
 
-    void set_data(std::vector<T> data)
+    Time_order time_order(std::size_t lod) const override
     {
-        auto new_payload = std::make_shared<Payload>(std::move(data), 0);
-        std::shared_ptr<Payload> old_payload;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return lod == 0 ? m_payload->order : Time_order::UNKNOWN;
+    }
+
+    data_query_result_t<value_range_t> query_published_v_range(
+        std::size_t                    lod,
+        const data_query_context_t&    query) const override
+    {
+        std::shared_ptr<Payload> payload;
         {
             std::lock_guard<std::mutex> lock(m_mutex);
-            new_payload->sequence = m_payload->sequence + 1;
-            old_payload           = std::move(m_payload);
-            m_payload             = std::move(new_payload);
+            payload = m_payload;
+        }
+        if (lod != 0) {
+            return {};
+        }
+        return payload->v_range.answer(query);
+    }
+
+    void set_data(std::vector<T> data)
+    {
+        std::lock_guard<std::mutex> write_lock(m_write_mutex);
+        publish(std::make_shared<Payload>(std::move(data), 0), false);
+    }
+
+    // Like set_data(), and computes the data's global value range under
+    // `access` once, so GLOBAL and GLOBAL_LOD auto range for that access
+    // answer from it instead of scanning (query_published_v_range()). Data
+    // whose timestamps never decrease is reported as Time_order::ASCENDING.
+    void set_data(
+        std::vector<T>                 data,
+        const Data_access_policy&      access,
+        Nonfinite_sample_policy        nonfinite_policy = Nonfinite_sample_policy::BREAK_SEGMENT)
+    {
+        std::lock_guard<std::mutex> write_lock(m_write_mutex);
+        auto new_payload = std::make_shared<Payload>(std::move(data), 0);
+        new_payload->v_range = compute_published_v_range(
+            samples_snapshot(*new_payload, 0), access, nonfinite_policy);
+        new_payload->order = timestamp_order(*new_payload, 1, access);
+        publish(std::move(new_payload), false);
+    }
+
+    // Appends `samples` after the current data. Snapshots keep their
+    // prefix_revision across appends, so consumers that cache per-sample
+    // work (timestamp order, stack compositions, incremental GLOBAL auto
+    // range) only process the new samples. The current data is copied into
+    // the new payload; the published value range and time order are dropped,
+    // as with set_data().
+    void append(const std::vector<T>& samples)
+    {
+        std::lock_guard<std::mutex> write_lock(m_write_mutex);
+        publish(appended_payload(*current_payload(), samples), true);
+    }
+
+    // Like append(), and keeps the range and time order published by
+    // set_data(data, access) current by reading only the appended samples.
+    void append(
+        const std::vector<T>&          samples,
+        const Data_access_policy&      access,
+        Nonfinite_sample_policy        nonfinite_policy = Nonfinite_sample_policy::BREAK_SEGMENT)
+    {
+        std::lock_guard<std::mutex> write_lock(m_write_mutex);
+        const std::shared_ptr<Payload> previous    = current_payload();
+        std::shared_ptr<Payload>       new_payload = appended_payload(*previous, samples);
+        const std::size_t              first       = previous->data.size();
+
+        const published_v_range_t appended_range = compute_published_v_range(
+            samples_snapshot(*new_payload, first), access, nonfinite_policy);
+        const published_v_range_t& previous_range = previous->v_range;
+        const bool extend_range =
+            (previous_range.status == Data_query_status::READY ||
+             previous_range.status == Data_query_status::EMPTY)                        &&
+            (appended_range.status == Data_query_status::READY ||
+             appended_range.status == Data_query_status::EMPTY)                        &&
+            previous_range.semantics_key.value    == appended_range.semantics_key.value    &&
+            previous_range.semantics_key.revision == appended_range.semantics_key.revision &&
+            previous_range.nonfinite_policy       == appended_range.nonfinite_policy;
+        if (!extend_range) {
+            new_payload->v_range = compute_published_v_range(
+                samples_snapshot(*new_payload, 0), access, nonfinite_policy);
         }
+        else
+        if (previous_range.status == Data_query_status::EMPTY) {
+            new_payload->v_range = appended_range;
+        }
+        else {
+            new_payload->v_range = previous_range;
+            if (appended_range.status == Data_query_status::READY) {
+                new_payload->v_range.range.min =
+                    std::min(previous_range.range.min, appended_range.range.min);
+                new_payload->v_range.range.max =
+                    std::max(previous_range.range.max, appended_range.range.max);
+            }
+        }
+
+        new_payload->order =
+            previous->order == Time_order::UNORDERED ? Time_order::UNORDERED :
+            previous->order == Time_order::ASCENDING
+                ? timestamp_order(*new_payload, std::max<std::size_t>(first, 1), access)
+                : timestamp_order(*new_payload, 1, access);
+        publish(std::move(new_payload), true);
     }
 
 private:
@@ -914,13 +1076,81 @@ private:
         Payload(std::vector<T> payload_data, std::uint64_t payload_sequence)
         :
             data(std::move(payload_data)),
-            sequence(payload_sequence)
+            sequence(payload_sequence),
+            prefix_revision(payload_sequence)
         {}
 
-        std::vector<T> data;
-        std::uint64_t  sequence = 0;
+        std::vector<T>         data;
+        std::uint64_t          sequence        = 0;
+        std::uint64_t          prefix_revision = 0;
+        published_v_range_t    v_range;
+        Time_order             order           = Time_order::UNKNOWN;
     };
 
+    std::shared_ptr<Payload> current_payload() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_payload;
+    }
+
+    static std::shared_ptr<Payload> appended_payload(
+        const Payload&         previous,
+        const std::vector<T>&  samples)
+    {
+        std::vector<T> data;
+        data.reserve(previous.data.size() + samples.size());
+        data.insert(data.end(), previous.data.begin(), previous.data.end());
+        data.insert(data.end(), samples.begin(), samples.end());
+        return std::make_shared<Payload>(std::move(data), 0);
+    }
+
+    static data_snapshot_t samples_snapshot(const Payload& payload, std::size_t first)
+    {
+        data_snapshot_t snapshot;
+        snapshot.data   = payload.data.data() + first;
+        snapshot.count  = payload.data.size() - first;
+        snapshot.stride = sizeof(T);
+        return snapshot;
+    }
+
+    // ASCENDING when no timestamp from index `first` on is below its
+    // predecessor, assuming the samples before `first` are ascending.
+    static Time_order timestamp_order(
+        const Payload&                 payload,
+        std::size_t                    first,
+        const Data_access_policy&      access)
+    {
+        if (!access.get_timestamp) {
+            return Time_order::UNKNOWN;
+        }
+        for (std::size_t i = first; i < payload.data.size(); ++i) {
+            if (access.get_timestamp(&payload.data[i]) <
+                access.get_timestamp(&payload.data[i - 1]))
+            {
+                return Time_order::UNORDERED;
+            }
+        }
+        return Time_order::ASCENDING;
+    }
+
+    // Publishes `new_payload` as the next sequence. An append keeps the
+    // current prefix_revision; any other change starts a new one.
+    void publish(std::shared_ptr<Payload> new_payload, bool append)
+    {
+        std::shared_ptr<Payload> old_payload;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            new_payload->sequence         = m_payload->sequence + 1;
+            new_payload->prefix_revision  = append && m_payload->prefix_revision != 0
+                ? m_payload->prefix_revision
+                : new_payload->sequence;
+            new_payload->v_range.sequence = new_payload->sequence;
+            old_payload                   = std::move(m_payload);
+            m_payload                     = std::move(new_payload);
+        }
+    }
+
+    std::mutex                 m_write_mutex;
     mutable std::mutex         m_mutex;
     std::shared_ptr<Payload>   m_payload;
 };
@@ -937,7 +1167,10 @@ enum class Display_style : int
     DOTS_LINE      = DOTS | LINE,
     DOTS_AREA      = DOTS | AREA,
     LINE_AREA      = LINE | AREA,
-    DOTS_LINE_AREA = DOTS | LINE | AREA
+    DOTS_LINE_AREA = DOTS | LINE | AREA,
+    // Per-pixel sample density drawn through a colormap; for windows too
+    // dense for DOTS/LINE to read. Combines with the other styles.
+    DENSITY        = 0x8
 };
 
 inline Display_style operator|(Display_style a, Display_style b)
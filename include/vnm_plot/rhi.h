@@ -5,6 +5,8 @@
 #include <vnm_plot/rhi/chrome_renderer.h>
 #include <vnm_plot/rhi/frame_context.h>
 #include <vnm_plot/rhi/font_renderer.h>
+#include <vnm_plot/rhi/offscreen_plot_renderer.h>
+#include <vnm_plot/rhi/pipeline_cache.h>
 #include <vnm_plot/rhi/primitive_renderer.h>
 #include <vnm_plot/rhi/qrhi_series_layer.h>
 #include <vnm_plot/rhi/series_builder.h>
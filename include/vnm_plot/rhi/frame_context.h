@@ -63,6 +63,12 @@ struct frame_context_t
     // renderer must NOT call cb->resourceUpdate(batch) itself, because that
     // call is illegal once the host's render pass is open.
     QRhiResourceUpdateBatch*   rhi_updates = nullptr;
+
+    // Left edge, in pixels from the plot body's left edge, of the part of the
+    // main body the series renderer redraws. A host that keeps the rest of
+    // the body from an earlier frame (Plot_config::scroll_blit) raises it;
+    // main view draws are then clipped to [main_redraw_x0, usable_width).
+    double                     main_redraw_x0 = 0.0;
 };
 
 } // namespace vnm::plot
@@ -0,0 +1,104 @@
+#pragma once
+
+// VNM Plot Library - Offscreen Plot Renderer
+// Qt-Quick-free plot rendering into an offscreen QRhi texture with pixel
+// readback, for batch image generation.
+
+#include <vnm_plot/core/plot_config.h>
+#include <vnm_plot/core/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vnm::plot {
+
+// -----------------------------------------------------------------------------
+// Offscreen Plot Renderer
+// -----------------------------------------------------------------------------
+
+enum class offscreen_backend_t : std::uint8_t
+{
+    NULL_BACKEND,   // Records nothing; readback returns blank pixels
+    OPENGL,         // OpenGL (ES); software rasterizers such as llvmpipe work
+    VULKAN,
+    D3D11,
+    METAL,
+    NATIVE          // D3D11 on Windows, Metal on macOS, OpenGL elsewhere
+};
+
+struct offscreen_view_t
+{
+    int            width           = 640;
+    int            height          = 360;
+    // Multiplies the config's font, label and preview sizes, like a
+    // Plot_widget's device pixel ratio.
+    double         scaling_factor  = 1.0;
+    data_config_t  data_cfg;
+    // Value range from the series (Plot_config::auto_v_range_mode) instead
+    // of data_cfg.v_min / v_max.
+    bool           v_auto          = true;
+    // Stands for the Plot_config passed to render(), which cannot be
+    // compared: bump it whenever the config changes. Frames with revision 0
+    // never count as unchanged (Plot_config::skip_unchanged_frames).
+    std::uint64_t  config_revision = 0;
+};
+
+struct offscreen_image_t
+{
+    int                        width  = 0;
+    int                        height = 0;
+    // RGBA8, rows top to bottom, width * 4 bytes per row, premultiplied
+    // when Plot_config::clear_to_transparent is set.
+    std::vector<std::uint8_t>  pixels;
+};
+
+// 64-bit FNV-1a-style hash over `size` bytes, seeded like the benchmark's
+// --pixel-checksum so the two report the same value for the same pixels.
+[[nodiscard]] std::uint64_t pixel_checksum(const std::uint8_t* data, std::size_t size);
+
+// Renders complete plot frames (series, chrome and, with text support,
+// labels) into its own offscreen QRhi texture and reads the pixels back.
+// Each instance owns its QRhi, so instances on different threads run
+// concurrently; an instance is created, used and destroyed on one thread.
+// OpenGL instances also need a QGuiApplication and, on most platforms, must
+// be initialized on the GUI thread, since they create an offscreen surface.
+//
+// The preview band is drawn when Plot_config::preview_height_px is
+// positive. Labels never fade: every frame is rendered as a still. With
+// Plot_config::skip_unchanged_frames, a frame whose view, config_revision
+// and series match the last rendered one is not drawn again; render()
+// returns a copy of the last image.
+class Offscreen_plot_renderer
+{
+public:
+    Offscreen_plot_renderer();
+    ~Offscreen_plot_renderer();
+
+    Offscreen_plot_renderer(const Offscreen_plot_renderer&)            = delete;
+    Offscreen_plot_renderer& operator=(const Offscreen_plot_renderer&) = delete;
+
+    // Creates the QRhi. Returns false and fills `error_message` when the
+    // backend is unavailable.
+    bool initialize(offscreen_backend_t backend, std::string& error_message);
+
+    // Renders one frame of `series` and reads it back into `image`. The
+    // render target follows view.width / view.height. Blocks until the GPU
+    // finished the frame.
+    bool render(
+        const offscreen_view_t&    view,
+        const std::map<int, std::shared_ptr<const series_data_t>>&
+                                   series,
+        const Plot_config&         config,
+        offscreen_image_t&         image,
+        std::string&               error_message);
+
+private:
+    struct impl_t;
+    std::unique_ptr<impl_t> m_impl;
+};
+
+} // namespace vnm::plot
@@ -0,0 +1,46 @@
+#pragma once
+
+// VNM Plot Library - QRhi Pipeline Disk Cache
+// Persists QRhi pipeline cache data between process starts.
+
+class QRhi;
+
+namespace vnm::plot {
+
+// -----------------------------------------------------------------------------
+// Pipeline Cache Configuration
+// -----------------------------------------------------------------------------
+// Cache files live next to the MSDF font cache and are keyed by the QRhi
+// backend, the device and a digest of the library's shaders, so a driver or
+// shader change starts a fresh file.
+
+// Enable or disable disk caching of QRhi pipeline data (default: enabled).
+void set_pipeline_disk_cache_enabled(bool enabled);
+
+// Returns true if disk caching is enabled.
+[[nodiscard]] bool pipeline_disk_cache_enabled();
+
+// Saving needs a QRhi created with QRhi::EnablePipelineCacheDataSave.
+// Offscreen_plot_renderer creates its QRhi with it. Plot_widget cannot, as
+// Qt Quick creates the window's QRhi; instead, before the scene graph
+// initializes, it points the window's QQuickGraphicsConfiguration pipeline
+// cache save and load files at a file in the same directory, and Qt Quick
+// loads and saves it. Windows that configured those files already keep
+// them, and then load_pipeline_disk_cache() leaves the QRhi to Qt Quick.
+
+// Seeds `rhi` from the cache file before the library creates pipelines on
+// it. Runs once per QRhi; a QRhi that already holds pipeline cache data
+// (for example Qt Quick's automatic pipeline cache) is left untouched.
+// Returns true when data was loaded. Plot_widget and
+// Offscreen_plot_renderer call this themselves; hosts that drive the
+// renderers on their own QRhi call it after creating it. A QRhi seen here
+// is saved once more when it is destroyed.
+bool load_pipeline_disk_cache(QRhi* rhi);
+
+// Writes the pipeline cache data of `rhi` when it differs from what was
+// last loaded or saved. Returns true when a file was written. Hashing and
+// writing the data takes a while, so call this off the frame path, for
+// example at shutdown.
+bool save_pipeline_disk_cache(QRhi* rhi);
+
+} // namespace vnm::plot
@@ -91,6 +91,16 @@ struct qrhi_series_prepare_context_t
     bool                                   resources_changed = false;
 };
 
+struct qrhi_series_async_prepare_context_t
+{
+    const frame_context_t*                 frame  = nullptr;
+    const series_data_t*                   series = nullptr;
+    // The planned window. Its snapshot stays valid until the matching
+    // prepare() returns. prepare() may see a different t_origin_ns when the
+    // view draws from a sample buffer shared with the other view.
+    sample_window_t                        window;
+};
+
 struct qrhi_series_record_context_t
 {
     QRhiCommandBuffer*                     cb            = nullptr;
@@ -112,6 +122,15 @@ public:
     // sample resources are reused. `resources_changed` only describes whether
     // the renderer-visible layer inputs changed; it does not suppress prepare.
     virtual bool prepare(const qrhi_series_prepare_context_t& ctx) = 0;
+    // Optional CPU-only stage for payloads derived from the sample window.
+    // When has_async_prepare() is true, prepare_async() runs once before
+    // every prepare() of a draw with a snapshot. With
+    // Plot_config::async_layer_prepare it runs on a worker thread while the
+    // renderer stages built-in samples, so it must not touch QRhi objects
+    // or state that other states use on the render thread; a draw dropped
+    // after planning may then get prepare_async() without prepare().
+    virtual bool has_async_prepare() const { return false; }
+    virtual void prepare_async(const qrhi_series_async_prepare_context_t& ctx) { (void)ctx; }
     virtual void record(const qrhi_series_record_context_t& ctx) = 0;
 };
 
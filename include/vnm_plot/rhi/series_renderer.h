@@ -82,6 +82,24 @@ public:
         const std::map<int, std::shared_ptr<const series_data_t>>&
                                series);
 
+    // True when the last prepare() planned every view from its source's
+    // current content; false after a busy-source fallback to older samples
+    // or a missing snapshot. Hosts that skip unchanged frames must not skip
+    // the frame after one that was not current.
+    bool last_frame_current() const { return m_last_frame_current; }
+
+    // Plot_config::scroll_blit. After prepare(), the leftmost main-body x in
+    // pixels where this frame's series can differ from the previous frame's
+    // once both are aligned on the time axis: 0 when the whole body must be
+    // redrawn, +infinity when only newly scrolled-in pixels changed.
+    double last_frame_main_changed_x() const { return m_last_frame_main_changed_x; }
+
+    // Plot_config::adaptive_lod_budget_ms. Log2 of the pixels per sample the
+    // next prepare() aims its LOD choice at; 0 is full detail. While it is
+    // positive the last frame was coarsened, and hosts keep rendering so a
+    // still view returns to full detail.
+    double lod_bias() const { return m_lod_bias; }
+
 private:
     friend class Plot_widget;
 
@@ -116,32 +134,66 @@ private:
         float y_max;
     };
 
-    struct vbo_view_state_t
+    // Staged samples of one view: the tail of a reused vector starting at
+    // `m_first`. Dropping leading samples only advances the start; the kept
+    // samples move to the front of a buffer with room to slide by their own
+    // length again only when growing them would reallocate.
+    class staging_buffer_t
     {
-        struct line_draw_span_t
+    public:
+        std::size_t         size()  const noexcept { return m_samples.size() - m_first; }
+        bool                empty() const noexcept { return size() == 0; }
+        gpu_sample_t*       data()        noexcept { return m_samples.data() + m_first; }
+        const gpu_sample_t* data()  const noexcept { return m_samples.data() + m_first; }
+        gpu_sample_t*       begin()       noexcept { return data(); }
+        const gpu_sample_t* begin() const noexcept { return data(); }
+        gpu_sample_t*       end()         noexcept { return data() + size(); }
+        const gpu_sample_t* end()   const noexcept { return data() + size(); }
+        gpu_sample_t&       front()       noexcept { return data()[0]; }
+        const gpu_sample_t& front() const noexcept { return data()[0]; }
+        gpu_sample_t&       back()        noexcept { return data()[size() - 1u]; }
+        const gpu_sample_t& back()  const noexcept { return data()[size() - 1u]; }
+
+        gpu_sample_t&       operator[](std::size_t i)       noexcept { return data()[i]; }
+        const gpu_sample_t& operator[](std::size_t i) const noexcept { return data()[i]; }
+
+        void clear() noexcept
+        {
+            m_samples.clear();
+            m_first = 0;
+        }
+
+        void assign(const gpu_sample_t* first, const gpu_sample_t* last)
         {
-            std::size_t gpu_first  = 0;
-            std::size_t gpu_count  = 0;
-            std::size_t line_first = 0;
-            std::size_t line_count = 0;
-        };
+            m_first = 0;
+            m_samples.assign(first, last);
+        }
 
+        // Forgets the first `count` samples without moving the others.
+        void drop_front(std::size_t count) noexcept;
+
+        void resize(std::size_t count);
+
+    private:
+        std::vector<gpu_sample_t>      m_samples;
+        std::size_t                    m_first = 0;
+    };
+
+    struct vbo_view_state_t
+    {
         bool has_uploaded_vbo = false;
         std::unique_ptr<detail::series_window_planner_state_t> planner;
 
         // Renderer-owned scratch buffer for VBO uploads. Holds the planned
         // visible gpu_sample_t values rebased against the active origin.
         // Reused across uploads to avoid reallocation.
-        std::vector<gpu_sample_t>      staging;
+        staging_buffer_t               staging;
         std::size_t                    last_staged_sample_count         = 0;
         std::size_t                    last_sample_upload_bytes         = 0;
         std::size_t                    last_sample_upload_count         = 0;
-        std::size_t                    last_line_window_upload_bytes    = 0;
-        std::size_t                    last_line_window_upload_count    = 0;
         std::size_t                    last_uniform_upload_bytes        = 0;
         std::size_t                    last_uniform_upload_count        = 0;
         std::size_t                    last_primitive_prepare_count     = 0;
-        std::size_t                    last_line_window_sample_count    = 0;
         std::size_t                    last_recorded_line_span_count    = 0;
         std::size_t                    last_recorded_line_segment_count = 0;
         std::size_t                    last_recorded_area_span_count    = 0;
@@ -154,14 +206,90 @@ private:
         QRhiBuffer*                    last_sample_buffer               = nullptr;
         detail::access_dispatch_kind_t last_sample_access_dispatch_kind =
             detail::access_dispatch_kind_t::NONE;
-        std::vector<gpu_sample_t>      line_window_staging;
-        std::vector<line_draw_span_t>  line_draw_spans;
-        bool                           line_window_geometry_dirty = true;
+        // Renderer-wide stamp taken whenever staging is rewritten; batched
+        // draws repack a member only when it moves.
+        std::uint64_t                  staging_revision           = 0;
+        // Plot_config::batch_series_draws. A static view that may be batched
+        // stages its samples without writing its own VBO; the write from
+        // staging is left pending until a draw of the view is recorded on
+        // its own (rhi_flush_sample_upload).
+        bool                           defer_sample_upload        = false;
+        bool                           sample_upload_pending      = false;
         std::vector<std::uint64_t>     stack_cache_key;
         data_snapshot_t                stack_cache_snapshot;
         bool                           stack_cache_resampled      = false;
         bool                           last_stack_view_suppressed = false;
 
+        // M4 decimation of the uploaded window; empty when the upload holds
+        // every planned sample. m4_plan_spans are the planned spans the
+        // decimation was derived from, so a reused upload can restore the
+        // compacted spans without a snapshot.
+        std::vector<std::size_t>            m4_source_indices;
+        std::vector<drawable_sample_span_t> m4_spans;
+        std::vector<drawable_sample_span_t> m4_plan_spans;
+        std::size_t                         m4_gpu_count = 0;
+        // Set when the m4_* fields hold DOTS cell culling instead: the view
+        // geometry its rows were computed for (v range, height, y offset).
+        std::vector<std::uint64_t>          m4_dots_key;
+
+        // DENSITY grid. density_key describes the window the uploaded grid
+        // texture was binned from; a frame that plans the same window only
+        // rewrites the colour uniform.
+        std::vector<std::uint64_t>     density_key;
+        std::size_t                    last_density_bin_count            = 0;
+        std::size_t                    last_density_upload_bytes         = 0;
+        std::size_t                    last_recorded_density_draw_count  = 0;
+
+        // Streaming upload (Plot_config::streaming_sample_buffers). The
+        // window occupies [sample_base, sample_base + gpu_count) of a
+        // Dynamic sample VBO; staging mirrors those slots. `stream_*`
+        // describe the uploaded real samples so a frame that only dropped
+        // leading samples and appended new ones can write just the tail.
+        std::size_t                    sample_base                    = 0;
+        bool                           rhi_vbo_dynamic                = false;
+        bool                           stream_valid                   = false;
+        std::size_t                    stream_real_count              = 0;
+        std::int64_t                   stream_last_timestamp_ns       = 0;
+        std::int64_t                   stream_t_origin_ns             = 0;
+        std::size_t                    stream_lod_level               = 0;
+        const Data_access_policy*      stream_access                  = nullptr;
+        Nonfinite_sample_policy        stream_nonfinite_policy        =
+            Nonfinite_sample_policy::BREAK_SEGMENT;
+
+        // Main/preview sample sharing (Plot_config::share_view_sample_buffers).
+        // A main view with `samples_shared` uploaded the window containing
+        // both views and draws its own part from sample_base; a preview view
+        // with `samples_borrowed` owns no sample VBO and draws from the main
+        // view's. `shared_*` describe the shared window (main) or the
+        // borrowed part of it (preview); staging holds only the view's own
+        // samples either way.
+        bool                           samples_shared                 = false;
+        bool                           samples_borrowed               = false;
+        std::uint64_t                  shared_sequence                = 0;
+        std::size_t                    shared_lod_level               = 0;
+        std::size_t                    shared_source_first            = 0;
+        std::size_t                    shared_source_count            = 0;
+        std::size_t                    shared_gpu_count               = 0;
+        std::int64_t                   shared_t_origin_ns             = 0;
+        std::size_t                    shared_upload_generation       = 0;
+
+        // Plot_config::scroll_blit. What the previous frame drew for this
+        // view: `scroll_valid` with `scroll_count == 0` for an empty window,
+        // otherwise the window's last real sample (timestamp and value) and
+        // the snapshot's first timestamp, so the next frame can tell samples
+        // appended after it from edits.
+        bool                           scroll_valid                   = false;
+        const Data_source*             scroll_source                  = nullptr;
+        const Data_access_policy*      scroll_access                  = nullptr;
+        std::uint64_t                  scroll_sequence                = 0;
+        std::size_t                    scroll_lod_level               = 0;
+        std::size_t                    scroll_count                   = 0;
+        std::int64_t                   scroll_front_ns                = 0;
+        std::int64_t                   scroll_last_ns                 = 0;
+        float                          scroll_last_y                  = 0.0f;
+        float                          scroll_last_y_min              = 0.0f;
+        float                          scroll_last_y_max              = 0.0f;
+
         // Per-view RHI resources. Defined out-of-line in series_renderer.cpp
         // where QRhiBuffer is complete; the public header only sees the
         // forward declaration. unique_ptr-of-incomplete-type forces every
@@ -170,8 +298,10 @@ private:
         struct rhi_buffers_t;
         std::unique_ptr<rhi_buffers_t> rhi;
 
-        std::size_t    rhi_vbo_capacity_bytes             = 0;
-        std::size_t    rhi_line_window_vbo_capacity_bytes = 0;
+        std::size_t    rhi_vbo_capacity_bytes = 0;
+        // Plot_config::gpu_buffer_shrink_frames: first frame of the current
+        // run of uploads that needed a quarter of the capacity or less.
+        std::uint64_t  rhi_vbo_underused_since_frame = 0;
 
         vbo_view_state_t();
         ~vbo_view_state_t();
@@ -185,7 +315,10 @@ private:
 
     struct vbo_state_t
     {
-        int                stack_group = 0;
+        int                stack_group      = 0;
+        // m_frame_id of the last frame that drew the series; orders the
+        // eviction under Plot_config::gpu_buffer_budget_bytes.
+        std::uint64_t      last_drawn_frame = 0;
         vbo_view_state_t   main_view;
         vbo_view_state_t   preview_view;
         std::unique_ptr<detail::Series_window_snapshot_cache>
@@ -213,8 +346,6 @@ private:
         Series_view_plan   main_plan;
         Series_view_plan   preview_plan;
         bool               has_preview                      = false;
-        bool               main_reuses_uploaded_geometry    = false;
-        bool               preview_reuses_uploaded_geometry = false;
         bool               main_stack_sum_overlay           = false;
         bool               preview_stack_sum_overlay        = false;
     };
@@ -234,35 +365,79 @@ private:
     std::vector<bool>                                                  m_last_recorded_stack_sum_overlays;
     std::vector<glm::vec4>                                             m_last_recorded_draw_colors;
     std::vector<float>                                                 m_last_recorded_line_widths;
+    std::size_t                                                        m_last_recorded_batch_draw_count = 0;
+    std::size_t                                                        m_last_recorded_batched_series_count = 0;
+    std::size_t                                                        m_last_batch_upload_count = 0;
     std::size_t                                                        m_last_qrhi_layer_cache_size = 0;
 
+    // Private test instrumentation: the packed sample VBO of draw batch
+    // `batch_index` and its instance count, or nullptr.
+    QRhiBuffer* draw_batch_vbo(std::size_t batch_index, std::size_t& instance_count) const;
+
     // The full implementation sits in series_renderer.cpp where the QRhi
     // types are complete.
     struct rhi_state_t;
     std::unique_ptr<rhi_state_t>                                       m_rhi_state;
 
     uint64_t m_frame_id = 0; // Monotonic frame counter for snapshot caching
+    bool     m_last_frame_current = false;
+    double   m_last_frame_main_changed_x = 0.0;
+    std::vector<int> m_scroll_series_ids;
+    // Plot_config::adaptive_lod_budget_ms: the current bias and the main
+    // view it was measured on.
+    double           m_lod_bias          = 0.0;
+    std::int64_t     m_lod_bias_t0       = 0;
+    std::int64_t     m_lod_bias_t1       = 0;
+    double           m_lod_bias_width_px = 0.0;
 
     void clear_frame_snapshot_caches();
 
+    // Reports the GPU bytes held for series and, past
+    // Plot_config::gpu_buffer_budget_bytes, releases the buffers of the
+    // series drawn least recently. Runs at the end of prepare().
+    void enforce_gpu_buffer_budget(const frame_context_t& ctx);
+
     // rhi_prepare_series_view_samples: writes the compact sample VBO for one
     //   planned series/view window. Built-in AREA/LINE/DOTS primitives share
-    //   this upload.
+    //   this upload. gpu_source_indices, when non-null, maps every GPU slot of
+    //   an M4-decimated window to its snapshot index. With
+    //   view_state.defer_sample_upload set, a static upload is only staged
+    //   and left pending.
+    //
+    // rhi_flush_sample_upload: writes a pending static upload from staging to
+    //   the view's VBO. Returns the bytes written.
     //
     // rhi_prepare_series_primitive: writes to ctx.rhi_updates only. Builds the
-    //   per-primitive UBO(s) and (LINE-only) the per-frame line_window_vbo, and
-    //   ensures the cached pipeline / SRB are valid. No cb->* draw calls. Must
-    //   run before the host calls beginPass(batch) so the upload is submitted
-    //   alongside the rest of ctx.rhi_updates.
+    //   per-primitive UBO(s) and ensures the cached pipeline / SRB are valid.
+    //   No cb->* draw calls. Must run before the host calls beginPass(batch)
+    //   so the upload is submitted alongside the rest of ctx.rhi_updates.
     //
     // rhi_record_series_primitive: emits cb->setGraphicsPipeline /
     //   setShaderResources / setVertexInput / draw only. Scissor is owned by
     //   the outer layer replay loop. No buffer writes; safe to call inside the
     //   open render pass.
+    //
+    // rhi_prepare_series_density / rhi_record_series_density: the DENSITY
+    //   counterparts of the two calls above. Prepare bins the window into a
+    //   per-pixel grid texture when the window moved and writes the UBO;
+    //   record draws the colormapped quad.
+    //
+    // rhi_prepare_draw_batches: with Plot_config::batch_series_draws, groups
+    //   the sorted prepared draws into batches, packs each batch's samples
+    //   and colors and writes them to ctx.rhi_updates. Runs after every
+    //   member went through rhi_prepare_series_primitive.
+    //
+    // rhi_record_draw_batch: records one batch prepared above with a single
+    //   draw. Same constraints as rhi_record_series_primitive.
     bool rhi_prepare_series_view_samples(
-        const frame_context_t& ctx,
-        vbo_view_state_t&      view_state,
-        const sample_window_t& window);
+        const frame_context_t&             ctx,
+        vbo_view_state_t&                  view_state,
+        const sample_window_t&             window,
+        const std::vector<std::size_t>*    gpu_source_indices = nullptr);
+
+    std::size_t rhi_flush_sample_upload(
+        const frame_context_t&             ctx,
+        vbo_view_state_t&                  view_state);
 
     bool rhi_prepare_series_primitive(
         const frame_context_t& ctx,
@@ -284,6 +459,23 @@ private:
         bool                   stack_sum_overlay,
         const std::vector<detail::builtin_segment_span_t>&
                                segment_spans);
+
+    bool rhi_prepare_series_density(
+        const frame_context_t&  ctx,
+        vbo_view_state_t&       view_state,
+        const Series_view_plan& plan,
+        const sample_window_t&  window,
+        const glm::vec4&        draw_color);
+
+    void rhi_record_series_density(
+        const frame_context_t& ctx,
+        vbo_view_state_t&      view_state);
+
+    void rhi_prepare_draw_batches(const frame_context_t& ctx);
+
+    void rhi_record_draw_batch(
+        const frame_context_t& ctx,
+        std::size_t            batch_index);
 };
 
 } // namespace vnm::plot
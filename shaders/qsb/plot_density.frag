@@ -0,0 +1,29 @@
+#version 440
+#extension GL_GOOGLE_include_directive : require
+
+#include "uniform_blocks.glsl"
+
+layout(std140, binding = 0) uniform Block
+{
+    Series_view_t view;
+} u;
+
+// Log-scaled sample count per pixel in r; 0 means no sample.
+layout(binding = 1) uniform sampler2D density_tex;
+
+layout(location = 0) in vec2 vs_uv;
+
+layout(location = 0) out vec4 frag_color;
+
+void main()
+{
+    float d = texture(density_tex, vs_uv).r;
+    if (d <= 0.0) {
+        discard;
+    }
+
+    // Sequential ramp of the series colour: sparse cells are faint, the
+    // densest cells brighten towards white.
+    vec3 rgb   = mix(u.view.color.rgb, vec3(1.0), 0.65 * d * d);
+    frag_color = vec4(rgb, u.view.color.a * (0.25 + 0.75 * d));
+}
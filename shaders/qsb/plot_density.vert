@@ -0,0 +1,28 @@
+#version 440
+#extension GL_GOOGLE_include_directive : require
+
+// Per-pixel density grid of one series view.
+//
+// Draws a single 4-vertex triangle strip over the plot band; the corners
+// come from gl_VertexIndex and the grid texture is sampled one texel per
+// pixel in the fragment shader.
+
+#include "uniform_blocks.glsl"
+
+layout(std140, binding = 0) uniform Block
+{
+    Series_view_t view;
+} u;
+
+layout(location = 0) out vec2 vs_uv;
+
+void main()
+{
+    vec2 corner = vec2(float(gl_VertexIndex & 1), float(gl_VertexIndex >> 1));
+    vec2 pos    = vec2(
+        corner.x * u.view.width,
+        corner.y * u.view.height + u.view.y_offset);
+
+    vs_uv       = corner;
+    gl_Position = u.view.pmv * vec4(pos, 0.0, 1.0);
+}
@@ -0,0 +1,29 @@
+#version 440
+#extension GL_GOOGLE_include_directive : require
+
+#include "uniform_blocks.glsl"
+
+layout(std140, binding = 0) uniform Block
+{
+    Series_view_t view;
+    float point_diameter_px;
+    vec4  series_color[256];
+} u;
+
+layout(location = 0) in vec2 fs_uv;
+layout(location = 1) flat in vec4 fs_color;
+
+layout(location = 0) out vec4 frag_color;
+
+void main()
+{
+    float dist = length(fs_uv);
+    if (dist > 1.0) {
+        discard;
+    }
+
+    float edge_width = fwidth(dist) * 1.5;
+    float alpha      = 1.0 - smoothstep(1.0 - edge_width, 1.0, dist);
+
+    frag_color = vec4(fs_color.rgb, fs_color.a * alpha);
+}
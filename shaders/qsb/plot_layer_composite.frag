@@ -0,0 +1,13 @@
+#version 440
+
+// Premultiplied layer colour; the pipeline blends with One/OneMinusSrcAlpha.
+layout(binding = 1) uniform sampler2D layer_tex;
+
+layout(location = 0) in vec2 vs_uv;
+
+layout(location = 0) out vec4 frag_color;
+
+void main()
+{
+    frag_color = texture(layer_tex, vs_uv);
+}
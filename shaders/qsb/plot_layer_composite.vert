@@ -0,0 +1,24 @@
+#version 440
+
+// Cached layer composite.
+//
+// Draws a single 4-vertex triangle strip over the window; the corners come
+// from gl_VertexIndex and the layer texture holds one texel per pixel.
+
+layout(std140, binding = 0) uniform Block
+{
+    mat4  pmv;
+    vec2  size;
+    int   framebuffer_y_up;
+} u;
+
+layout(location = 0) out vec2 vs_uv;
+
+void main()
+{
+    vec2 corner = vec2(float(gl_VertexIndex & 1), float(gl_VertexIndex >> 1));
+
+    // A layer rendered on a y-up framebuffer stores its top row last.
+    vs_uv       = vec2(corner.x, u.framebuffer_y_up != 0 ? 1.0 - corner.y : corner.y);
+    gl_Position = u.pmv * vec4(corner * u.size, 0.0, 1.0);
+}
@@ -8,12 +8,13 @@ layout(std140, binding = 0) uniform Block
     Series_view_t view;
     float line_px;
     int   snap_to_pixels;
+    int   interpolation;
 } u;
 
-layout(location = 0) flat in vec2 fs_p_prev;
-layout(location = 1) flat in vec2 fs_p0;
+// fs_p_mid equals fs_p1 for LINEAR, so the second leg adds nothing there.
+layout(location = 0) flat in vec2 fs_p0;
+layout(location = 1) flat in vec2 fs_p_mid;
 layout(location = 2) flat in vec2 fs_p1;
-layout(location = 3) flat in vec2 fs_p_next;
 
 layout(location = 0) out vec4 frag_color;
 
@@ -35,10 +36,9 @@ void main()
         : gl_FragCoord.y;
     vec2 frag = vec2(gl_FragCoord.x, frag_y);
 
-    float d0     = dist_to_segment(frag, fs_p0, fs_p1);
-    float d_prev = dist_to_segment(frag, fs_p_prev, fs_p0);
-    float d_next = dist_to_segment(frag, fs_p1, fs_p_next);
-    float dist   = min(d0, min(d_prev, d_next));
+    float dist = min(
+        dist_to_segment(frag, fs_p0,    fs_p_mid),
+        dist_to_segment(frag, fs_p_mid, fs_p1));
 
     float half_px = max(u.line_px * 0.5, 0.5);
     float aa      = max(fwidth(dist), 0.75);
@@ -1,38 +1,37 @@
 #version 440
 #extension GL_GOOGLE_include_directive : require
 
-// Per-instance segment expansion of the line strip. The four triangle-strip
-// corners (gl_VertexIndex 0..3) form a thickened screen-space quad spanning
-// samples p0 -> p1, with prev and next passed flat to the fragment shader
-// for rounded segment joins.
+// Per-instance segment expansion of the line strip. Each instance reads one
+// (p0, p1) pair straight from the compact sample buffer: the host binds that
+// buffer twice, at element offsets i and i + 1, with per-instance stepping.
+// Reading samples through vertex attributes avoids the SSBO -> UAV mapping
+// SPIRV-Cross emits for std430 buffers; D3D11 SM 5.0 vertex shaders accept
+// no UAVs at all, so any storage-buffer access in the vertex stage fails to
+// compile.
 //
-// The shader receives the four neighbouring samples (prev, p0, p1, next)
-// for each segment as four per-instance vertex attributes. The host fills a
-// dedicated per-frame buffer that already contains the leading and trailing
-// boundary duplicates ([s[first], s[first], s[first+1], ..., s[last], s[last]])
-// and binds it four times at consecutive gpu_sample_t offsets. Reading neighbour
-// samples through vertex attributes avoids the SSBO -> UAV mapping SPIRV-Cross
-// emits for std430 buffers; D3D11 SM 5.0 vertex shaders accept no UAVs at all,
-// so any storage-buffer access in the vertex stage fails to compile.
+// LINEAR draws 4 triangle-strip corners (gl_VertexIndex 0..3): a thickened
+// screen-space quad spanning p0 -> p1. STEP_AFTER draws 10: the quad of the
+// horizontal leg p0 -> held (0..3), two degenerate bridge vertices (4, 5),
+// then the quad of the vertical leg held -> p1 (6..9), where held is
+// (p1.t, p0.y). Rounded caps from the per-leg distance in the fragment
+// shader close the joins between instances.
 
 #include "uniform_blocks.glsl"
 
-layout(location = 0) in vec2 in_prev;
-layout(location = 1) in vec2 in_p0;
-layout(location = 2) in vec2 in_p1;
-layout(location = 3) in vec2 in_next;
+layout(location = 0) in vec2 in_p0;
+layout(location = 1) in vec2 in_p1;
 
 layout(std140, binding = 0) uniform Block
 {
     Series_view_t view;
     float line_px;
     int   snap_to_pixels;
+    int   interpolation;
 } u;
 
-layout(location = 0) flat out vec2 fs_p_prev;
-layout(location = 1) flat out vec2 fs_p0;
+layout(location = 0) flat out vec2 fs_p0;
+layout(location = 1) flat out vec2 fs_p_mid;
 layout(location = 2) flat out vec2 fs_p1;
-layout(location = 3) flat out vec2 fs_p_next;
 
 vec2 sample_to_pos(vec2 sample_xy)
 {
@@ -49,38 +48,43 @@ vec2 sample_to_pos(vec2 sample_xy)
     return vec2(x, y);
 }
 
-void main()
+vec2 quad_corner(vec2 a, vec2 b, int corner, float half_px)
 {
-    vec2 p_prev = sample_to_pos(in_prev);
-    vec2 p0     = sample_to_pos(in_p0);
-    vec2 p1     = sample_to_pos(in_p1);
-    vec2 p_next = sample_to_pos(in_next);
-
-    vec2  seg_v   = p1 - p0;
+    vec2  seg_v   = b - a;
     float seg_len = length(seg_v);
-    float half_px = max(u.line_px * 0.5, 0.5);
-
-    vec2 pos;
     if (seg_len <= 1e-6) {
         // Degenerate segment collapses to a point; the rasterizer culls it.
-        pos = p0;
+        return a;
     }
-    else {
-        vec2 dir = seg_v / seg_len;
-        vec2 n   = vec2(-dir.y, dir.x);
+    vec2 dir = seg_v / seg_len;
+    vec2 n   = vec2(-dir.y, dir.x);
+
+    // Triangle-strip vertex order (corner 0..3): a+n, a-n, b+n, b-n.
+    vec2  base   = (corner < 2) ? a - dir * half_px : b + dir * half_px;
+    float n_sign = (corner & 1) == 0 ? 1.0 : -1.0;
+    return base + n * (half_px * n_sign);
+}
 
-        vec2 p0_ext = p0 - dir * half_px;
-        vec2 p1_ext = p1 + dir * half_px;
+void main()
+{
+    vec2  p0      = sample_to_pos(in_p0);
+    vec2  p1      = sample_to_pos(in_p1);
+    float half_px = max(u.line_px * 0.5, 0.5);
 
-        // Triangle-strip vertex order (gl_VertexIndex 0..3): p0+n, p0-n, p1+n, p1-n.
-        vec2  base   = (gl_VertexIndex < 2) ? p0_ext : p1_ext;
-        float n_sign = (gl_VertexIndex & 1) == 0 ? 1.0 : -1.0;
-        pos = base + n * (half_px * n_sign);
+    vec2 p_mid = p1;
+    vec2 pos;
+    if (u.interpolation == 1) {
+        p_mid = sample_to_pos(vec2(in_p1.x, in_p0.y));
+        pos = (gl_VertexIndex < 5)
+            ? quad_corner(p0,    p_mid, min(gl_VertexIndex, 3),     half_px)
+            : quad_corner(p_mid, p1,    max(gl_VertexIndex - 6, 0), half_px);
+    }
+    else {
+        pos = quad_corner(p0, p1, gl_VertexIndex, half_px);
     }
 
-    fs_p_prev   = p_prev;
     fs_p0       = p0;
+    fs_p_mid    = p_mid;
     fs_p1       = p1;
-    fs_p_next   = p_next;
     gl_Position = u.view.pmv * vec4(pos, 0.0, 1.0);
 }
@@ -0,0 +1,87 @@
+#version 440
+#extension GL_GOOGLE_include_directive : require
+
+// Batched variant of plot_line.vert: one draw covers the drawable spans of
+// several series packed back to back. p0 and p1 also carry the range lanes,
+// which the host repurposes: z is the series slot into series_color, w tags
+// the span the sample belongs to. Instances whose p0 and p1 carry different
+// tags straddle a span or series boundary and collapse to a point the
+// rasterizer culls.
+
+#include "uniform_blocks.glsl"
+
+layout(location = 0) in vec4 in_p0;
+layout(location = 1) in vec4 in_p1;
+
+layout(std140, binding = 0) uniform Block
+{
+    Series_view_t view;
+    float line_px;
+    int   snap_to_pixels;
+    int   interpolation;
+    vec4  series_color[256];
+} u;
+
+layout(location = 0) flat out vec2 fs_p0;
+layout(location = 1) flat out vec2 fs_p_mid;
+layout(location = 2) flat out vec2 fs_p1;
+layout(location = 3) flat out vec4 fs_color;
+
+vec2 sample_to_pos(vec2 sample_xy)
+{
+    float rt = max(u.view.t_max - u.view.t_min, 1e-30);
+    float rv = max(u.view.v_max - u.view.v_min, 1e-30);
+
+    float x = u.view.width  *       (sample_xy.x - u.view.t_min) / rt;
+    float y = u.view.height * (1.0 - (sample_xy.y - u.view.v_min) / rv) + u.view.y_offset;
+
+    if (u.snap_to_pixels != 0) {
+        x = floor(x) + 0.5;
+        y = floor(y) + 0.5;
+    }
+    return vec2(x, y);
+}
+
+vec2 quad_corner(vec2 a, vec2 b, int corner, float half_px)
+{
+    vec2  seg_v   = b - a;
+    float seg_len = length(seg_v);
+    if (seg_len <= 1e-6) {
+        return a;
+    }
+    vec2 dir = seg_v / seg_len;
+    vec2 n   = vec2(-dir.y, dir.x);
+
+    vec2  base   = (corner < 2) ? a - dir * half_px : b + dir * half_px;
+    float n_sign = (corner & 1) == 0 ? 1.0 : -1.0;
+    return base + n * (half_px * n_sign);
+}
+
+void main()
+{
+    vec2  p0      = sample_to_pos(in_p0.xy);
+    vec2  p1      = sample_to_pos(in_p1.xy);
+    float half_px = max(u.line_px * 0.5, 0.5);
+
+    vec2 p_mid = p1;
+    vec2 pos;
+    if (in_p0.w != in_p1.w) {
+        pos = p0;
+    }
+    else
+    if (u.interpolation == 1) {
+        p_mid = sample_to_pos(vec2(in_p1.x, in_p0.y));
+        pos = (gl_VertexIndex < 5)
+            ? quad_corner(p0,    p_mid, min(gl_VertexIndex, 3),     half_px)
+            : quad_corner(p_mid, p1,    max(gl_VertexIndex - 6, 0), half_px);
+    }
+    else {
+        pos = quad_corner(p0, p1, gl_VertexIndex, half_px);
+    }
+
+    fs_p0       = p0;
+    fs_p_mid    = p_mid;
+    fs_p1       = p1;
+    fs_color    = u.series_color[clamp(int(in_p0.z), 0, 255)];
+    gl_Position = u.view.pmv * vec4(pos, 0.0, 1.0);
+}
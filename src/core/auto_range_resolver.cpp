@@ -1,14 +1,21 @@
 #include "auto_range_resolver.h"
+#include "parallel_for.h"
 
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace vnm::plot::detail {
 
 namespace {
 
+// Series whose range is not cached are resolved on several threads once
+// there are at least twice this many sources to query.
+constexpr std::size_t k_parallel_auto_range_min_sources_per_range = 4;
+
 constexpr time_range_t all_time_window()
 {
     return {
@@ -288,6 +295,248 @@ void prune_cache_entries(
             ++it;
         }
     }
+    if (preview) {
+        return;
+    }
+    for (auto it = cache->visible_trackers.begin(); it != cache->visible_trackers.end();) {
+        if (series.find(it->first) == series.end()) {
+            it = cache->visible_trackers.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+// Records how far `snapshot` was scanned for `entry`'s range.
+void record_scanned_extent(
+    const data_snapshot_t&     snapshot,
+    const Data_access_policy&  access,
+    auto_range_cache_entry_t&  entry)
+{
+    const void* first_sample = snapshot.at(0);
+    const void* last_sample  = snapshot.count > 0 ? snapshot.at(snapshot.count - 1u) : nullptr;
+    if (!first_sample || !last_sample) {
+        return;
+    }
+    entry.scanned_count           = snapshot.count;
+    entry.scanned_first_ts        = access.get_timestamp(first_sample);
+    entry.scanned_last_ts         = access.get_timestamp(last_sample);
+    entry.scanned_prefix_revision = snapshot.prefix_revision;
+}
+
+// True when `snapshot` is the snapshot `entry` scanned with samples appended.
+// Matching end timestamps cannot rule out an edit between them, so the
+// source must promise it through an unchanged nonzero prefix_revision; the
+// timestamps only guard against a source that breaks that promise.
+bool snapshot_extends_scan(
+    const data_snapshot_t&             snapshot,
+    const Data_access_policy&          access,
+    const auto_range_cache_entry_t&    entry)
+{
+    if (entry.scanned_count == 0 || snapshot.count <= entry.scanned_count) {
+        return false;
+    }
+    if (entry.scanned_prefix_revision == 0 ||
+        snapshot.prefix_revision != entry.scanned_prefix_revision)
+    {
+        return false;
+    }
+    const void* first_sample  = snapshot.at(0);
+    const void* anchor_sample = snapshot.at(entry.scanned_count - 1u);
+    return
+        first_sample  != nullptr                                     &&
+        anchor_sample != nullptr                                     &&
+        access.get_timestamp(first_sample)  == entry.scanned_first_ts &&
+        access.get_timestamp(anchor_sample) == entry.scanned_last_ts;
+}
+
+// First index of `snapshot` whose timestamp is not below `t_ns` (or, with
+// `after`, above it). Timestamps must be ascending.
+std::size_t ascending_timestamp_bound(
+    const data_snapshot_t&     snapshot,
+    const Data_access_policy&  access,
+    std::int64_t               t_ns,
+    bool                       after)
+{
+    std::size_t first = 0;
+    std::size_t count = snapshot.count;
+    while (count > 0) {
+        const std::size_t step   = count / 2u;
+        const void*       sample = snapshot.at(first + step);
+        const std::int64_t t     = sample
+            ? access.get_timestamp(sample)
+            : std::numeric_limits<std::int64_t>::max();
+        if (after ? t <= t_ns : t < t_ns) {
+            first += step + 1u;
+            count -= step + 1u;
+        }
+        else {
+            count = step;
+        }
+    }
+    return first;
+}
+
+bool same_tracker_shape(
+    const visible_range_tracker_t&     tracker,
+    const Data_source&                 source,
+    const Data_access_policy&          access,
+    std::size_t                        lod_level,
+    const data_query_context_t&        query)
+{
+    const erased_access_policy_t access_view =
+        make_erased_access_policy_view(access);
+    const access_policy_cache_key_t access_key =
+        make_access_policy_cache_key(&access, access_view);
+    return (
+        tracker.valid                                              &&
+        tracker.source_identity    == source.identity()            &&
+        tracker.access_identity    == &access                      &&
+        tracker.access_key         == access_key                   &&
+        tracker.layout_key         == access.layout_key            &&
+        tracker.semantics_value    == query.semantics_key.value    &&
+        tracker.semantics_revision == query.semantics_key.revision &&
+        tracker.lod_level          == lod_level                    &&
+        tracker.nonfinite_policy   == query.nonfinite_policy);
+}
+
+// True when the samples `tracker` read are still in `snapshot` unchanged:
+// the content is the same, or the source kept its append or streaming
+// promise (leading samples may have been dropped).
+bool snapshot_keeps_tracked_samples(
+    const visible_range_tracker_t&     tracker,
+    const data_snapshot_t&             snapshot)
+{
+    return
+        snapshot.sequence == tracker.sequence ||
+        (tracker.prefix_revision != 0 &&
+         snapshot.prefix_revision == tracker.prefix_revision) ||
+        (tracker.stream_revision != 0 &&
+         snapshot.stream_revision == tracker.stream_revision);
+}
+
+// Slides `tracker` to query.time_window over `snapshot`. Continues from the
+// last sample read when the window only moved forward, the source promised
+// the samples read are unchanged and that sample is still in the snapshot;
+// otherwise rebuilds from the window start. Returns false, leaving the
+// tracker unusable, when a sample cannot be read or timestamps are not
+// ascending.
+bool slide_visible_range_tracker(
+    visible_range_tracker_t&       tracker,
+    const data_snapshot_t&         snapshot,
+    const Data_source&             source,
+    const Data_access_policy&      access,
+    std::size_t                    lod_level,
+    const data_query_context_t&    query,
+    std::size_t&                   read_count,
+    bool&                          rebuilt)
+{
+    const std::int64_t t_min = query.time_window.min_ns;
+    const std::int64_t t_max = query.time_window.max_ns;
+    read_count = 0;
+
+    std::size_t next = 0;
+    rebuilt =
+        !same_tracker_shape(tracker, source, access, lod_level, query) ||
+        !snapshot_keeps_tracked_samples(tracker, snapshot)             ||
+        t_min < tracker.t_min_ns                                       ||
+        t_max < tracker.t_max_ns;
+    if (!rebuilt) {
+        next = ascending_timestamp_bound(snapshot, access, tracker.read_until_ts, false) +
+            tracker.read_until_run;
+        const void* anchor = next > 0 && next <= snapshot.count ? snapshot.at(next - 1u) : nullptr;
+        rebuilt = !anchor || access.get_timestamp(anchor) != tracker.read_until_ts;
+    }
+    if (rebuilt) {
+        const erased_access_policy_t access_view =
+            make_erased_access_policy_view(access);
+        tracker                    = visible_range_tracker_t{};
+        tracker.source_identity    = source.identity();
+        tracker.access_identity    = &access;
+        tracker.access_key         = make_access_policy_cache_key(&access, access_view);
+        tracker.layout_key         = access.layout_key;
+        tracker.semantics_value    = query.semantics_key.value;
+        tracker.semantics_revision = query.semantics_key.revision;
+        tracker.lod_level          = lod_level;
+        tracker.nonfinite_policy   = query.nonfinite_policy;
+        next = 0;
+    }
+    tracker.valid = false;
+
+    // Samples before the window start never enter it again.
+    next = std::max(next, ascending_timestamp_bound(snapshot, access, t_min, false));
+
+    std::int64_t previous_t = std::numeric_limits<std::int64_t>::min();
+    for (; next < snapshot.count; ++next) {
+        const void* sample = snapshot.at(next);
+        if (!sample) {
+            return false;
+        }
+        const std::int64_t t = access.get_timestamp(sample);
+        if (t > t_max) {
+            break;
+        }
+        if (t < previous_t) {
+            return false;
+        }
+        previous_t = t;
+
+        sample_draw_value_t draw_value;
+        const sample_draw_status_t status =
+            read_sample_draw_value(access, sample, query.nonfinite_policy, draw_value);
+        if (status == sample_draw_status_t::FAILED) {
+            return false;
+        }
+        ++read_count;
+        if (status != sample_draw_status_t::DRAWABLE) {
+            continue;
+        }
+        while (!tracker.min_samples.empty() &&
+               tracker.min_samples.back().value >= draw_value.y_min)
+        {
+            tracker.min_samples.pop_back();
+        }
+        tracker.min_samples.push_back({t, draw_value.y_min});
+        while (!tracker.max_samples.empty() &&
+               tracker.max_samples.back().value <= draw_value.y_max)
+        {
+            tracker.max_samples.pop_back();
+        }
+        tracker.max_samples.push_back({t, draw_value.y_max});
+    }
+
+    // Candidates leave once the window start passes them, or when the
+    // source dropped them from the front of the snapshot.
+    const void*        first_sample = snapshot.at(0);
+    const std::int64_t cutoff       = first_sample
+        ? std::max(t_min, access.get_timestamp(first_sample))
+        : t_min;
+    while (!tracker.min_samples.empty() && tracker.min_samples.front().t_ns < cutoff) {
+        tracker.min_samples.pop_front();
+    }
+    while (!tracker.max_samples.empty() && tracker.max_samples.front().t_ns < cutoff) {
+        tracker.max_samples.pop_front();
+    }
+
+    tracker.t_min_ns        = t_min;
+    tracker.t_max_ns        = t_max;
+    tracker.sequence        = snapshot.sequence;
+    tracker.prefix_revision = snapshot.prefix_revision;
+    tracker.stream_revision = snapshot.stream_revision;
+    if (next == 0) {
+        // Nothing before the window end: the next frame starts over.
+        return true;
+    }
+    const void* anchor = snapshot.at(next - 1u);
+    if (!anchor) {
+        return false;
+    }
+    tracker.read_until_ts  = access.get_timestamp(anchor);
+    tracker.read_until_run =
+        next - ascending_timestamp_bound(snapshot, access, tracker.read_until_ts, false);
+    tracker.valid          = true;
+    return true;
 }
 
 bool valid_query_range(value_range_t range)
@@ -298,6 +547,64 @@ bool valid_query_range(value_range_t range)
         range.min <= range.max;
 }
 
+// Answers `query` from series_id's cache entry when it still matches the
+// source's current sequence. Returns false on a miss; on a hit, `got_range`
+// tells whether the entry holds a range (EMPTY entries do not).
+bool cached_series_range(
+    const std::map<int, auto_range_cache_entry_t>* entries,
+    int                                            series_id,
+    const Data_source&                             source,
+    const Data_access_policy&                      access,
+    std::size_t                                    level,
+    const data_query_context_t&                    query,
+    bool&                                          got_range,
+    float&                                         out_min,
+    float&                                         out_max)
+{
+    if (!entries || query.semantics_key.conservative) {
+        return false;
+    }
+    const std::uint64_t current_sequence = source.current_sequence(level);
+    if (current_sequence == 0) {
+        return false;
+    }
+    const auto found = entries->find(series_id);
+    if (found == entries->end() ||
+        !same_cache_shape(found->second, source, access, level, query, current_sequence))
+    {
+        return false;
+    }
+    got_range = found->second.status != Data_query_status::EMPTY;
+    if (got_range) {
+        out_min = found->second.range.min;
+        out_max = found->second.range.max;
+    }
+    return true;
+}
+
+// Buffers the observations a series makes on a worker thread so they reach
+// the frame's profiler from the calling thread, in series order.
+class Deferred_profiler final : public Profiler
+{
+public:
+    void begin_scope(const char* /*name*/) override {}
+    void end_scope() override {}
+    void record_observation(const char* name, double value) override
+    {
+        m_observations.emplace_back(name, value);
+    }
+
+    void replay(Profiler& target) const
+    {
+        for (const auto& [name, value] : m_observations) {
+            target.record_observation(name, value);
+        }
+    }
+
+private:
+    std::vector<std::pair<const char*, double>> m_observations;
+};
+
 bool query_or_scan_series_range(
     int                        series_id,
     bool                       preview,
@@ -308,6 +615,8 @@ bool query_or_scan_series_range(
     Empty_window_behavior      empty_window_behavior,
     Nonfinite_sample_policy    nonfinite_policy,
     bool                       visible_only,
+    bool                       incremental,
+    bool                       sliding,
     time_range_t               time_window,
     auto_range_cache_t*        cache,
     Profiler*                  profiler,
@@ -327,24 +636,203 @@ bool query_or_scan_series_range(
 
     const bool cacheable_query =
         entries && current_sequence != 0 && !query.semantics_key.conservative;
-    if (cacheable_query) {
+    bool cached_got_range = false;
+    if (cached_series_range(
+            entries, series_id, source, access, level, query, cached_got_range, out_min, out_max))
+    {
+        return cached_got_range;
+    }
+
+    const auto cache_result = [&](const data_query_result_t<value_range_t>& result) {
+        if (!query.semantics_key.conservative && entries && result.sequence != 0) {
+            (*entries)[series_id] = make_cache_entry(
+                source,
+                access,
+                level,
+                query,
+                result.sequence,
+                result.status,
+                result.value);
+        }
+    };
+
+    // Global modes first ask for the range the source published with this
+    // content, which needs no sample access.
+    if (!visible_only) {
+        const auto published = source.query_published_v_range(level, query);
+        if (published.sequence != 0 &&
+            (published.status == Data_query_status::READY ||
+             published.status == Data_query_status::EMPTY))
+        {
+            if (profiler) {
+                profiler->record_counter("renderer.auto_range.published_range_count");
+            }
+            if (published.status == Data_query_status::EMPTY) {
+                cache_result(published);
+                return false;
+            }
+            if (valid_query_range(published.value)) {
+                cache_result(published);
+                out_min = published.value.min;
+                out_max = published.value.max;
+                return true;
+            }
+        }
+    }
+
+    // Full-resolution global ranges the resolver scans itself keep the
+    // scanned extent, so an append-only source only has its new samples
+    // scanned on the next sequence.
+    const bool extendable_query =
+        cacheable_query && incremental && !visible_only && level == 0 &&
+        static_cast<bool>(access.get_timestamp);
+
+    // Forward-sliding VISIBLE windows over ascending data keep a tracker,
+    // so a frame only reads the samples that entered the window.
+    const bool trackable_query =
+        cacheable_query && sliding && visible_only && !preview &&
+        interpolation    == Series_interpolation::LINEAR           &&
+        nonfinite_policy != Nonfinite_sample_policy::REJECT_WINDOW &&
+        static_cast<bool>(access.get_timestamp)                    &&
+        source.time_order(level) == Time_order::ASCENDING;
+
+    // Both replace only the default scan: a source that overrides
+    // query_v_range() is asked first and keeps answering itself.
+    data_query_result_t<value_range_t> query_result;
+    const bool deferred_query = extendable_query || trackable_query;
+    if (deferred_query) {
+        if (profiler) {
+            profiler->record_counter("renderer.auto_range.query_count");
+        }
+        data_query_context_t deferred = query;
+        deferred.defer_default_scan = true;
+        query_result = source.query_v_range(level, deferred);
+    }
+    const bool source_answered = query_result.status != Data_query_status::UNSUPPORTED;
+    const auto scan_and_cache = [&](
+        const data_snapshot_t&             snapshot,
+        const auto_range_cache_entry_t*    previous) -> bool
+    {
+        value_range_t range{};
+        bool          have_any = false;
+        std::size_t   first    = 0;
+        if (previous) {
+            first = previous->scanned_count;
+            if (previous->status == Data_query_status::READY) {
+                range    = previous->range;
+                have_any = true;
+            }
+        }
+        for (std::size_t i = first; i < snapshot.count; ++i) {
+            const void* sample = snapshot.at(i);
+            if (!sample ||
+                include_sample_range(
+                    access,
+                    sample,
+                    nonfinite_policy,
+                    range.min,
+                    range.max,
+                    have_any) == sample_draw_status_t::FAILED)
+            {
+                return false;
+            }
+        }
+        if (profiler) {
+            profiler->record_observation(
+                "renderer.auto_range.scanned_samples",
+                static_cast<double>(snapshot.count - first));
+        }
+        if (snapshot.sequence != 0) {
+            auto entry = make_cache_entry(
+                source,
+                access,
+                level,
+                query,
+                snapshot.sequence,
+                have_any ? Data_query_status::READY : Data_query_status::EMPTY,
+                range);
+            record_scanned_extent(snapshot, access, entry);
+            (*entries)[series_id] = entry;
+        }
+        if (!have_any || !valid_query_range(range)) {
+            return false;
+        }
+        out_min = range.min;
+        out_max = range.max;
+        return true;
+    };
+
+    if (extendable_query && !source_answered) {
         const auto found = entries->find(series_id);
         if (found != entries->end() &&
-            same_cache_shape(found->second, source, access, level, query, current_sequence))
+            found->second.scanned_count > 0 &&
+            same_cache_shape(found->second, source, access, level, query, found->second.sequence))
         {
-            if (found->second.status == Data_query_status::EMPTY) {
-                return false;
+            const data_snapshot_t snapshot = source.snapshot(level);
+            if (snapshot.is_valid() && snapshot_extends_scan(snapshot, access, found->second)) {
+                if (profiler) {
+                    profiler->record_counter("renderer.auto_range.incremental_scan_count");
+                }
+                const auto_range_cache_entry_t previous = found->second;
+                return scan_and_cache(snapshot, &previous);
+            }
+        }
+    }
+
+    if (extendable_query && !source_answered) {
+        const data_snapshot_t snapshot = source.snapshot(level);
+        if (snapshot.is_valid()) {
+            if (profiler) {
+                profiler->record_counter("renderer.auto_range.range_scan_count");
+            }
+            return scan_and_cache(snapshot, nullptr);
+        }
+    }
+
+    if (trackable_query && !source_answered) {
+        const data_snapshot_t snapshot = source.snapshot(level);
+        if (snapshot.is_valid()) {
+            visible_range_tracker_t& tracker = cache->visible_trackers[series_id];
+            std::size_t read_count = 0;
+            bool        rebuilt    = false;
+            if (slide_visible_range_tracker(
+                    tracker, snapshot, source, access, level, query, read_count, rebuilt))
+            {
+                if (profiler) {
+                    profiler->record_counter(rebuilt
+                        ? "renderer.auto_range.visible_tracker_rebuild_count"
+                        : "renderer.auto_range.visible_tracker_slide_count");
+                    profiler->record_observation(
+                        "renderer.auto_range.scanned_samples",
+                        static_cast<double>(read_count));
+                }
+                data_query_result_t<value_range_t> result;
+                result.sequence = snapshot.sequence;
+                if (tracker.min_samples.empty()) {
+                    result.status = Data_query_status::EMPTY;
+                    cache_result(result);
+                    return false;
+                }
+                result.status = Data_query_status::READY;
+                result.value  = {tracker.min_samples.front().value, tracker.max_samples.front().value};
+                if (!valid_query_range(result.value)) {
+                    return false;
+                }
+                cache_result(result);
+                out_min = result.value.min;
+                out_max = result.value.max;
+                return true;
             }
-            out_min = found->second.range.min;
-            out_max = found->second.range.max;
-            return true;
+            cache->visible_trackers.erase(series_id);
         }
     }
 
-    if (profiler) {
-        profiler->record_counter("renderer.auto_range.query_count");
+    if (!deferred_query) {
+        if (profiler) {
+            profiler->record_counter("renderer.auto_range.query_count");
+        }
+        query_result = source.query_v_range(level, query);
     }
-    auto query_result = source.query_v_range(level, query);
     if (query_result.status == Data_query_status::UNSUPPORTED) {
         query_result = source.Data_source::query_v_range(level, query);
     }
@@ -354,30 +842,12 @@ bool query_or_scan_series_range(
         }
         out_min = query_result.value.min;
         out_max = query_result.value.max;
-        if (!query.semantics_key.conservative && entries && query_result.sequence != 0) {
-            (*entries)[series_id] = make_cache_entry(
-                source,
-                access,
-                level,
-                query,
-                query_result.sequence,
-                query_result.status,
-                query_result.value);
-        }
+        cache_result(query_result);
         return true;
     }
 
     if (query_result.status == Data_query_status::EMPTY) {
-        if (!query.semantics_key.conservative && entries && query_result.sequence != 0) {
-            (*entries)[series_id] = make_cache_entry(
-                source,
-                access,
-                level,
-                query,
-                query_result.sequence,
-                query_result.status,
-                query_result.value);
-        }
+        cache_result(query_result);
         return false;
     }
 
@@ -413,6 +883,19 @@ bool resolve_series_collection_range(
     float&                 out_min,
     float&                 out_max)
 {
+    struct series_range_job_t
+    {
+        int                        series_id = 0;
+        const series_data_t*       item      = nullptr;
+        Data_source*               source    = nullptr;
+        const Data_access_policy*  access    = nullptr;
+        std::size_t                level     = 0;
+        bool                       resolved  = false;
+        bool                       got_range = false;
+        float                      min       = 0.0f;
+        float                      max       = 0.0f;
+    };
+
     bool      have_any = false;
     Profiler* profiler = config.profiler.get();
     const bool visible_only =
@@ -429,6 +912,7 @@ bool resolve_series_collection_range(
     }
     prune_cache_entries(cache, preview, series);
 
+    std::vector<series_range_job_t> jobs;
     for (const auto& [id, item] : series) {
         if (!item || !item->enabled) {
             continue;
@@ -449,34 +933,147 @@ bool resolve_series_collection_range(
         if (levels == 0) {
             continue;
         }
-        const std::size_t level =
+
+        series_range_job_t job;
+        job.series_id = id;
+        job.item      = item.get();
+        job.source    = source;
+        job.access    = &access;
+        job.level     =
             config.auto_v_range_mode == Auto_v_range_mode::GLOBAL_LOD
                 ? levels - 1
                 : 0;
+        jobs.push_back(job);
+    }
 
-        float series_min = 0.0f;
-        float series_max = 0.0f;
-        const bool got_range = query_or_scan_series_range(
-            id,
+    const auto resolve_job = [&](
+        series_range_job_t&    job,
+        auto_range_cache_t*    job_cache,
+        Profiler*              job_profiler)
+    {
+        job.got_range = query_or_scan_series_range(
+            job.series_id,
             preview,
-            *source,
-            access,
-            level,
-            preview ? item->effective_preview_interpolation() : item->interpolation,
-            item->empty_window_behavior,
-            item->nonfinite_policy,
+            *job.source,
+            *job.access,
+            job.level,
+            preview ? job.item->effective_preview_interpolation() : job.item->interpolation,
+            job.item->empty_window_behavior,
+            job.item->nonfinite_policy,
             visible_only,
+            config.incremental_global_auto_range,
+            config.sliding_visible_auto_range,
             visible_window,
-            cache,
-            profiler,
-            series_min,
-            series_max);
-        if (!got_range) {
+            job_cache,
+            job_profiler,
+            job.min,
+            job.max);
+        job.resolved = true;
+    };
+
+    // Cached ranges are read on this thread. The rest are grouped by source,
+    // so no source is queried from two threads at once, and each group runs
+    // against a private copy of its cache entries (trackers are moved) and a
+    // deferred profiler.
+    // Entries and observations are merged back in series order afterwards.
+    if (config.parallel_auto_range) {
+        std::map<int, auto_range_cache_entry_t>* entries = cache_entries(cache, preview);
+        std::vector<std::vector<std::size_t>>        groups;
+        std::unordered_map<const void*, std::size_t> group_of_source;
+        for (std::size_t i = 0; i < jobs.size(); ++i) {
+            series_range_job_t& job = jobs[i];
+            const data_query_context_t query = make_query(
+                *job.access,
+                visible_only ? visible_window : all_time_window(),
+                preview ? job.item->effective_preview_interpolation() : job.item->interpolation,
+                job.item->empty_window_behavior,
+                job.item->nonfinite_policy);
+            if (cached_series_range(
+                    entries,
+                    job.series_id,
+                    *job.source,
+                    *job.access,
+                    job.level,
+                    query,
+                    job.got_range,
+                    job.min,
+                    job.max))
+            {
+                job.resolved = true;
+                continue;
+            }
+            const auto [group, inserted] =
+                group_of_source.emplace(job.source->identity(), groups.size());
+            if (inserted) {
+                groups.emplace_back();
+            }
+            groups[group->second].push_back(i);
+        }
+
+        if (parallel_range_count(groups.size(), k_parallel_auto_range_min_sources_per_range) > 1) {
+            std::vector<auto_range_cache_t> job_caches(cache ? jobs.size() : 0);
+            std::vector<Deferred_profiler>  job_profilers(profiler ? jobs.size() : 0);
+            for (std::size_t i = 0; i < job_caches.size(); ++i) {
+                if (jobs[i].resolved) {
+                    continue;
+                }
+                const auto found = entries->find(jobs[i].series_id);
+                if (found != entries->end()) {
+                    (*cache_entries(&job_caches[i], preview))[found->first] = found->second;
+                }
+                const auto tracker = cache->visible_trackers.find(jobs[i].series_id);
+                if (tracker != cache->visible_trackers.end()) {
+                    job_caches[i].visible_trackers.insert(
+                        cache->visible_trackers.extract(tracker));
+                }
+            }
+
+            const std::size_t range_count = parallel_for_ranges(
+                groups.size(),
+                k_parallel_auto_range_min_sources_per_range,
+                [&](std::size_t, std::size_t first, std::size_t last) {
+                    for (std::size_t g = first; g < last; ++g) {
+                        for (const std::size_t i : groups[g]) {
+                            resolve_job(
+                                jobs[i],
+                                cache    ? &job_caches[i]    : nullptr,
+                                profiler ? &job_profilers[i] : nullptr);
+                        }
+                    }
+                });
+
+            for (std::size_t i = 0; i < jobs.size(); ++i) {
+                if (!job_caches.empty()) {
+                    for (const auto& [id, entry] : *cache_entries(&job_caches[i], preview)) {
+                        (*entries)[id] = entry;
+                    }
+                    cache->visible_trackers.merge(job_caches[i].visible_trackers);
+                }
+                if (!job_profilers.empty()) {
+                    job_profilers[i].replay(*profiler);
+                }
+            }
+            if (profiler) {
+                profiler->record_counter(
+                    "renderer.auto_range.parallel_range_count",
+                    static_cast<double>(range_count));
+            }
+        }
+    }
+
+    for (series_range_job_t& job : jobs) {
+        if (!job.resolved) {
+            resolve_job(job, cache, profiler);
+        }
+        if (!job.got_range) {
             continue;
         }
 
-        if (item->stack_group != 0 && stack_members[item->stack_group] > 1) {
-            auto& cumulative   = stack_ranges[item->stack_group];
+        const float series_min = job.min;
+        const float series_max = job.max;
+        const int   stack_group = job.item->stack_group;
+        if (stack_group != 0 && stack_members[stack_group] > 1) {
+            auto& cumulative   = stack_ranges[stack_group];
             out_min            = std::min(out_min, std::min(cumulative.first,
                 cumulative.first + series_min));
             out_max            = std::max(out_max, std::max(cumulative.second,
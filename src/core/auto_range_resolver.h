@@ -3,7 +3,9 @@
 #include <vnm_plot/core/plot_config.h>
 #include <vnm_plot/core/types.h>
 
+#include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <map>
 #include <memory>
 #include <utility>
@@ -29,12 +31,57 @@ struct auto_range_cache_entry_t
     value_range_t              range{};
     Data_query_status          status                 = Data_query_status::EMPTY;
     bool                       valid                  = false;
+    // Extent of the snapshot the resolver scanned itself for this range
+    // (incremental_global_auto_range); 0 when the range came from a query.
+    std::size_t                scanned_count          = 0;
+    std::int64_t               scanned_first_ts       = 0;
+    std::int64_t               scanned_last_ts        = 0;
+    std::uint64_t              scanned_prefix_revision = 0;
+};
+
+// Min/max of the drawable samples inside a forward-sliding VISIBLE window
+// over ascending data (sliding_visible_auto_range). Monotonic deques keep
+// the candidates in timestamp order: min_samples holds increasing values
+// and max_samples decreasing ones, so each front is the window's extreme
+// and a frame only reads the samples entering the window.
+struct visible_range_tracker_t
+{
+    struct sample_t
+    {
+        std::int64_t   t_ns  = 0;
+        float          value = 0.0f;
+    };
+
+    const void*                source_identity    = nullptr;
+    const Data_access_policy*  access_identity    = nullptr;
+    access_policy_cache_key_t  access_key;
+    std::uint64_t              layout_key         = 0;
+    std::uint64_t              semantics_value    = 0;
+    std::uint64_t              semantics_revision = 0;
+    std::size_t                lod_level          = 0;
+    Nonfinite_sample_policy    nonfinite_policy   = Nonfinite_sample_policy::BREAK_SEGMENT;
+    std::int64_t               t_min_ns           = 0;
+    std::int64_t               t_max_ns           = 0;
+    // The snapshot last slid over; a new sequence is only slid over when
+    // the source keeps one of its revisions (data_snapshot_t).
+    std::uint64_t              sequence           = 0;
+    std::uint64_t              prefix_revision    = 0;
+    std::uint64_t              stream_revision    = 0;
+    // The last sample read (or skipped as before the window) has timestamp
+    // read_until_ts and ends a run of read_until_run samples sharing it;
+    // later samples have not been read.
+    std::int64_t               read_until_ts      = 0;
+    std::size_t                read_until_run     = 0;
+    bool                       valid              = false;
+    std::deque<sample_t>       min_samples;
+    std::deque<sample_t>       max_samples;
 };
 
 struct auto_range_cache_t
 {
     std::map<int, auto_range_cache_entry_t>    main_entries;
     std::map<int, auto_range_cache_entry_t>    preview_entries;
+    std::map<int, visible_range_tracker_t>     visible_trackers;
 };
 
 std::pair<float, float> resolve_main_v_range(
@@ -0,0 +1,86 @@
+#pragma once
+
+// Internal helper that runs a fixed list of jobs on one short-lived worker
+// thread while the caller keeps working, with a per-job completion
+// handoff. Like parallel_for.h it keeps no long-lived pool: the thread
+// lives for one batch of jobs.
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace vnm::plot::detail {
+
+// Jobs run in list order. wait(i) returns once job i finished, so the
+// caller consumes results in the same order without waiting for the rest.
+// The destructor waits for every job. Jobs must not throw.
+class Background_jobs
+{
+public:
+    Background_jobs() = default;
+
+    ~Background_jobs()
+    {
+        wait_all();
+    }
+
+    Background_jobs(const Background_jobs&)            = delete;
+    Background_jobs& operator=(const Background_jobs&) = delete;
+
+    // Starts the worker on `jobs`. If no thread can be started the jobs run
+    // inline before start() returns. Must not be called while jobs run.
+    void start(std::vector<std::function<void()>> jobs)
+    {
+        wait_all();
+        m_jobs = std::move(jobs);
+        m_done = 0;
+        if (m_jobs.empty()) {
+            return;
+        }
+        try {
+            m_worker = std::thread([this]() {
+                for (auto& job : m_jobs) {
+                    job();
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    ++m_done;
+                    m_done_changed.notify_all();
+                }
+            });
+        }
+        catch (const std::system_error&) {
+            for (auto& job : m_jobs) {
+                job();
+            }
+            m_done = m_jobs.size();
+        }
+    }
+
+    std::size_t size() const { return m_jobs.size(); }
+
+    void wait(std::size_t index)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done_changed.wait(lock, [&]() { return m_done > index || m_done >= m_jobs.size(); });
+    }
+
+    void wait_all()
+    {
+        if (m_worker.joinable()) {
+            m_worker.join();
+        }
+    }
+
+private:
+    std::vector<std::function<void()>> m_jobs;
+    std::mutex                         m_mutex;
+    std::condition_variable            m_done_changed;
+    std::size_t                        m_done = 0;
+    std::thread                        m_worker;
+};
+
+} // namespace vnm::plot::detail
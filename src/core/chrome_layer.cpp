@@ -0,0 +1,71 @@
+#include "chrome_layer.h"
+#include "plot_frame_helpers.h"
+
+#include <vnm_plot/core/plot_config.h>
+
+namespace vnm::plot::detail {
+
+bool Chrome_layer::prepare(
+    QRhi*                      rhi,
+    QSize                      size,
+    QRhiResourceUpdateBatch*   updates,
+    QRhiRenderTarget*          rt,
+    const glm::mat4&           pmv)
+{
+    if (m_layer.ensure(rhi, size, updates) &&
+        m_layer.prepare_composite(updates, rt, pmv))
+    {
+        return true;
+    }
+    reset();
+    return false;
+}
+
+bool Chrome_layer::needs_redraw(
+    const layout_cache_key_t&  layout,
+    const chrome_theme_t&      theme,
+    Profiler*                  profiler)
+{
+    auto& theme_key = m_next_theme_key;
+    theme_key.clear();
+    theme_key.insert(theme_key.end(), {
+        ieee_key_bits(theme.window_background.r),
+        ieee_key_bits(theme.window_background.g),
+        ieee_key_bits(theme.window_background.b),
+        ieee_key_bits(theme.window_background.a),
+        static_cast<std::uint64_t>(theme.lcd_subpixel_order),
+        static_cast<std::uint64_t>(theme.visible_info_flags),
+        ieee_key_bits(theme.base_label_height_px),
+        pointer_key(theme.prepared_text)
+    });
+    const bool redraw =
+        !m_layer.has_previous()    ||
+        !(layout == m_layout_key)  ||
+        theme_key != m_theme_key;
+    m_layout_key = layout;
+    m_theme_key.swap(theme_key);
+    if (profiler) {
+        profiler->record_counter(redraw
+            ? "qrhi.renderer.chrome_layer.redraw_count"
+            : "qrhi.renderer.chrome_layer.reuse_count");
+    }
+    return redraw;
+}
+
+void Chrome_layer::finish_redraw(bool label_fades_active)
+{
+    if (label_fades_active) {
+        m_layer.invalidate();
+    }
+    else {
+        m_layer.finish_frame();
+    }
+}
+
+void Chrome_layer::reset()
+{
+    m_layer.reset();
+    m_theme_key.clear();
+}
+
+} // namespace vnm::plot::detail
@@ -0,0 +1,86 @@
+#pragma once
+
+// VNM Plot Library - Chrome layer
+// The retained back-chrome layer of Plot_config::cache_chrome_layer and the
+// inputs that decide when it is redrawn.
+
+#include "offscreen_layer.h"
+
+#include <vnm_plot/core/lcd.h>
+#include <vnm_plot/core/types.h>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include <QSize>
+
+#include <cstdint>
+#include <vector>
+
+class QRhi;
+class QRhiCommandBuffer;
+class QRhiRenderTarget;
+class QRhiResourceUpdateBatch;
+
+namespace vnm::plot {
+class Profiler;
+}
+
+namespace vnm::plot::detail {
+
+// What the back chrome depends on apart from its layout.
+struct chrome_theme_t
+{
+    glm::vec4              window_background    = glm::vec4(0.f, 0.f, 0.f, 1.f);
+    lcd_subpixel_order_t   lcd_subpixel_order   = lcd_subpixel_order_t::NONE;
+    int                    visible_info_flags   = k_visible_info_none;
+    double                 base_label_height_px = 0.0;
+    // Text prepared for the frame, which draws the tick labels; nullptr
+    // when the frame shows none.
+    const void*            prepared_text        = nullptr;
+};
+
+// Backgrounds, grid and tick labels drawn into a RETAINED Offscreen_layer
+// and composited by every frame. The layer is redrawn only when it holds no
+// finished frame or its layout or theme changed; a layer drawn while label
+// fades run is redrawn next frame, since the tick alphas follow the fades.
+class Chrome_layer
+{
+public:
+    // Readies the layer and its composite for the window target `rt`.
+    // Returns false when the layer cannot be used; it then forgets its
+    // content and the host draws the chrome in the main pass.
+    bool prepare(
+        QRhi*                      rhi,
+        QSize                      size,
+        QRhiResourceUpdateBatch*   updates,
+        QRhiRenderTarget*          rt,
+        const glm::mat4&           pmv);
+
+    // Whether the frame must redraw the layer, which is then drawn for
+    // `layout` and `theme`. Counts qrhi.renderer.chrome_layer.redraw_count
+    // or reuse_count on `profiler`.
+    bool needs_redraw(
+        const layout_cache_key_t&  layout,
+        const chrome_theme_t&      theme,
+        Profiler*                  profiler);
+
+    // Target of a redraw pass; it clears to transparent.
+    QRhiRenderTarget* render_target() const { return m_layer.render_target(); }
+
+    // Ends the redraw pass of the frame.
+    void finish_redraw(bool label_fades_active);
+
+    // Draws the layer over the window; inside the open main pass.
+    void record_composite(QRhiCommandBuffer* cb) { m_layer.record_composite(cb); }
+
+    void reset();
+
+private:
+    Offscreen_layer                m_layer{Offscreen_layer::mode_t::RETAINED};
+    layout_cache_key_t             m_layout_key;
+    std::vector<std::uint64_t>     m_theme_key;
+    std::vector<std::uint64_t>     m_next_theme_key;
+};
+
+} // namespace vnm::plot::detail
@@ -3,6 +3,7 @@
 #include <vnm_plot/rhi/asset_loader.h>
 #include "platform_paths.h"
 #include "rhi_helpers.h"
+#include "rhi_shared_resources.h"
 
 #include <glm/gtc/type_ptr.hpp>
 #include <vnm_msdf_text/lcd_contract.h>
@@ -12,7 +13,6 @@
 #include <QByteArrayView>
 #include <QFile>
 #include <QCryptographicHash>
-#include <QImage>
 #include <rhi/qrhi.h>
 
 #include <algorithm>
@@ -437,28 +437,11 @@ std::filesystem::path cache_file_path(
     int                                    pixel_height,
     const std::array<std::uint8_t, 32>&    font_digest)
 {
-    static std::filesystem::path s_cache_dir;
-
-    if (s_cache_dir.empty()) {
-        // Prefer cache directory for disposable MSDF artifacts
-        s_cache_dir = get_cache_directory();
-        if (s_cache_dir.empty()) {
-            // Fallback to data directory
-            s_cache_dir = get_data_directory();
-        }
-        if (s_cache_dir.empty()) {
-            // Last resort: current directory
-            s_cache_dir = std::filesystem::current_path() / ".vnm_plot_cache";
-            std::error_code ec;
-            std::filesystem::create_directories(s_cache_dir, ec);
-        }
-    }
-
     std::ostringstream oss;
     oss << "msdf_cache_v" << k_cache_version << "_px" << pixel_height << "_font";
     oss << digest_to_hex(font_digest);
     oss << ".bin";
-    return s_cache_dir / oss.str();
+    return get_disk_cache_directory() / oss.str();
 }
 
 // Forward declarations for disk cache helpers
@@ -843,11 +826,13 @@ struct rhi_text_draw_op_t
 
 struct rhi_text_state_t
 {
+    // Released last: the atlas, sampler and pipeline below belong to it.
+    std::shared_ptr<detail::Rhi_shared_resources>
+                                       shared;
     QRhi*                              last_rhi    = nullptr;
 
-    std::unique_ptr<QRhiTexture>       atlas_texture;
-    std::unique_ptr<QRhiSampler>       sampler;
-    int                                atlas_size = 0;
+    std::shared_ptr<QRhiTexture>       atlas_texture;
+    QRhiSampler*                       sampler = nullptr;
     std::uint64_t                      uploaded_cache_epoch = 0;
 
     std::unique_ptr<QRhiBuffer>        vbo;
@@ -859,10 +844,7 @@ struct rhi_text_state_t
     std::vector<rhi_text_draw_op_t>    ops;
     std::size_t                        call_used = 0;
 
-    std::unique_ptr<QRhiGraphicsPipeline>
-                                       pipeline;
-    QRhiRenderPassDescriptor*          pipeline_rpd = nullptr;
-    int                                pipeline_samples = 0;
+    QRhiGraphicsPipeline*              pipeline = nullptr;
 
     QShader                            vert;
     QShader                            frag;
@@ -1212,10 +1194,18 @@ void Font_renderer::rhi_queue_draw(
 
     QRhiResourceUpdateBatch* updates = ctx.rhi_updates;
 
-    if (rhi_state.last_rhi != rhi) {
+    if (rhi_state.last_rhi != rhi ||
+        (rhi_state.shared && rhi_state.shared->rhi() != rhi))
+    {
         rhi_state = rhi_text_state_t{};
+        rhi_state.shared   = detail::Rhi_shared_resources::acquire(rhi);
         rhi_state.last_rhi = rhi;
     }
+    if (!rhi_state.shared) {
+        m_impl->m_rhi_vertex_data.clear();
+        m_impl->m_rhi_index_data.clear();
+        return;
+    }
 
     if (!rhi_state.shaders_loaded) {
         rhi_state.vert           = load_qsb("msdf_text.vert.qsb");
@@ -1225,26 +1215,20 @@ void Font_renderer::rhi_queue_draw(
 
     const auto& cached = *m_impl->m_font_cache;
     if (!rhi_state.atlas_texture ||
-        rhi_state.atlas_size           != cached.atlas.atlas_size ||
         rhi_state.uploaded_cache_epoch != cached.cache_epoch)
     {
-        rhi_state.atlas_texture.reset(rhi->newTexture(
-            QRhiTexture::RGBA8,
-            QSize(cached.atlas.atlas_size, cached.atlas.atlas_size)));
-        if (!rhi_state.atlas_texture || !rhi_state.atlas_texture->create()) {
-            rhi_state.atlas_texture.reset();
+        // Cached fonts are immutable, so renderers showing the same font
+        // share one texture per QRhi.
+        rhi_state.atlas_texture = rhi_state.shared->font_atlas(
+            cached.cache_epoch,
+            cached.atlas.atlas_size,
+            cached.atlas.rgba.data(),
+            updates);
+        if (!rhi_state.atlas_texture) {
             m_impl->m_rhi_vertex_data.clear();
             m_impl->m_rhi_index_data.clear();
             return;
         }
-        QImage image(
-            cached.atlas.rgba.data(),
-            cached.atlas.atlas_size,
-            cached.atlas.atlas_size,
-            cached.atlas.atlas_size * 4,
-            QImage::Format_RGBA8888);
-        updates->uploadTexture(rhi_state.atlas_texture.get(), image);
-        rhi_state.atlas_size           = cached.atlas.atlas_size;
         rhi_state.uploaded_cache_epoch = cached.cache_epoch;
         for (auto& call : rhi_state.calls) {
             call.srb.reset();
@@ -1253,14 +1237,8 @@ void Font_renderer::rhi_queue_draw(
     }
 
     if (!rhi_state.sampler) {
-        rhi_state.sampler.reset(rhi->newSampler(
-            QRhiSampler::Linear,
-            QRhiSampler::Linear,
-            QRhiSampler::None,
-            QRhiSampler::ClampToEdge,
-            QRhiSampler::ClampToEdge));
-        if (!rhi_state.sampler || !rhi_state.sampler->create()) {
-            rhi_state.sampler.reset();
+        rhi_state.sampler = rhi_state.shared->clamp_sampler(QRhiSampler::Linear);
+        if (!rhi_state.sampler) {
             m_impl->m_rhi_vertex_data.clear();
             m_impl->m_rhi_index_data.clear();
             return;
@@ -1289,7 +1267,7 @@ void Font_renderer::rhi_queue_draw(
         if (!call.srb ||
             call.srb_last_ubo     != call.ubo.get()                ||
             call.srb_last_texture != rhi_state.atlas_texture.get() ||
-            call.srb_last_sampler != rhi_state.sampler.get())
+            call.srb_last_sampler != rhi_state.sampler)
         {
             call.srb.reset(rhi->newShaderResourceBindings());
             call.srb->setBindings({
@@ -1304,7 +1282,7 @@ void Font_renderer::rhi_queue_draw(
                     1,
                     QRhiShaderResourceBinding::FragmentStage,
                     rhi_state.atlas_texture.get(),
-                    rhi_state.sampler.get())
+                    rhi_state.sampler)
             });
             if (!call.srb->create()) {
                 call.srb.reset();
@@ -1313,7 +1291,7 @@ void Font_renderer::rhi_queue_draw(
             }
             call.srb_last_ubo     = call.ubo.get();
             call.srb_last_texture = rhi_state.atlas_texture.get();
-            call.srb_last_sampler = rhi_state.sampler.get();
+            call.srb_last_sampler = rhi_state.sampler;
         }
 
         return call_index;
@@ -1346,16 +1324,12 @@ void Font_renderer::rhi_queue_draw(
 
     auto& first_call = rhi_state.calls[first_call_index];
 
-    QRhiRenderPassDescriptor* current_rpd     = ctx.render_target->renderPassDescriptor();
-    const int                 current_samples = ctx.render_target->sampleCount();
-    if (rhi_state.pipeline &&
-        (rhi_state.pipeline_rpd != current_rpd ||
-         rhi_state.pipeline_samples != current_samples))
+    rhi_state.pipeline = rhi_state.shared->pipeline(
+        "text.msdf",
+        ctx.render_target,
+        [&](QRhiRenderPassDescriptor* rpd, int sample_count)
+            -> std::unique_ptr<QRhiGraphicsPipeline>
     {
-        rhi_state.pipeline.reset();
-    }
-
-    if (!rhi_state.pipeline) {
         std::unique_ptr<QRhiShaderResourceBindings> layout_srb(
             rhi->newShaderResourceBindings());
         layout_srb->setBindings({
@@ -1370,12 +1344,10 @@ void Font_renderer::rhi_queue_draw(
                 1,
                 QRhiShaderResourceBinding::FragmentStage,
                 rhi_state.atlas_texture.get(),
-                rhi_state.sampler.get())
+                rhi_state.sampler)
         });
         if (!layout_srb->create()) {
-            m_impl->m_rhi_vertex_data.clear();
-            m_impl->m_rhi_index_data.clear();
-            return;
+            return nullptr;
         }
 
         QRhiVertexInputLayout vlayout;
@@ -1393,14 +1365,14 @@ void Font_renderer::rhi_queue_draw(
         vlayout.setBindings({binding});
         vlayout.setAttributes({position, tex_bounds, frame_rect});
 
-        rhi_state.pipeline.reset(rhi->newGraphicsPipeline());
-        rhi_state.pipeline->setShaderStages({
+        std::unique_ptr<QRhiGraphicsPipeline> pipeline(rhi->newGraphicsPipeline());
+        pipeline->setShaderStages({
             { QRhiShaderStage::Vertex, rhi_state.vert },
             { QRhiShaderStage::Fragment, rhi_state.frag }
         });
-        rhi_state.pipeline->setVertexInputLayout(vlayout);
-        rhi_state.pipeline->setShaderResourceBindings(layout_srb.get());
-        rhi_state.pipeline->setTopology(QRhiGraphicsPipeline::Triangles);
+        pipeline->setVertexInputLayout(vlayout);
+        pipeline->setShaderResourceBindings(layout_srb.get());
+        pipeline->setTopology(QRhiGraphicsPipeline::Triangles);
 
         QRhiGraphicsPipeline::TargetBlend blend;
         blend.enable   = true;
@@ -1408,19 +1380,20 @@ void Font_renderer::rhi_queue_draw(
         blend.dstColor = QRhiGraphicsPipeline::OneMinusSrcAlpha;
         blend.srcAlpha = QRhiGraphicsPipeline::One;
         blend.dstAlpha = QRhiGraphicsPipeline::OneMinusSrcAlpha;
-        rhi_state.pipeline->setTargetBlends({blend});
-        rhi_state.pipeline->setFlags(QRhiGraphicsPipeline::UsesScissor);
-        rhi_state.pipeline->setRenderPassDescriptor(current_rpd);
-        rhi_state.pipeline->setSampleCount(current_samples);
+        pipeline->setTargetBlends({blend});
+        pipeline->setFlags(QRhiGraphicsPipeline::UsesScissor);
+        pipeline->setRenderPassDescriptor(rpd);
+        pipeline->setSampleCount(sample_count);
 
-        if (!rhi_state.pipeline->create()) {
-            rhi_state.pipeline.reset();
-            m_impl->m_rhi_vertex_data.clear();
-            m_impl->m_rhi_index_data.clear();
-            return;
+        if (!pipeline->create()) {
+            return nullptr;
         }
-        rhi_state.pipeline_rpd     = current_rpd;
-        rhi_state.pipeline_samples = current_samples;
+        return pipeline;
+    });
+    if (!rhi_state.pipeline) {
+        m_impl->m_rhi_vertex_data.clear();
+        m_impl->m_rhi_index_data.clear();
+        return;
     }
 
     const auto queue_text_pass = [&](std::size_t call_index,
@@ -1569,7 +1542,7 @@ void Font_renderer::rhi_record_frame(const frame_context_t& ctx)
     }
 
     QRhiCommandBuffer* cb = ctx.cb;
-    cb->setGraphicsPipeline(rhi_state.pipeline.get());
+    cb->setGraphicsPipeline(rhi_state.pipeline);
 
     QRhiCommandBuffer::VertexInput vertex_input{rhi_state.vbo.get(), 0u};
     const auto record_pass = [&](rhi_text_pass_t pass) {
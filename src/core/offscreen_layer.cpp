@@ -0,0 +1,375 @@
+#include "offscreen_layer.h"
+#include "rhi_helpers.h"
+#include "rhi_shared_resources.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <QImage>
+#include <rhi/qrhi.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace vnm::plot::detail {
+
+namespace {
+
+// plot_layer_composite.vert exposes:
+//
+//     layout(std140, binding = 0) uniform Block {
+//         mat4  pmv;               // offset 0
+//         vec2  size;              // offset 64
+//         int   framebuffer_y_up;  // offset 72
+//     } u;
+struct Composite_block_std140
+{
+    float         pmv[16];          // offset 0
+    float         size[2];          // offset 64
+    std::int32_t  framebuffer_y_up; // offset 72
+    std::int32_t  pad0;             // offset 76
+};
+static_assert(sizeof(Composite_block_std140) == 80,
+    "Composite UBO mirror must be 80 bytes");
+
+constexpr quint32 k_composite_ubo_bytes = sizeof(Composite_block_std140);
+
+} // anonymous namespace
+
+struct Offscreen_layer::impl_t
+{
+    mode_t                                       mode = mode_t::SCROLLING;
+    QRhi*                                        rhi  = nullptr;
+    QSize                                        size;
+    // Owns the sampler and the pipeline below.
+    std::shared_ptr<Rhi_shared_resources>        shared;
+
+    // Declaration order doubles as release order: targets go before the
+    // descriptor and the textures they reference.
+    std::unique_ptr<QRhiTexture>                 blank;
+    std::unique_ptr<QRhiTexture>                 layers[2];
+    std::unique_ptr<QRhiRenderPassDescriptor>    rpd;
+    std::unique_ptr<QRhiTextureRenderTarget>     targets[2];
+
+    QRhiSampler*                                 sampler = nullptr;
+    std::unique_ptr<QRhiBuffer>                  ubo;
+    std::size_t                                  ubo_capacity_bytes = 0;
+    Composite_block_std140                       uploaded{};
+    bool                                         uploaded_valid = false;
+    std::unique_ptr<QRhiShaderResourceBindings>  srbs[2];
+    QRhiGraphicsPipeline*                        pipeline         = nullptr;
+    QRhiRenderPassDescriptor*                    pipeline_rpd     = nullptr;
+    int                                          pipeline_samples = 0;
+
+    QShader                                      vert;
+    QShader                                      frag;
+    bool                                         shaders_loaded = false;
+
+    int                                          current      = 0;
+    bool                                         has_previous = false;
+
+    int layer_count() const
+    {
+        return mode == mode_t::SCROLLING ? 2 : 1;
+    }
+
+    void release_layers()
+    {
+        pipeline         = nullptr;
+        pipeline_rpd     = nullptr;
+        pipeline_samples = 0;
+        srbs[0].reset();
+        srbs[1].reset();
+        targets[0].reset();
+        targets[1].reset();
+        rpd.reset();
+        layers[0].reset();
+        layers[1].reset();
+        blank.reset();
+        size         = QSize();
+        current      = 0;
+        has_previous = false;
+    }
+
+    // Copies take texture coordinates, whose rows run bottom-up on y-up
+    // framebuffers.
+    QRect to_texture_rect(const QRect& rect) const
+    {
+        if (!rhi || !rhi->isYUpInFramebuffer()) {
+            return rect;
+        }
+        return QRect(
+            rect.x(),
+            size.height() - rect.y() - rect.height(),
+            rect.width(),
+            rect.height());
+    }
+
+    void copy(
+        QRhiResourceUpdateBatch* updates,
+        QRhiTexture*             destination,
+        QRhiTexture*             source,
+        const QRect&             source_rect,
+        const QPoint&            destination_top_left)
+    {
+        // Clip both rectangles to the layer, keeping them aligned.
+        const QRect  bounds(QPoint(0, 0), size);
+        const QPoint offset = destination_top_left - source_rect.topLeft();
+        const QRect  from   = source_rect
+            .intersected(bounds)
+            .intersected(bounds.translated(-offset));
+        const QRect  to     = from.translated(offset);
+        if (!updates || !destination || !source || from.isEmpty()) {
+            return;
+        }
+        const QRect texture_from = to_texture_rect(from);
+        const QRect texture_to   = to_texture_rect(to);
+        QRhiTextureCopyDescription description;
+        description.setPixelSize(to.size());
+        description.setSourceTopLeft(texture_from.topLeft());
+        description.setDestinationTopLeft(texture_to.topLeft());
+        updates->copyTexture(destination, source, description);
+    }
+};
+
+Offscreen_layer::Offscreen_layer(mode_t mode)
+:
+    m_impl(std::make_unique<impl_t>())
+{
+    m_impl->mode = mode;
+}
+
+Offscreen_layer::~Offscreen_layer() = default;
+
+bool Offscreen_layer::ensure(QRhi* rhi, QSize size, QRhiResourceUpdateBatch* updates)
+{
+    auto& impl = *m_impl;
+    if (!rhi || !updates || size.isEmpty()) {
+        return false;
+    }
+    if (impl.rhi != rhi || (impl.shared && impl.shared->rhi() != rhi)) {
+        reset();
+        impl.rhi    = rhi;
+        impl.shared = Rhi_shared_resources::acquire(rhi);
+    }
+    if (impl.layers[0] && impl.size == size) {
+        return true;
+    }
+    impl.release_layers();
+
+    const bool scrolling = impl.mode == mode_t::SCROLLING;
+    if (scrolling) {
+        impl.blank.reset(rhi->newTexture(
+            QRhiTexture::RGBA8, size, 1, QRhiTexture::UsedAsTransferSource));
+        if (!impl.blank || !impl.blank->create()) {
+            impl.release_layers();
+            return false;
+        }
+        QImage transparent(size, QImage::Format_RGBA8888_Premultiplied);
+        transparent.fill(Qt::transparent);
+        updates->uploadTexture(impl.blank.get(), transparent);
+    }
+    impl.size = size;
+
+    for (int i = 0; i < impl.layer_count(); ++i) {
+        impl.layers[i].reset(rhi->newTexture(
+            QRhiTexture::RGBA8,
+            size,
+            1,
+            QRhiTexture::RenderTarget | QRhiTexture::UsedAsTransferSource));
+        if (!impl.layers[i] || !impl.layers[i]->create()) {
+            impl.release_layers();
+            return false;
+        }
+        // A scrolling pass loads what the copies left, so the layer is
+        // never cleared by beginPass.
+        impl.targets[i].reset(rhi->newTextureRenderTarget(
+            {impl.layers[i].get()},
+            scrolling
+                ? QRhiTextureRenderTarget::Flags(QRhiTextureRenderTarget::PreserveColorContents)
+                : QRhiTextureRenderTarget::Flags()));
+        if (!impl.targets[i]) {
+            impl.release_layers();
+            return false;
+        }
+        if (!impl.rpd) {
+            impl.rpd.reset(impl.targets[i]->newCompatibleRenderPassDescriptor());
+            if (!impl.rpd) {
+                impl.release_layers();
+                return false;
+            }
+        }
+        impl.targets[i]->setRenderPassDescriptor(impl.rpd.get());
+        if (!impl.targets[i]->create()) {
+            impl.release_layers();
+            return false;
+        }
+        if (scrolling) {
+            impl.copy(updates, impl.layers[i].get(), impl.blank.get(), QRect(QPoint(0, 0), size), QPoint(0, 0));
+        }
+    }
+    return true;
+}
+
+bool Offscreen_layer::has_previous() const
+{
+    return m_impl->has_previous;
+}
+
+QRhiRenderTarget* Offscreen_layer::render_target() const
+{
+    return m_impl->targets[m_impl->current].get();
+}
+
+void Offscreen_layer::copy_from_previous(
+    QRhiResourceUpdateBatch* updates,
+    const QRect&             source,
+    const QPoint&            destination)
+{
+    auto& impl = *m_impl;
+    if (impl.mode != mode_t::SCROLLING || !impl.has_previous) {
+        return;
+    }
+    impl.copy(
+        updates,
+        impl.layers[impl.current].get(),
+        impl.layers[impl.current ^ 1].get(),
+        source,
+        destination);
+}
+
+void Offscreen_layer::clear(QRhiResourceUpdateBatch* updates, const QRect& rect)
+{
+    auto& impl = *m_impl;
+    impl.copy(updates, impl.layers[impl.current].get(), impl.blank.get(), rect, rect.topLeft());
+}
+
+bool Offscreen_layer::prepare_composite(
+    QRhiResourceUpdateBatch* updates,
+    QRhiRenderTarget*        rt,
+    const glm::mat4&         pmv)
+{
+    auto& impl = *m_impl;
+    QRhiTexture* const layer = impl.layers[impl.current].get();
+    if (!impl.rhi || !updates || !rt || !layer) {
+        return false;
+    }
+
+    if (!impl.shaders_loaded) {
+        impl.vert           = load_qsb("plot_layer_composite.vert.qsb");
+        impl.frag           = load_qsb("plot_layer_composite.frag.qsb");
+        impl.shaders_loaded = true;
+    }
+    if (!impl.vert.isValid() || !impl.frag.isValid()) {
+        return false;
+    }
+
+    if (!impl.sampler) {
+        impl.sampler = impl.shared->clamp_sampler(QRhiSampler::Nearest);
+        if (!impl.sampler) {
+            return false;
+        }
+    }
+
+    const bool ubo_sized = impl.ubo && impl.ubo_capacity_bytes >= k_composite_ubo_bytes;
+    if (!ensure_dynamic_ubo(impl.rhi, impl.ubo, impl.ubo_capacity_bytes, k_composite_ubo_bytes)) {
+        return false;
+    }
+    if (!ubo_sized) {
+        impl.srbs[0].reset();
+        impl.srbs[1].reset();
+        impl.uploaded_valid = false;
+    }
+
+    QRhiRenderPassDescriptor* const current_rpd     = rt->renderPassDescriptor();
+    const int                       current_samples = rt->sampleCount();
+    if (impl.pipeline &&
+        (impl.pipeline_rpd != current_rpd || impl.pipeline_samples != current_samples))
+    {
+        impl.pipeline = nullptr;
+    }
+    if (!impl.pipeline) {
+        // The quad's corners come from gl_VertexIndex; no vertex input.
+        alpha_blended_pipeline_desc_t desc;
+        desc.vert                = impl.vert;
+        desc.frag                = impl.frag;
+        desc.ubo_bytes           = k_composite_ubo_bytes;
+        desc.layout_texture      = layer;
+        desc.layout_sampler      = impl.sampler;
+        desc.premultiplied_alpha = true;
+        impl.pipeline = impl.shared->pipeline(
+            "layer.composite",
+            rt,
+            [&](QRhiRenderPassDescriptor* target_rpd, int sample_count) {
+                return build_alpha_blended_pipeline(impl.rhi, target_rpd, sample_count, desc);
+            });
+        if (!impl.pipeline) {
+            return false;
+        }
+        impl.pipeline_rpd     = current_rpd;
+        impl.pipeline_samples = current_samples;
+    }
+
+    auto& srb = impl.srbs[impl.current];
+    if (!srb &&
+        !rebuild_ubo_texture_srb(
+            impl.rhi, srb, impl.ubo.get(), k_composite_ubo_bytes,
+            QRhiShaderResourceBinding::VertexStage,
+            layer,
+            impl.sampler))
+    {
+        srb.reset();
+        return false;
+    }
+
+    Composite_block_std140 block{};
+    std::memcpy(block.pmv, glm::value_ptr(pmv), sizeof(block.pmv));
+    block.size[0]          = static_cast<float>(impl.size.width());
+    block.size[1]          = static_cast<float>(impl.size.height());
+    block.framebuffer_y_up = impl.rhi->isYUpInFramebuffer() ? 1 : 0;
+    if (!impl.uploaded_valid || std::memcmp(&block, &impl.uploaded, sizeof(block)) != 0) {
+        updates->updateDynamicBuffer(impl.ubo.get(), 0, sizeof(block), &block);
+        impl.uploaded       = block;
+        impl.uploaded_valid = true;
+    }
+    return true;
+}
+
+void Offscreen_layer::record_composite(QRhiCommandBuffer* cb)
+{
+    auto& impl = *m_impl;
+    auto& srb  = impl.srbs[impl.current];
+    if (!cb || !impl.pipeline || !srb) {
+        return;
+    }
+    cb->setGraphicsPipeline(impl.pipeline);
+    cb->setShaderResources(srb.get());
+    cb->draw(4);
+}
+
+void Offscreen_layer::finish_frame()
+{
+    auto& impl = *m_impl;
+    impl.has_previous = true;
+    if (impl.mode == mode_t::SCROLLING) {
+        impl.current ^= 1;
+    }
+}
+
+void Offscreen_layer::invalidate()
+{
+    m_impl->has_previous = false;
+}
+
+void Offscreen_layer::reset()
+{
+    auto& impl = *m_impl;
+    impl.release_layers();
+    impl.sampler = nullptr;
+    impl.ubo.reset();
+    impl.ubo_capacity_bytes = 0;
+    impl.uploaded_valid     = false;
+    impl.shared.reset();
+    impl.rhi                = nullptr;
+}
+
+} // namespace vnm::plot::detail
@@ -0,0 +1,100 @@
+#pragma once
+
+// VNM Plot Library - Offscreen layer
+// Persistent window-sized texture layers composited over the main pass:
+// the series layer of Plot_config::scroll_blit and the chrome layer of
+// Plot_config::cache_chrome_layer.
+
+#include <glm/mat4x4.hpp>
+
+#include <QPoint>
+#include <QRect>
+#include <QSize>
+
+#include <memory>
+
+class QRhi;
+class QRhiCommandBuffer;
+class QRhiRenderTarget;
+class QRhiResourceUpdateBatch;
+
+namespace vnm::plot::detail {
+
+// A window-sized premultiplied colour layer that keeps its content across
+// frames and is composited over the window in the main pass.
+//
+// SCROLLING: two textures take turns as the frame's layer target. A frame
+// seeds the current texture from the previous one, shifted, and clears what
+// it is about to redraw; both are GPU copies recorded on the frame's update
+// batch, so every pixel the frame does not redraw survives from the
+// previous frame. A third texture that is never rendered to supplies the
+// transparent pixels.
+//
+// RETAINED: one texture, cleared by the pass that redraws it and composited
+// unchanged by every frame that does not. copy_from_previous() and clear()
+// do nothing.
+//
+// Rectangles are window pixels with a top-left origin.
+class Offscreen_layer
+{
+public:
+    enum class mode_t
+    {
+        SCROLLING,
+        RETAINED
+    };
+
+    explicit Offscreen_layer(mode_t mode);
+    ~Offscreen_layer();
+
+    Offscreen_layer(const Offscreen_layer&)            = delete;
+    Offscreen_layer& operator=(const Offscreen_layer&) = delete;
+
+    // Creates the textures for `rhi` and `size`, or recreates them when
+    // either changed. Recreated layers start transparent, with no previous
+    // frame. Returns false when the resources cannot be created.
+    bool ensure(QRhi* rhi, QSize size, QRhiResourceUpdateBatch* updates);
+
+    // True while the layer holds a finished frame: the previous texture in
+    // SCROLLING mode, the only one in RETAINED mode.
+    bool has_previous() const;
+
+    // Target of the current frame's layer pass. In SCROLLING mode both
+    // targets share one render-pass descriptor, so pipelines built for one
+    // serve the other. A RETAINED target clears to transparent in beginPass.
+    QRhiRenderTarget* render_target() const;
+
+    void copy_from_previous(
+        QRhiResourceUpdateBatch* updates,
+        const QRect&             source,
+        const QPoint&            destination);
+
+    void clear(QRhiResourceUpdateBatch* updates, const QRect& rect);
+
+    // Writes the composite uniforms and readies the pipeline for the window
+    // target `rt`. The uniforms are only uploaded when they changed. Must
+    // run before the host opens its first pass.
+    bool prepare_composite(
+        QRhiResourceUpdateBatch* updates,
+        QRhiRenderTarget*        rt,
+        const glm::mat4&         pmv);
+
+    // Draws the current texture over the window; inside the open main pass.
+    void record_composite(QRhiCommandBuffer* cb);
+
+    // Marks the current texture finished; in SCROLLING mode it becomes the
+    // previous one.
+    void finish_frame();
+
+    // Forgets the finished content, so has_previous() is false until the
+    // next finish_frame(). Keeps the textures.
+    void invalidate();
+
+    void reset();
+
+private:
+    struct impl_t;
+    std::unique_ptr<impl_t> m_impl;
+};
+
+} // namespace vnm::plot::detail
@@ -0,0 +1,569 @@
+#include <vnm_plot/rhi/offscreen_plot_renderer.h>
+
+#include <vnm_plot/core/color_palette.h>
+#include <vnm_plot/core/constants.h>
+#include <vnm_plot/core/layout_calculator.h>
+#include <vnm_plot/rhi/asset_loader.h>
+#include <vnm_plot/rhi/chrome_renderer.h>
+#include <vnm_plot/rhi/font_renderer.h>
+#include <vnm_plot/rhi/frame_context.h>
+#include <vnm_plot/rhi/pipeline_cache.h>
+#include <vnm_plot/rhi/primitive_renderer.h>
+#include <vnm_plot/rhi/series_renderer.h>
+#include <vnm_plot/rhi/text_renderer.h>
+#include "frame_range_planner.h"
+#include "plot_frame_helpers.h"
+
+#include <QColor>
+#include <QMatrix4x4>
+#include <QOffscreenSurface>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <rhi/qrhi.h>
+#if QT_CONFIG(vulkan) && __has_include(<vulkan/vulkan.h>)
+#include <QVulkanInstance>
+#define VNM_PLOT_OFFSCREEN_VULKAN 1
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace vnm::plot {
+
+namespace {
+
+glm::mat4 to_glm_mat4(const QMatrix4x4& matrix)
+{
+    return glm::make_mat4(matrix.constData());
+}
+
+} // anonymous namespace
+
+std::uint64_t pixel_checksum(const std::uint8_t* data, std::size_t size)
+{
+    std::uint64_t checksum = 1'469'598'103'934'665'603ull;
+    for (std::size_t i = 0; i < size; ++i) {
+        checksum ^= data[i];
+        checksum *= 1'099'511'628'211ull;
+    }
+    return checksum;
+}
+
+struct Offscreen_plot_renderer::impl_t
+{
+    // Declaration order doubles as release order: the renderers' QRhi
+    // resources go first, then the target, the QRhi and what it was
+    // created on.
+    std::unique_ptr<QOffscreenSurface>             fallback_surface;
+#if defined(VNM_PLOT_OFFSCREEN_VULKAN)
+    std::unique_ptr<QVulkanInstance>               vulkan_instance;
+#endif
+    std::unique_ptr<QRhi>                          rhi;
+    std::unique_ptr<QRhiTexture>                   color_texture;
+    std::unique_ptr<QRhiRenderPassDescriptor>      rpd;
+    std::unique_ptr<QRhiTextureRenderTarget>       render_target;
+    QSize                                          target_size;
+
+    Asset_loader                                   asset_loader;
+    Series_renderer                                series;
+    Primitive_renderer                             primitives;
+    Chrome_renderer                                chrome;
+    Layout_calculator                              layout_calc;
+    detail::Frame_range_planner                    frame_range_planner;
+    double                                         last_vbar_width_pixels = detail::k_vbar_min_width_px_d;
+#if defined(VNM_PLOT_ENABLE_TEXT)
+    Font_renderer                                  fonts;
+    std::unique_ptr<Text_renderer>                 text;
+#endif
+
+    // Plot_config::skip_unchanged_frames: the key and pixels of the last
+    // frame rendered with it set.
+    detail::unchanged_frame_filter_t               unchanged_frame;
+    offscreen_image_t                              last_image;
+
+    bool create_rhi(offscreen_backend_t backend, std::string& error_message);
+    bool ensure_target(QSize size, std::string& error_message);
+    bool build_frame_key(
+        const offscreen_view_t&    view,
+        const std::map<int, std::shared_ptr<const series_data_t>>&
+                                   series);
+};
+
+bool Offscreen_plot_renderer::impl_t::create_rhi(
+    offscreen_backend_t    backend,
+    std::string&           error_message)
+{
+    // Saving needs the flag. load_pipeline_disk_cache() seeds the QRhi
+    // below, and the data is saved when the QRhi is destroyed.
+    const QRhi::Flags flags = QRhi::EnablePipelineCacheDataSave;
+
+    if (backend == offscreen_backend_t::NATIVE) {
+#if defined(Q_OS_WIN)
+        backend = offscreen_backend_t::D3D11;
+#elif defined(Q_OS_MACOS)
+        backend = offscreen_backend_t::METAL;
+#else
+        backend = offscreen_backend_t::OPENGL;
+#endif
+    }
+
+    switch (backend) {
+        case offscreen_backend_t::NULL_BACKEND: {
+            QRhiNullInitParams params;
+            rhi.reset(QRhi::create(QRhi::Null, &params, flags));
+            break;
+        }
+        case offscreen_backend_t::OPENGL: {
+#if QT_CONFIG(opengl)
+            QRhiGles2InitParams params;
+            fallback_surface.reset(QRhiGles2InitParams::newFallbackSurface());
+            if (!fallback_surface || !fallback_surface->isValid()) {
+                error_message = "failed to create an offscreen surface for OpenGL";
+                fallback_surface.reset();
+                return false;
+            }
+            params.fallbackSurface = fallback_surface.get();
+            rhi.reset(QRhi::create(QRhi::OpenGLES2, &params, flags));
+#endif
+            break;
+        }
+        case offscreen_backend_t::VULKAN: {
+#if defined(VNM_PLOT_OFFSCREEN_VULKAN)
+            vulkan_instance = std::make_unique<QVulkanInstance>();
+            if (!vulkan_instance->create()) {
+                error_message = "failed to create a Vulkan instance";
+                vulkan_instance.reset();
+                return false;
+            }
+            QRhiVulkanInitParams params;
+            params.inst = vulkan_instance.get();
+            rhi.reset(QRhi::create(QRhi::Vulkan, &params, flags));
+#endif
+            break;
+        }
+        case offscreen_backend_t::D3D11: {
+#if defined(Q_OS_WIN)
+            QRhiD3D11InitParams params;
+            rhi.reset(QRhi::create(QRhi::D3D11, &params, flags));
+#endif
+            break;
+        }
+        case offscreen_backend_t::METAL: {
+#if defined(Q_OS_MACOS) && QT_CONFIG(metal)
+            QRhiMetalInitParams params;
+            rhi.reset(QRhi::create(QRhi::Metal, &params, flags));
+#endif
+            break;
+        }
+        case offscreen_backend_t::NATIVE:
+            break;
+    }
+
+    if (!rhi) {
+        error_message = "failed to create the requested offscreen QRhi backend";
+        return false;
+    }
+    load_pipeline_disk_cache(rhi.get());
+    return true;
+}
+
+bool Offscreen_plot_renderer::impl_t::ensure_target(QSize size, std::string& error_message)
+{
+    if (render_target && target_size == size) {
+        return true;
+    }
+    render_target.reset();
+    color_texture.reset();
+    target_size = QSize();
+
+    color_texture.reset(rhi->newTexture(
+        QRhiTexture::RGBA8,
+        size,
+        1,
+        QRhiTexture::RenderTarget | QRhiTexture::UsedAsTransferSource));
+    if (!color_texture || !color_texture->create()) {
+        error_message = "failed to create the offscreen color texture";
+        color_texture.reset();
+        return false;
+    }
+
+    render_target.reset(rhi->newTextureRenderTarget({color_texture.get()}));
+    if (!render_target) {
+        error_message = "failed to allocate the offscreen render target";
+        return false;
+    }
+    // The descriptor outlives resizes, so pipelines built against it stay
+    // valid for every later target.
+    if (!rpd) {
+        rpd.reset(render_target->newCompatibleRenderPassDescriptor());
+        if (!rpd) {
+            error_message = "failed to allocate the offscreen render pass descriptor";
+            render_target.reset();
+            return false;
+        }
+    }
+    render_target->setRenderPassDescriptor(rpd.get());
+    if (!render_target->create()) {
+        error_message = "failed to create the offscreen render target";
+        render_target.reset();
+        return false;
+    }
+    target_size = size;
+    return true;
+}
+
+// Fills unchanged_frame.key with everything render() reads. Returns false
+// when the frame cannot be compared: no config revision, or a source that
+// cannot report its content revision.
+bool Offscreen_plot_renderer::impl_t::build_frame_key(
+    const offscreen_view_t&    view,
+    const std::map<int, std::shared_ptr<const series_data_t>>&
+                               series)
+{
+    using detail::ieee_key_bits;
+
+    const data_config_t& data_cfg = view.data_cfg;
+    std::vector<std::uint64_t>& frame_key = unchanged_frame.key;
+    frame_key.clear();
+    if (view.config_revision == 0) {
+        return false;
+    }
+    frame_key.insert(frame_key.end(), {
+        static_cast<std::uint64_t>(view.width),
+        static_cast<std::uint64_t>(view.height),
+        ieee_key_bits(view.scaling_factor),
+        view.config_revision,
+        ieee_key_bits(data_cfg.v_min),
+        ieee_key_bits(data_cfg.v_max),
+        ieee_key_bits(data_cfg.v_manual_min),
+        ieee_key_bits(data_cfg.v_manual_max),
+        static_cast<std::uint64_t>(data_cfg.t_min),
+        static_cast<std::uint64_t>(data_cfg.t_max),
+        static_cast<std::uint64_t>(data_cfg.t_available_min),
+        static_cast<std::uint64_t>(data_cfg.t_available_max),
+        ieee_key_bits(data_cfg.vbar_width),
+        ieee_key_bits(last_vbar_width_pixels),
+        static_cast<std::uint64_t>(view.v_auto)
+    });
+    return detail::append_series_frame_key(frame_key, series);
+}
+
+Offscreen_plot_renderer::Offscreen_plot_renderer()
+:
+    m_impl(std::make_unique<impl_t>())
+{
+    init_embedded_assets(m_impl->asset_loader);
+}
+
+Offscreen_plot_renderer::~Offscreen_plot_renderer() = default;
+
+bool Offscreen_plot_renderer::initialize(offscreen_backend_t backend, std::string& error_message)
+{
+    auto& impl = *m_impl;
+    if (impl.rhi) {
+        error_message = "offscreen renderer is already initialized";
+        return false;
+    }
+    if (!impl.create_rhi(backend, error_message)) {
+        return false;
+    }
+    impl.series.initialize(impl.asset_loader);
+#if defined(VNM_PLOT_ENABLE_TEXT)
+    impl.text = std::make_unique<Text_renderer>(&impl.fonts);
+#endif
+    return true;
+}
+
+bool Offscreen_plot_renderer::render(
+    const offscreen_view_t&    view,
+    const std::map<int, std::shared_ptr<const series_data_t>>&
+                               series,
+    const Plot_config&         config,
+    offscreen_image_t&         image,
+    std::string&               error_message)
+{
+    auto& impl = *m_impl;
+    QRhi* const rhi = impl.rhi.get();
+    if (!rhi) {
+        error_message = "offscreen renderer is not initialized";
+        return false;
+    }
+    if (view.width <= 0 || view.height <= 0) {
+        error_message = "offscreen view size must be positive";
+        return false;
+    }
+    if (!impl.ensure_target(QSize(view.width, view.height), error_message)) {
+        return false;
+    }
+
+    vnm::plot::Profiler* profiler = config.profiler.get();
+    bool remember_frame = false;
+    if (config.skip_unchanged_frames) {
+        remember_frame = impl.build_frame_key(view, series);
+        if (remember_frame && impl.unchanged_frame.unchanged()) {
+            if (profiler) {
+                profiler->record_counter("qrhi.renderer.unchanged_frame_skip_count");
+            }
+            image = impl.last_image;
+            return true;
+        }
+    }
+    // Whatever happens below, the last remembered image no longer
+    // describes the target.
+    impl.unchanged_frame.forget();
+
+    VNM_PLOT_PROFILE_SCOPE(profiler, "renderer");
+    VNM_PLOT_PROFILE_SCOPE(profiler, "renderer.frame");
+
+    impl.primitives.set_profiler(profiler);
+    impl.primitives.set_log_callback(config.log_error);
+    impl.asset_loader.set_log_callback(config.log_error);
+
+    const int    win_w = view.width;
+    const int    win_h = view.height;
+    const double scale =
+        (std::isfinite(view.scaling_factor) && view.scaling_factor > 0.0) ? view.scaling_factor : 1.0;
+    const double font_px           = config.font_size_px * scale;
+    const double base_label_height = config.base_label_height_px * scale;
+    const double preview_height    =
+        config.preview_height_px > 0.0 ? config.preview_height_px * scale : 0.0;
+    const double reserved_h        = base_label_height + preview_height;
+
+    const Color_palette palette = resolved_color_palette(&config, config.dark_mode);
+    const glm::vec4 plot_body_background =
+        config.clear_to_transparent ? glm::vec4(0.f) : palette.background;
+
+    QColor clear_color;
+    if (config.clear_to_transparent) {
+        clear_color = QColor(0, 0, 0, 0);
+    }
+    else {
+        clear_color = QColor::fromRgbF(
+            palette.background.r,
+            palette.background.g,
+            palette.background.b,
+            palette.background.a);
+    }
+
+    const bool preview_enabled = preview_height > 0.0 && config.preview_visibility > 0.0;
+    const Frame_range_plan frame_plan = impl.frame_range_planner.plan(
+        series,
+        view.data_cfg,
+        config,
+        view.v_auto,
+        preview_enabled);
+    const float v_min = frame_plan.main_v_range.min;
+    const float v_max = frame_plan.main_v_range.max;
+
+#if defined(VNM_PLOT_ENABLE_TEXT)
+    impl.fonts.set_log_callbacks(config.log_error, config.log_debug);
+    if (config.show_text) {
+        const int font_px_int = static_cast<int>(std::lround(font_px));
+        if (font_px_int > 0) {
+            impl.fonts.initialize_metrics(impl.asset_loader, font_px_int);
+        }
+    }
+    const Font_renderer* layout_fonts =
+        (config.show_text && impl.fonts.text_measure_cache_key() != 0) ? &impl.fonts : nullptr;
+#else
+    const Font_renderer* layout_fonts = nullptr;
+#endif
+
+    // Lay out once at the last measured label bar width, and again when the
+    // labels need a different one.
+    const double usable_height  = std::max(0.0, double(win_h) - reserved_h);
+    const double max_vbar_width = std::max(
+        detail::k_vbar_min_width_px_d,
+        std::max(0.0, double(win_w) * 0.5));
+    double vbar_width = std::clamp(
+        impl.last_vbar_width_pixels,
+        detail::k_vbar_min_width_px_d,
+        max_vbar_width);
+    const auto calculate_layout = [&](double width_px) {
+        return impl.layout_calc.calculate(detail::build_layout_params(
+            v_min,
+            v_max,
+            view.data_cfg.t_min,
+            view.data_cfg.t_max,
+            win_w,
+            usable_height,
+            width_px,
+            preview_height,
+            font_px,
+            config,
+            layout_fonts));
+    };
+    auto layout_result = calculate_layout(vbar_width);
+    double measured_vbar_width = std::max(
+        detail::k_vbar_min_width_px_d,
+        double(layout_result.max_v_label_text_width) + detail::k_v_label_horizontal_padding_px);
+    if (!std::isfinite(measured_vbar_width)) {
+        measured_vbar_width = detail::k_vbar_min_width_px_d;
+    }
+    measured_vbar_width = std::clamp(
+        measured_vbar_width,
+        detail::k_vbar_min_width_px_d,
+        max_vbar_width);
+    if (std::abs(measured_vbar_width - vbar_width) > detail::k_vbar_width_change_threshold_d) {
+        layout_result = calculate_layout(measured_vbar_width);
+    }
+    vbar_width = measured_vbar_width;
+    impl.last_vbar_width_pixels = vbar_width;
+
+    frame_layout_result_t layout;
+    layout.usable_width           = std::max(0.0, double(win_w) - vbar_width);
+    layout.usable_height          = usable_height;
+    layout.v_bar_width            = vbar_width;
+    layout.h_bar_height           = base_label_height + detail::k_scissor_pad_px;
+    layout.max_v_label_text_width = layout_result.max_v_label_text_width;
+    layout.v_labels               = std::move(layout_result.v_labels);
+    layout.h_labels               = std::move(layout_result.h_labels);
+    layout.v_label_fixed_digits   = layout_result.v_label_fixed_digits;
+    layout.h_labels_subsecond     = layout_result.h_labels_subsecond;
+    layout.vertical_seed_index    = layout_result.vertical_seed_index;
+    layout.vertical_seed_step     = layout_result.vertical_seed_step;
+    layout.vertical_finest_step   = layout_result.vertical_finest_step;
+    layout.horizontal_seed_index  = layout_result.horizontal_seed_index;
+    layout.horizontal_seed_step   = layout_result.horizontal_seed_step;
+
+    QRhiCommandBuffer* cb = nullptr;
+    if (rhi->beginOffscreenFrame(&cb) != QRhi::FrameOpSuccess || !cb) {
+        error_message = "QRhi beginOffscreenFrame failed";
+        return false;
+    }
+
+    // Every offscreen frame is a still, which adaptive LOD must not coarsen.
+    std::optional<Plot_config> still_config;
+    if (config.adaptive_lod_budget_ms > 0.0) {
+        still_config.emplace(config);
+        still_config->adaptive_lod_budget_ms = 0.0;
+    }
+
+    frame_context_t ctx{layout};
+    ctx.v0              = v_min;
+    ctx.v1              = v_max;
+    ctx.preview_v0      = frame_plan.preview_v_range.min;
+    ctx.preview_v1      = frame_plan.preview_v_range.max;
+    ctx.t0              = view.data_cfg.t_min;
+    ctx.t1              = view.data_cfg.t_max;
+    ctx.t_available_min = view.data_cfg.t_available_min;
+    ctx.t_available_max = view.data_cfg.t_available_max;
+    ctx.win_w           = win_w;
+    ctx.win_h           = win_h;
+    const glm::mat4 pixel_ortho = glm::ortho(
+        0.0f,
+        static_cast<float>(win_w),
+        static_cast<float>(win_h),
+        0.0f,
+        -1.0f,
+        1.0f);
+    ctx.pmv                      = to_glm_mat4(rhi->clipSpaceCorrMatrix()) * pixel_ortho;
+    ctx.adjusted_font_px         = font_px;
+    ctx.base_label_height_px     = base_label_height;
+    ctx.adjusted_reserved_height = reserved_h;
+    ctx.adjusted_preview_height  = preview_height;
+    ctx.visible_info_flags       = k_visible_info_none;
+    ctx.dark_mode                = config.dark_mode;
+    ctx.plot_body_background     = plot_body_background;
+    ctx.config                   = still_config ? &*still_config : &config;
+    ctx.rhi                      = rhi;
+    ctx.cb                       = cb;
+    ctx.render_target            = impl.render_target.get();
+
+    {
+        VNM_PLOT_PROFILE_SCOPE(profiler, "renderer.frame.render_passes");
+
+        QRhiResourceUpdateBatch* rhi_updates = rhi->nextResourceUpdateBatch();
+        ctx.rhi_updates = rhi_updates;
+
+        impl.series.prepare(ctx, series);
+        remember_frame = remember_frame && impl.series.last_frame_current();
+
+#if defined(VNM_PLOT_ENABLE_TEXT)
+        const Text_renderer* prepared_text = nullptr;
+        if (impl.text && config.show_text) {
+            const detail::label_pane_opacity_t pane_opacity = detail::label_pane_opacity_for_text(ctx);
+            impl.text->prepare(
+                ctx,
+                false,
+                false,
+                pane_opacity.vertical_axis_label_pane_is_opaque,
+                pane_opacity.horizontal_axis_label_pane_is_opaque);
+            prepared_text = impl.text.get();
+        }
+#else
+        const Text_renderer* prepared_text = nullptr;
+#endif
+
+        impl.chrome.render_grid_and_backgrounds(ctx, impl.primitives, prepared_text);
+        const std::size_t back_layer_end = impl.primitives.queued_op_count();
+        impl.chrome.render_zero_line(ctx, impl.primitives);
+        if (preview_height > 0.0) {
+            impl.chrome.render_preview_overlay(ctx, impl.primitives);
+        }
+        const std::size_t front_layer_end = impl.primitives.queued_op_count();
+
+        cb->beginPass(
+            impl.render_target.get(),
+            clear_color,
+            QRhiDepthStencilClearValue(1.0f, 0),
+            rhi_updates);
+        cb->setViewport(QRhiViewport(0, 0, win_w, win_h));
+        impl.primitives.record_draws(ctx, back_layer_end);
+        impl.series.render(ctx, series);
+        impl.primitives.record_draws(ctx, front_layer_end);
+#if defined(VNM_PLOT_ENABLE_TEXT)
+        if (prepared_text) {
+            impl.text->record(ctx);
+        }
+#endif
+        cb->endPass();
+        impl.primitives.reset_frame();
+    }
+
+    QRhiReadbackResult readback;
+    QRhiResourceUpdateBatch* readback_updates = rhi->nextResourceUpdateBatch();
+    readback_updates->readBackTexture(QRhiReadbackDescription(impl.color_texture.get()), &readback);
+    cb->resourceUpdate(readback_updates);
+
+    // Offscreen frames complete synchronously, readbacks included.
+    const QRhi::FrameOpResult end_result = rhi->endOffscreenFrame();
+    if (end_result != QRhi::FrameOpSuccess) {
+        error_message = "QRhi endOffscreenFrame failed";
+        return false;
+    }
+
+    const qsizetype row_bytes = qsizetype(win_w) * 4;
+    if (readback.data.size() < row_bytes * win_h) {
+        error_message = "QRhi returned no pixel data";
+        return false;
+    }
+    image.width  = win_w;
+    image.height = win_h;
+    image.pixels.resize(std::size_t(row_bytes) * std::size_t(win_h));
+    const bool flip = rhi->isYUpInFramebuffer();
+    for (int y = 0; y < win_h; ++y) {
+        const int source_row = flip ? win_h - 1 - y : y;
+        std::memcpy(
+            image.pixels.data() + std::size_t(row_bytes) * std::size_t(y),
+            readback.data.constData() + row_bytes * source_row,
+            std::size_t(row_bytes));
+    }
+
+    if (remember_frame) {
+        impl.unchanged_frame.remember();
+        impl.last_image = image;
+    }
+    else {
+        impl.last_image = {};
+    }
+    return true;
+}
+
+} // namespace vnm::plot
@@ -0,0 +1,86 @@
+#pragma once
+
+// Internal fork/join helper for data-parallel loops over an index range.
+// The library has no long-lived worker pool: callers gate on a size
+// threshold so short-lived threads are only spawned when the per-range
+// work clearly outweighs thread start-up.
+
+#include <algorithm>
+#include <cstddef>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace vnm::plot::detail {
+
+// Number of contiguous ranges parallel_for_ranges() splits item_count into.
+// Returns 1 when the range is too small to be worth splitting.
+inline std::size_t parallel_range_count(
+    std::size_t    item_count,
+    std::size_t    min_items_per_range)
+{
+    if (min_items_per_range == 0 || item_count / 2u < min_items_per_range) {
+        return 1;
+    }
+    const std::size_t hardware_threads =
+        std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    return std::clamp<std::size_t>(
+        item_count / min_items_per_range, 1, hardware_threads);
+}
+
+// Begin index of range `range_index` when [0, item_count) is split into
+// range_count near-equal contiguous ranges.
+inline std::size_t parallel_range_begin(
+    std::size_t    item_count,
+    std::size_t    range_count,
+    std::size_t    range_index)
+{
+    const std::size_t base  = item_count / range_count;
+    const std::size_t extra = item_count % range_count;
+    return base * range_index + std::min(range_index, extra);
+}
+
+// Calls fn(range_index, first, last_exclusive) once per range. Ranges are
+// disjoint, so fn may write output slots owned by its range without
+// synchronization. Range 0 runs on the calling thread; if a worker thread
+// cannot be started its range runs inline instead. fn must not throw.
+// Returns the number of ranges used.
+template<typename Fn>
+std::size_t parallel_for_ranges(
+    std::size_t    item_count,
+    std::size_t    min_items_per_range,
+    Fn&&           fn)
+{
+    if (item_count == 0) {
+        return 0;
+    }
+
+    const std::size_t range_count =
+        parallel_range_count(item_count, min_items_per_range);
+    if (range_count <= 1) {
+        fn(std::size_t(0), std::size_t(0), item_count);
+        return 1;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(range_count - 1u);
+    for (std::size_t range = 1; range < range_count; ++range) {
+        const std::size_t first = parallel_range_begin(item_count, range_count, range);
+        const std::size_t last  = parallel_range_begin(item_count, range_count, range + 1u);
+        try {
+            workers.emplace_back([&fn, range, first, last]() { fn(range, first, last); });
+        }
+        catch (const std::system_error&) {
+            fn(range, first, last);
+        }
+    }
+
+    fn(std::size_t(0), std::size_t(0), parallel_range_begin(item_count, range_count, 1));
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    return range_count;
+}
+
+} // namespace vnm::plot::detail
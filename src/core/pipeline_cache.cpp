@@ -0,0 +1,303 @@
+#include <vnm_plot/rhi/pipeline_cache.h>
+
+#include "pipeline_cache_file.h"
+#include "platform_paths.h"
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDirIterator>
+#include <QFile>
+#include <QHashFunctions>
+#include <QStringList>
+#include <rhi/qrhi.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace vnm::plot {
+
+namespace {
+
+using detail::pipeline_cache_digest_t;
+
+constexpr std::uint32_t k_cache_version = 1;
+constexpr std::uint32_t k_magic         = 0x51504c43; // 'QPLC'
+
+std::atomic<bool> s_disk_cache_enabled{true};
+
+// Fingerprint of pipeline cache data. The size alone misses data that
+// changed without growing, such as a driver replacing a blob.
+struct synced_data_t
+{
+    qsizetype      size = 0;
+    std::size_t    hash = 0;
+
+    bool operator==(const synced_data_t&) const = default;
+};
+
+synced_data_t fingerprint(const QByteArray& data)
+{
+    return {data.size(), qHash(data)};
+}
+
+// Per QRhi: the data last loaded into or saved from it. A QRhi is seeded at
+// most once; its entry goes away when the QRhi is destroyed.
+std::mutex                                          s_registry_mutex;
+std::unordered_map<const QRhi*, synced_data_t>      s_synced_data;
+
+// Adds the entry of `rhi`, which is saved and dropped when the QRhi is
+// destroyed. Returns false when it was already tracked. Called with
+// s_registry_mutex held.
+bool track_locked(QRhi* rhi, const synced_data_t& synced)
+{
+    if (!s_synced_data.emplace(rhi, synced).second) {
+        return false;
+    }
+    // QRhi runs cleanup callbacks first thing in its destructor, while the
+    // backend can still report its pipeline cache data.
+    rhi->addCleanupCallback([](QRhi* released) {
+        save_pipeline_disk_cache(released);
+        std::lock_guard<std::mutex> lock(s_registry_mutex);
+        s_synced_data.erase(released);
+    });
+    return true;
+}
+
+// Digest of every embedded shader, computed once: the resources cannot
+// change while the process runs.
+const QByteArray& shader_digest()
+{
+    static const QByteArray s_digest = [] {
+        QStringList  files;
+        QDirIterator it(QStringLiteral(":/vnm_plot/shaders/qsb"), QDir::Files);
+        while (it.hasNext()) {
+            files.append(it.next());
+        }
+        files.sort();
+
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        for (const QString& name : files) {
+            QFile file(name);
+            if (!file.open(QIODevice::ReadOnly)) {
+                continue;
+            }
+            hash.addData(name.toUtf8());
+            hash.addData(file.readAll());
+        }
+        return hash.result();
+    }();
+    return s_digest;
+}
+
+pipeline_cache_digest_t compute_cache_digest(QRhi* rhi)
+{
+    const QRhiDriverInfo driver = rhi->driverInfo();
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    const auto add_bytes = [&hash](const auto& value) {
+        hash.addData(QByteArrayView(reinterpret_cast<const char*>(&value), sizeof(value)));
+    };
+    add_bytes(k_cache_version);
+    hash.addData(QByteArray(rhi->backendName()));
+    hash.addData(driver.deviceName);
+    add_bytes(driver.deviceId);
+    add_bytes(driver.vendorId);
+    hash.addData(shader_digest());
+
+    const QByteArray bytes = hash.result();
+    pipeline_cache_digest_t digest{};
+    std::copy_n(bytes.constData(), digest.size(), reinterpret_cast<char*>(digest.data()));
+    return digest;
+}
+
+std::filesystem::path cache_file_path(
+    const char*                        name_prefix,
+    const char*                        backend_name,
+    const QByteArray&                  digest)
+{
+    std::ostringstream oss;
+    oss << "qrhi_pipeline_cache_v" << k_cache_version << "_" << name_prefix << backend_name << "_";
+    oss << digest.toHex().toStdString();
+    oss << ".bin";
+    return get_disk_cache_directory() / oss.str();
+}
+
+std::filesystem::path cache_file_path(
+    QRhi*                              rhi,
+    const pipeline_cache_digest_t&     digest)
+{
+    return cache_file_path(
+        "",
+        rhi->backendName(),
+        QByteArray(
+            reinterpret_cast<const char*>(digest.data()),
+            static_cast<qsizetype>(digest.size())));
+}
+
+} // anonymous namespace
+
+namespace detail {
+
+QByteArray load_pipeline_cache_file(
+    const std::filesystem::path&       path,
+    const pipeline_cache_digest_t&     expected_digest)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return {};
+    }
+
+    auto read = [&](auto& val) -> bool {
+        in.read(reinterpret_cast<char*>(&val), sizeof(val));
+        return bool(in);
+    };
+
+    std::uint32_t magic   = 0;
+    std::uint32_t version = 0;
+    if (!read(magic) || !read(version) || magic != k_magic || version != k_cache_version) {
+        return {};
+    }
+
+    pipeline_cache_digest_t digest{};
+    in.read(reinterpret_cast<char*>(digest.data()), digest.size());
+    if (!in || digest != expected_digest) {
+        return {};
+    }
+
+    std::uint64_t size = 0;
+    if (!read(size) || size == 0 || size > std::uint64_t(1) << 30) {
+        return {};
+    }
+    QByteArray data(static_cast<qsizetype>(size), Qt::Uninitialized);
+    in.read(data.data(), data.size());
+    if (!in) {
+        return {};
+    }
+    return data;
+}
+
+bool save_pipeline_cache_file(
+    const std::filesystem::path&       path,
+    const pipeline_cache_digest_t&     digest,
+    const QByteArray&                  data)
+{
+    // Written aside and renamed, so a concurrent reader never sees a
+    // partial file.
+    std::filesystem::path temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+
+        auto write = [&](auto val) {
+            out.write(reinterpret_cast<const char*>(&val), sizeof(val));
+        };
+
+        write(k_magic);
+        write(k_cache_version);
+        out.write(reinterpret_cast<const char*>(digest.data()), digest.size());
+        write(static_cast<std::uint64_t>(data.size()));
+        out.write(data.constData(), data.size());
+        if (!out) {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+std::filesystem::path quick_pipeline_cache_file_path(const char* backend_name)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(QByteArrayView(
+        reinterpret_cast<const char*>(&k_cache_version), sizeof(k_cache_version)));
+    hash.addData(QByteArrayLiteral("quick"));
+    hash.addData(QByteArray(backend_name));
+    hash.addData(shader_digest());
+    return cache_file_path("quick_", backend_name, hash.result());
+}
+
+} // namespace detail
+
+void set_pipeline_disk_cache_enabled(bool enabled)
+{
+    s_disk_cache_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool pipeline_disk_cache_enabled()
+{
+    return s_disk_cache_enabled.load(std::memory_order_relaxed);
+}
+
+bool load_pipeline_disk_cache(QRhi* rhi)
+{
+    if (!rhi || !s_disk_cache_enabled.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(s_registry_mutex);
+    if (s_synced_data.count(rhi) != 0) {
+        return false;
+    }
+    const QByteArray existing = rhi->pipelineCacheData();
+    track_locked(rhi, fingerprint(existing));
+    if (!existing.isEmpty()) {
+        return false;
+    }
+
+    const auto       digest = compute_cache_digest(rhi);
+    const QByteArray data   = detail::load_pipeline_cache_file(cache_file_path(rhi, digest), digest);
+    if (data.isEmpty()) {
+        return false;
+    }
+    // QRhi checks its own header (backend, driver, device) and ignores data
+    // it cannot use.
+    rhi->setPipelineCacheData(data);
+    s_synced_data[rhi] = fingerprint(data);
+    return true;
+}
+
+bool save_pipeline_disk_cache(QRhi* rhi)
+{
+    if (!rhi || !s_disk_cache_enabled.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    const QByteArray data = rhi->pipelineCacheData();
+    if (data.isEmpty()) {
+        return false;
+    }
+
+    const synced_data_t synced = fingerprint(data);
+    std::lock_guard<std::mutex> lock(s_registry_mutex);
+    const auto it = s_synced_data.find(rhi);
+    if (it != s_synced_data.end() && it->second == synced) {
+        return false;
+    }
+    const auto digest = compute_cache_digest(rhi);
+    if (!detail::save_pipeline_cache_file(cache_file_path(rhi, digest), digest, data)) {
+        return false;
+    }
+    if (!track_locked(rhi, synced)) {
+        s_synced_data[rhi] = synced;
+    }
+    return true;
+}
+
+} // namespace vnm::plot
@@ -0,0 +1,38 @@
+#pragma once
+
+// VNM Plot Library - QRhi pipeline cache file format
+// Reads and writes the files behind load_pipeline_disk_cache() and
+// save_pipeline_disk_cache().
+
+#include <QByteArray>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+
+namespace vnm::plot::detail {
+
+// SHA-256 over the QRhi backend, the device and the embedded shaders.
+using pipeline_cache_digest_t = std::array<std::uint8_t, 32>;
+
+// Returns the data of the file at `path`, or empty data when it is missing,
+// malformed or written for another digest.
+QByteArray load_pipeline_cache_file(
+    const std::filesystem::path&       path,
+    const pipeline_cache_digest_t&     expected_digest);
+
+// Writes `data` under a magic, version and `digest` header. The file is
+// written aside and renamed, so a concurrent reader never sees it partial.
+bool save_pipeline_cache_file(
+    const std::filesystem::path&       path,
+    const pipeline_cache_digest_t&     digest,
+    const QByteArray&                  data);
+
+// File that Qt Quick's own pipeline cache (QQuickGraphicsConfiguration)
+// loads and saves for windows rendering through `backend_name`, spelled as
+// QRhi::backendName() does. Qt Quick writes raw QRhi data, whose header
+// QRhi checks against the device itself, so only the backend and the
+// shaders key the name.
+std::filesystem::path quick_pipeline_cache_file_path(const char* backend_name);
+
+} // namespace vnm::plot::detail
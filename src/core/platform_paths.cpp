@@ -119,4 +119,24 @@ std::filesystem::path get_data_directory()
 #endif
 }
 
+std::filesystem::path get_disk_cache_directory()
+{
+    static const std::filesystem::path s_cache_dir = [] {
+        // Prefer the cache directory for disposable artifacts
+        auto dir = get_cache_directory();
+        if (dir.empty()) {
+            // Fallback to data directory
+            dir = get_data_directory();
+        }
+        if (dir.empty()) {
+            // Last resort: current directory
+            std::error_code ec;
+            dir = std::filesystem::current_path(ec) / ".vnm_plot_cache";
+            std::filesystem::create_directories(dir, ec);
+        }
+        return dir;
+    }();
+    return s_cache_dir;
+}
+
 } // namespace vnm::plot
@@ -32,4 +32,9 @@ namespace vnm::plot {
 // - Linux: $XDG_DATA_HOME/vnm_plot or ~/.local/share/vnm_plot
 [[nodiscard]] std::filesystem::path get_data_directory();
 
+// Directory shared by the library's disk caches (MSDF atlases, QRhi
+// pipeline data): the cache directory, else the data directory, else
+// .vnm_plot_cache under the current directory. Resolved once per process.
+[[nodiscard]] std::filesystem::path get_disk_cache_directory();
+
 } // namespace vnm::plot
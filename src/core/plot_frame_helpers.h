@@ -0,0 +1,183 @@
+#pragma once
+
+// VNM Plot Library - Plot frame helpers
+// Frame setup shared by the hosts that drive the RHI renderers directly:
+// Plot_widget's renderer and Offscreen_plot_renderer.
+
+#include "label_pane_geometry.h"
+#include "lcd_policy.h"
+
+#include <vnm_plot/core/color_palette.h>
+#include <vnm_plot/core/constants.h>
+#include <vnm_plot/core/layout_calculator.h>
+#include <vnm_plot/core/plot_config.h>
+#include <vnm_plot/rhi/font_renderer.h>
+#include <vnm_plot/rhi/frame_context.h>
+#include <vnm_plot/rhi/qrhi_series_layer.h>
+#include <vnm_plot/rhi/series_data.h>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace vnm::plot::detail {
+
+struct label_pane_opacity_t
+{
+    bool vertical_axis_label_pane_is_opaque   = false;
+    bool horizontal_axis_label_pane_is_opaque = false;
+};
+
+inline bool color_is_opaque(const glm::vec4& color)
+{
+    return color.a >= k_lcd_opaque_alpha_cutoff;
+}
+
+inline label_pane_opacity_t label_pane_opacity_for_text(const frame_context_t& ctx)
+{
+    const Color_palette palette = resolved_color_palette(ctx.config, ctx.dark_mode);
+
+    glm::vec4 pane_rect;
+    label_pane_opacity_t opacity;
+    opacity.horizontal_axis_label_pane_is_opaque =
+        color_is_opaque(palette.h_label_background) &&
+        horizontal_axis_label_pane_rect(ctx, pane_rect);
+    opacity.vertical_axis_label_pane_is_opaque =
+        color_is_opaque(palette.v_label_background) &&
+        vertical_axis_label_pane_rect(ctx, pane_rect);
+    return opacity;
+}
+
+inline Layout_calculator::parameters_t build_layout_params(
+    float                  v_min,
+    float                  v_max,
+    std::int64_t           t_min_ns,
+    std::int64_t           t_max_ns,
+    int                    win_w,
+    double                 usable_height,
+    double                 vbar_width,
+    double                 preview_height,
+    double                 font_px,
+    const Plot_config&     config,
+    const Font_renderer*   fonts)
+{
+    Layout_calculator::parameters_t params;
+    params.v_min                         = v_min;
+    params.v_max                         = v_max;
+    params.t_min                         = t_min_ns;
+    params.t_max                         = t_max_ns;
+    params.usable_width                  = std::max(0.0, double(win_w) - vbar_width);
+    params.usable_height                 = usable_height;
+    params.vbar_width                    = vbar_width;
+    params.label_visible_height          = usable_height + preview_height;
+    params.adjusted_font_size_in_pixels  = font_px;
+    params.h_label_vertical_nudge_factor = k_h_label_vertical_nudge_px;
+
+    if (fonts) {
+        params.monospace_char_advance_px     = fonts->monospace_advance_px();
+        params.monospace_advance_is_reliable = fonts->monospace_advance_is_reliable();
+        params.measure_text_cache_key        = fonts->text_measure_cache_key();
+        params.measure_text_func             = [fonts](const char* text) {
+            return fonts->measure_text_px(text);
+        };
+    }
+
+    const Plot_config* config_ptr = &config;
+    params.format_timestamp_func = [config_ptr](
+        std::int64_t   ts_ns,
+        std::int64_t   step_ns) -> std::string
+    {
+        if (config_ptr->format_timestamp) {
+            return config_ptr->format_timestamp(ts_ns, step_ns);
+        }
+        return default_format_timestamp(ts_ns, step_ns);
+    };
+    params.format_timestamp_revision     = config.format_timestamp_revision;
+    params.horizontal_axis_left_to_right = config.horizontal_axis_left_to_right;
+    params.format_value_func             = [config_ptr](
+        double                         value,
+        const value_format_context_t&  context) -> std::string
+    {
+        if (config_ptr->format_value) {
+            return config_ptr->format_value(value, context);
+        }
+        return {};
+    };
+    params.format_value_revision = config.format_value_revision;
+    params.profiler              = config.profiler.get();
+    return params;
+}
+
+template<typename T>
+std::uint64_t ieee_key_bits(T value)
+{
+    using Bits = std::conditional_t<std::is_same_v<T, float>, std::uint32_t, std::uint64_t>;
+    static_assert(sizeof(Bits) == sizeof(T), "size mismatch");
+    Bits bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline std::uint64_t pointer_key(const void* pointer)
+{
+    return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(pointer));
+}
+
+// Appends what the series layer of a frame reads: each series, its sources'
+// current_sequence() at every LOD level and its custom QRhi layers'
+// revision(). Returns false when a source reports sequence 0, since its
+// content cannot be compared then.
+inline bool append_series_frame_key(
+    std::vector<std::uint64_t>&                                   key,
+    const std::map<int, std::shared_ptr<const series_data_t>>&    series)
+{
+    for (const auto& [id, entry] : series) {
+        key.push_back(static_cast<std::uint64_t>(id));
+        key.push_back(pointer_key(entry.get()));
+        if (!entry || !entry->enabled) {
+            continue;
+        }
+        for (const Data_source* source : {entry->main_source(), entry->preview_source()}) {
+            key.push_back(pointer_key(source ? source->identity() : nullptr));
+            if (!source) {
+                continue;
+            }
+            const std::size_t levels = std::max<std::size_t>(source->lod_levels(), 1);
+            for (std::size_t level = 0; level < levels; ++level) {
+                const std::uint64_t sequence = source->current_sequence(level);
+                if (sequence == 0) {
+                    return false;
+                }
+                key.push_back(sequence);
+            }
+        }
+        for (const auto& layer : qrhi_layers_for(*entry)) {
+            key.push_back(pointer_key(layer.get()));
+            key.push_back(layer ? layer->revision() : 0);
+        }
+    }
+    return true;
+}
+
+// Plot_config::skip_unchanged_frames. The host fills `key` with everything
+// its frame reads; the frame is unchanged when that matches the key of the
+// last frame it remembered. A frame that must not arm the skip (label
+// fades, stale snapshots) forgets instead.
+struct unchanged_frame_filter_t
+{
+    std::vector<std::uint64_t>     key;
+    std::vector<std::uint64_t>     last_key;
+
+    bool unchanged() const { return !last_key.empty() && key == last_key; }
+    void remember()        { last_key.swap(key); }
+    void forget()          { last_key.clear(); }
+};
+
+} // namespace vnm::plot::detail
@@ -2,6 +2,7 @@
 #include <vnm_plot/core/constants.h>
 #include <vnm_plot/core/plot_config.h>
 #include "rhi_helpers.h"
+#include "rhi_shared_resources.h"
 
 #include <glm/gtc/type_ptr.hpp>
 
@@ -93,9 +94,10 @@ constexpr std::uint32_t k_grid_ubo_bytes = sizeof(Grid_block_std140);
 // rhi_state_t: Cached pipelines, per-frame buffers, and the deferred draw plan.
 // -----------------------------------------------------------------------------
 //
-// The rect pipeline is one cached QRhiGraphicsPipeline shared across every
-// rect draw in the frame; pipeline state (vertex layout, blend, sample count)
-// only depends on the binding LAYOUT, not on the concrete buffer handles.
+// The rect pipeline is one QRhiGraphicsPipeline shared across every rect
+// draw in the frame, and with every other renderer on the QRhi; pipeline
+// state (vertex layout, blend, sample count) only depends on the binding
+// LAYOUT, not on the concrete buffer handles.
 // Each flush_rects call allocates a fresh per-call vertex buffer + UBO + SRB
 // triple via the renderer's per-frame ring; this keeps lifetimes simple
 // because every draw owns its own buffers and the ring is reset each frame.
@@ -105,6 +107,11 @@ constexpr std::uint32_t k_grid_ubo_bytes = sizeof(Grid_block_std140);
 
 struct Primitive_renderer::rhi_state_t
 {
+    // Owns the pipelines and the unit quad below; declared first so it is
+    // released after the per-call resources.
+    std::shared_ptr<detail::Rhi_shared_resources>
+                                           shared;
+
     // Per-call buffers used by exactly one draw op. Owned by rhi_state_t and
     // recycled across frames: the pool grows as the frame's draw count
     // demands and m_used resets to 0 at the top of each prepare phase. The
@@ -163,20 +170,20 @@ struct Primitive_renderer::rhi_state_t
     // front of the data series in a single frame.
     std::size_t                            record_cursor = 0;
 
-    // Cached pipelines keyed only by primitive kind: the descriptor depends
+    // Shared pipelines keyed only by primitive kind: the descriptor depends
     // on shader stages, vertex layout, blend, and sample count. Per-call
     // buffer handles ride the SRB on each draw.
-    std::unique_ptr<QRhiGraphicsPipeline>  rect_pipeline;
-    std::unique_ptr<QRhiGraphicsPipeline>  grid_pipeline;
+    QRhiGraphicsPipeline*                  rect_pipeline = nullptr;
+    QRhiGraphicsPipeline*                  grid_pipeline = nullptr;
     QRhiRenderPassDescriptor*              rect_pipeline_rpd     = nullptr;
     int                                    rect_pipeline_samples = 0;
     QRhiRenderPassDescriptor*              grid_pipeline_rpd     = nullptr;
     int                                    grid_pipeline_samples = 0;
 
-    // Static unit-quad VBO consumed by the grid pipeline. Allocated once on
-    // first prepare and reused forever; the same four vertices feed every
-    // grid draw (the fragment shader resolves region clipping itself).
-    std::unique_ptr<QRhiBuffer>            grid_quad_vbo;
+    // Static unit-quad VBO consumed by the grid pipeline, owned by `shared`;
+    // the same four vertices feed every grid draw (the fragment shader
+    // resolves region clipping itself).
+    QRhiBuffer*                            grid_quad_vbo = nullptr;
 
     QShader                                rect_vert;
     QShader                                rect_frag;
@@ -210,13 +217,14 @@ void Primitive_renderer::cleanup_resources()
     m_rhi_state->ops.clear();
     m_rhi_state->rect_used             = 0;
     m_rhi_state->grid_used             = 0;
-    m_rhi_state->rect_pipeline.reset();
-    m_rhi_state->grid_pipeline.reset();
+    m_rhi_state->rect_pipeline         = nullptr;
+    m_rhi_state->grid_pipeline         = nullptr;
     m_rhi_state->rect_pipeline_rpd     = nullptr;
     m_rhi_state->rect_pipeline_samples = 0;
     m_rhi_state->grid_pipeline_rpd     = nullptr;
     m_rhi_state->grid_pipeline_samples = 0;
-    m_rhi_state->grid_quad_vbo.reset();
+    m_rhi_state->grid_quad_vbo         = nullptr;
+    m_rhi_state->shared.reset();
     m_rhi_state->shaders_loaded        = false;
     m_rhi_state->rect_vert             = {};
     m_rhi_state->rect_frag             = {};
@@ -243,7 +251,7 @@ bool Primitive_renderer::rhi_ensure_rect_pipeline(
 
     if (rhi_state.rect_pipeline && (rhi_state.rect_pipeline_rpd != rpd || rhi_state.rect_pipeline_samples != samples))
     {
-        rhi_state.rect_pipeline.reset();
+        rhi_state.rect_pipeline = nullptr;
     }
     if (rhi_state.rect_pipeline) {
         return true;
@@ -269,7 +277,12 @@ bool Primitive_renderer::rhi_ensure_rect_pipeline(
     desc.vlayout            = vlayout;
     desc.ubo_bytes          = k_rect_ubo_bytes;
     desc.ubo_stages         = QRhiShaderResourceBinding::VertexStage;
-    rhi_state.rect_pipeline = detail::build_alpha_blended_pipeline(rhi, rt, desc);
+    rhi_state.rect_pipeline = rhi_state.shared->pipeline(
+        "primitive.rect",
+        rt,
+        [&](QRhiRenderPassDescriptor* target_rpd, int sample_count) {
+            return detail::build_alpha_blended_pipeline(rhi, target_rpd, sample_count, desc);
+        });
     if (!rhi_state.rect_pipeline) {
         return false;
     }
@@ -288,7 +301,7 @@ bool Primitive_renderer::rhi_ensure_grid_pipeline(
 
     if (rhi_state.grid_pipeline && (rhi_state.grid_pipeline_rpd != rpd || rhi_state.grid_pipeline_samples != samples))
     {
-        rhi_state.grid_pipeline.reset();
+        rhi_state.grid_pipeline = nullptr;
     }
     if (rhi_state.grid_pipeline) {
         return true;
@@ -311,7 +324,12 @@ bool Primitive_renderer::rhi_ensure_grid_pipeline(
     desc.ubo_bytes          = k_grid_ubo_bytes;
     desc.ubo_stages         = QRhiShaderResourceBinding::FragmentStage;
     desc.flags              = QRhiGraphicsPipeline::UsesScissor;
-    rhi_state.grid_pipeline = detail::build_alpha_blended_pipeline(rhi, rt, desc);
+    rhi_state.grid_pipeline = rhi_state.shared->pipeline(
+        "primitive.grid",
+        rt,
+        [&](QRhiRenderPassDescriptor* target_rpd, int sample_count) {
+            return detail::build_alpha_blended_pipeline(rhi, target_rpd, sample_count, desc);
+        });
     if (!rhi_state.grid_pipeline) {
         return false;
     }
@@ -322,29 +340,13 @@ bool Primitive_renderer::rhi_ensure_grid_pipeline(
 
 bool Primitive_renderer::rhi_ensure_grid_quad_vbo(
     rhi_state_t&               rhi_state,
-    QRhi*                      rhi,
+    QRhi*                      /*rhi*/,
     QRhiResourceUpdateBatch*   updates)
 {
-    if (rhi_state.grid_quad_vbo) {
-        return true;
-    }
-    static constexpr float k_quad[] = {
-        -1.f, -1.f,
-         1.f, -1.f,
-        -1.f,  1.f,
-         1.f,  1.f
-    };
-    rhi_state.grid_quad_vbo.reset(rhi->newBuffer(
-        QRhiBuffer::Immutable, QRhiBuffer::VertexBuffer, sizeof(k_quad)));
-    if (!rhi_state.grid_quad_vbo || !rhi_state.grid_quad_vbo->create()) {
-        rhi_state.grid_quad_vbo.reset();
-        return false;
+    if (!rhi_state.grid_quad_vbo) {
+        rhi_state.grid_quad_vbo = rhi_state.shared->unit_quad_vbo(updates);
     }
-    if (updates) {
-        updates->uploadStaticBuffer(
-            rhi_state.grid_quad_vbo.get(), 0, sizeof(k_quad), k_quad);
-    }
-    return true;
+    return rhi_state.grid_quad_vbo != nullptr;
 }
 
 // Reset the per-frame plan if the caller hasn't already. A fresh prepare
@@ -362,22 +364,26 @@ void Primitive_renderer::rhi_reset_frame_plan(rhi_state_t& rhi_state)
 
 void Primitive_renderer::rhi_on_backend_change(rhi_state_t& rhi_state, QRhi* rhi)
 {
-    if (rhi_state.last_rhi == rhi) {
+    if (rhi_state.last_rhi == rhi &&
+        (!rhi_state.shared || rhi_state.shared->rhi() == rhi))
+    {
         return;
     }
-    // Backend swap: every cached resource belongs to the previous QRhi and
-    // is no longer valid. Drop the lot and rebuild lazily on the next call.
+    // Backend swap (a detached registry means the QRhi was destroyed, even
+    // when a new one took its address): every cached resource belongs to
+    // the previous QRhi and is no longer valid. Drop the lot and rebuild lazily on the next call.
     rhi_state.rect_calls.clear();
     rhi_state.grid_calls.clear();
     rhi_state.ops.clear();
     rhi_state.rect_used = 0;
     rhi_state.grid_used = 0;
-    rhi_state.rect_pipeline.reset();
-    rhi_state.grid_pipeline.reset();
+    rhi_state.rect_pipeline     = nullptr;
+    rhi_state.grid_pipeline     = nullptr;
     rhi_state.rect_pipeline_rpd = nullptr;
     rhi_state.grid_pipeline_rpd = nullptr;
-    rhi_state.grid_quad_vbo.reset();
-    rhi_state.last_rhi = rhi;
+    rhi_state.grid_quad_vbo     = nullptr;
+    rhi_state.shared            = detail::Rhi_shared_resources::acquire(rhi);
+    rhi_state.last_rhi          = rhi;
 }
 
 void Primitive_renderer::flush_rects(const frame_context_t& ctx, const glm::mat4& pmv)
@@ -665,7 +671,7 @@ void Primitive_renderer::record_draws(
                 if (!call.vbo || !call.srb) {
                     continue;
                 }
-                cb->setGraphicsPipeline(m_rhi_state->rect_pipeline.get());
+                cb->setGraphicsPipeline(m_rhi_state->rect_pipeline);
                 cb->setShaderResources(call.srb.get());
                 QRhiCommandBuffer::VertexInput vi{call.vbo.get(), 0u};
                 cb->setVertexInput(0, 1, &vi);
@@ -677,9 +683,9 @@ void Primitive_renderer::record_draws(
                 if (!call.srb || !m_rhi_state->grid_quad_vbo) {
                     continue;
                 }
-                cb->setGraphicsPipeline(m_rhi_state->grid_pipeline.get());
+                cb->setGraphicsPipeline(m_rhi_state->grid_pipeline);
                 cb->setShaderResources(call.srb.get());
-                QRhiCommandBuffer::VertexInput vi{m_rhi_state->grid_quad_vbo.get(), 0u};
+                QRhiCommandBuffer::VertexInput vi{m_rhi_state->grid_quad_vbo, 0u};
                 cb->setVertexInput(0, 1, &vi);
                 cb->setScissor(QRhiScissor(op.grid.x, op.grid.y, op.grid.w, op.grid.h));
                 cb->draw(4);
@@ -11,16 +11,32 @@
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 namespace vnm::plot::detail {
 
+// Each shader is deserialized once per process; QShader copies share it.
 inline QShader load_qsb(const char* alias)
 {
+    static std::mutex                                s_mutex;
+    static std::unordered_map<std::string, QShader>  s_shaders;
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    const auto it = s_shaders.find(alias);
+    if (it != s_shaders.end()) {
+        return it->second;
+    }
     QFile file(QStringLiteral(":/vnm_plot/shaders/qsb/") + QString::fromLatin1(alias));
     if (!file.open(QIODevice::ReadOnly)) {
         return {};
     }
-    return QShader::fromSerialized(file.readAll());
+    QShader shader = QShader::fromSerialized(file.readAll());
+    if (shader.isValid()) {
+        s_shaders.emplace(alias, shader);
+    }
+    return shader;
 }
 
 inline bool to_int_rounded(double value, int& out)
@@ -184,6 +200,28 @@ inline bool rebuild_single_ubo_srb(
     return srb->create();
 }
 
+// As rebuild_single_ubo_srb, plus a fragment-stage sampled texture at slot 1.
+inline bool rebuild_ubo_texture_srb(
+    QRhi*                                          rhi,
+    std::unique_ptr<QRhiShaderResourceBindings>&   srb,
+    QRhiBuffer*                                    ubo,
+    quint32                                        ubo_bytes,
+    QRhiShaderResourceBinding::StageFlags          stages,
+    QRhiTexture*                                   texture,
+    QRhiSampler*                                   sampler)
+{
+    srb.reset(rhi->newShaderResourceBindings());
+    if (!srb) {
+        return false;
+    }
+    srb->setBindings({
+        QRhiShaderResourceBinding::uniformBuffer(0, stages, ubo, 0, ubo_bytes),
+        QRhiShaderResourceBinding::sampledTexture(
+            1, QRhiShaderResourceBinding::FragmentStage, texture, sampler)
+    });
+    return srb->create();
+}
+
 // Grows / lazily creates a Dynamic UBO so it can hold at least `bytes_needed`
 // bytes. Returns true if the buffer is ready; on failure the unique_ptr is
 // reset to null so callers can early-out cleanly.
@@ -219,20 +257,29 @@ struct alpha_blended_pipeline_desc_t
     QRhiShaderResourceBinding::StageFlags ubo_stages =
         QRhiShaderResourceBinding::VertexStage;
     QRhiGraphicsPipeline::Flags    flags = {};
+    // Optional fragment-stage sampled texture at slot 1. Any texture and
+    // sampler of the right kind will do; only the layout is captured.
+    QRhiTexture*           layout_texture = nullptr;
+    QRhiSampler*           layout_sampler = nullptr;
+    // The fragment shader outputs premultiplied colour, e.g. a layer texture
+    // that was itself rendered with this blend.
+    bool                   premultiplied_alpha = false;
 };
 
 // Builds a graphics pipeline with the standard vnm_plot alpha blend and a
-// layout-only SRB containing a single UBO at slot 0. The SRB and the
+// layout-only SRB containing a single UBO at slot 0 (and the optional
+// texture at slot 1). The SRB and the
 // throwaway UBO it references live only long enough for the pipeline's
 // create() call; Qt validates layout, not handles, at create-time, so the
 // caller is free to bind a per-draw SRB with a different UBO handle
 // (matching layout) at draw time.
 inline std::unique_ptr<QRhiGraphicsPipeline> build_alpha_blended_pipeline(
     QRhi*                                  rhi,
-    QRhiRenderTarget*                      rt,
+    QRhiRenderPassDescriptor*              rpd,
+    int                                    sample_count,
     const alpha_blended_pipeline_desc_t&   desc)
 {
-    if (!rhi || !rt || !desc.vert.isValid() || !desc.frag.isValid()) {
+    if (!rhi || !rpd || !desc.vert.isValid() || !desc.frag.isValid()) {
         return nullptr;
     }
 
@@ -243,9 +290,13 @@ inline std::unique_ptr<QRhiGraphicsPipeline> build_alpha_blended_pipeline(
     }
 
     std::unique_ptr<QRhiShaderResourceBindings> layout_srb;
-    if (!rebuild_single_ubo_srb(
-            rhi, layout_srb, layout_ubo.get(), desc.ubo_bytes, desc.ubo_stages))
-    {
+    const bool layout_ready = (desc.layout_texture && desc.layout_sampler)
+        ? rebuild_ubo_texture_srb(
+            rhi, layout_srb, layout_ubo.get(), desc.ubo_bytes, desc.ubo_stages,
+            desc.layout_texture, desc.layout_sampler)
+        : rebuild_single_ubo_srb(
+            rhi, layout_srb, layout_ubo.get(), desc.ubo_bytes, desc.ubo_stages);
+    if (!layout_ready) {
         return nullptr;
     }
 
@@ -264,7 +315,9 @@ inline std::unique_ptr<QRhiGraphicsPipeline> build_alpha_blended_pipeline(
 
     QRhiGraphicsPipeline::TargetBlend blend;
     blend.enable   = true;
-    blend.srcColor = QRhiGraphicsPipeline::SrcAlpha;
+    blend.srcColor = desc.premultiplied_alpha
+        ? QRhiGraphicsPipeline::One
+        : QRhiGraphicsPipeline::SrcAlpha;
     blend.dstColor = QRhiGraphicsPipeline::OneMinusSrcAlpha;
     blend.srcAlpha = QRhiGraphicsPipeline::One;
     blend.dstAlpha = QRhiGraphicsPipeline::OneMinusSrcAlpha;
@@ -272,8 +325,8 @@ inline std::unique_ptr<QRhiGraphicsPipeline> build_alpha_blended_pipeline(
     if (desc.flags) {
         pipeline->setFlags(desc.flags);
     }
-    pipeline->setRenderPassDescriptor(rt->renderPassDescriptor());
-    pipeline->setSampleCount(rt->sampleCount());
+    pipeline->setRenderPassDescriptor(rpd);
+    pipeline->setSampleCount(sample_count);
 
     if (!pipeline->create()) {
         return nullptr;
@@ -281,4 +334,15 @@ inline std::unique_ptr<QRhiGraphicsPipeline> build_alpha_blended_pipeline(
     return pipeline;
 }
 
+inline std::unique_ptr<QRhiGraphicsPipeline> build_alpha_blended_pipeline(
+    QRhi*                                  rhi,
+    QRhiRenderTarget*                      rt,
+    const alpha_blended_pipeline_desc_t&   desc)
+{
+    if (!rt) {
+        return nullptr;
+    }
+    return build_alpha_blended_pipeline(rhi, rt->renderPassDescriptor(), rt->sampleCount(), desc);
+}
+
 } // namespace vnm::plot::detail
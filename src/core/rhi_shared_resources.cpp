@@ -0,0 +1,202 @@
+#include "rhi_shared_resources.h"
+
+#include <QImage>
+
+#include <mutex>
+
+namespace vnm::plot::detail {
+
+namespace {
+
+// One entry per live QRhi that has been asked for a registry; the entry goes
+// away when the QRhi is destroyed.
+std::mutex                                                         s_registry_mutex;
+std::unordered_map<const QRhi*, std::weak_ptr<Rhi_shared_resources>> s_registries;
+
+} // anonymous namespace
+
+std::shared_ptr<Rhi_shared_resources> Rhi_shared_resources::acquire(QRhi* rhi)
+{
+    if (!rhi) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(s_registry_mutex);
+    const auto [it, inserted] = s_registries.try_emplace(rhi);
+    if (inserted) {
+        rhi->addCleanupCallback(&Rhi_shared_resources::on_rhi_destroyed);
+    }
+    else
+    if (auto existing = it->second.lock()) {
+        return existing;
+    }
+    auto created = std::make_shared<Rhi_shared_resources>(rhi);
+    it->second = created;
+    return created;
+}
+
+// QRhi runs cleanup callbacks first thing in its destructor, while the
+// resources the registry owns can still be released against it.
+void Rhi_shared_resources::on_rhi_destroyed(QRhi* rhi)
+{
+    std::shared_ptr<Rhi_shared_resources> registry;
+    {
+        std::lock_guard<std::mutex> lock(s_registry_mutex);
+        const auto it = s_registries.find(rhi);
+        if (it == s_registries.end()) {
+            return;
+        }
+        registry = it->second.lock();
+        s_registries.erase(it);
+    }
+    if (registry) {
+        registry->release();
+    }
+}
+
+Rhi_shared_resources::Rhi_shared_resources(QRhi* rhi)
+:
+    m_rhi(rhi)
+{}
+
+Rhi_shared_resources::~Rhi_shared_resources() = default;
+
+void Rhi_shared_resources::release()
+{
+    m_pipelines.clear();
+    m_formats.clear();
+    m_nearest_sampler.reset();
+    m_linear_sampler.reset();
+    m_unit_quad_vbo.reset();
+    m_font_atlases.clear();
+    m_rhi = nullptr;
+}
+
+QRhiGraphicsPipeline* Rhi_shared_resources::pipeline(
+    std::string_view           name,
+    QRhiRenderTarget*          rt,
+    const pipeline_builder_t&  build)
+{
+    QRhiRenderPassDescriptor* const rt_rpd = rt ? rt->renderPassDescriptor() : nullptr;
+    if (!m_rhi || !rt_rpd || !build) {
+        return nullptr;
+    }
+
+    const QVector<quint32> serialized   = rt_rpd->serializedFormat();
+    const int              sample_count = rt->sampleCount();
+    std::size_t            format_index = 0;
+    while (format_index < m_formats.size() &&
+           (m_formats[format_index].sample_count != sample_count ||
+            m_formats[format_index].serialized   != serialized))
+    {
+        ++format_index;
+    }
+    if (format_index == m_formats.size()) {
+        target_format_t format;
+        format.serialized   = serialized;
+        format.sample_count = sample_count;
+        format.rpd.reset(rt_rpd->newCompatibleRenderPassDescriptor());
+        if (!format.rpd) {
+            return nullptr;
+        }
+        m_formats.push_back(std::move(format));
+    }
+
+    std::string key(name);
+    key += '#';
+    key += std::to_string(format_index);
+    auto& entry = m_pipelines[key];
+    if (!entry) {
+        const target_format_t& format = m_formats[format_index];
+        entry = build(format.rpd.get(), format.sample_count);
+        if (!entry) {
+            m_pipelines.erase(key);
+            return nullptr;
+        }
+    }
+    return entry.get();
+}
+
+QRhiSampler* Rhi_shared_resources::clamp_sampler(QRhiSampler::Filter filter)
+{
+    auto& sampler = (filter == QRhiSampler::Linear) ? m_linear_sampler : m_nearest_sampler;
+    if (!sampler && m_rhi) {
+        sampler.reset(m_rhi->newSampler(
+            filter,
+            filter,
+            QRhiSampler::None,
+            QRhiSampler::ClampToEdge,
+            QRhiSampler::ClampToEdge));
+        if (!sampler || !sampler->create()) {
+            sampler.reset();
+        }
+    }
+    return sampler.get();
+}
+
+QRhiBuffer* Rhi_shared_resources::unit_quad_vbo(QRhiResourceUpdateBatch* updates)
+{
+    if (m_unit_quad_vbo) {
+        return m_unit_quad_vbo.get();
+    }
+    if (!m_rhi || !updates) {
+        return nullptr;
+    }
+    static constexpr float k_quad[] = {
+        -1.f, -1.f,
+         1.f, -1.f,
+        -1.f,  1.f,
+         1.f,  1.f
+    };
+    m_unit_quad_vbo.reset(m_rhi->newBuffer(
+        QRhiBuffer::Immutable, QRhiBuffer::VertexBuffer, sizeof(k_quad)));
+    if (!m_unit_quad_vbo || !m_unit_quad_vbo->create()) {
+        m_unit_quad_vbo.reset();
+        return nullptr;
+    }
+    updates->uploadStaticBuffer(m_unit_quad_vbo.get(), 0, sizeof(k_quad), k_quad);
+    return m_unit_quad_vbo.get();
+}
+
+std::shared_ptr<QRhiTexture> Rhi_shared_resources::font_atlas(
+    std::uint64_t              cache_epoch,
+    int                        atlas_size,
+    const std::uint8_t*        rgba,
+    QRhiResourceUpdateBatch*   updates)
+{
+    for (auto it = m_font_atlases.begin(); it != m_font_atlases.end(); ) {
+        if (it->second.expired()) {
+            it = m_font_atlases.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    auto& slot = m_font_atlases[cache_epoch];
+    if (auto existing = slot.lock()) {
+        return existing;
+    }
+    if (!m_rhi || !rgba || !updates || atlas_size <= 0) {
+        m_font_atlases.erase(cache_epoch);
+        return nullptr;
+    }
+
+    std::shared_ptr<QRhiTexture> texture(
+        m_rhi->newTexture(QRhiTexture::RGBA8, QSize(atlas_size, atlas_size)));
+    if (!texture || !texture->create()) {
+        m_font_atlases.erase(cache_epoch);
+        return nullptr;
+    }
+    const QImage image(
+        rgba,
+        atlas_size,
+        atlas_size,
+        atlas_size * 4,
+        QImage::Format_RGBA8888);
+    updates->uploadTexture(texture.get(), image);
+    slot = texture;
+    return texture;
+}
+
+} // namespace vnm::plot::detail
@@ -0,0 +1,103 @@
+#pragma once
+
+// VNM Plot Library - Shared QRhi resources
+// Pipelines, samplers, font atlas textures and static buffers shared by
+// every renderer that draws on the same QRhi.
+
+#include <rhi/qrhi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace vnm::plot::detail {
+
+// One registry per QRhi, reference-counted by the renderers that draw on it:
+// a dashboard of plots on one window builds each pipeline once and uploads
+// each font atlas once, however many plots it shows. The registry goes away
+// with the last renderer that holds it, or with the QRhi: destroying the
+// QRhi releases what the registry owns and forgets it, so a later QRhi at
+// the same address starts from an empty registry. A registry still held past
+// that point hands out nothing.
+//
+// acquire() is thread-safe. Everything else runs on the thread that renders
+// with the QRhi, like the QRhi itself.
+class Rhi_shared_resources
+{
+public:
+    using pipeline_builder_t = std::function<
+        std::unique_ptr<QRhiGraphicsPipeline>(QRhiRenderPassDescriptor* rpd, int sample_count)>;
+
+    // Returns the registry of `rhi`, creating it when no renderer holds one.
+    static std::shared_ptr<Rhi_shared_resources> acquire(QRhi* rhi);
+
+    explicit Rhi_shared_resources(QRhi* rhi);
+    ~Rhi_shared_resources();
+
+    Rhi_shared_resources(const Rhi_shared_resources&)            = delete;
+    Rhi_shared_resources& operator=(const Rhi_shared_resources&) = delete;
+
+    QRhi* rhi() const { return m_rhi; }
+
+    // Returns the pipeline `name` for targets compatible with `rt`, calling
+    // `build` on the first request per render-pass format and sample count.
+    // The pipeline is built against a descriptor the registry owns, so it
+    // stays valid after the requesting target is gone. `name` must identify
+    // the shaders, vertex layout, bindings and state that `build` sets up.
+    QRhiGraphicsPipeline* pipeline(
+        std::string_view           name,
+        QRhiRenderTarget*          rt,
+        const pipeline_builder_t&  build);
+
+    // Clamp-to-edge sampler without mipmaps.
+    QRhiSampler* clamp_sampler(QRhiSampler::Filter filter);
+
+    // Immutable triangle-strip unit quad: four Float2 corners spanning
+    // [-1, 1]. The first request uploads it through `updates`.
+    QRhiBuffer* unit_quad_vbo(QRhiResourceUpdateBatch* updates);
+
+    // RGBA8 texture holding the font atlas identified by `cache_epoch`. The
+    // first request uploads `rgba` through `updates`; later ones share the
+    // texture for as long as any caller holds it.
+    std::shared_ptr<QRhiTexture> font_atlas(
+        std::uint64_t              cache_epoch,
+        int                        atlas_size,
+        const std::uint8_t*        rgba,
+        QRhiResourceUpdateBatch*   updates);
+
+    std::size_t pipeline_count() const { return m_pipelines.size(); }
+
+private:
+    // QRhi cleanup callback: forgets the registry of `rhi` and releases it.
+    static void on_rhi_destroyed(QRhi* rhi);
+
+    // Releases every resource the registry owns and detaches it from m_rhi.
+    void release();
+
+    struct target_format_t
+    {
+        QVector<quint32>                           serialized;
+        int                                        sample_count = 1;
+        std::unique_ptr<QRhiRenderPassDescriptor>  rpd;
+    };
+
+    QRhi*                                          m_rhi = nullptr;
+
+    // Declaration order doubles as release order: pipelines go before the
+    // descriptors they were built against.
+    std::vector<target_format_t>                   m_formats;
+    std::unordered_map<std::string, std::unique_ptr<QRhiGraphicsPipeline>>
+                                                   m_pipelines;
+    std::unique_ptr<QRhiSampler>                   m_nearest_sampler;
+    std::unique_ptr<QRhiSampler>                   m_linear_sampler;
+    std::unique_ptr<QRhiBuffer>                    m_unit_quad_vbo;
+    std::unordered_map<std::uint64_t, std::weak_ptr<QRhiTexture>>
+                                                   m_font_atlases;
+};
+
+} // namespace vnm::plot::detail
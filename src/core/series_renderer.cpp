@@ -7,19 +7,28 @@
 #include <vnm_plot/core/time_units.h>
 #include <vnm_plot/rhi/qrhi_series_layer.h>
 #include <vnm_plot/rhi/series_data.h>
+#include "background_jobs.h"
+#include "parallel_for.h"
 #include "rhi_helpers.h"
+#include "rhi_shared_resources.h"
 #include "series_window_planner.h"
 
 #include <glm/gtc/type_ptr.hpp>
+#include <QImage>
 #include <rhi/qrhi.h>
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <functional>
+#include <limits>
+#include <set>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
@@ -61,6 +70,10 @@ constexpr int           k_stack_sum_z_order         = 20;
 constexpr float         k_stack_sum_width_extra_px  = 2.0f;
 constexpr std::uint64_t k_stack_grid_policy_version = 1;
 
+// Windows with fewer than twice this many GPU samples are staged on the
+// calling thread; larger ones are split into ranges of at least this size.
+constexpr std::size_t k_parallel_staging_min_samples_per_range = 131'072;
+
 const char* stack_rejection_reason_text(Stack_rejection_reason reason)
 {
     switch (reason) {
@@ -104,6 +117,12 @@ glm::vec4 builtin_draw_color(
     float                  area_fill_alpha)
 {
     glm::vec4 color = series_color;
+    if (primitive_style == Display_style::DENSITY &&
+        ctx.dark_mode && is_default_series_color(color))
+    {
+        color = k_default_series_color_dark;
+    }
+    else
     if (primitive_style == Display_style::AREA) {
         const bool use_dark_default_color =
             ctx.dark_mode && is_default_series_color(color);
@@ -117,34 +136,14 @@ glm::vec4 builtin_draw_color(
     return color;
 }
 
-bool line_window_sample_count(
-    std::size_t            source_count,
-    Series_interpolation   interpolation,
-    std::size_t&           out_count)
-{
-    out_count = 0;
-    if (source_count == 0) {
-        return true;
-    }
-    if (interpolation == Series_interpolation::STEP_AFTER) {
-        std::size_t doubled = 0;
-        if (!detail::checked_size_product(source_count, 2u, doubled)) {
-            return false;
-        }
-        out_count = doubled - 1u;
-        return true;
-    }
-    out_count = source_count;
-    return true;
-}
-
 int builtin_primitive_z_order(Display_style primitive_style)
 {
     switch (primitive_style) {
-        case Display_style::AREA: return -10;
-        case Display_style::DOTS: return  10;
+        case Display_style::DENSITY: return -20;
+        case Display_style::AREA:    return -10;
+        case Display_style::DOTS:    return  10;
         case Display_style::LINE:
-        default:                  return   0;
+        default:                     return   0;
     }
 }
 
@@ -201,6 +200,21 @@ std::vector<builtin_segment_span_t> builtin_segment_spans(
     return spans;
 }
 
+bool same_drawable_spans(
+    const std::vector<drawable_sample_span_t>& a,
+    const std::vector<drawable_sample_span_t>& b)
+{
+    return std::equal(
+        a.begin(), a.end(), b.begin(), b.end(),
+        [](const drawable_sample_span_t& x, const drawable_sample_span_t& y) {
+            return
+                x.source_first == y.source_first &&
+                x.source_count == y.source_count &&
+                x.gpu_first    == y.gpu_first    &&
+                x.gpu_count    == y.gpu_count;
+        });
+}
+
 bool has_builtin_segment_span(const sample_window_t& window)
 {
     if (window.gpu_count        <  2)                             { return false; }
@@ -217,11 +231,30 @@ bool is_builtin_primitive_drawable(
     Display_style          primitive_style,
     const sample_window_t& window)
 {
-    if (window.gpu_count == 0)                   { return false; }
-    if (primitive_style  == Display_style::DOTS) { return true;  }
+    if (window.gpu_count == 0)                      { return false; }
+    if (primitive_style  == Display_style::DOTS)    { return true;  }
+    if (primitive_style  == Display_style::DENSITY) { return true;  }
     return has_builtin_segment_span(window);
 }
 
+std::uint64_t float_key_bits(float value) noexcept
+{
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// View geometry that DOTS cell culling depends on besides the planned window.
+std::vector<std::uint64_t> dots_cull_key(
+    float v_min, float v_max, float height_px, float y_offset_px)
+{
+    return {
+        float_key_bits(v_min),
+        float_key_bits(v_max),
+        float_key_bits(height_px),
+        float_key_bits(y_offset_px)};
+}
+
 std::size_t hash_access_policy_cache_key(
     const detail::access_policy_cache_key_t& key) noexcept
 {
@@ -251,20 +284,18 @@ static_assert(offsetof(series_view_uniform_std140_t, framebuffer_y_up) == 112,
     "Series_view_t framebuffer_y_up offset");
 static_assert(sizeof(series_view_uniform_std140_t) == 128, "Series_view_t std140 size");
 
-series_view_uniform_std140_t make_series_view_uniform(
+series_view_uniform_std140_t make_view_uniform(
     const frame_context_t& frame,
-    const series_data_t&   series,
-    const sample_window_t& window)
+    const sample_window_t& window,
+    const glm::vec4&       draw_color)
 {
     series_view_uniform_std140_t uniform{};
     std::memcpy(uniform.pmv, glm::value_ptr(frame.pmv), sizeof(float) * 16);
 
-    glm::vec4 draw_color = series.color;
-    draw_color.w     *= window.window_alpha;
-    uniform.color[0]  = draw_color.r;
-    uniform.color[1]  = draw_color.g;
-    uniform.color[2]  = draw_color.b;
-    uniform.color[3]  = draw_color.a;
+    uniform.color[0] = draw_color.r;
+    uniform.color[1] = draw_color.g;
+    uniform.color[2] = draw_color.b;
+    uniform.color[3] = draw_color.a;
 
     uniform.t_min    = detail::to_view_seconds(window.t_min_ns, window.t_origin_ns);
     uniform.t_max    = detail::to_view_seconds(window.t_max_ns, window.t_origin_ns);
@@ -279,6 +310,16 @@ series_view_uniform_std140_t make_series_view_uniform(
     return uniform;
 }
 
+series_view_uniform_std140_t make_series_view_uniform(
+    const frame_context_t& frame,
+    const series_data_t&   series,
+    const sample_window_t& window)
+{
+    glm::vec4 draw_color = series.color;
+    draw_color.w *= window.window_alpha;
+    return make_view_uniform(frame, window, draw_color);
+}
+
 // Per-view RHI resources held off-line so the public header forward-declares
 // the type. The unique_ptr<rhi_buffers_t> in vbo_view_state_t pulls in QRhiBuffer
 // transitively through this struct's members.
@@ -292,13 +333,14 @@ struct Series_renderer::vbo_view_state_t::rhi_buffers_t
 {
     std::unique_ptr<QRhiBuffer>    vbo;
     std::unique_ptr<QRhiBuffer>    ubo;
-    // LINE-specific per-frame buffer that holds the active sample window
-    // padded with leading and trailing duplicates. Bound four times as a
-    // vertex buffer at consecutive gpu_sample_t offsets with per-instance
-    // stepping, so the vertex shader receives prev/p0/p1/next as plain
-    // attributes. This side-steps the SM 5.0 UAV restriction that blocks
-    // SSBOs in the D3D11 vertex stage.
-    std::unique_ptr<QRhiBuffer>    line_window_vbo;
+    // Main view's sample VBO while a preview view borrows it; see
+    // vbo_view_state_t::samples_borrowed.
+    QRhiBuffer*                    borrowed_vbo = nullptr;
+
+    QRhiBuffer* sample_vbo() const
+    {
+        return borrowed_vbo ? borrowed_vbo : vbo.get();
+    }
 
     // Per-(view, primitive_style) UBO + SRB cache. Each drawable primitive
     // needs an independent UBO because every resource update is submitted
@@ -319,6 +361,14 @@ struct Series_renderer::vbo_view_state_t::rhi_buffers_t
     srb_entry_t                    stack_sum_line_srb;
     srb_entry_t                    area_fill_srb;
 
+    // DENSITY grid texture, one texel per plot pixel, and the SRB that binds
+    // it next to density_srb.ubo (the bare Series_view block). The SRB was
+    // built against density_srb_texture.
+    std::unique_ptr<QRhiTexture>   density_texture;
+    srb_entry_t                    density_srb;
+    QRhiTexture*                   density_srb_texture = nullptr;
+    std::size_t                    density_width       = 0;
+    std::size_t                    density_height      = 0;
 };
 
 Series_renderer::vbo_view_state_t::vbo_view_state_t()
@@ -335,6 +385,30 @@ void Series_renderer::vbo_view_state_t::reset()
     *this = vbo_view_state_t{};
 }
 
+void Series_renderer::staging_buffer_t::drop_front(std::size_t count) noexcept
+{
+    if (count >= size()) {
+        clear();
+        return;
+    }
+    m_first += count;
+}
+
+void Series_renderer::staging_buffer_t::resize(std::size_t count)
+{
+    if (m_first > 0 && m_first + count > m_samples.capacity()) {
+        const std::size_t kept = std::min(size(), count);
+        std::vector<gpu_sample_t> compacted;
+        compacted.reserve(count > std::numeric_limits<std::size_t>::max() / 2u
+            ? count
+            : count * 2u);
+        compacted.insert(compacted.end(), data(), data() + kept);
+        m_samples.swap(compacted);
+        m_first = 0;
+    }
+    m_samples.resize(m_first + count);
+}
+
 Series_renderer::vbo_state_t::vbo_state_t()
 :
     snapshot_cache(std::make_unique<detail::Series_window_snapshot_cache>())
@@ -359,11 +433,28 @@ struct Series_renderer::rhi_state_t
 {
     enum class pipeline_kind_t : uint32_t
     {
-        DOTS = 0,
-        LINE = 1,
-        AREA = 2
+        DOTS       = 0,
+        LINE       = 1,
+        AREA       = 2,
+        DOTS_BATCH = 3,
+        LINE_BATCH = 4,
+        DENSITY    = 5
     };
 
+    // Name of the kind's pipeline in the shared per-QRhi registry.
+    static const char* pipeline_name(pipeline_kind_t kind)
+    {
+        switch (kind) {
+            case pipeline_kind_t::DOTS:       return "series.dots";
+            case pipeline_kind_t::LINE:       return "series.line";
+            case pipeline_kind_t::AREA:       return "series.area";
+            case pipeline_kind_t::DOTS_BATCH: return "series.dots_batch";
+            case pipeline_kind_t::LINE_BATCH: return "series.line_batch";
+            case pipeline_kind_t::DENSITY:    return "series.density";
+        }
+        return "series.unknown";
+    }
+
     struct pipeline_key_t
     {
         pipeline_kind_t kind;
@@ -384,13 +475,14 @@ struct Series_renderer::rhi_state_t
 
     struct rhi_pipeline_t
     {
-        std::unique_ptr<QRhiGraphicsPipeline>  pipeline;
+        // Owned by `shared`.
+        QRhiGraphicsPipeline*                  pipeline = nullptr;
         QShader                                vert;
         QShader                                frag;
-        // Render-pass descriptor captured at pipeline creation. If the host's
-        // current render target carries a different descriptor (e.g. resize
-        // recreated the FBO with a different color format or sample count),
-        // the cached pipeline is no longer compatible and is rebuilt.
+        // Render-pass descriptor the pipeline was last looked up for. If the
+        // host's current render target carries a different descriptor (e.g.
+        // resize recreated the FBO with a different color format or sample
+        // count), the pipeline is looked up again for the new format.
         QRhiRenderPassDescriptor*              last_rpd          = nullptr;
         int                                    last_sample_count = 1;
     };
@@ -541,8 +633,56 @@ struct Series_renderer::rhi_state_t
         // record pass instead of recomputing from window. Empty for DOTS.
         std::vector<detail::builtin_segment_span_t>
                                    builtin_segment_spans;
+        // Member of draw_batches[batch_index]; only the first member records
+        // the batch, the others record nothing of their own.
+        bool                       batched           = false;
+        bool                       batch_head        = false;
+        std::size_t                batch_index       = 0;
+    };
+
+    // One packed draw of consecutive built-in commands
+    // (Plot_config::batch_series_draws). Entries are reused by position from
+    // frame to frame; `members` identifies the packed contents so an
+    // unchanged batch is neither repacked nor uploaded.
+    struct draw_batch_t
+    {
+        struct member_t
+        {
+            vbo_view_state_t*  view_state       = nullptr;
+            std::uint64_t      staging_revision = 0;
+            std::size_t        sample_count     = 0;
+            // LINE only: the drawable spans packed for this member.
+            std::vector<builtin_segment_span_t>
+                               segment_spans;
+
+            bool operator==(const member_t& o) const noexcept
+            {
+                return
+                    view_state       == o.view_state       &&
+                    staging_revision == o.staging_revision &&
+                    sample_count     == o.sample_count     &&
+                    std::equal(
+                        segment_spans.begin(), segment_spans.end(),
+                        o.segment_spans.begin(), o.segment_spans.end(),
+                        [](const builtin_segment_span_t& x, const builtin_segment_span_t& y) {
+                            return x.gpu_first == y.gpu_first && x.gpu_count == y.gpu_count;
+                        });
+            }
+        };
+
+        pipeline_kind_t                kind               = pipeline_kind_t::LINE_BATCH;
+        bool                           step_after         = false;
+        std::vector<member_t>          members;
+        std::unique_ptr<QRhiBuffer>    vbo;
+        std::size_t                    vbo_capacity_bytes = 0;
+        std::size_t                    instance_count     = 0;
+        vbo_view_state_t::rhi_buffers_t::srb_entry_t
+                                       uniforms;
     };
 
+    // Owns the pipelines and the DENSITY sampler; declared first so it is
+    // released after everything that binds them.
+    std::shared_ptr<detail::Rhi_shared_resources>                              shared;
     std::unordered_map<pipeline_key_t, rhi_pipeline_t, pipeline_key_hash_t>    pipelines;
     std::unordered_map<view_ubo_key_t, view_ubo_state_t, view_ubo_key_hash_t>  view_ubos;
     std::unordered_map<
@@ -550,13 +690,28 @@ struct Series_renderer::rhi_state_t
         qrhi_layer_cache_entry_t,
         qrhi_layer_program_key_hash_t> qrhi_layer_cache;
     std::vector<prepared_draw_command_t>                                       prepared_draws;
+    std::vector<draw_batch_t>                                                  draw_batches;
+    std::vector<gpu_sample_t>                                                  batch_staging;
+    std::uint64_t                                                              staging_revision = 0;
     QShader                                                                    cached_dot_vert;
     QShader                                                                    cached_dot_frag;
     QShader                                                                    cached_line_vert;
     QShader                                                                    cached_line_frag;
     QShader                                                                    cached_area_vert;
     QShader                                                                    cached_area_frag;
+    QShader                                                                    cached_dot_batch_vert;
+    QShader                                                                    cached_dot_batch_frag;
+    QShader                                                                    cached_line_batch_vert;
+    QShader                                                                    cached_line_batch_frag;
     bool                                                                       shaders_loaded = false;
+    QShader                                                                    cached_density_vert;
+    QShader                                                                    cached_density_frag;
+    bool                                                                       density_shaders_loaded = false;
+    // Shared by every DENSITY draw; nearest so one texel stays one pixel.
+    // Owned by `shared`.
+    QRhiSampler*                                                               density_sampler = nullptr;
+    // Binning scratch, reused across views and frames.
+    detail::density_grid_t                                                     density_grid;
 
     QRhi*                                                                      last_rhi = nullptr;
     QRhiResourceUpdateBatch*                                                   pending_updates = nullptr;
@@ -573,6 +728,11 @@ struct Series_renderer::rhi_state_t
     // True if prepare() filled this plan. Reset after render() consumes it
     // so a stray render() without a matching prepare() is a no-op.
     bool                                                                       frame_plan_ready = false;
+
+    // Last composition of each stack group and view, kept so an append-only
+    // frame can extend it instead of merging every member from scratch.
+    std::map<std::pair<int, Series_view_kind>, detail::stack_composition_cache_t>
+                                                                               stack_compositions;
 };
 
 // -----------------------------------------------------------------------------
@@ -587,6 +747,7 @@ struct Series_renderer::rhi_state_t
 //         Series_view_t view;             // 128 bytes
 //         float         line_px;          // for LINE
 //         int           snap;             // for LINE
+//         int           interpolation;    // for LINE
 //         float         dot_px;           // for DOTS
 //         int           interpolation;    // for AREA
 //     } u;
@@ -615,8 +776,8 @@ struct Series_renderer::rhi_state_t
 // satisfy std140's structure-trailing rule. The renderer allocates enough UBO
 // bytes for the largest block and uploads the concrete block size needed by
 // each primitive.
-// Whole-block layout: Series_view + LINE trailing (line_px, snap_to_pixels).
-// Padded out to a 16-byte multiple so the host-side struct mirrors the
+// Whole-block layout: Series_view + LINE trailing (line_px, snap_to_pixels,
+// interpolation). Padded out to a 16-byte multiple so the host-side struct mirrors the
 // vec4-aligned trailing element rule std140 enforces on the GLSL block.
 struct Line_block_std140
 {
@@ -624,12 +785,13 @@ struct Line_block_std140
            view;           // offset 0
     float  line_px;        // offset 128
     int    snap_to_pixels; // offset 132
-    float  pad0;           // offset 136
+    int    interpolation;  // offset 136
     float  pad1;           // offset 140
 };
 static_assert(sizeof(Line_block_std140) == 144, "Line_block_std140 must be a multiple of 16");
 static_assert(offsetof(Line_block_std140, line_px)        == 128, "Line_block line_px offset");
 static_assert(offsetof(Line_block_std140, snap_to_pixels) == 132, "Line_block snap_to_pixels offset");
+static_assert(offsetof(Line_block_std140, interpolation)  == 136, "Line_block interpolation offset");
 
 // Whole-block layout: Series_view + DOTS trailing (point_diameter_px).
 // Padded out to 144 bytes for the same reason as Line_block_std140.
@@ -665,6 +827,29 @@ static_assert(sizeof(Line_block_std140) <= k_series_ubo_bytes, "ubo bytes fit LI
 static_assert(sizeof(Dot_block_std140)  <= k_series_ubo_bytes, "ubo bytes fit DOTS block");
 static_assert(sizeof(Area_block_std140) == k_series_ubo_bytes, "ubo bytes match AREA block");
 
+// Whole-block layout of plot_line_batch and plot_dot_quad_batch: Series_view
+// (color unused), the LINE/DOTS size, then one color per batch member.
+// size_px is line_px for LINE and point_diameter_px for DOTS; the DOTS block
+// leaves snap_to_pixels and interpolation unused.
+constexpr std::size_t k_batch_max_series = 256;
+
+struct Batch_block_std140
+{
+    series_view_uniform_std140_t
+           view;                                 // offset 0
+    float  size_px;                              // offset 128
+    int    snap_to_pixels;                       // offset 132
+    int    interpolation;                        // offset 136
+    float  pad1;                                 // offset 140
+    float  series_color[k_batch_max_series][4];  // offset 144
+};
+static_assert(offsetof(Batch_block_std140, size_px)      == 128, "Batch_block size_px offset");
+static_assert(offsetof(Batch_block_std140, series_color) == 144, "Batch_block series_color offset");
+static_assert(sizeof(Batch_block_std140) == 144 + 16 * k_batch_max_series,
+    "Batch_block_std140 must be a multiple of 16");
+
+constexpr std::uint32_t k_batch_ubo_bytes = sizeof(Batch_block_std140);
+
 Series_renderer::Series_renderer()
 :
     m_rhi_state(std::make_unique<rhi_state_t>())
@@ -703,11 +888,24 @@ void Series_renderer::cleanup_resources()
     m_rhi_state->cached_line_frag = {};
     m_rhi_state->cached_area_vert = {};
     m_rhi_state->cached_area_frag = {};
+    m_rhi_state->cached_dot_batch_vert  = {};
+    m_rhi_state->cached_dot_batch_frag  = {};
+    m_rhi_state->cached_line_batch_vert = {};
+    m_rhi_state->cached_line_batch_frag = {};
+    m_rhi_state->density_shaders_loaded = false;
+    m_rhi_state->cached_density_vert    = {};
+    m_rhi_state->cached_density_frag    = {};
+    m_rhi_state->density_sampler = nullptr;
+    m_rhi_state->density_grid = {};
+    m_rhi_state->draw_batches.clear();
+    m_rhi_state->batch_staging.clear();
+    m_rhi_state->shared.reset();
     m_rhi_state->last_rhi         = nullptr;
     m_rhi_state->pending_updates  = nullptr;
     m_rhi_state->frame_draw_states.clear();
     m_rhi_state->prepared_draws.clear();
     m_rhi_state->frame_plan_ready = false;
+    m_rhi_state->stack_compositions.clear();
     m_last_recorded_draw_z_orders.clear();
     m_last_recorded_draw_styles.clear();
     m_last_recorded_draw_series_ids.clear();
@@ -715,7 +913,11 @@ void Series_renderer::cleanup_resources()
     m_last_recorded_stack_sum_overlays.clear();
     m_last_recorded_draw_colors.clear();
     m_last_recorded_line_widths.clear();
+    m_last_recorded_batch_draw_count = 0;
+    m_last_recorded_batched_series_count = 0;
+    m_last_batch_upload_count = 0;
     m_last_qrhi_layer_cache_size = 0;
+    m_lod_bias                   = 0.0;
 }
 
 void Series_renderer::clear_frame_snapshot_caches()
@@ -737,6 +939,12 @@ void Series_renderer::prepare(
     m_rhi_state->frame_draw_states.clear();
     m_rhi_state->prepared_draws.clear();
     m_rhi_state->frame_plan_ready = false;
+    m_last_frame_current = false;
+    m_last_frame_main_changed_x = 0.0;
+    // Emptied so that any early return below forces the next scroll-blit
+    // frame to redraw in full.
+    const std::vector<int> previous_scroll_series_ids = std::move(m_scroll_series_ids);
+    m_scroll_series_ids.clear();
     m_last_recorded_draw_z_orders.clear();
     m_last_recorded_draw_styles.clear();
     m_last_recorded_draw_series_ids.clear();
@@ -744,6 +952,9 @@ void Series_renderer::prepare(
     m_last_recorded_stack_sum_overlays.clear();
     m_last_recorded_draw_colors.clear();
     m_last_recorded_line_widths.clear();
+    m_last_recorded_batch_draw_count = 0;
+    m_last_recorded_batched_series_count = 0;
+    m_last_batch_upload_count = 0;
     m_last_qrhi_layer_cache_size = m_rhi_state->qrhi_layer_cache.size();
 
     const auto clear_retired_series_resources = [&]() {
@@ -757,11 +968,14 @@ void Series_renderer::prepare(
         m_rhi_state->qrhi_layer_cache.clear();
         m_rhi_state->view_ubos.clear();
         m_rhi_state->prepared_draws.clear();
+        m_rhi_state->draw_batches.clear();
         m_last_qrhi_layer_cache_size = 0;
     };
 
     if (series.empty()) {
         clear_retired_series_resources();
+        m_last_frame_current = true;
+        m_lod_bias           = 0.0;
         return;
     }
     if (!m_asset_loader) {
@@ -774,6 +988,10 @@ void Series_renderer::prepare(
     }
 
     ++m_frame_id;
+    m_last_frame_current = true;
+
+    const auto   prepare_start  = std::chrono::steady_clock::now();
+    const double lod_pps_target = std::exp2(m_lod_bias);
 
     vnm::plot::Profiler* profiler = ctx.config ? ctx.config->profiler.get() : nullptr;
     VNM_PLOT_PROFILE_SCOPE(profiler,
@@ -781,7 +999,9 @@ void Series_renderer::prepare(
 
     QRhi* rhi = ctx.rhi;
     QRhiResourceUpdateBatch* rhi_updates = ctx.rhi_updates;
-    if (m_rhi_state->last_rhi != rhi) {
+    if (m_rhi_state->last_rhi != rhi ||
+        (m_rhi_state->shared && m_rhi_state->shared->rhi() != rhi))
+    {
         for (auto& [key, entry] : m_rhi_state->qrhi_layer_cache) {
             if (entry.state) {
                 entry.state->cleanup_qrhi_resources(key.rhi);
@@ -790,7 +1010,10 @@ void Series_renderer::prepare(
         m_rhi_state->qrhi_layer_cache.clear();
         m_rhi_state->view_ubos.clear();
         m_rhi_state->pipelines.clear();
+        m_rhi_state->density_sampler = nullptr;
+        m_rhi_state->shared          = detail::Rhi_shared_resources::acquire(rhi);
         m_rhi_state->prepared_draws.clear();
+        m_rhi_state->draw_batches.clear();
         for (auto& [_, state] : m_vbo_states) {
             state.main_view.reset();
             state.preview_view.reset();
@@ -918,6 +1141,7 @@ void Series_renderer::prepare(
             vbo_state = vbo_state_t{};
             vbo_state.stack_group = s->stack_group;
         }
+        vbo_state.last_drawn_frame = m_frame_id;
 
         std::vector<std::size_t> main_scales = source_lod_scales(*main_source);
         std::vector<std::size_t> preview_scales;
@@ -962,7 +1186,35 @@ void Series_renderer::prepare(
             request.style                 = style;
             request.interpolation         = interpolation;
             request.snapshot_requirement  = snapshot_requirement;
-            request.has_uploaded_vbo      = view_state.has_uploaded_vbo;
+            // A decimated upload can only stand in for a view that would be
+            // decimated again; DOTS need every planned sample unless they
+            // were culled for the view geometry they are drawn with now.
+            const bool dots_culled_upload_reusable =
+                ctx.config && ctx.config->dots_pixel_culling &&
+                style == Display_style::DOTS &&
+                view_state.m4_dots_key == (view_kind == Series_view_kind::MAIN
+                    ? dots_cull_key(
+                        ctx.v0,
+                        ctx.v1,
+                        static_cast<float>(layout.usable_height),
+                        0.0f)
+                    : dots_cull_key(
+                        ctx.preview_v0,
+                        ctx.preview_v1,
+                        static_cast<float>(ctx.adjusted_preview_height),
+                        static_cast<float>(double(ctx.win_h) - ctx.adjusted_preview_height)));
+            const bool uploaded_vbo_reusable =
+                view_state.m4_spans.empty() ||
+                (view_state.m4_dots_key.empty()
+                    ? ctx.config && ctx.config->m4_decimation && !(style & Display_style::DOTS)
+                    : dots_culled_upload_reusable);
+            // A borrowed upload belongs to the main view and may change under
+            // the preview view, so a borrowing view always plans afresh.
+            request.has_uploaded_vbo      =
+                view_state.has_uploaded_vbo && uploaded_vbo_reusable &&
+                !view_state.samples_borrowed;
+            request.lod_hysteresis        = ctx.config ? ctx.config->lod_hysteresis : 0.0;
+            request.lod_pps_target        = lod_pps_target;
             request.profiler              = profiler;
             return detail::plan_series_window(request);
         };
@@ -985,8 +1237,15 @@ void Series_renderer::prepare(
             (has_main_layer || s->stack_group != 0)
                 ? detail::Snapshot_requirement::Frame_snapshot_required
                 : detail::Snapshot_requirement::Optional);
-        const bool main_reuses_uploaded_geometry =
-            vbo_state.main_view.planner->last_plan_reused_upload;
+        // A view that fell back to an older upload (busy source) or found no
+        // snapshot does not show the source's current content.
+        const auto plan_is_current = [](const Series_view_plan& plan, const Data_source& source) {
+            return plan.snapshot.sequence != 0 &&
+                plan.snapshot.sequence == source.current_sequence(plan.lod_level);
+        };
+        if (!plan_is_current(main_plan, *main_source)) {
+            m_last_frame_current = false;
+        }
         main_plan.v_min        = ctx.v0;
         main_plan.v_max        = ctx.v1;
         main_plan.height_px    = static_cast<float>(layout.usable_height);
@@ -1003,7 +1262,6 @@ void Series_renderer::prepare(
         }
 
         Series_view_plan preview_plan;
-        bool             preview_reuses_uploaded_geometry = false;
         preview_plan.series_id             = id;
         preview_plan.view_kind             = Series_view_kind::PREVIEW;
         preview_plan.source                = preview_source;
@@ -1028,8 +1286,9 @@ void Series_renderer::prepare(
                 (has_preview_layer || s->stack_group != 0)
                     ? detail::Snapshot_requirement::Frame_snapshot_required
                     : detail::Snapshot_requirement::Optional);
-            preview_reuses_uploaded_geometry =
-                vbo_state.preview_view.planner->last_plan_reused_upload;
+            if (!plan_is_current(preview_plan, *preview_source)) {
+                m_last_frame_current = false;
+            }
             const double preview_top =
                 double(ctx.win_h) - ctx.adjusted_preview_height;
             preview_plan.v_min        = ctx.preview_v0;
@@ -1047,13 +1306,129 @@ void Series_renderer::prepare(
         draw_state.main_plan    = std::move(main_plan);
         draw_state.preview_plan = std::move(preview_plan);
         draw_state.has_preview  = preview_visible && preview_valid;
-        draw_state.main_reuses_uploaded_geometry =
-            main_reuses_uploaded_geometry;
-        draw_state.preview_reuses_uploaded_geometry =
-            preview_reuses_uploaded_geometry;
         draw_states.push_back(std::move(draw_state));
     }
 
+    // Plot_config::scroll_blit: where each main view can differ from what
+    // the previous frame drew for it. A view that only gained samples after
+    // the previous frame's last sample changes from that sample onwards.
+    const auto scroll_changed_x = [&](const series_draw_state_t& draw_state) -> double {
+        constexpr double unchanged = std::numeric_limits<double>::infinity();
+        const Series_view_plan& plan = draw_state.main_plan;
+        vbo_view_state_t&       view = draw_state.vbo_state->main_view;
+        const bool was_valid = view.scroll_valid;
+        view.scroll_valid = false;
+
+        // These views' pixels depend on the whole window.
+        if (draw_state.series->stack_group != 0                 ||
+            !!(plan.style & Display_style::DENSITY)             ||
+            !qrhi_layers_for(*draw_state.series).empty()        ||
+            !plan.access || !plan.source || plan.snapshot.sequence == 0)
+        {
+            return 0.0;
+        }
+        const bool same_view =
+            was_valid                                   &&
+            view.scroll_source    == plan.source        &&
+            view.scroll_access    == plan.access        &&
+            view.scroll_lod_level == plan.lod_level;
+        const auto remember_view = [&](std::size_t count) {
+            view.scroll_valid     = true;
+            view.scroll_source    = plan.source;
+            view.scroll_access    = plan.access;
+            view.scroll_lod_level = plan.lod_level;
+            view.scroll_sequence  = plan.snapshot.sequence;
+            view.scroll_count     = count;
+        };
+        if (plan.source_count == 0) {
+            const bool was_empty = same_view && view.scroll_count == 0;
+            remember_view(0);
+            return was_empty ? unchanged : 0.0;
+        }
+
+        const data_snapshot_t& snapshot    = plan.snapshot.snapshot;
+        const auto             access_view = detail::make_erased_access_policy_view(*plan.access);
+        const std::size_t      last_index  = plan.source_first + plan.source_count - 1u;
+        const void*            front       = snapshot.at(0);
+        const void*            last        = snapshot.at(last_index);
+        detail::sample_draw_value_t last_value;
+        if (!front || !last ||
+            detail::read_sample_draw_value(
+                access_view, last, plan.nonfinite_policy, last_value) !=
+                    detail::sample_draw_status_t::DRAWABLE)
+        {
+            return 0.0;
+        }
+        const std::int64_t front_ns = access_view.timestamp(front);
+        const std::int64_t last_ns  = access_view.timestamp(last);
+
+        double changed_x = 0.0;
+        if (same_view && view.scroll_count > 0) {
+            // Leading samples the source dropped are still on screen unless
+            // the new first sample is left of the view.
+            const bool front_kept = front_ns == view.scroll_front_ns || front_ns <= ctx.t0;
+            if (view.scroll_sequence == plan.snapshot.sequence) {
+                changed_x = unchanged;
+            }
+            else
+            if (front_kept) {
+                std::size_t first = plan.source_first;
+                std::size_t end   = plan.source_first + plan.source_count;
+                while (first < end) {
+                    const std::size_t middle = first + (end - first) / 2u;
+                    const void*       sample = snapshot.at(middle);
+                    if (!sample) {
+                        first = end = plan.source_first + plan.source_count;
+                        break;
+                    }
+                    if (access_view.timestamp(sample) < view.scroll_last_ns) {
+                        first = middle + 1u;
+                    }
+                    else {
+                        end = middle;
+                    }
+                }
+                const void* anchor = first < plan.source_first + plan.source_count
+                    ? snapshot.at(first)
+                    : nullptr;
+                detail::sample_draw_value_t anchor_value;
+                if (anchor                                                       &&
+                    access_view.timestamp(anchor) == view.scroll_last_ns         &&
+                    detail::read_sample_draw_value(
+                        access_view, anchor, plan.nonfinite_policy, anchor_value) ==
+                            detail::sample_draw_status_t::DRAWABLE               &&
+                    anchor_value.y     == view.scroll_last_y                     &&
+                    anchor_value.y_min == view.scroll_last_y_min                 &&
+                    anchor_value.y_max == view.scroll_last_y_max)
+                {
+                    const double span_ns = double(ctx.t1 - ctx.t0);
+                    changed_x = first == last_index
+                        ? unchanged
+                        : std::max(0.0,
+                            double(view.scroll_last_ns - ctx.t0) / span_ns * layout.usable_width);
+                }
+            }
+        }
+
+        remember_view(plan.source_count);
+        view.scroll_front_ns   = front_ns;
+        view.scroll_last_ns    = last_ns;
+        view.scroll_last_y     = last_value.y;
+        view.scroll_last_y_min = last_value.y_min;
+        view.scroll_last_y_max = last_value.y_max;
+        return changed_x;
+    };
+    if (ctx.config && ctx.config->scroll_blit && ctx.t1 > ctx.t0) {
+        double changed_x = std::numeric_limits<double>::infinity();
+        m_scroll_series_ids.reserve(draw_states.size());
+        for (const auto& draw_state : draw_states) {
+            m_scroll_series_ids.push_back(draw_state.id);
+            changed_x = std::min(changed_x, scroll_changed_x(draw_state));
+        }
+        m_last_frame_main_changed_x =
+            m_scroll_series_ids == previous_scroll_series_ids ? changed_x : 0.0;
+    }
+
     const auto compose_stacks = [&](Series_view_kind view_kind) {
         VNM_PLOT_PROFILE_SCOPE(profiler, "renderer.frame.compose_stacks");
         const auto view_state_for = [view_kind](series_draw_state_t& member)
@@ -1068,15 +1443,6 @@ void Series_renderer::prepare(
             state.stack_cache_snapshot  = {};
             state.stack_cache_resampled = false;
         };
-        const auto set_reuses_uploaded_geometry =
-            [view_kind](series_draw_state_t& member, bool value) {
-                if (view_kind == Series_view_kind::MAIN) {
-                    member.main_reuses_uploaded_geometry = value;
-                }
-                else {
-                    member.preview_reuses_uploaded_geometry = value;
-                }
-            };
         for (auto& draw_state : draw_states) {
             if (draw_state.vbo_state) {
                 view_state_for(draw_state).last_stack_view_suppressed = false;
@@ -1093,6 +1459,7 @@ void Series_renderer::prepare(
             }
             groups[draw_state.series->stack_group].push_back(&draw_state);
         }
+        std::set<int> composed_groups;
 
         for (auto& [group, members] : groups) {
             auto& published = m_stack_view_statuses[{group, view_kind}];
@@ -1189,14 +1556,15 @@ void Series_renderer::prepare(
                         state.stack_cache_key == cache_key &&
                         state.stack_cache_snapshot;
                 });
-            std::vector<std::vector<detail::stacked_sample_t>> layers;
+            auto& composition = m_rhi_state->stack_compositions[{group, view_kind}];
+            composed_groups.insert(group);
             detail::stack_composition_stats_t composition_stats;
             const Stack_rejection_reason rejection = cache_hit
                 ? Stack_rejection_reason::NONE
                 : detail::compose_stacked_series(
                     plans,
                     selected_time_orders,
-                    layers,
+                    composition,
                     timestamp_budget,
                     &composition_stats);
             if (cache_hit) {
@@ -1230,6 +1598,7 @@ void Series_renderer::prepare(
                 if (profiler && rejection == Stack_rejection_reason::OUTPUT_LIMIT) {
                     profiler->record_counter("renderer.stacking.output_limit_count");
                 }
+                m_rhi_state->stack_compositions.erase({group, view_kind});
                 continue;
             }
             std::size_t output_samples = 0;
@@ -1255,19 +1624,15 @@ void Series_renderer::prepare(
                     : members[i]->preview_plan;
                 auto& view_state = view_state_for(*members[i]);
                 if (!cache_hit) {
-                    auto samples = std::make_shared<std::vector<detail::stacked_sample_t>>(
-                        std::move(layers[i]));
+                    const auto& samples = composition.layers[i];
                     view_state.stack_cache_snapshot  = {
-                        samples->data(), samples->size(),
+                        samples->data() + composition.first, composition.count,
                         sizeof(detail::stacked_sample_t),
                         m_frame_id,
                         nullptr, 0, samples};
                     view_state.stack_cache_key       = cache_key;
                     view_state.stack_cache_resampled = composition_stats.resampled;
                 }
-                set_reuses_uploaded_geometry(
-                    *members[i],
-                    cache_hit && view_state.has_uploaded_vbo);
                 const data_snapshot_t snapshot = view_state.stack_cache_snapshot;
                 if (main_validity) {
                     (*main_validity)[i].cumulative = snapshot;
@@ -1320,6 +1685,24 @@ void Series_renderer::prepare(
                 if (cache_hit) {
                     profiler->record_counter("renderer.stacking.cache_hit_count");
                 }
+                else
+                if (composition_stats.extended) {
+                    profiler->record_counter("renderer.stacking.extended_group_count");
+                    profiler->record_observation(
+                        "renderer.stacking.reused_timestamp_count",
+                        static_cast<double>(composition_stats.reused_timestamp_count));
+                }
+            }
+        }
+
+        for (auto it = m_rhi_state->stack_compositions.begin();
+            it != m_rhi_state->stack_compositions.end();)
+        {
+            if (it->first.second == view_kind && !composed_groups.count(it->first.first)) {
+                it = m_rhi_state->stack_compositions.erase(it);
+            }
+            else {
+                ++it;
             }
         }
     };
@@ -1334,12 +1717,22 @@ void Series_renderer::prepare(
         view_state.last_sample_buffer            = nullptr;
         view_state.last_staged_sample_count      = 0;
         view_state.last_sample_upload_bytes      = 0;
-        view_state.last_line_window_upload_bytes = 0;
-        view_state.last_line_window_upload_count = 0;
         view_state.last_uniform_upload_bytes     = 0;
         view_state.last_uniform_upload_count     = 0;
-        view_state.line_window_geometry_dirty    = true;
-        view_state.line_draw_spans.clear();
+        view_state.m4_source_indices.clear();
+        view_state.m4_spans.clear();
+        view_state.m4_plan_spans.clear();
+        view_state.m4_dots_key.clear();
+        view_state.m4_gpu_count = 0;
+        view_state.sample_base  = 0;
+        view_state.stream_valid = false;
+        view_state.samples_shared           = false;
+        view_state.samples_borrowed         = false;
+        view_state.shared_upload_generation = 0;
+        view_state.sample_upload_pending    = false;
+        if (view_state.rhi) {
+            view_state.rhi->borrowed_vbo = nullptr;
+        }
     };
 
     if (!rhi || !rhi_updates || !ctx.render_target) {
@@ -1353,7 +1746,10 @@ void Series_renderer::prepare(
                     draw_state.vbo_state->preview_view);
             }
         }
-        m_rhi_state->frame_plan_ready = false;
+        m_rhi_state->frame_plan_ready    = false;
+        m_last_frame_current             = false;
+        m_last_frame_main_changed_x      = 0.0;
+        m_scroll_series_ids.clear();
         return;
     }
 
@@ -1394,14 +1790,14 @@ void Series_renderer::prepare(
         qrhi_series_sample_buffer_t sample_buffer;
         if (!view_state.has_uploaded_vbo ||
             !view_state.rhi ||
-            !view_state.rhi->vbo ||
+            !view_state.rhi->sample_vbo() ||
             window.gpu_count == 0)
         {
             return sample_buffer;
         }
 
-        sample_buffer.buffer               = view_state.rhi->vbo.get();
-        sample_buffer.first_sample         = 0;
+        sample_buffer.buffer               = view_state.rhi->sample_vbo();
+        sample_buffer.first_sample         = view_state.sample_base;
         sample_buffer.sample_count         = window.gpu_count;
         sample_buffer.source_first         = window.source_first;
         sample_buffer.source_count         = window.source_count;
@@ -1420,12 +1816,118 @@ void Series_renderer::prepare(
         return sample_buffer;
     };
 
-    std::size_t frame_sample_upload_bytes      = 0;
-    std::size_t frame_sample_upload_count      = 0;
-    std::size_t frame_line_window_upload_bytes = 0;
-    std::size_t frame_line_window_upload_count = 0;
-    std::size_t frame_uniform_upload_bytes     = 0;
-    std::size_t frame_uniform_upload_count     = 0;
+    // Main and preview views of one series that select the same LOD window
+    // share one sample VBO. The main view is prepared first: it uploads
+    // whichever window contains the other, keeps its own part in staging and
+    // lends the preview view its part. The view drawn against the other's
+    // origin must stay within k_shared_origin_max_spans of its own span from
+    // it, which keeps fp32 t_rel well below a pixel.
+    constexpr long double k_shared_origin_max_spans = 256.0L;
+    const bool share_view_samples =
+        ctx.config                            &&
+        ctx.config->share_view_sample_buffers &&
+        !ctx.config->streaming_sample_buffers;
+    const auto single_drawable_span = [](const Series_view_plan& plan) {
+        return
+            plan.drawable_spans.size() == 1                            &&
+            plan.drawable_spans.front().source_first == plan.source_first &&
+            plan.drawable_spans.front().source_count == plan.source_count;
+    };
+    // M4 decimation or DOTS cell culling may apply; either keeps a view's
+    // upload to itself.
+    const auto m4_candidate = [&](const Series_view_plan& plan) {
+        if (!ctx.config || !(plan.pixels_per_sample > 0.0)) {
+            return false;
+        }
+        return
+            (ctx.config->m4_decimation &&
+             plan.pixels_per_sample <= detail::k_m4_max_pixels_per_sample) ||
+            (ctx.config->dots_pixel_culling                                  &&
+             plan.style == Display_style::DOTS                               &&
+             plan.pixels_per_sample <= detail::k_dots_cull_max_pixels_per_sample);
+    };
+    const auto origin_within_reach =
+        [](const Series_view_plan& plan, std::int64_t origin_ns) {
+            const long double reach = k_shared_origin_max_spans * std::max(
+                1.0L, span_ns_as_long_double(plan.t_min_ns, plan.t_max_ns));
+            return
+                std::fabs(span_ns_as_long_double(origin_ns, plan.t_min_ns)) <= reach &&
+                std::fabs(span_ns_as_long_double(origin_ns, plan.t_max_ns)) <= reach;
+        };
+    const auto window_contains =
+        [](const Series_view_plan& outer, const Series_view_plan& inner) {
+            return
+                inner.synthetic_hold_count == 0                  &&
+                inner.source_first >= outer.source_first         &&
+                inner.source_first - outer.source_first + inner.source_count <=
+                    outer.source_count;
+        };
+    // The plan whose window holds both views' samples, or null when the
+    // views cannot share.
+    const auto shared_view_window =
+        [&](const series_draw_state_t& draw_state) -> const Series_view_plan* {
+            const Series_view_plan& main    = draw_state.main_plan;
+            const Series_view_plan& preview = draw_state.preview_plan;
+            if (!share_view_samples                            ||
+                !draw_state.has_preview                        ||
+                !draw_state.series                             ||
+                draw_state.series->stack_group != 0            ||
+                !draw_state.series->preview_matches_main()     ||
+                main.stacked           || preview.stacked      ||
+                main.gpu_count   == 0  || preview.gpu_count == 0 ||
+                main.source      != preview.source             ||
+                main.lod_level   != preview.lod_level          ||
+                main.snapshot.sequence != preview.snapshot.sequence ||
+                !single_drawable_span(main)                    ||
+                !single_drawable_span(preview)                 ||
+                m4_candidate(main) || m4_candidate(preview))
+            {
+                return nullptr;
+            }
+            const Series_view_plan* shared = window_contains(preview, main)
+                ? &preview
+                : (window_contains(main, preview) ? &main : nullptr);
+            if (!shared) {
+                return nullptr;
+            }
+            const Series_view_plan& other = shared == &main ? preview : main;
+            return origin_within_reach(other, shared->t_origin_ns) ? shared : nullptr;
+        };
+    const auto lend_samples =
+        [](vbo_view_state_t& owner, vbo_view_state_t& borrower,
+            const Series_view_plan& plan, std::size_t first_slot)
+    {
+        if (!borrower.rhi) {
+            borrower.rhi = std::make_unique<vbo_view_state_t::rhi_buffers_t>();
+        }
+        borrower.rhi->vbo.reset();
+        borrower.rhi_vbo_capacity_bytes   = 0;
+        borrower.rhi_vbo_dynamic          = false;
+        borrower.rhi->borrowed_vbo        = owner.rhi->vbo.get();
+        borrower.has_uploaded_vbo         = true;
+        borrower.samples_borrowed         = true;
+        borrower.sample_base              = first_slot;
+        borrower.stream_valid             = false;
+        borrower.shared_sequence          = plan.snapshot.sequence;
+        borrower.shared_lod_level         = plan.lod_level;
+        borrower.shared_source_first      = plan.source_first;
+        borrower.shared_source_count      = plan.source_count;
+        borrower.shared_gpu_count         = plan.gpu_count;
+        borrower.shared_t_origin_ns       = owner.shared_t_origin_ns;
+        borrower.shared_upload_generation = owner.shared_upload_generation;
+        borrower.m4_source_indices.clear();
+        borrower.m4_spans.clear();
+        borrower.m4_plan_spans.clear();
+        borrower.m4_dots_key.clear();
+        borrower.m4_gpu_count = 0;
+    };
+
+    std::size_t frame_sample_upload_bytes  = 0;
+    std::size_t frame_sample_upload_count  = 0;
+    std::size_t frame_uniform_upload_bytes = 0;
+    std::size_t frame_uniform_upload_count = 0;
+    std::size_t frame_density_upload_bytes = 0;
+    std::size_t frame_density_upload_count = 0;
     std::size_t next_draw_insertion_order      = 0;
 
     const auto ensure_view_ubo =
@@ -1466,27 +1968,77 @@ void Series_renderer::prepare(
         return state.buffer.get();
     };
 
+    const auto layer_program_key =
+        [&](const series_draw_state_t& draw_state,
+            const Series_view_plan& plan,
+            const Qrhi_series_layer& layer)
+    {
+        const detail::erased_access_policy_t layer_access_view =
+            plan.access
+                ? detail::make_erased_access_policy_view(*plan.access)
+                : detail::erased_access_policy_t{};
+
+        rhi_state_t::qrhi_layer_program_key_t program_key;
+        program_key.series_id      = draw_state.id;
+        program_key.view_kind      = plan.view_kind;
+        program_key.layer_id       = std::string(layer.id());
+        program_key.layer_revision = layer.revision();
+        program_key.data_identity  = plan.source ? plan.source->identity() : nullptr;
+        program_key.layout_key     = plan.access ? plan.access->layout_key : 0;
+        program_key.access_key     = detail::make_access_policy_cache_key(
+            plan.access,
+            layer_access_view);
+        program_key.rhi            = rhi;
+        return program_key;
+    };
+
+    // Async layer stages (Plot_config::async_layer_prepare), started below
+    // before any view stages its samples. prepare_view_layers() waits for a
+    // state's own stage right before its prepare().
+    detail::Background_jobs async_layer_jobs;
+    std::unordered_map<const Qrhi_series_layer_state*, std::size_t> async_layer_job_index;
+    const auto make_async_prepare_context =
+        [&](const series_draw_state_t& draw_state, const Series_view_plan& plan) {
+            qrhi_series_async_prepare_context_t async_ctx;
+            async_ctx.frame  = &ctx;
+            async_ctx.series = draw_state.series.get();
+            async_ctx.window = make_window(plan);
+            return async_ctx;
+        };
+
     const auto prepare_view_layers =
         [&](series_draw_state_t& draw_state,
             const Series_view_plan& plan,
             vbo_view_state_t& view_state)
     {
         view_state.last_sample_upload_count         = 0;
-        view_state.last_line_window_upload_bytes    = 0;
-        view_state.last_line_window_upload_count    = 0;
         view_state.last_uniform_upload_bytes        = 0;
         view_state.last_uniform_upload_count        = 0;
         view_state.last_primitive_prepare_count     = 0;
-        view_state.last_line_window_sample_count    = 0;
         view_state.last_recorded_line_span_count    = 0;
         view_state.last_recorded_line_segment_count = 0;
         view_state.last_recorded_area_span_count    = 0;
         view_state.last_recorded_area_segment_count = 0;
         view_state.last_recorded_dot_sample_count   = 0;
+        view_state.last_density_bin_count           = 0;
+        view_state.last_density_upload_bytes        = 0;
+        view_state.last_recorded_density_draw_count = 0;
         view_state.last_sample_access_dispatch_kind =
             detail::access_dispatch_kind_t::NONE;
         view_state.last_sample_buffer = nullptr;
 
+        // The main view decides below whether the preview view borrows its
+        // samples this frame.
+        if (plan.view_kind == Series_view_kind::MAIN && draw_state.vbo_state) {
+            auto& preview_view = draw_state.vbo_state->preview_view;
+            if (preview_view.samples_borrowed) {
+                preview_view.samples_borrowed = false;
+                preview_view.has_uploaded_vbo = false;
+                preview_view.sample_base      = 0;
+                preview_view.rhi->borrowed_vbo = nullptr;
+            }
+        }
+
         if (!draw_state.series) {
             return;
         }
@@ -1505,7 +2057,7 @@ void Series_renderer::prepare(
             bool           stack_sum_overlay = false;
         };
 
-        // Built-in LINE/DOTS/AREA all read the primary value lane. A range-only
+        // Built-in LINE/DOTS/AREA/DENSITY all read the primary value lane. A range-only
         // access policy (timestamp + range, no value) is valid for auto-range
         // and custom range-band layers, but feeding it to a value style would
         // silently render flat at y = 0. Require a value accessor for built-ins;
@@ -1513,12 +2065,13 @@ void Series_renderer::prepare(
         const bool wants_builtin_value_style =
             !!(plan.style & Display_style::AREA) ||
             !!(plan.style & Display_style::LINE) ||
-            !!(plan.style & Display_style::DOTS);
+            !!(plan.style & Display_style::DOTS) ||
+            !!(plan.style & Display_style::DENSITY);
         const bool access_has_value = plan.access && plan.access->get_value;
         if (wants_builtin_value_style && !access_has_value) {
             static std::atomic<bool> warned_missing_value{false};
             if (!warned_missing_value.exchange(true)) {
-                qWarning("vnm_plot: built-in LINE/DOTS/AREA styles require a "
+                qWarning("vnm_plot: built-in LINE/DOTS/AREA/DENSITY styles require a "
                     "primary value accessor; a range-only access policy renders "
                     "nothing for these styles. Use a custom range-band layer "
                     "instead. Skipping built-in primitives for such series.");
@@ -1526,6 +2079,15 @@ void Series_renderer::prepare(
         }
 
         std::vector<planned_draw_t> planned_draws;
+        // DENSITY bins the raw source samples, which a stacked window does
+        // not draw; stacked series skip it.
+        if (access_has_value && !plan.stacked && !!(plan.style & Display_style::DENSITY)) {
+            planned_draws.push_back({
+                nullptr,
+                true,
+                Display_style::DENSITY,
+                builtin_primitive_z_order(Display_style::DENSITY)});
+        }
         if (access_has_value && !!(plan.style & Display_style::AREA)) {
             planned_draws.push_back({
                 nullptr,
@@ -1589,9 +2151,16 @@ void Series_renderer::prepare(
             planned_draws.end(),
             [&](const planned_draw_t& draw) {
                 return
-                    draw.is_builtin &&
+                    draw.is_builtin                                &&
+                    draw.primitive_style != Display_style::DENSITY &&
                     is_builtin_primitive_drawable(draw.primitive_style, window);
             });
+        const bool has_density_draw = std::any_of(
+            planned_draws.begin(),
+            planned_draws.end(),
+            [](const planned_draw_t& draw) {
+                return draw.is_builtin && draw.primitive_style == Display_style::DENSITY;
+            });
         const bool has_custom_layer = std::any_of(
             planned_draws.begin(),
             planned_draws.end(),
@@ -1602,22 +2171,210 @@ void Series_renderer::prepare(
             has_drawable_builtin_layer || has_custom_layer;
         if (!needs_sample_buffer) {
             invalidate_view_upload_state(view_state);
-            return;
+            if (!has_density_draw) {
+                return;
+            }
         }
-        bool samples_ready = true;
-        samples_ready = rhi_prepare_series_view_samples(
-            ctx,
-            view_state,
-            window);
-        const bool reuses_uploaded_geometry =
-            plan.view_kind == Series_view_kind::MAIN
-                ? draw_state.main_reuses_uploaded_geometry
-                : draw_state.preview_reuses_uploaded_geometry;
-        if (samples_ready                              &&
-            view_state.last_sample_upload_count > 0   &&
-            !reuses_uploaded_geometry)
+        // Optional M4 reduction of dense LINE/AREA-only views. DOTS and custom
+        // layers read every planned sample from the shared buffer, so views
+        // that draw them are never decimated.
+        const bool has_dots_draw = std::any_of(
+            planned_draws.begin(),
+            planned_draws.end(),
+            [](const planned_draw_t& draw) {
+                return draw.is_builtin && draw.primitive_style == Display_style::DOTS;
+            });
+        const Series_view_plan* const shared_window_plan =
+            plan.view_kind == Series_view_kind::MAIN && window.snapshot
+                ? shared_view_window(draw_state)
+                : nullptr;
+        const bool m4_allowed =
+            ctx.config && ctx.config->m4_decimation && needs_sample_buffer &&
+            !has_custom_layer && !has_dots_draw && !window.stacked &&
+            !shared_window_plan && !view_state.samples_borrowed;
+        // DOTS cell culling, for views whose only sample reader is DOTS.
+        const bool dots_cull_allowed =
+            ctx.config && ctx.config->dots_pixel_culling && has_dots_draw &&
+            !has_custom_layer && !window.stacked &&
+            !shared_window_plan && !view_state.samples_borrowed &&
+            std::all_of(
+                planned_draws.begin(),
+                planned_draws.end(),
+                [](const planned_draw_t& draw) {
+                    return draw.primitive_style == Display_style::DOTS;
+                });
+        const std::vector<std::size_t>* gpu_source_indices = nullptr;
+        if (window.snapshot) {
+            view_state.m4_source_indices.clear();
+            view_state.m4_spans.clear();
+            view_state.m4_plan_spans.clear();
+            view_state.m4_dots_key.clear();
+            view_state.m4_gpu_count = 0;
+
+            detail::m4_window_t m4;
+            if (m4_allowed                                                       &&
+                window.pixels_per_sample >  0.0                                  &&
+                window.pixels_per_sample <= detail::k_m4_max_pixels_per_sample   &&
+                detail::decimate_window_m4(window, m4))
+            {
+                if (profiler) {
+                    profiler->record_counter("renderer.frame.m4_decimated_view_count");
+                    profiler->record_observation(
+                        "renderer.frame.m4_decimated_samples",
+                        static_cast<double>(window.gpu_count - m4.gpu_count));
+                }
+                view_state.m4_plan_spans     = window.drawable_spans;
+                view_state.m4_source_indices = std::move(m4.source_indices);
+                view_state.m4_spans          = std::move(m4.spans);
+                view_state.m4_gpu_count      = m4.gpu_count;
+                gpu_source_indices           = &view_state.m4_source_indices;
+            }
+            else
+            if (dots_cull_allowed                                                       &&
+                window.pixels_per_sample >  0.0                                         &&
+                window.pixels_per_sample <= detail::k_dots_cull_max_pixels_per_sample   &&
+                detail::cull_window_dots(window, m4))
+            {
+                if (profiler) {
+                    profiler->record_counter("renderer.frame.dots_culled_view_count");
+                    profiler->record_observation(
+                        "renderer.frame.dots_culled_samples",
+                        static_cast<double>(window.gpu_count - m4.gpu_count));
+                }
+                view_state.m4_plan_spans     = window.drawable_spans;
+                view_state.m4_source_indices = std::move(m4.source_indices);
+                view_state.m4_spans          = std::move(m4.spans);
+                view_state.m4_gpu_count      = m4.gpu_count;
+                view_state.m4_dots_key       = dots_cull_key(
+                    window.v_min, window.v_max, window.height_px, window.y_offset_px);
+                gpu_source_indices           = &view_state.m4_source_indices;
+            }
+        }
+        if (!view_state.m4_spans.empty() &&
+            same_drawable_spans(view_state.m4_plan_spans, window.drawable_spans))
         {
-            view_state.line_window_geometry_dirty = true;
+            // Either freshly decimated above or a reused upload that still
+            // holds the decimated samples.
+            window.drawable_spans = view_state.m4_spans;
+            window.gpu_count      = view_state.m4_gpu_count;
+        }
+
+        // Batched LINE/DOTS draws pack from staging, so a plain static view
+        // leaves its own VBO write until batching is decided. Views whose
+        // buffer the preview shares or custom layers read upload now.
+        view_state.defer_sample_upload =
+            ctx.config && ctx.config->batch_series_draws &&
+            !has_custom_layer && !shared_window_plan &&
+            !view_state.samples_shared && !view_state.samples_borrowed;
+
+        bool samples_ready = true;
+        if (!needs_sample_buffer) {
+            // DENSITY-only view: the grid is binned from the snapshot, so no
+            // samples are staged or uploaded.
+            samples_ready = false;
+        }
+        else
+        if (view_state.samples_borrowed) {
+            window.t_origin_ns            = view_state.shared_t_origin_ns;
+            view_state.last_sample_buffer = view_state.rhi->borrowed_vbo;
+        }
+        else
+        if (shared_window_plan) {
+            const Series_view_plan& preview      = draw_state.preview_plan;
+            auto&                   preview_view = draw_state.vbo_state->preview_view;
+            sample_window_t shared_window = shared_window_plan == &plan
+                ? window
+                : make_window(*shared_window_plan);
+            shared_window.snapshot        = window.snapshot;
+            shared_window.access          = window.access;
+            shared_window.sample_sequence = window.sample_sequence;
+            samples_ready = rhi_prepare_series_view_samples(
+                ctx,
+                view_state,
+                shared_window,
+                nullptr);
+            if (samples_ready &&
+                view_state.staging.size() == shared_window.gpu_count)
+            {
+                const std::size_t main_first =
+                    plan.source_first    - shared_window_plan->source_first;
+                const std::size_t preview_first =
+                    preview.source_first - shared_window_plan->source_first;
+                const auto staged = view_state.staging.begin();
+                preview_view.staging.assign(
+                    staged + static_cast<std::ptrdiff_t>(preview_first),
+                    staged + static_cast<std::ptrdiff_t>(preview_first + preview.gpu_count));
+                view_state.staging.drop_front(main_first);
+                view_state.staging.resize(plan.gpu_count);
+                view_state.staging_revision   = ++m_rhi_state->staging_revision;
+                preview_view.staging_revision = ++m_rhi_state->staging_revision;
+
+                view_state.sample_base         = main_first;
+                view_state.samples_shared      = true;
+                view_state.shared_sequence     = shared_window_plan->snapshot.sequence;
+                view_state.shared_lod_level    = shared_window_plan->lod_level;
+                view_state.shared_source_first = shared_window_plan->source_first;
+                view_state.shared_source_count = shared_window_plan->source_count;
+                view_state.shared_gpu_count    = shared_window_plan->gpu_count;
+                view_state.shared_t_origin_ns  = shared_window_plan->t_origin_ns;
+                ++view_state.shared_upload_generation;
+                window.t_origin_ns = view_state.shared_t_origin_ns;
+
+                lend_samples(view_state, preview_view, preview, preview_first);
+            }
+            else {
+                samples_ready = false;
+            }
+        }
+        else {
+            if (plan.view_kind == Series_view_kind::MAIN && view_state.samples_shared) {
+                if (window.snapshot) {
+                    view_state.samples_shared = false;
+                }
+                else {
+                    // Reused upload of a shared window: keep drawing the
+                    // main part against the shared origin and lend the
+                    // preview view the same part as before when it asks for
+                    // exactly that.
+                    window.t_origin_ns = view_state.shared_t_origin_ns;
+                    const Series_view_plan& preview      = draw_state.preview_plan;
+                    auto&                   preview_view = draw_state.vbo_state->preview_view;
+                    if (share_view_samples                              &&
+                        draw_state.has_preview                          &&
+                        draw_state.series->stack_group == 0             &&
+                        draw_state.series->preview_matches_main()       &&
+                        preview_view.shared_upload_generation ==
+                            view_state.shared_upload_generation         &&
+                        preview_view.shared_sequence     == preview.snapshot.sequence &&
+                        preview_view.shared_lod_level    == preview.lod_level         &&
+                        preview_view.shared_source_first == preview.source_first      &&
+                        preview_view.shared_source_count == preview.source_count      &&
+                        preview_view.shared_gpu_count    == preview.gpu_count         &&
+                        preview_view.staging.size()      == preview.gpu_count         &&
+                        origin_within_reach(preview, view_state.shared_t_origin_ns))
+                    {
+                        lend_samples(
+                            view_state,
+                            preview_view,
+                            preview,
+                            preview.source_first - view_state.shared_source_first);
+                    }
+                }
+            }
+            if (plan.view_kind == Series_view_kind::PREVIEW) {
+                view_state.shared_upload_generation = 0;
+            }
+            samples_ready = rhi_prepare_series_view_samples(
+                ctx,
+                view_state,
+                window,
+                gpu_source_indices);
+        }
+        if (!view_state.defer_sample_upload) {
+            rhi_flush_sample_upload(ctx, view_state);
+        }
+        if (view_state.samples_borrowed && profiler) {
+            profiler->record_counter("renderer.frame.shared_view_sample_buffer_count");
         }
         const qrhi_series_sample_buffer_t sample_buffer =
             samples_ready
@@ -1645,6 +2402,33 @@ void Series_renderer::prepare(
             ? static_cast<float>(ctx.config->area_fill_alpha) : 0.3f;
 
         for (const auto& planned_draw : planned_draws) {
+            if (planned_draw.is_builtin &&
+                planned_draw.primitive_style == Display_style::DENSITY)
+            {
+                const glm::vec4 draw_color = builtin_draw_color(
+                    ctx,
+                    draw_state.series->color,
+                    Display_style::DENSITY,
+                    window,
+                    area_fill_alpha);
+                if (rhi_prepare_series_density(ctx, view_state, plan, window, draw_color)) {
+                    rhi_state_t::prepared_draw_command_t command;
+                    command.kind =
+                        rhi_state_t::prepared_draw_command_t::kind_t::BUILTIN;
+                    command.z_order         = planned_draw.z_order;
+                    command.series_id       = draw_state.id;
+                    command.view_kind       = plan.view_kind;
+                    command.series_order    = draw_state.series_order;
+                    command.insertion_order = next_draw_insertion_order++;
+                    command.series          = draw_state.series.get();
+                    command.window          = window;
+                    command.primitive_style = Display_style::DENSITY;
+                    command.view_state      = &view_state;
+                    command.draw_color      = draw_color;
+                    m_rhi_state->prepared_draws.push_back(std::move(command));
+                }
+                continue;
+            }
             if (planned_draw.is_builtin) {
                 if (!samples_ready ||
                     !is_builtin_primitive_drawable( planned_draw.primitive_style, window))
@@ -1696,23 +2480,10 @@ void Series_renderer::prepare(
                 continue;
             }
 
-            const detail::erased_access_policy_t layer_access_view =
-                plan.access
-                    ? detail::make_erased_access_policy_view(*plan.access)
-                    : detail::erased_access_policy_t{};
-            const detail::access_policy_cache_key_t layer_access_key = detail::make_access_policy_cache_key(
-                plan.access,
-                layer_access_view);
-
-            rhi_state_t::qrhi_layer_program_key_t program_key;
-            program_key.series_id      = draw_state.id;
-            program_key.view_kind      = plan.view_kind;
-            program_key.layer_id       = std::string(layer->id());
-            program_key.layer_revision = layer->revision();
-            program_key.data_identity  = plan.source ? plan.source->identity() : nullptr;
-            program_key.layout_key     = plan.access ? plan.access->layout_key : 0;
-            program_key.access_key     = layer_access_key;
-            program_key.rhi            = rhi;
+            const rhi_state_t::qrhi_layer_program_key_t program_key =
+                layer_program_key(draw_state, plan, *layer);
+            const detail::access_policy_cache_key_t& layer_access_key =
+                program_key.access_key;
 
             if (!window.snapshot) {
                 for (auto& [cached_key, cache_entry] : m_rhi_state->qrhi_layer_cache) {
@@ -1767,6 +2538,17 @@ void Series_renderer::prepare(
                 continue;
             }
 
+            if (cache_entry.state->has_async_prepare()) {
+                const auto job = async_layer_job_index.find(cache_entry.state.get());
+                if (job != async_layer_job_index.end()) {
+                    async_layer_jobs.wait(job->second);
+                }
+                else {
+                    cache_entry.state->prepare_async(
+                        make_async_prepare_context(draw_state, plan));
+                }
+            }
+
             qrhi_series_prepare_context_t prepare_ctx;
             prepare_ctx.rhi               = rhi;
             prepare_ctx.render_target     = ctx.render_target;
@@ -1811,14 +2593,75 @@ void Series_renderer::prepare(
                     static_cast<double>(view_state.last_sample_upload_count));
             }
         }
-        if (view_state.last_line_window_upload_count > 0) {
-            frame_line_window_upload_bytes += view_state.last_line_window_upload_bytes;
-            frame_line_window_upload_count += view_state.last_line_window_upload_count;
-        }
         frame_uniform_upload_bytes += view_state.last_uniform_upload_bytes;
         frame_uniform_upload_count += view_state.last_uniform_upload_count;
+        frame_density_upload_bytes += view_state.last_density_upload_bytes;
+        frame_density_upload_count += view_state.last_density_bin_count;
     };
 
+    if (ctx.config && ctx.config->async_layer_prepare) {
+        // Same view order and per-view z order as prepare_view_layers(), so
+        // the worker finishes stages in the order they are waited for.
+        std::vector<std::function<void()>> jobs;
+        const auto queue_view_jobs =
+            [&](const series_draw_state_t& draw_state, const Series_view_plan& plan) {
+                if (!draw_state.series || plan.gpu_count == 0 || !plan.snapshot.snapshot) {
+                    return;
+                }
+                std::vector<std::shared_ptr<const Qrhi_series_layer>> layers;
+                for (const auto& layer : qrhi_layers_for(*draw_state.series)) {
+                    if (layer && layer->draws_view(plan.view_kind)) {
+                        layers.push_back(layer);
+                    }
+                }
+                std::stable_sort(
+                    layers.begin(),
+                    layers.end(),
+                    [](const auto& a, const auto& b) {
+                        return a->z_order() < b->z_order();
+                    });
+                for (const auto& layer : layers) {
+                    auto& cache_entry =
+                        m_rhi_state->qrhi_layer_cache[layer_program_key(draw_state, plan, *layer)];
+                    if (!cache_entry.state) {
+                        cache_entry.state = layer->create_state(*rhi);
+                        // prepare() still reports the new state as changed.
+                        cache_entry.has_data_key = false;
+                    }
+                    cache_entry.last_frame_used = m_frame_id;
+                    Qrhi_series_layer_state* const state = cache_entry.state.get();
+                    if (!state || !state->has_async_prepare() ||
+                        async_layer_job_index.count(state) != 0)
+                    {
+                        continue;
+                    }
+                    async_layer_job_index.emplace(state, jobs.size());
+                    jobs.push_back(
+                        [state, async_ctx = make_async_prepare_context(draw_state, plan)]() {
+                            state->prepare_async(async_ctx);
+                        });
+                }
+            };
+        for (const auto& draw_state : draw_states) {
+            if (draw_state.vbo_state) {
+                queue_view_jobs(draw_state, draw_state.main_plan);
+            }
+        }
+        if (preview_visible) {
+            for (const auto& draw_state : draw_states) {
+                if (draw_state.vbo_state && draw_state.has_preview) {
+                    queue_view_jobs(draw_state, draw_state.preview_plan);
+                }
+            }
+        }
+        if (profiler && !jobs.empty()) {
+            profiler->record_observation(
+                "renderer.frame.async_layer_prepare_count",
+                static_cast<double>(jobs.size()));
+        }
+        async_layer_jobs.start(std::move(jobs));
+    }
+
     for (auto& draw_state : draw_states) {
         if (!draw_state.vbo_state) {
             continue;
@@ -1840,6 +2683,8 @@ void Series_renderer::prepare(
                 draw_state.vbo_state->preview_view);
         }
     }
+    // Stages of draws dropped after planning; no stage outlives prepare().
+    async_layer_jobs.wait_all();
 
     std::stable_sort(
         m_rhi_state->prepared_draws.begin(),
@@ -1853,6 +2698,25 @@ void Series_renderer::prepare(
             return a.insertion_order < b.insertion_order;
         });
 
+    if (ctx.config && ctx.config->batch_series_draws) {
+        rhi_prepare_draw_batches(ctx);
+    }
+    else {
+        m_rhi_state->draw_batches.clear();
+    }
+    // Uploads deferred for batching: only views that still record a draw of
+    // their own need their VBO written.
+    for (auto& command : m_rhi_state->prepared_draws) {
+        if (command.batched || !command.view_state) {
+            continue;
+        }
+        const std::size_t flushed_bytes = rhi_flush_sample_upload(ctx, *command.view_state);
+        if (flushed_bytes > 0) {
+            frame_sample_upload_bytes += flushed_bytes;
+            ++frame_sample_upload_count;
+        }
+    }
+
     if (profiler) {
         profiler->record_observation(
             "renderer.frame.uploaded_sample_bytes",
@@ -1866,32 +2730,32 @@ void Series_renderer::prepare(
         profiler->record_observation(
             "renderer.frame.upload.primary_count",
             static_cast<double>(frame_sample_upload_count));
-        profiler->record_observation(
-            "renderer.frame.upload.line_window_bytes",
-            static_cast<double>(frame_line_window_upload_bytes));
-        profiler->record_observation(
-            "renderer.frame.upload.line_window_count",
-            static_cast<double>(frame_line_window_upload_count));
         profiler->record_observation(
             "renderer.frame.upload.uniform_bytes",
             static_cast<double>(frame_uniform_upload_bytes));
         profiler->record_observation(
             "renderer.frame.upload.uniform_count",
             static_cast<double>(frame_uniform_upload_count));
+        profiler->record_observation(
+            "renderer.frame.upload.density_bytes",
+            static_cast<double>(frame_density_upload_bytes));
+        profiler->record_observation(
+            "renderer.frame.upload.density_count",
+            static_cast<double>(frame_density_upload_count));
         profiler->record_observation("renderer.frame.upload.known_custom_bytes", 0.0);
         profiler->record_observation("renderer.frame.upload.known_custom_count", 0.0);
         profiler->record_observation(
             "renderer.frame.upload.total_bytes",
             static_cast<double>(
                 frame_sample_upload_bytes +
-                frame_line_window_upload_bytes +
-                frame_uniform_upload_bytes));
+                frame_uniform_upload_bytes +
+                frame_density_upload_bytes));
         profiler->record_observation(
             "renderer.frame.upload.total_count",
             static_cast<double>(
                 frame_sample_upload_count +
-                frame_line_window_upload_count +
-                frame_uniform_upload_count));
+                frame_uniform_upload_count +
+                frame_density_upload_count));
     }
 
     const auto qrhi_layer_still_configured =
@@ -1970,28 +2834,152 @@ void Series_renderer::prepare(
         it = m_rhi_state->view_ubos.erase(it);
     }
 
+    enforce_gpu_buffer_budget(ctx);
+
+    // Plot_config::adaptive_lod_budget_ms: the next frame's LOD bias
+    // follows this one's prepare time while the main view moves.
+    const double prepare_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - prepare_start).count();
+    const bool view_moved =
+        ctx.t0               != m_lod_bias_t0 ||
+        ctx.t1               != m_lod_bias_t1 ||
+        layout.usable_width  != m_lod_bias_width_px;
+    m_lod_bias_t0       = ctx.t0;
+    m_lod_bias_t1       = ctx.t1;
+    m_lod_bias_width_px = layout.usable_width;
+    const double lod_budget_ms = ctx.config ? ctx.config->adaptive_lod_budget_ms : 0.0;
+    m_lod_bias = detail::next_adaptive_lod_bias(
+        m_lod_bias,
+        prepare_ms,
+        lod_budget_ms,
+        ctx.config ? ctx.config->adaptive_lod_max_bias : 0.0,
+        view_moved);
+    if (profiler && lod_budget_ms > 0.0) {
+        profiler->record_observation(
+            "renderer.frame.lod_bias",
+            std::log2(lod_pps_target));
+        if (lod_pps_target > 1.0) {
+            profiler->record_counter("renderer.frame.lod_biased_count");
+        }
+    }
+
     m_rhi_state->frame_plan_ready = true;
 }
 
-void Series_renderer::render(
-    const frame_context_t& ctx,
-    const std::map<int, std::shared_ptr<const series_data_t>>&
-                           series)
+void Series_renderer::enforce_gpu_buffer_budget(const frame_context_t& ctx)
 {
-    if (!ctx.rhi) {
-        prepare(ctx, series);
-        m_rhi_state->pending_updates = nullptr;
-        m_rhi_state->frame_draw_states.clear();
-        m_rhi_state->prepared_draws.clear();
-        m_rhi_state->frame_plan_ready = false;
-        clear_frame_snapshot_caches();
-        return;
-    }
-
-    if (!ctx.rhi || !ctx.cb || !m_rhi_state->frame_plan_ready) {
+    const std::size_t budget   = ctx.config ? ctx.config->gpu_buffer_budget_bytes : 0u;
+    Profiler*         profiler = ctx.config ? ctx.config->profiler.get() : nullptr;
+    if (budget == 0 && !profiler) {
         return;
     }
 
+    using srb_entry_t = vbo_view_state_t::rhi_buffers_t::srb_entry_t;
+    const auto ubo_bytes = [](const srb_entry_t& entry) -> std::size_t {
+        return entry.ubo ? entry.ubo_capacity_bytes : 0u;
+    };
+    const auto view_bytes = [&](const vbo_view_state_t& view) -> std::size_t {
+        if (!view.rhi) {
+            return 0;
+        }
+        const auto& buffers = *view.rhi;
+        std::size_t bytes   = buffers.vbo ? view.rhi_vbo_capacity_bytes : 0u;
+        bytes += ubo_bytes(buffers.dots_srb);
+        bytes += ubo_bytes(buffers.line_srb);
+        bytes += ubo_bytes(buffers.stack_sum_line_srb);
+        bytes += ubo_bytes(buffers.area_fill_srb);
+        bytes += ubo_bytes(buffers.density_srb);
+        if (buffers.density_texture) {
+            bytes += buffers.density_width * buffers.density_height * 4u;
+        }
+        return bytes;
+    };
+
+    // Batch buffers belong to this frame's draws and are never released.
+    std::size_t resident_bytes = 0;
+    for (const auto& batch : m_rhi_state->draw_batches) {
+        resident_bytes += batch.vbo ? batch.vbo_capacity_bytes : 0u;
+        resident_bytes += ubo_bytes(batch.uniforms);
+    }
+
+    struct candidate_t
+    {
+        std::uint64_t  last_drawn_frame = 0;
+        std::size_t    bytes            = 0;
+        vbo_state_t*   state            = nullptr;
+    };
+    std::vector<candidate_t> candidates;
+    for (auto& [_, state] : m_vbo_states) {
+        const std::size_t bytes = view_bytes(state.main_view) + view_bytes(state.preview_view);
+        resident_bytes += bytes;
+        if (bytes > 0 && state.last_drawn_frame != m_frame_id) {
+            candidates.push_back({state.last_drawn_frame, bytes, &state});
+        }
+    }
+
+    std::size_t evicted_count = 0;
+    std::size_t evicted_bytes = 0;
+    if (budget > 0 && resident_bytes > budget) {
+        std::sort(candidates.begin(), candidates.end(),
+            [](const candidate_t& a, const candidate_t& b) {
+                return a.last_drawn_frame < b.last_drawn_frame;
+            });
+        for (const candidate_t& candidate : candidates) {
+            if (resident_bytes <= budget) {
+                break;
+            }
+            // Both views go together: a preview view may borrow the main
+            // view's sample buffer.
+            candidate.state->main_view.reset();
+            candidate.state->preview_view.reset();
+            resident_bytes -= candidate.bytes;
+            evicted_bytes  += candidate.bytes;
+            ++evicted_count;
+        }
+    }
+
+    if (profiler) {
+        profiler->record_observation(
+            "renderer.frame.gpu_resident_bytes",
+            static_cast<double>(resident_bytes));
+        if (evicted_count > 0) {
+            profiler->record_counter("renderer.frame.gpu_budget_eviction_count");
+            profiler->record_observation(
+                "renderer.frame.gpu_budget_evicted_series",
+                static_cast<double>(evicted_count));
+            profiler->record_observation(
+                "renderer.frame.gpu_budget_evicted_bytes",
+                static_cast<double>(evicted_bytes));
+        }
+        if (budget > 0 && resident_bytes > budget) {
+            profiler->record_counter("renderer.frame.gpu_budget_exceeded_count");
+        }
+    }
+}
+
+void Series_renderer::render(
+    const frame_context_t& ctx,
+    const std::map<int, std::shared_ptr<const series_data_t>>&
+                           series)
+{
+    if (!ctx.rhi) {
+        prepare(ctx, series);
+        m_rhi_state->pending_updates = nullptr;
+        m_rhi_state->frame_draw_states.clear();
+        m_rhi_state->prepared_draws.clear();
+        m_rhi_state->frame_plan_ready = false;
+        clear_frame_snapshot_caches();
+        return;
+    }
+
+    if (!ctx.rhi || !ctx.cb || !m_rhi_state->frame_plan_ready) {
+        return;
+    }
+
+    const double redraw_x0 = std::clamp(
+        std::floor(ctx.main_redraw_x0),
+        0.0,
+        std::max(0.0, ctx.layout.usable_width - 1.0));
     const auto apply_band_scissor = [&](const sample_window_t& window) {
         const auto to_scissor_y = [&](double top, double height) -> int {
             return static_cast<int>(std::lround(double(ctx.win_h) - (top + height)));
@@ -2005,12 +2993,66 @@ void Series_renderer::render(
             return;
         }
         ctx.cb->setScissor(QRhiScissor(
-            0,
+            static_cast<int>(redraw_x0),
             to_scissor_y(0.0, ctx.layout.usable_height),
-            static_cast<int>(std::max(1.0, ctx.layout.usable_width)),
+            static_cast<int>(std::max(1.0, ctx.layout.usable_width - redraw_x0)),
             static_cast<int>(std::max(1.0, ctx.layout.usable_height))));
     };
 
+    // Plot_config::scroll_blit: a main view drawn into a partly kept body
+    // skips the GPU slots left of the redrawn strip. Lines keep the segment
+    // that enters the strip; `pad_px` covers line width and dot size.
+    const float pad_px = ctx.config
+        ? static_cast<float>(std::max(ctx.config->line_width_px, ctx.config->point_diameter_px)) + 1.0f
+        : 1.0f;
+    std::vector<builtin_segment_span_t> clipped_spans;
+    const auto clip_to_redraw = [&](const rhi_state_t::prepared_draw_command_t& command)
+        -> const std::vector<builtin_segment_span_t>*
+    {
+        const sample_window_t& window = command.window;
+        const auto* view_state = command.view_state;
+        const double cut_x = redraw_x0 - std::max(pad_px, command.line_width_px);
+        if (cut_x <= 0.0                                   ||
+            window.view_kind != Series_view_kind::MAIN     ||
+            !view_state                                    ||
+            window.width_px <= 0.0f                        ||
+            window.t_max_ns <= window.t_min_ns             ||
+            view_state->staging.size() < window.gpu_count)
+        {
+            return nullptr;
+        }
+        const auto cut_ns = window.t_min_ns + static_cast<std::int64_t>(
+            cut_x / double(window.width_px) * double(window.t_max_ns - window.t_min_ns));
+        const float cut_t_rel = detail::to_view_seconds(cut_ns, window.t_origin_ns);
+        const auto& staging = view_state->staging;
+        const auto first_at_or_after_cut = [&](std::size_t first, std::size_t end) {
+            return static_cast<std::size_t>(std::partition_point(
+                staging.begin() + static_cast<std::ptrdiff_t>(first),
+                staging.begin() + static_cast<std::ptrdiff_t>(end),
+                [&](const gpu_sample_t& sample) { return sample.t_rel < cut_t_rel; }) -
+                staging.begin());
+        };
+
+        clipped_spans.clear();
+        if (command.primitive_style == Display_style::DOTS) {
+            const std::size_t first = first_at_or_after_cut(0, window.gpu_count);
+            clipped_spans.push_back({first, window.gpu_count - first});
+            return &clipped_spans;
+        }
+        for (const builtin_segment_span_t& span : command.builtin_segment_spans) {
+            const std::size_t end = span.gpu_first + span.gpu_count;
+            if (span.gpu_count < 2 || end > window.gpu_count) {
+                return nullptr;
+            }
+            const std::size_t cut   = first_at_or_after_cut(span.gpu_first, end);
+            const std::size_t first = std::max(span.gpu_first, cut > 0 ? cut - 1u : 0u);
+            if (end - first >= 2) {
+                clipped_spans.push_back({first, end - first});
+            }
+        }
+        return &clipped_spans;
+    };
+
     for (auto& command : m_rhi_state->prepared_draws) {
         apply_band_scissor(command.window);
         m_last_recorded_draw_z_orders.push_back(command.z_order);
@@ -2025,17 +3067,31 @@ void Series_renderer::render(
         m_last_recorded_draw_colors.push_back(command.draw_color);
         m_last_recorded_line_widths.push_back(command.line_width_px);
 
+        if (command.batched) {
+            if (command.batch_head) {
+                rhi_record_draw_batch(ctx, command.batch_index);
+            }
+            continue;
+        }
+
         if (command.kind ==
             rhi_state_t::prepared_draw_command_t::kind_t::BUILTIN)
         {
+            if (command.view_state &&
+                command.primitive_style == Display_style::DENSITY)
+            {
+                rhi_record_series_density(ctx, *command.view_state);
+            }
+            else
             if (command.view_state) {
+                const auto* clipped = clip_to_redraw(command);
                 rhi_record_series_primitive(
                     ctx,
                     command.primitive_style,
                     *command.view_state,
                     command.window,
                     command.stack_sum_overlay,
-                    command.builtin_segment_spans);
+                    clipped ? *clipped : command.builtin_segment_spans);
             }
             continue;
         }
@@ -2061,9 +3117,10 @@ void Series_renderer::render(
 }
 
 bool Series_renderer::rhi_prepare_series_view_samples(
-    const frame_context_t& ctx,
-    vbo_view_state_t&      view_state,
-    const sample_window_t& window)
+    const frame_context_t&             ctx,
+    vbo_view_state_t&                  view_state,
+    const sample_window_t&             window,
+    const std::vector<std::size_t>*    gpu_source_indices)
 {
     QRhi* rhi = ctx.rhi;
     QRhiResourceUpdateBatch* updates = ctx.rhi_updates;
@@ -2077,17 +3134,26 @@ bool Series_renderer::rhi_prepare_series_view_samples(
         view_state.staging.clear();
         view_state.last_staged_sample_count      = 0;
         view_state.last_sample_upload_bytes      = 0;
-        view_state.last_line_window_upload_bytes = 0;
-        view_state.last_line_window_upload_count = 0;
         view_state.last_uniform_upload_bytes     = 0;
         view_state.last_uniform_upload_count     = 0;
-        view_state.last_line_window_sample_count = 0;
         view_state.last_prepared_t_min_ns        = 0;
         view_state.last_prepared_t_max_ns        = 0;
         view_state.last_prepared_width_px        = 0.0;
         view_state.last_sample_buffer            = nullptr;
-        view_state.line_window_geometry_dirty    = true;
-        view_state.line_draw_spans.clear();
+        view_state.m4_source_indices.clear();
+        view_state.m4_spans.clear();
+        view_state.m4_plan_spans.clear();
+        view_state.m4_dots_key.clear();
+        view_state.m4_gpu_count = 0;
+        view_state.sample_base  = 0;
+        view_state.stream_valid = false;
+        view_state.samples_shared           = false;
+        view_state.samples_borrowed         = false;
+        view_state.shared_upload_generation = 0;
+        view_state.sample_upload_pending    = false;
+        if (view_state.rhi) {
+            view_state.rhi->borrowed_vbo = nullptr;
+        }
     };
 
     if (window.gpu_count == 0) {
@@ -2117,7 +3183,8 @@ bool Series_renderer::rhi_prepare_series_view_samples(
         if (window.synthetic_hold_count > 1              ||
             window.drawable_spans.empty()                ||
             window.source_first         > snapshot.count ||
-            window.source_count         > snapshot.count - window.source_first)
+            window.source_count         > snapshot.count - window.source_first ||
+            (gpu_source_indices && gpu_source_indices->size() != window.gpu_count))
         {
             invalidate_uploaded_vbo();
             return false;
@@ -2133,7 +3200,9 @@ bool Series_renderer::rhi_prepare_series_view_samples(
                 window.drawable_spans[span_index];
             const bool final_span =
                 span_index + 1u == window.drawable_spans.size();
-            if (span.source_count == 0               || span.gpu_count < span.source_count                     ||
+            const bool undecimated_slots_missing =
+                !gpu_source_indices && span.gpu_count < span.source_count;
+            if (span.source_count == 0               || undecimated_slots_missing                              ||
                 span.gpu_first != expected_gpu_count || span.source_first < window.source_first                ||
                 span.source_first >  snapshot.count  || span.source_count > snapshot.count - span.source_first ||
                 span.source_first + span.source_count >  window.source_first + window.source_count)
@@ -2142,17 +3211,45 @@ bool Series_renderer::rhi_prepare_series_view_samples(
                 return false;
             }
 
-            const bool has_synthetic_hold =
-                final_span                               &&
-                window.synthetic_hold_count == 1         &&
-                span.gpu_count == span.source_count + 1u;
-            if (has_synthetic_hold) {
-                synthetic_hold_seen = true;
+            if (gpu_source_indices) {
+                // Decimated span: every real slot maps to a strictly
+                // increasing source index inside the span.
+                const bool        hold_span  = final_span && window.synthetic_hold_count == 1;
+                const std::size_t real_slots = span.gpu_count - (hold_span ? 1u : 0u);
+                std::size_t       next_index = span.source_first;
+                if (span.gpu_count == 0                             ||
+                    real_slots     == 0                             ||
+                    span.gpu_first >  gpu_source_indices->size()    ||
+                    span.gpu_count >  gpu_source_indices->size() - span.gpu_first)
+                {
+                    invalidate_uploaded_vbo();
+                    return false;
+                }
+                for (std::size_t i = 0; i < real_slots; ++i) {
+                    const std::size_t source_index = (*gpu_source_indices)[span.gpu_first + i];
+                    if (source_index <  next_index ||
+                        source_index >= span.source_first + span.source_count)
+                    {
+                        invalidate_uploaded_vbo();
+                        return false;
+                    }
+                    next_index = source_index + 1u;
+                }
+                synthetic_hold_seen = synthetic_hold_seen || hold_span;
             }
-            else
-            if (span.gpu_count != span.source_count) {
-                invalidate_uploaded_vbo();
-                return false;
+            else {
+                const bool has_synthetic_hold =
+                    final_span                               &&
+                    window.synthetic_hold_count == 1         &&
+                    span.gpu_count == span.source_count + 1u;
+                if (has_synthetic_hold) {
+                    synthetic_hold_seen = true;
+                }
+                else
+                if (span.gpu_count != span.source_count) {
+                    invalidate_uploaded_vbo();
+                    return false;
+                }
             }
 
             if (!detail::checked_size_add(
@@ -2180,8 +3277,42 @@ bool Series_renderer::rhi_prepare_series_view_samples(
             return false;
         }
 
+        const bool streaming = ctx.config && ctx.config->streaming_sample_buffers;
+        const drawable_sample_span_t& first_span = window.drawable_spans.front();
+        const bool stream_eligible =
+            streaming                                      &&
+            !gpu_source_indices                            &&
+            !window.stacked                                &&
+            window.drawable_spans.size() == 1              &&
+            first_span.source_first == window.source_first &&
+            first_span.source_count == window.source_count;
+
+        // Plot_config::gpu_buffer_shrink_frames: a buffer that has long been
+        // much larger than its uploads is dropped here and reallocated at
+        // the current size below.
+        const std::uint32_t shrink_frames = ctx.config ? ctx.config->gpu_buffer_shrink_frames : 0u;
+        if (!view_state.rhi->vbo ||
+            shrink_frames == 0   ||
+            view_state.rhi_vbo_capacity_bytes / 4u < needed_bytes)
+        {
+            view_state.rhi_vbo_underused_since_frame = 0;
+        }
+        else
+        if (view_state.rhi_vbo_underused_since_frame == 0) {
+            view_state.rhi_vbo_underused_since_frame = m_frame_id;
+        }
+        else
+        if (m_frame_id - view_state.rhi_vbo_underused_since_frame >= shrink_frames) {
+            view_state.rhi->vbo.reset();
+            view_state.rhi_vbo_capacity_bytes        = 0;
+            view_state.rhi_vbo_dynamic               = false;
+            view_state.rhi_vbo_underused_since_frame = 0;
+            if (ctx.config->profiler) {
+                ctx.config->profiler->record_counter("renderer.frame.gpu_buffer_shrink_count");
+            }
+        }
+
         auto& staging = view_state.staging;
-        staging.resize(needed_elements);
 
         const auto stage_one_sample =
             [&](gpu_sample_t& dst, const void* src, std::int64_t ts_ns) {
@@ -2201,50 +3332,184 @@ bool Series_renderer::rhi_prepare_series_view_samples(
                 return true;
             };
 
-        for (const drawable_sample_span_t& span : window.drawable_spans) {
-            for (std::size_t i = 0; i < span.source_count; ++i) {
-                const std::size_t source_index = span.source_first + i;
-                const void*       src          = snapshot.at(source_index);
-                if (!src ||
-                    !stage_one_sample(
-                        staging[span.gpu_first + i], src, access_view.timestamp(src)))
-                {
-                    invalidate_uploaded_vbo();
-                    return false;
+        // Every drawable span owns the output slots [gpu_first, gpu_first +
+        // gpu_count), so any gpu-index range can be staged independently of
+        // the others. Spans were validated above to tile [0, gpu_count).
+        const auto stage_gpu_range = [&](std::size_t gpu_begin, std::size_t gpu_end) {
+            auto span_it = std::upper_bound(
+                window.drawable_spans.begin(),
+                window.drawable_spans.end(),
+                gpu_begin,
+                [](std::size_t gpu_index, const drawable_sample_span_t& span) {
+                    return gpu_index < span.gpu_first;
+                });
+            --span_it;
+            for (; span_it != window.drawable_spans.end() && span_it->gpu_first < gpu_end; ++span_it) {
+                const drawable_sample_span_t& span  = *span_it;
+                const std::size_t             first = std::max(gpu_begin, span.gpu_first) - span.gpu_first;
+                const std::size_t             last  =
+                    std::min(gpu_end, span.gpu_first + span.gpu_count) - span.gpu_first;
+                const bool hold_span =
+                    &span == &window.drawable_spans.back() && window.synthetic_hold_count == 1;
+                const std::size_t real_slots = gpu_source_indices
+                    ? span.gpu_count - (hold_span ? 1u : 0u)
+                    : span.source_count;
+                for (std::size_t i = first; i < last; ++i) {
+                    gpu_sample_t& dst = staging[span.gpu_first + i];
+                    if (i < real_slots) {
+                        const std::size_t source_index = gpu_source_indices
+                            ? (*gpu_source_indices)[span.gpu_first + i]
+                            : span.source_first + i;
+                        const void* src = snapshot.at(source_index);
+                        if (!src || !stage_one_sample(dst, src, access_view.timestamp(src))) {
+                            return false;
+                        }
+                        continue;
+                    }
+
+                    // Synthetic hold slot: the last source sample repeated at
+                    // the hold timestamp.
+                    const void* source_sample =
+                        snapshot.at(span.source_first + span.source_count - 1u);
+                    if (!source_sample ||
+                        !stage_one_sample(dst, source_sample, window.hold_timestamp_ns))
+                    {
+                        return false;
+                    }
                 }
             }
-            if (span.gpu_count == span.source_count + 1u) {
-                const std::size_t source_index =
-                    span.source_first + span.source_count - 1u;
-                const void* source_sample = snapshot.at(source_index);
-                if (!source_sample ||
-                    !stage_one_sample(
-                        staging[span.gpu_first + span.gpu_count - 1u],
-                        source_sample, window.hold_timestamp_ns))
+            return true;
+        };
+
+        // A streaming window that only dropped leading samples and appended
+        // new ones keeps its uploaded prefix. The previous last real sample
+        // is located by timestamp, and it and the window's first sample must
+        // stage to the bytes already uploaded for them.
+        std::size_t kept_count    = 0;
+        std::size_t dropped_count = 0;
+        if (stream_eligible                                       &&
+            view_state.stream_valid                               &&
+            view_state.rhi_vbo_dynamic                            &&
+            view_state.rhi->vbo                                   &&
+            view_state.stream_t_origin_ns      == window.t_origin_ns      &&
+            view_state.stream_lod_level        == window.lod_level        &&
+            view_state.stream_access           == window.access           &&
+            view_state.stream_nonfinite_policy == window.nonfinite_policy &&
+            view_state.stream_real_count       >  0                       &&
+            view_state.stream_real_count       <= staging.size())
+        {
+            std::size_t first = 0;
+            std::size_t last  = window.source_count;
+            while (first < last) {
+                const std::size_t middle = first + (last - first) / 2u;
+                const void*       sample = snapshot.at(window.source_first + middle);
+                if (!sample) {
+                    first = last = 0;
+                    break;
+                }
+                if (view_state.stream_last_timestamp_ns < access_view.timestamp(sample)) {
+                    last = middle;
+                }
+                else {
+                    first = middle + 1u;
+                }
+            }
+
+            gpu_sample_t anchor;
+            const void*  last_kept = first > 0
+                ? snapshot.at(window.source_first + first - 1u)
+                : nullptr;
+            if (last_kept                                                         &&
+                first <= view_state.stream_real_count                             &&
+                access_view.timestamp(last_kept) == view_state.stream_last_timestamp_ns &&
+                stage_one_sample(anchor, last_kept, view_state.stream_last_timestamp_ns) &&
+                std::memcmp(&anchor, &staging[view_state.stream_real_count - 1u],
+                    sizeof(gpu_sample_t)) == 0)
+            {
+                const std::size_t dropped    = view_state.stream_real_count - first;
+                const void*       first_kept = snapshot.at(window.source_first);
+                if (first_kept &&
+                    stage_one_sample(anchor, first_kept, access_view.timestamp(first_kept)) &&
+                    std::memcmp(&anchor, &staging[dropped], sizeof(gpu_sample_t)) == 0)
                 {
-                    invalidate_uploaded_vbo();
-                    return false;
+                    kept_count    = first;
+                    dropped_count = dropped;
                 }
             }
         }
 
+        const std::size_t capacity_elements = view_state.rhi_vbo_dynamic
+            ? view_state.rhi_vbo_capacity_bytes / sizeof(gpu_sample_t)
+            : 0;
+        std::size_t stream_end = 0;
+        const bool  appending  =
+            kept_count > 0 &&
+            detail::checked_size_add(
+                view_state.sample_base + dropped_count, needed_elements, stream_end) &&
+            stream_end <= capacity_elements;
+        if (appending) {
+            staging.drop_front(dropped_count);
+        }
+        else {
+            kept_count = 0;
+            staging.clear();
+        }
+        staging.resize(needed_elements);
+
+        // Large windows (e.g. a zoom-out over raw LOD 0 data) are staged on
+        // several threads. Accessors only read the pinned snapshot, so they
+        // are called concurrently from the staging threads.
+        std::atomic<bool> staging_failed{false};
+        const std::size_t staging_range_count = detail::parallel_for_ranges(
+            needed_elements - kept_count,
+            k_parallel_staging_min_samples_per_range,
+            [&](std::size_t, std::size_t gpu_begin, std::size_t gpu_end) {
+                if (!stage_gpu_range(kept_count + gpu_begin, kept_count + gpu_end)) {
+                    staging_failed.store(true, std::memory_order_relaxed);
+                }
+            });
+        if (staging_failed.load(std::memory_order_relaxed)) {
+            invalidate_uploaded_vbo();
+            return false;
+        }
+        view_state.staging_revision = ++m_rhi_state->staging_revision;
+        if (staging_range_count > 1 && ctx.config && ctx.config->profiler) {
+            ctx.config->profiler->record_counter(
+                "renderer.frame.parallel_staging_count");
+            ctx.config->profiler->record_observation(
+                "renderer.frame.parallel_staging_ranges",
+                static_cast<double>(staging_range_count));
+        }
+
+        // Streaming buffers reserve room for the window to slide by its own
+        // length before they are compacted.
+        std::size_t requested_bytes = needed_bytes;
+        if (streaming) {
+            requested_bytes = std::min<std::size_t>(
+                needed_bytes > std::numeric_limits<std::size_t>::max() / 2u
+                    ? needed_bytes
+                    : needed_bytes * 2u,
+                std::numeric_limits<quint32>::max());
+        }
         std::size_t alloc_bytes      = 0;
         quint32     qrhi_alloc_bytes = 0;
         if (!detail::qrhi_grown_capacity_bytes(
-                needed_bytes, alloc_bytes, qrhi_alloc_bytes))
+                requested_bytes, alloc_bytes, qrhi_alloc_bytes))
         {
             invalidate_uploaded_vbo();
             return false;
         }
-        if (!view_state.rhi->vbo ||
-            view_state.rhi_vbo_capacity_bytes < needed_bytes)
+        if (!view_state.rhi->vbo                             ||
+            view_state.rhi_vbo_capacity_bytes < needed_bytes ||
+            view_state.rhi_vbo_dynamic        != streaming)
         {
             view_state.rhi->vbo.reset(rhi->newBuffer(
-                QRhiBuffer::Static,
+                streaming ? QRhiBuffer::Dynamic : QRhiBuffer::Static,
                 QRhiBuffer::VertexBuffer,
                 qrhi_alloc_bytes));
             if (view_state.rhi->vbo && view_state.rhi->vbo->create()) {
                 view_state.rhi_vbo_capacity_bytes = alloc_bytes;
+                view_state.rhi_vbo_dynamic        = streaming;
                 ++view_state.last_vbo_generation;
                 if (ctx.config && ctx.config->profiler) {
                     ctx.config->profiler->record_observation(
@@ -2257,18 +3522,89 @@ bool Series_renderer::rhi_prepare_series_view_samples(
             else {
                 view_state.rhi->vbo.reset();
                 view_state.rhi_vbo_capacity_bytes = 0;
+                view_state.rhi_vbo_dynamic        = false;
                 invalidate_uploaded_vbo();
                 return false;
             }
         }
-        updates->uploadStaticBuffer(
-            view_state.rhi->vbo.get(),
-            0,
-            upload_bytes,
-            staging.data());
+
+        if (!streaming) {
+            view_state.sample_base = 0;
+            if (view_state.defer_sample_upload) {
+                // Batched draws pack from staging; the VBO is only written if
+                // the view ends up drawing on its own.
+                view_state.sample_upload_pending    = true;
+                view_state.last_sample_upload_bytes = 0;
+            }
+            else {
+                updates->uploadStaticBuffer(
+                    view_state.rhi->vbo.get(),
+                    0,
+                    upload_bytes,
+                    staging.data());
+                view_state.sample_upload_pending    = false;
+                view_state.last_sample_upload_bytes = upload_bytes;
+            }
+        }
+        else {
+            // Dynamic buffers keep one copy per frame in flight; QRhi applies
+            // each region update to every copy, so a partial write is safe.
+            view_state.sample_base = appending
+                ? view_state.sample_base + dropped_count
+                : 0;
+            quint32 write_offset = 0;
+            quint32 write_bytes  = 0;
+            if (!detail::qrhi_buffer_offset(
+                    view_state.sample_base + kept_count, sizeof(gpu_sample_t), write_offset) ||
+                !detail::qrhi_byte_size(
+                    needed_elements - kept_count, sizeof(gpu_sample_t), write_bytes))
+            {
+                invalidate_uploaded_vbo();
+                return false;
+            }
+            if (write_bytes > 0) {
+                updates->updateDynamicBuffer(
+                    view_state.rhi->vbo.get(),
+                    write_offset,
+                    write_bytes,
+                    staging.data() + kept_count);
+            }
+            view_state.sample_upload_pending    = false;
+            view_state.last_sample_upload_bytes = write_bytes;
+            if (ctx.config && ctx.config->profiler) {
+                if (appending) {
+                    ctx.config->profiler->record_counter(
+                        "renderer.frame.sample_stream_append_count");
+                    ctx.config->profiler->record_observation(
+                        "renderer.frame.sample_stream_reused_samples",
+                        static_cast<double>(kept_count));
+                }
+                else
+                if (view_state.stream_valid && stream_eligible) {
+                    ctx.config->profiler->record_counter(
+                        "renderer.frame.sample_stream_rewrite_count");
+                }
+            }
+        }
+
+        view_state.stream_valid = false;
+        if (stream_eligible) {
+            const void* last_real =
+                snapshot.at(window.source_first + window.source_count - 1u);
+            if (last_real) {
+                view_state.stream_valid             = true;
+                view_state.stream_real_count        = window.source_count;
+                view_state.stream_last_timestamp_ns = access_view.timestamp(last_real);
+                view_state.stream_t_origin_ns       = window.t_origin_ns;
+                view_state.stream_lod_level         = window.lod_level;
+                view_state.stream_access            = window.access;
+                view_state.stream_nonfinite_policy  = window.nonfinite_policy;
+            }
+        }
         view_state.last_staged_sample_count = needed_elements;
-        view_state.last_sample_upload_bytes = upload_bytes;
-        ++view_state.last_sample_upload_count;
+        if (!view_state.sample_upload_pending) {
+            ++view_state.last_sample_upload_count;
+        }
         view_state.has_uploaded_vbo = true;
     }
 
@@ -2282,6 +3618,37 @@ bool Series_renderer::rhi_prepare_series_view_samples(
     return true;
 }
 
+std::size_t Series_renderer::rhi_flush_sample_upload(
+    const frame_context_t&             ctx,
+    vbo_view_state_t&                  view_state)
+{
+    if (!view_state.sample_upload_pending) {
+        return 0;
+    }
+    view_state.sample_upload_pending = false;
+
+    std::size_t needed_bytes = 0;
+    quint32     upload_bytes = 0;
+    if (!ctx.rhi_updates     ||
+        !view_state.rhi      ||
+        !view_state.rhi->vbo ||
+        !detail::qrhi_byte_size(
+            view_state.staging.size(), sizeof(gpu_sample_t), needed_bytes, upload_bytes) ||
+        needed_bytes > view_state.rhi_vbo_capacity_bytes)
+    {
+        view_state.has_uploaded_vbo = false;
+        return 0;
+    }
+    ctx.rhi_updates->uploadStaticBuffer(
+        view_state.rhi->vbo.get(),
+        0,
+        upload_bytes,
+        view_state.staging.data());
+    view_state.last_sample_upload_bytes = upload_bytes;
+    ++view_state.last_sample_upload_count;
+    return upload_bytes;
+}
+
 bool Series_renderer::rhi_prepare_series_primitive(
     const frame_context_t&                         ctx,
     Display_style                                  primitive_style,
@@ -2326,6 +3693,10 @@ bool Series_renderer::rhi_prepare_series_primitive(
         m_rhi_state->cached_line_frag = load_qsb("plot_line.frag.qsb");
         m_rhi_state->cached_area_vert = load_qsb("plot_area.vert.qsb");
         m_rhi_state->cached_area_frag = load_qsb("plot_area.frag.qsb");
+        m_rhi_state->cached_dot_batch_vert  = load_qsb("plot_dot_quad_batch.vert.qsb");
+        m_rhi_state->cached_dot_batch_frag  = load_qsb("plot_dot_quad_batch.frag.qsb");
+        m_rhi_state->cached_line_batch_vert = load_qsb("plot_line_batch.vert.qsb");
+        m_rhi_state->cached_line_batch_frag = load_qsb("plot_line_batch.frag.qsb");
         m_rhi_state->shaders_loaded   = true;
     }
 
@@ -2379,167 +3750,10 @@ bool Series_renderer::rhi_prepare_series_primitive(
         return false;
     }
 
-    if (!view_state.rhi->vbo) {
+    if (!view_state.rhi->sample_vbo()) {
         return false;
     }
 
-    // LINE under RHI feeds the vertex shader through four per-instance
-    // vertex attributes (prev, p0, p1, next) sourced from a dedicated
-    // per-frame buffer with the active sample window padded by leading and
-    // trailing duplicates: [s[first], s[first], s[first+1], ..., s[last],
-    // s[last]]. The buffer is bound four times at element offsets 0, 1, 2, 3,
-    // so instance i sees (padded[i], padded[i+1],
-    // padded[i+2], padded[i+3]) which collapses to the desired clamping at
-    // the window edges. SSBOs are unusable here because SPIRV-Cross emits
-    // them as RWByteAddressBuffer UAVs and D3D11 SM 5.0 vertex shaders
-    // accept zero UAVs; QRhi requires HLSL 5.0 bytecode for D3D11, so any
-    // storage-buffer access in the vertex stage fails to compile.
-    const bool line_geometry_current =
-        !view_state.line_window_geometry_dirty &&
-        view_state.rhi->line_window_vbo        &&
-        !view_state.line_draw_spans.empty();
-    if (!is_dots && !is_area && !line_geometry_current) {
-        view_state.line_window_geometry_dirty = true;
-        view_state.line_draw_spans.clear();
-        std::size_t total_window_count = 0;
-        std::size_t total_padded_count = 0;
-        for (const builtin_segment_span_t& span : segment_spans) {
-            std::size_t span_window_count = 0;
-            if (!line_window_sample_count(
-                    span.gpu_count, window.interpolation, span_window_count))
-            {
-                return false;
-            }
-            std::size_t span_padded_count = 0;
-            if (!detail::checked_size_add( span_window_count, 2u, span_padded_count) ||
-                !detail::checked_size_add(
-                    total_window_count, span_window_count, total_window_count)       ||
-                !detail::checked_size_add(
-                    total_padded_count, span_padded_count, total_padded_count))
-            {
-                return false;
-            }
-        }
-        if (total_window_count < 2 || total_padded_count == 0) {
-            return false;
-        }
-
-        std::size_t needed_bytes = 0;
-        quint32     upload_bytes = 0;
-        if (!detail::qrhi_byte_size(
-                total_padded_count, sizeof(gpu_sample_t), needed_bytes, upload_bytes))
-        {
-            return false;
-        }
-        std::size_t alloc_bytes      = 0;
-        quint32     qrhi_alloc_bytes = 0;
-        if (!detail::qrhi_grown_capacity_bytes(
-                needed_bytes, alloc_bytes, qrhi_alloc_bytes))
-        {
-            return false;
-        }
-        if (!view_state.rhi->line_window_vbo ||
-            view_state.rhi_line_window_vbo_capacity_bytes < needed_bytes)
-        {
-            view_state.rhi->line_window_vbo.reset(rhi->newBuffer(
-                QRhiBuffer::Static, QRhiBuffer::VertexBuffer,
-                qrhi_alloc_bytes));
-            if (view_state.rhi->line_window_vbo && view_state.rhi->line_window_vbo->create())
-            {
-                view_state.rhi_line_window_vbo_capacity_bytes = alloc_bytes;
-                if (ctx.config && ctx.config->profiler) {
-                    ctx.config->profiler->record_observation(
-                        "renderer.frame.gpu_buffer_allocation_bytes",
-                        static_cast<double>(alloc_bytes));
-                    ctx.config->profiler->record_counter(
-                        "renderer.frame.gpu_buffer_allocation_count");
-                }
-            }
-            else {
-                view_state.rhi->line_window_vbo.reset();
-                view_state.rhi_line_window_vbo_capacity_bytes = 0;
-                view_state.line_window_geometry_dirty         = true;
-                return false;
-            }
-        }
-        if (updates) {
-            if (view_state.staging.size() < count) {
-                return false;
-            }
-            auto& padded = view_state.line_window_staging;
-            padded.resize(total_padded_count);
-            std::size_t write_idx = 0;
-            for (const builtin_segment_span_t& span : segment_spans) {
-                if (span.gpu_first > view_state.staging.size() ||
-                    span.gpu_count >
-                        view_state.staging.size() - span.gpu_first)
-                {
-                    return false;
-                }
-
-                std::size_t span_window_count = 0;
-                if (!line_window_sample_count(
-                        span.gpu_count, window.interpolation, span_window_count))
-                {
-                    return false;
-                }
-                std::size_t span_padded_count = 0;
-                if (!detail::checked_size_add( span_window_count, 2u, span_padded_count) ||
-                    span_padded_count > total_padded_count - write_idx)
-                {
-                    return false;
-                }
-
-                vbo_view_state_t::line_draw_span_t line_span;
-                line_span.gpu_first  = span.gpu_first;
-                line_span.gpu_count  = span.gpu_count;
-                line_span.line_first = write_idx;
-                line_span.line_count = span_window_count;
-                view_state.line_draw_spans.push_back(line_span);
-
-                const std::size_t span_base = write_idx;
-                const std::size_t span_last =
-                    span.gpu_first + span.gpu_count - 1u;
-                std::size_t span_write = span_base + 1u;
-                padded[span_base] = view_state.staging[span.gpu_first];
-                if (window.interpolation == Series_interpolation::STEP_AFTER) {
-                    padded[span_write++] =
-                        view_state.staging[span.gpu_first];
-                    for (std::size_t i = 1; i < span.gpu_count; ++i) {
-                        const gpu_sample_t previous =
-                            view_state.staging[span.gpu_first + i - 1u];
-                        const gpu_sample_t current =
-                            view_state.staging[span.gpu_first + i];
-                        gpu_sample_t held    = current;
-                        held.y               = previous.y;
-                        held.y_min           = previous.y_min;
-                        held.y_max           = previous.y_max;
-                        padded[span_write++] = held;
-                        padded[span_write++] = current;
-                    }
-                }
-                else {
-                    for (std::size_t i = 0; i < span.gpu_count; ++i) {
-                        padded[span_write++] =
-                            view_state.staging[span.gpu_first + i];
-                    }
-                }
-                padded[span_base + span_padded_count - 1u] =
-                    view_state.staging[span_last];
-                write_idx += span_padded_count;
-            }
-            updates->uploadStaticBuffer(
-                view_state.rhi->line_window_vbo.get(),
-                0,
-                upload_bytes,
-                padded.data());
-            view_state.last_line_window_sample_count = total_window_count;
-            view_state.last_line_window_upload_bytes = upload_bytes;
-            ++view_state.last_line_window_upload_count;
-            view_state.line_window_geometry_dirty = false;
-        }
-    }
-
     // Pipeline cache key: only kind. The pipeline descriptor depends on the
     // shader-resource-binding LAYOUT (which slots, which stages), not on the
     // concrete buffer handles. Per-series binding handles ride the SRB,
@@ -2562,7 +3776,7 @@ bool Series_renderer::rhi_prepare_series_primitive(
     const int                 current_samples = rt->sampleCount();
     if (cached.pipeline && (cached.last_rpd != current_rpd || cached.last_sample_count != current_samples))
     {
-        cached.pipeline.reset();
+        cached.pipeline = nullptr;
     }
 
     if (!cached.pipeline) {
@@ -2615,35 +3829,25 @@ bool Series_renderer::rhi_prepare_series_primitive(
                 a_x1, a_y1, a_min1, a_max1});
         }
         else {
-            // LINE binds the line_window_vbo four times at element offsets 0,
-            // 1, 2, 3. Each binding has stride sizeof(gpu_sample_t)
-            // and steps once per instance, so the bindings form a
-            // sliding (prev, p0, p1, next) window over the padded
-            // sample array. Only the (t_rel, y) pair is consumed by
-            // the LINE vertex shader; the range lanes are left unbound.
+            // LINE binds the compact sample VBO twice, at element offsets i
+            // and i + 1, with per-instance stepping, so each instance reads
+            // one (p0, p1) segment straight from the staged samples. Only the
+            // (t_rel, y) pair is consumed; the range lanes are left unbound.
             const quint32 line_stride =
                 static_cast<quint32>(sizeof(gpu_sample_t));
-            QRhiVertexInputBinding ib_prev(
-                line_stride, QRhiVertexInputBinding::PerInstance, 1);
             QRhiVertexInputBinding ib_p0(
                 line_stride, QRhiVertexInputBinding::PerInstance, 1);
             QRhiVertexInputBinding ib_p1(
                 line_stride, QRhiVertexInputBinding::PerInstance, 1);
-            QRhiVertexInputBinding ib_next(
-                line_stride, QRhiVertexInputBinding::PerInstance, 1);
-            vlayout.setBindings({ib_prev, ib_p0, ib_p1, ib_next});
+            vlayout.setBindings({ib_p0, ib_p1});
 
             const quint32 ty_offset =
                 static_cast<quint32>(offsetof(gpu_sample_t, t_rel));
-            QRhiVertexInputAttribute a_prev(
-                0, 0, QRhiVertexInputAttribute::Float2, ty_offset);
             QRhiVertexInputAttribute a_p0(
-                1, 1, QRhiVertexInputAttribute::Float2, ty_offset);
+                0, 0, QRhiVertexInputAttribute::Float2, ty_offset);
             QRhiVertexInputAttribute a_p1(
-                2, 2, QRhiVertexInputAttribute::Float2, ty_offset);
-            QRhiVertexInputAttribute a_next(
-                3, 3, QRhiVertexInputAttribute::Float2, ty_offset);
-            vlayout.setAttributes({a_prev, a_p0, a_p1, a_next});
+                1, 1, QRhiVertexInputAttribute::Float2, ty_offset);
+            vlayout.setAttributes({a_p0, a_p1});
         }
 
         // RHI series primitives bind only a UBO through the SRB. Sample data
@@ -2657,7 +3861,12 @@ bool Series_renderer::rhi_prepare_series_primitive(
         desc.ubo_stages = QRhiShaderResourceBinding::VertexStage
                         | QRhiShaderResourceBinding::FragmentStage;
         desc.flags      = QRhiGraphicsPipeline::UsesScissor;
-        cached.pipeline = detail::build_alpha_blended_pipeline(rhi, rt, desc);
+        cached.pipeline = m_rhi_state->shared->pipeline(
+            rhi_state_t::pipeline_name(key.kind),
+            rt,
+            [&](QRhiRenderPassDescriptor* target_rpd, int sample_count) {
+                return detail::build_alpha_blended_pipeline(rhi, target_rpd, sample_count, desc);
+            });
         if (!cached.pipeline) {
             return false;
         }
@@ -2696,26 +3905,8 @@ bool Series_renderer::rhi_prepare_series_primitive(
         return false;
     }
 
-    series_view_uniform_std140_t view_block{};
-    std::memcpy(view_block.pmv, glm::value_ptr(ctx.pmv), sizeof(float) * 16);
-
-    view_block.color[0] = draw_color.r;
-    view_block.color[1] = draw_color.g;
-    view_block.color[2] = draw_color.b;
-    view_block.color[3] = draw_color.a;
-
-    view_block.t_min    = detail::to_view_seconds(
-        window.t_min_ns, window.t_origin_ns);
-    view_block.t_max    = detail::to_view_seconds(
-        window.t_max_ns, window.t_origin_ns);
-    view_block.v_min    = window.v_min;
-    view_block.v_max    = window.v_max;
-    view_block.y_offset = window.y_offset_px;
-    view_block.width    = window.width_px;
-    view_block.height   = window.height_px;
-    view_block.win_h    = static_cast<float>(ctx.win_h);
-    view_block.framebuffer_y_up =
-        (ctx.rhi && ctx.rhi->isYUpInFramebuffer()) ? 1 : 0;
+    const series_view_uniform_std140_t view_block =
+        make_view_uniform(ctx, window, draw_color);
 
     if (is_dots) {
         Dot_block_std140 block{};
@@ -2750,6 +3941,8 @@ bool Series_renderer::rhi_prepare_series_primitive(
         block.line_px        = line_width_px;
         block.snap_to_pixels = (ctx.config && ctx.config->snap_lines_to_pixels)
             ? 1 : 0;
+        block.interpolation  =
+            window.interpolation == Series_interpolation::STEP_AFTER ? 1 : 0;
         if (updates) {
             updates->updateDynamicBuffer(
                 primary_srb_entry.ubo.get(), 0, sizeof(block), &block);
@@ -2782,7 +3975,8 @@ void Series_renderer::rhi_record_series_primitive(
         return;
     }
     // segment_spans were computed in rhi_prepare_series_primitive and carried on
-    // the prepared draw command; DOTS pass an empty span list (drawn per-sample).
+    // the prepared draw command; DOTS pass an empty span list (drawn per-sample)
+    // or, in a scroll-blit frame, the one slot range left to draw.
     const bool has_segment_span = !segment_spans.empty();
     if (!is_dots && !has_segment_span) {
         return;
@@ -2814,28 +4008,45 @@ void Series_renderer::rhi_record_series_primitive(
     if (!srb_entry.srb) {
         return;
     }
-    cb->setGraphicsPipeline(cached.pipeline.get());
+    cb->setGraphicsPipeline(cached.pipeline);
 
     if (is_dots) {
+        const builtin_segment_span_t slots = has_segment_span
+            ? segment_spans.front()
+            : builtin_segment_span_t{0, count};
+        if (slots.gpu_first > count ||
+            slots.gpu_count > count - slots.gpu_first)
+        {
+            return;
+        }
+        if (slots.gpu_count == 0) {
+            return;
+        }
         cb->setShaderResources(srb_entry.srb.get());
-        if (view_state.rhi->vbo) {
+        quint32 base_offset = 0;
+        if (!detail::qrhi_buffer_offset(
+                view_state.sample_base + slots.gpu_first, sizeof(gpu_sample_t), base_offset))
+        {
+            return;
+        }
+        if (view_state.rhi->sample_vbo()) {
             QRhiCommandBuffer::VertexInput input{
-                view_state.rhi->vbo.get(), 0u};
+                view_state.rhi->sample_vbo(), base_offset};
             cb->setVertexInput(0, 1, &input);
         }
         quint32 instance_count = 0;
-        if (!detail::to_qrhi_count(count, instance_count)) {
+        if (!detail::to_qrhi_count(slots.gpu_count, instance_count)) {
             return;
         }
         cb->draw(4, instance_count);
-        view_state.last_recorded_dot_sample_count += count;
+        view_state.last_recorded_dot_sample_count += slots.gpu_count;
     }
     else
     if (is_area) {
-        if (!view_state.rhi->vbo) {
+        if (!view_state.rhi->sample_vbo()) {
             return;
         }
-        QRhiBuffer* const vbo = view_state.rhi->vbo.get();
+        QRhiBuffer* const vbo = view_state.rhi->sample_vbo();
         for (const builtin_segment_span_t& span : segment_spans) {
             if (span.gpu_first > count ||
                 span.gpu_count > count - span.gpu_first)
@@ -2845,10 +4056,11 @@ void Series_renderer::rhi_record_series_primitive(
             quint32 instance_count = 0;
             quint32 first_offset   = 0;
             quint32 next_offset    = 0;
-            if (!detail::to_qrhi_count(span.gpu_count - 1u, instance_count)                      ||
-                !detail::qrhi_buffer_offset( span.gpu_first, sizeof(gpu_sample_t), first_offset) ||
+            const std::size_t first = view_state.sample_base + span.gpu_first;
+            if (!detail::to_qrhi_count(span.gpu_count - 1u, instance_count)             ||
+                !detail::qrhi_buffer_offset( first, sizeof(gpu_sample_t), first_offset) ||
                 !detail::qrhi_buffer_offset(
-                    span.gpu_first + 1u, sizeof(gpu_sample_t), next_offset))
+                    first + 1u, sizeof(gpu_sample_t), next_offset))
             {
                 return;
             }
@@ -2864,50 +4076,690 @@ void Series_renderer::rhi_record_series_primitive(
         }
     }
     else {
-        cb->setShaderResources(srb_entry.srb.get());
-        // LINE: triangle-strip quads per segment, one instance per segment.
-        // The four vertex inputs all reference the line_window_vbo at
-        // increasing element offsets so each instance reads a sliding
-        // (prev, p0, p1, next) window across the padded sample array.
-        if (!view_state.rhi->line_window_vbo) {
+        // LINE: one triangle-strip instance per segment, read from the
+        // compact sample VBO like AREA. STEP_AFTER expands each segment into
+        // its horizontal and vertical legs in the vertex shader.
+        if (!view_state.rhi->sample_vbo()) {
             return;
         }
-        QRhiBuffer* const win = view_state.rhi->line_window_vbo.get();
-        for (const auto& line_span : view_state.line_draw_spans) {
-            if (line_span.line_count < 2) {
+        const bool step_after =
+            window.interpolation == Series_interpolation::STEP_AFTER;
+        QRhiBuffer* const vbo = view_state.rhi->sample_vbo();
+        for (const builtin_segment_span_t& span : segment_spans) {
+            if (span.gpu_count < 2) {
                 continue;
             }
-            const std::size_t offset0        = line_span.line_first;
-            std::size_t       offset1        = 0;
-            std::size_t       offset2        = 0;
-            std::size_t       offset3        = 0;
-            quint32           qrhi_offset0   = 0;
-            quint32           qrhi_offset1   = 0;
-            quint32           qrhi_offset2   = 0;
-            quint32           qrhi_offset3   = 0;
-            quint32           instance_count = 0;
-            if (!detail::checked_size_add( line_span.line_first, 1u, offset1)             ||
-                !detail::checked_size_add( line_span.line_first, 2u, offset2)             ||
-                !detail::checked_size_add( line_span.line_first, 3u, offset3)             ||
-                !detail::qrhi_buffer_offset( offset0, sizeof(gpu_sample_t), qrhi_offset0) ||
-                !detail::qrhi_buffer_offset( offset1, sizeof(gpu_sample_t), qrhi_offset1) ||
-                !detail::qrhi_buffer_offset( offset2, sizeof(gpu_sample_t), qrhi_offset2) ||
-                !detail::qrhi_buffer_offset( offset3, sizeof(gpu_sample_t), qrhi_offset3) ||
-                !detail::to_qrhi_count( line_span.line_count - 1u, instance_count))
+            if (span.gpu_first > count ||
+                span.gpu_count > count - span.gpu_first)
+            {
+                return;
+            }
+            quint32 instance_count = 0;
+            quint32 first_offset   = 0;
+            quint32 next_offset    = 0;
+            const std::size_t first = view_state.sample_base + span.gpu_first;
+            if (!detail::to_qrhi_count(span.gpu_count - 1u, instance_count)             ||
+                !detail::qrhi_buffer_offset( first, sizeof(gpu_sample_t), first_offset) ||
+                !detail::qrhi_buffer_offset(
+                    first + 1u, sizeof(gpu_sample_t), next_offset))
             {
                 return;
             }
-            const QRhiCommandBuffer::VertexInput inputs[4] = {
-                { win, qrhi_offset0 },
-                { win, qrhi_offset1 },
-                { win, qrhi_offset2 },
-                { win, qrhi_offset3 }
+            const QRhiCommandBuffer::VertexInput inputs[2] = {
+                { vbo, first_offset },
+                { vbo, next_offset }
             };
-            cb->setVertexInput(0, 4, inputs);
-            cb->draw(4, instance_count);
+            cb->setVertexInput(0, 2, inputs);
+            cb->setShaderResources(srb_entry.srb.get());
+            cb->draw(step_after ? 10 : 4, instance_count);
+            ++view_state.last_recorded_line_span_count;
+            view_state.last_recorded_line_segment_count +=
+                (span.gpu_count - 1u) * (step_after ? 2u : 1u);
+        }
+    }
+}
+
+bool Series_renderer::rhi_prepare_series_density(
+    const frame_context_t&  ctx,
+    vbo_view_state_t&       view_state,
+    const Series_view_plan& plan,
+    const sample_window_t&  window,
+    const glm::vec4&        draw_color)
+{
+    QRhi*                    rhi     = ctx.rhi;
+    QRhiResourceUpdateBatch* updates = ctx.rhi_updates;
+    QRhiRenderTarget*        rt      = ctx.render_target;
+    if (!rhi || !updates || !rt || window.source_count == 0) {
+        return false;
+    }
+
+    if (!m_rhi_state->density_shaders_loaded) {
+        m_rhi_state->cached_density_vert    = load_qsb("plot_density.vert.qsb");
+        m_rhi_state->cached_density_frag    = load_qsb("plot_density.frag.qsb");
+        m_rhi_state->density_shaders_loaded = true;
+    }
+    if (!m_rhi_state->cached_density_vert.isValid() ||
+        !m_rhi_state->cached_density_frag.isValid())
+    {
+        return false;
+    }
+
+    if (!view_state.rhi) {
+        view_state.rhi = std::make_unique<vbo_view_state_t::rhi_buffers_t>();
+    }
+    auto& buffers = *view_state.rhi;
+
+    // Everything the binned counts depend on. The colour is deliberately
+    // absent: a colour or alpha change only rewrites the UBO below.
+    const auto access_view = plan.access
+        ? detail::make_erased_access_policy_view(*plan.access)
+        : detail::erased_access_policy_t{};
+    const auto access_key = detail::make_access_policy_cache_key(
+        plan.access, access_view);
+    const auto semantics_key = detail::make_sample_semantics_key(plan.access);
+    std::vector<std::uint64_t> density_key{
+        static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(
+            plan.source ? plan.source->identity() : nullptr)),
+        plan.snapshot.sequence,
+        static_cast<std::uint64_t>(window.lod_level),
+        static_cast<std::uint64_t>(plan.lod_scale),
+        static_cast<std::uint64_t>(window.source_first),
+        static_cast<std::uint64_t>(window.source_count),
+        static_cast<std::uint64_t>(window.t_min_ns),
+        static_cast<std::uint64_t>(window.t_max_ns),
+        float_key_bits(window.v_min),
+        float_key_bits(window.v_max),
+        float_key_bits(window.width_px),
+        float_key_bits(window.height_px),
+        static_cast<std::uint64_t>(window.nonfinite_policy),
+        static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(
+            access_key.identity)),
+        access_key.layout_key,
+        access_key.revision,
+        static_cast<std::uint64_t>(access_key.dispatch_kind),
+        static_cast<std::uint64_t>(access_key.has_timestamp),
+        static_cast<std::uint64_t>(access_key.has_value),
+        static_cast<std::uint64_t>(access_key.has_range),
+        semantics_key.value,
+        semantics_key.revision,
+        static_cast<std::uint64_t>(semantics_key.conservative)
+    };
+    const bool cacheable = plan.snapshot.sequence != 0;
+
+    if (!cacheable || !buffers.density_texture || view_state.density_key != density_key) {
+        view_state.density_key.clear();
+        detail::density_grid_t& grid = m_rhi_state->density_grid;
+        if (!detail::bin_window_density(window, plan.lod_scale, grid)) {
+            return false;
+        }
+
+        if (!buffers.density_texture               ||
+            buffers.density_width  != grid.width   ||
+            buffers.density_height != grid.height)
+        {
+            buffers.density_texture.reset(rhi->newTexture(
+                QRhiTexture::RGBA8,
+                QSize(static_cast<int>(grid.width), static_cast<int>(grid.height))));
+            if (!buffers.density_texture || !buffers.density_texture->create()) {
+                buffers.density_texture.reset();
+                buffers.density_width  = 0;
+                buffers.density_height = 0;
+                return false;
+            }
+            buffers.density_width  = grid.width;
+            buffers.density_height = grid.height;
+        }
+
+        // Log-scaled counts, so a lone outlier stays visible next to a core
+        // of millions. Any occupied cell gets at least the lowest step; the
+        // same intensity is written to every channel and the shader reads r.
+        QImage image(
+            static_cast<int>(grid.width),
+            static_cast<int>(grid.height),
+            QImage::Format_RGBA8888);
+        const float intensity_scale = grid.max_count > 0.0f
+            ? 254.0f / std::log1p(grid.max_count)
+            : 0.0f;
+        for (std::size_t row = 0; row < grid.height; ++row) {
+            const float*  counts = grid.counts.data() + row * grid.width;
+            std::uint8_t* texel  = image.scanLine(static_cast<int>(row));
+            for (std::size_t column = 0; column < grid.width; ++column, texel += 4) {
+                const float count = counts[column];
+                const std::uint8_t intensity = count > 0.0f
+                    ? static_cast<std::uint8_t>(std::min(
+                        255.0f, 1.0f + std::round(std::log1p(count) * intensity_scale)))
+                    : std::uint8_t{0};
+                texel[0] = intensity;
+                texel[1] = intensity;
+                texel[2] = intensity;
+                texel[3] = intensity;
+            }
+        }
+        updates->uploadTexture(buffers.density_texture.get(), image);
+
+        if (cacheable) {
+            view_state.density_key = std::move(density_key);
+        }
+        ++view_state.last_density_bin_count;
+        view_state.last_density_upload_bytes += grid.width * grid.height * 4u;
+        if (ctx.config && ctx.config->profiler) {
+            ctx.config->profiler->record_counter("renderer.frame.density_bin_count");
+            ctx.config->profiler->record_observation(
+                "renderer.frame.density_binned_samples",
+                static_cast<double>(grid.binned_samples));
+        }
+    }
+
+    if (!m_rhi_state->density_sampler) {
+        m_rhi_state->density_sampler = m_rhi_state->shared->clamp_sampler(QRhiSampler::Nearest);
+        if (!m_rhi_state->density_sampler) {
+            return false;
+        }
+    }
+
+    auto& entry = buffers.density_srb;
+    const bool ubo_sized = entry.ubo && entry.ubo_capacity_bytes >= k_series_ubo_bytes;
+    if (!detail::ensure_dynamic_ubo(
+            rhi, entry.ubo, entry.ubo_capacity_bytes, k_series_ubo_bytes))
+    {
+        return false;
+    }
+    if (!ubo_sized) {
+        entry.srb.reset();
+        entry.last_ubo = nullptr;
+    }
+
+    auto& cached = m_rhi_state->pipelines[
+        rhi_state_t::pipeline_key_t{rhi_state_t::pipeline_kind_t::DENSITY}];
+    QRhiRenderPassDescriptor* current_rpd     = rt->renderPassDescriptor();
+    const int                 current_samples = rt->sampleCount();
+    if (cached.pipeline && (cached.last_rpd != current_rpd || cached.last_sample_count != current_samples))
+    {
+        cached.pipeline = nullptr;
+    }
+    if (!cached.pipeline) {
+        cached.vert = m_rhi_state->cached_density_vert;
+        cached.frag = m_rhi_state->cached_density_frag;
+
+        // The quad's corners come from gl_VertexIndex; no vertex input.
+        detail::alpha_blended_pipeline_desc_t desc;
+        desc.vert           = cached.vert;
+        desc.frag           = cached.frag;
+        desc.ubo_bytes      = k_series_ubo_bytes;
+        desc.ubo_stages     = QRhiShaderResourceBinding::VertexStage
+                            | QRhiShaderResourceBinding::FragmentStage;
+        desc.flags          = QRhiGraphicsPipeline::UsesScissor;
+        desc.layout_texture = buffers.density_texture.get();
+        desc.layout_sampler = m_rhi_state->density_sampler;
+        cached.pipeline = m_rhi_state->shared->pipeline(
+            rhi_state_t::pipeline_name(rhi_state_t::pipeline_kind_t::DENSITY),
+            rt,
+            [&](QRhiRenderPassDescriptor* target_rpd, int sample_count) {
+                return detail::build_alpha_blended_pipeline(rhi, target_rpd, sample_count, desc);
+            });
+        if (!cached.pipeline) {
+            return false;
+        }
+        cached.last_rpd          = current_rpd;
+        cached.last_sample_count = current_samples;
+    }
+
+    if (!entry.srb                                             ||
+        entry.last_ubo              != entry.ubo.get()         ||
+        buffers.density_srb_texture != buffers.density_texture.get())
+    {
+        if (!detail::rebuild_ubo_texture_srb(
+                rhi, entry.srb, entry.ubo.get(), k_series_ubo_bytes,
+                QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage,
+                buffers.density_texture.get(),
+                m_rhi_state->density_sampler))
+        {
+            entry.srb.reset();
+            entry.last_ubo              = nullptr;
+            buffers.density_srb_texture = nullptr;
+            return false;
+        }
+        entry.last_ubo              = entry.ubo.get();
+        buffers.density_srb_texture = buffers.density_texture.get();
+    }
+
+    const series_view_uniform_std140_t block = make_view_uniform(ctx, window, draw_color);
+    updates->updateDynamicBuffer(entry.ubo.get(), 0, sizeof(block), &block);
+    view_state.last_uniform_upload_bytes += sizeof(block);
+    ++view_state.last_uniform_upload_count;
+    ++view_state.last_primitive_prepare_count;
+    return true;
+}
+
+void Series_renderer::rhi_record_series_density(
+    const frame_context_t& ctx,
+    vbo_view_state_t&      view_state)
+{
+    QRhiCommandBuffer* cb = ctx.cb;
+    if (!cb || !view_state.rhi || !view_state.rhi->density_srb.srb) {
+        return;
+    }
+    auto pipe_it = m_rhi_state->pipelines.find(
+        rhi_state_t::pipeline_key_t{rhi_state_t::pipeline_kind_t::DENSITY});
+    if (pipe_it == m_rhi_state->pipelines.end() || !pipe_it->second.pipeline) {
+        return;
+    }
+    cb->setGraphicsPipeline(pipe_it->second.pipeline);
+    cb->setShaderResources(view_state.rhi->density_srb.srb.get());
+    cb->draw(4);
+    ++view_state.last_recorded_density_draw_count;
+}
+
+void Series_renderer::rhi_prepare_draw_batches(const frame_context_t& ctx)
+{
+    using command_t = rhi_state_t::prepared_draw_command_t;
+    using batch_t   = rhi_state_t::draw_batch_t;
+
+    QRhi*                    rhi     = ctx.rhi;
+    QRhiResourceUpdateBatch* updates = ctx.rhi_updates;
+    QRhiRenderTarget*        rt      = ctx.render_target;
+    auto&                    draws   = m_rhi_state->prepared_draws;
+    auto&                    batches = m_rhi_state->draw_batches;
+    if (!rhi || !updates || !rt) {
+        batches.clear();
+        return;
+    }
+    vnm::plot::Profiler* profiler = ctx.config ? ctx.config->profiler.get() : nullptr;
+    const float point_diameter_px = ctx.config
+        ? static_cast<float>(ctx.config->point_diameter_px) : 1.0f;
+
+    // Span tags must stay exact in the float y_max lane.
+    constexpr std::size_t k_batch_max_span_tags = std::size_t{1} << 23;
+
+    // A member's packed input is read from its staging, which always holds
+    // just the view's own window from slot 0: sample_base only offsets the
+    // window inside the GPU buffer (a streaming VBO, or the main view's
+    // shared containing window), never inside staging.
+    const auto batchable = [](const command_t& command) {
+        if (command.kind != command_t::kind_t::BUILTIN ||
+            !command.view_state                        ||
+            command.stack_sum_overlay)
+        {
+            return false;
+        }
+        if (command.view_state->staging.size() < command.window.gpu_count) {
+            return false;
+        }
+        return
+            command.primitive_style == Display_style::DOTS ||
+            (command.primitive_style == Display_style::LINE &&
+             !command.builtin_segment_spans.empty());
+    };
+
+    // Members share one Series_view block and one size uniform. Commands
+    // are adjacent in draw order, so packing them in order keeps it.
+    const auto same_batch = [](const command_t& a, const command_t& b) {
+        const sample_window_t& wa = a.window;
+        const sample_window_t& wb = b.window;
+        return
+            a.view_kind       == b.view_kind       &&
+            a.primitive_style == b.primitive_style &&
+            a.line_width_px   == b.line_width_px   &&
+            wa.interpolation  == wb.interpolation  &&
+            wa.t_origin_ns    == wb.t_origin_ns    &&
+            wa.t_min_ns       == wb.t_min_ns       &&
+            wa.t_max_ns       == wb.t_max_ns       &&
+            wa.v_min          == wb.v_min          &&
+            wa.v_max          == wb.v_max          &&
+            wa.width_px       == wb.width_px       &&
+            wa.height_px      == wb.height_px      &&
+            wa.y_offset_px    == wb.y_offset_px;
+    };
+
+    const auto ensure_batch_pipeline = [&](rhi_state_t::pipeline_kind_t kind) -> bool {
+        const bool is_dots = (kind == rhi_state_t::pipeline_kind_t::DOTS_BATCH);
+        auto&      cached  = m_rhi_state->pipelines[rhi_state_t::pipeline_key_t{kind}];
+
+        QRhiRenderPassDescriptor* current_rpd     = rt->renderPassDescriptor();
+        const int                 current_samples = rt->sampleCount();
+        if (cached.pipeline && (cached.last_rpd != current_rpd || cached.last_sample_count != current_samples))
+        {
+            cached.pipeline = nullptr;
+        }
+        if (cached.pipeline) {
+            return true;
+        }
+
+        const QShader& vert = is_dots
+            ? m_rhi_state->cached_dot_batch_vert
+            : m_rhi_state->cached_line_batch_vert;
+        const QShader& frag = is_dots
+            ? m_rhi_state->cached_dot_batch_frag
+            : m_rhi_state->cached_line_batch_frag;
+        if (!vert.isValid() || !frag.isValid()) {
+            return false;
+        }
+        cached.vert = vert;
+        cached.frag = frag;
+
+        const quint32 stride = static_cast<quint32>(sizeof(gpu_sample_t));
+        const quint32 t_offset =
+            static_cast<quint32>(offsetof(gpu_sample_t, t_rel));
+        QRhiVertexInputLayout vlayout;
+        if (is_dots) {
+            QRhiVertexInputBinding ib0(stride, QRhiVertexInputBinding::PerInstance, 1);
+            vlayout.setBindings({ib0});
+            QRhiVertexInputAttribute a0(0, 0, QRhiVertexInputAttribute::Float, t_offset);
+            QRhiVertexInputAttribute a1(
+                0, 1, QRhiVertexInputAttribute::Float,
+                static_cast<quint32>(offsetof(gpu_sample_t, y)));
+            QRhiVertexInputAttribute a_slot(
+                0, 2, QRhiVertexInputAttribute::Float,
+                static_cast<quint32>(offsetof(gpu_sample_t, y_min)));
+            vlayout.setAttributes({a0, a1, a_slot});
+        }
+        else {
+            // Same (p0, p1) pair as LINE, also reading the slot and span
+            // tag lanes.
+            QRhiVertexInputBinding ib_p0(stride, QRhiVertexInputBinding::PerInstance, 1);
+            QRhiVertexInputBinding ib_p1(stride, QRhiVertexInputBinding::PerInstance, 1);
+            vlayout.setBindings({ib_p0, ib_p1});
+            QRhiVertexInputAttribute a_p0(0, 0, QRhiVertexInputAttribute::Float4, t_offset);
+            QRhiVertexInputAttribute a_p1(1, 1, QRhiVertexInputAttribute::Float4, t_offset);
+            vlayout.setAttributes({a_p0, a_p1});
+        }
+
+        detail::alpha_blended_pipeline_desc_t desc;
+        desc.vert       = cached.vert;
+        desc.frag       = cached.frag;
+        desc.vlayout    = vlayout;
+        desc.ubo_bytes  = k_batch_ubo_bytes;
+        desc.ubo_stages = QRhiShaderResourceBinding::VertexStage
+                        | QRhiShaderResourceBinding::FragmentStage;
+        desc.flags      = QRhiGraphicsPipeline::UsesScissor;
+        cached.pipeline = m_rhi_state->shared->pipeline(
+            rhi_state_t::pipeline_name(kind),
+            rt,
+            [&](QRhiRenderPassDescriptor* target_rpd, int sample_count) {
+                return detail::build_alpha_blended_pipeline(rhi, target_rpd, sample_count, desc);
+            });
+        if (!cached.pipeline) {
+            return false;
+        }
+        cached.last_rpd          = current_rpd;
+        cached.last_sample_count = current_samples;
+        return true;
+    };
+
+    std::size_t frame_batch_upload_bytes = 0;
+    const auto prepare_batch = [&](
+        batch_t&       batch,
+        std::size_t    first,
+        std::size_t    end) -> bool
+    {
+        const command_t& head    = draws[first];
+        const bool       is_dots = (head.primitive_style == Display_style::DOTS);
+        const auto       kind    = is_dots
+            ? rhi_state_t::pipeline_kind_t::DOTS_BATCH
+            : rhi_state_t::pipeline_kind_t::LINE_BATCH;
+        if (!ensure_batch_pipeline(kind)) {
+            return false;
+        }
+        batch.step_after = !is_dots &&
+            head.window.interpolation == Series_interpolation::STEP_AFTER;
+
+        std::vector<batch_t::member_t> members;
+        members.reserve(end - first);
+        for (std::size_t i = first; i < end; ++i) {
+            vbo_view_state_t& view_state = *draws[i].view_state;
+            batch_t::member_t member;
+            member.view_state       = &view_state;
+            member.staging_revision = view_state.staging_revision;
+            member.sample_count     = draws[i].window.gpu_count;
+            if (!is_dots) {
+                member.segment_spans = draws[i].builtin_segment_spans;
+            }
+            members.push_back(std::move(member));
+        }
+
+        if (!batch.vbo || batch.kind != kind || batch.members != members) {
+            auto& packed = m_rhi_state->batch_staging;
+            packed.clear();
+            std::size_t span_tag = 0;
+            for (std::size_t slot = 0; slot < members.size(); ++slot) {
+                const batch_t::member_t& member     = members[slot];
+                const vbo_view_state_t&  view_state = *member.view_state;
+                const float              slot_lane  = static_cast<float>(slot);
+                if (is_dots) {
+                    for (std::size_t i = 0; i < member.sample_count; ++i) {
+                        gpu_sample_t sample = view_state.staging[i];
+                        sample.y_min = slot_lane;
+                        packed.push_back(sample);
+                    }
+                    continue;
+                }
+
+                // Every sample of one span carries the same tag, so the one
+                // instance that joins two spans collapses in the shader.
+                for (const builtin_segment_span_t& span : member.segment_spans) {
+                    if (span.gpu_count < 2) {
+                        continue;
+                    }
+                    if (span_tag >= k_batch_max_span_tags      ||
+                        span.gpu_first > member.sample_count   ||
+                        span.gpu_count > member.sample_count - span.gpu_first)
+                    {
+                        return false;
+                    }
+                    const float tag_lane = static_cast<float>(span_tag);
+                    for (std::size_t i = 0; i < span.gpu_count; ++i) {
+                        gpu_sample_t sample = view_state.staging[span.gpu_first + i];
+                        sample.y_min = slot_lane;
+                        sample.y_max = tag_lane;
+                        packed.push_back(sample);
+                    }
+                    ++span_tag;
+                }
+            }
+            if (packed.size() < (is_dots ? 1u : 2u)) {
+                return false;
+            }
+
+            std::size_t needed_bytes = 0;
+            quint32     upload_bytes = 0;
+            if (!detail::qrhi_byte_size(
+                    packed.size(), sizeof(gpu_sample_t), needed_bytes, upload_bytes))
+            {
+                return false;
+            }
+            if (!batch.vbo || batch.vbo_capacity_bytes < needed_bytes) {
+                std::size_t alloc_bytes      = 0;
+                quint32     qrhi_alloc_bytes = 0;
+                if (!detail::qrhi_grown_capacity_bytes(
+                        needed_bytes, alloc_bytes, qrhi_alloc_bytes))
+                {
+                    return false;
+                }
+                batch.members.clear();
+                batch.vbo.reset(rhi->newBuffer(
+                    QRhiBuffer::Static, QRhiBuffer::VertexBuffer, qrhi_alloc_bytes));
+                if (!batch.vbo || !batch.vbo->create()) {
+                    batch.vbo.reset();
+                    batch.vbo_capacity_bytes = 0;
+                    return false;
+                }
+                batch.vbo_capacity_bytes = alloc_bytes;
+                if (profiler) {
+                    profiler->record_observation(
+                        "renderer.frame.gpu_buffer_allocation_bytes",
+                        static_cast<double>(alloc_bytes));
+                    profiler->record_counter(
+                        "renderer.frame.gpu_buffer_allocation_count");
+                }
+            }
+            updates->uploadStaticBuffer(batch.vbo.get(), 0, upload_bytes, packed.data());
+            frame_batch_upload_bytes += upload_bytes;
+            ++m_last_batch_upload_count;
+
+            batch.kind           = kind;
+            batch.members        = std::move(members);
+            batch.instance_count = is_dots ? packed.size() : packed.size() - 1u;
+        }
+
+        auto& uniforms = batch.uniforms;
+        if (!detail::ensure_dynamic_ubo(
+                rhi, uniforms.ubo, uniforms.ubo_capacity_bytes, k_batch_ubo_bytes))
+        {
+            return false;
+        }
+        if (!uniforms.srb || uniforms.last_ubo != uniforms.ubo.get()) {
+            if (!detail::rebuild_single_ubo_srb(
+                    rhi, uniforms.srb, uniforms.ubo.get(), k_batch_ubo_bytes,
+                    QRhiShaderResourceBinding::VertexStage | QRhiShaderResourceBinding::FragmentStage))
+            {
+                uniforms.srb.reset();
+                uniforms.last_ubo = nullptr;
+                return false;
+            }
+            uniforms.last_ubo = uniforms.ubo.get();
+        }
+
+        Batch_block_std140 block{};
+        block.view           = make_view_uniform(ctx, head.window, glm::vec4(1.0f));
+        block.size_px        = is_dots ? point_diameter_px : head.line_width_px;
+        block.snap_to_pixels = (!is_dots && ctx.config && ctx.config->snap_lines_to_pixels)
+            ? 1 : 0;
+        block.interpolation  = batch.step_after ? 1 : 0;
+        for (std::size_t i = first; i < end; ++i) {
+            const glm::vec4& color = draws[i].draw_color;
+            float*           dst   = block.series_color[i - first];
+            dst[0] = color.r;
+            dst[1] = color.g;
+            dst[2] = color.b;
+            dst[3] = color.a;
+        }
+        // Upload only the colors of the slots in use.
+        const std::size_t block_bytes =
+            offsetof(Batch_block_std140, series_color) +
+            (end - first) * sizeof(block.series_color[0]);
+        updates->updateDynamicBuffer(
+            uniforms.ubo.get(), 0, static_cast<quint32>(block_bytes), &block);
+        return true;
+    };
+
+    std::size_t batch_count  = 0;
+    std::size_t member_count = 0;
+    for (std::size_t first = 0; first < draws.size();) {
+        std::size_t end = first + 1;
+        if (batchable(draws[first])) {
+            while (end < draws.size()                 &&
+                   end - first < k_batch_max_series   &&
+                   batchable(draws[end])              &&
+                   same_batch(draws[first], draws[end]))
+            {
+                ++end;
+            }
+        }
+        if (end - first < 2) {
+            first = end;
+            continue;
+        }
+
+        if (batches.size() == batch_count) {
+            batches.emplace_back();
+        }
+        if (prepare_batch(batches[batch_count], first, end)) {
+            for (std::size_t i = first; i < end; ++i) {
+                draws[i].batched     = true;
+                draws[i].batch_head  = (i == first);
+                draws[i].batch_index = batch_count;
+            }
+            member_count += end - first;
+            ++batch_count;
+        }
+        first = end;
+    }
+    batches.resize(batch_count);
+
+    if (profiler && batch_count > 0) {
+        profiler->record_observation(
+            "renderer.frame.batched_draw_count",
+            static_cast<double>(batch_count));
+        profiler->record_observation(
+            "renderer.frame.batched_series_draw_count",
+            static_cast<double>(member_count));
+        profiler->record_observation(
+            "renderer.frame.upload.batch_bytes",
+            static_cast<double>(frame_batch_upload_bytes));
+    }
+}
+
+QRhiBuffer* Series_renderer::draw_batch_vbo(
+    std::size_t            batch_index,
+    std::size_t&           instance_count) const
+{
+    instance_count = 0;
+    if (batch_index >= m_rhi_state->draw_batches.size()) {
+        return nullptr;
+    }
+    const rhi_state_t::draw_batch_t& batch = m_rhi_state->draw_batches[batch_index];
+    instance_count = batch.instance_count;
+    return batch.vbo.get();
+}
+
+void Series_renderer::rhi_record_draw_batch(
+    const frame_context_t& ctx,
+    std::size_t            batch_index)
+{
+    QRhiCommandBuffer* cb = ctx.cb;
+    if (!cb || batch_index >= m_rhi_state->draw_batches.size()) {
+        return;
+    }
+    const rhi_state_t::draw_batch_t& batch = m_rhi_state->draw_batches[batch_index];
+    if (!batch.vbo || !batch.uniforms.srb || batch.instance_count == 0) {
+        return;
+    }
+    auto pipe_it = m_rhi_state->pipelines.find(rhi_state_t::pipeline_key_t{batch.kind});
+    if (pipe_it == m_rhi_state->pipelines.end() || !pipe_it->second.pipeline) {
+        return;
+    }
+    quint32 instance_count = 0;
+    if (!detail::to_qrhi_count(batch.instance_count, instance_count)) {
+        return;
+    }
+
+    const bool  is_dots = (batch.kind == rhi_state_t::pipeline_kind_t::DOTS_BATCH);
+    QRhiBuffer* vbo     = batch.vbo.get();
+    cb->setGraphicsPipeline(pipe_it->second.pipeline);
+    cb->setShaderResources(batch.uniforms.srb.get());
+    if (is_dots) {
+        const QRhiCommandBuffer::VertexInput input{vbo, 0};
+        cb->setVertexInput(0, 1, &input);
+    }
+    else {
+        quint32 offset1 = 0;
+        if (!detail::qrhi_buffer_offset(1u, sizeof(gpu_sample_t), offset1)) {
+            return;
+        }
+        const QRhiCommandBuffer::VertexInput inputs[2] = {
+            { vbo, 0       },
+            { vbo, offset1 }
+        };
+        cb->setVertexInput(0, 2, inputs);
+    }
+    cb->draw(!is_dots && batch.step_after ? 10 : 4, instance_count);
+    ++m_last_recorded_batch_draw_count;
+    m_last_recorded_batched_series_count += batch.members.size();
+
+    // Keep the per-view record counters as if every member drew alone.
+    for (const auto& member : batch.members) {
+        vbo_view_state_t& view_state = *member.view_state;
+        if (is_dots) {
+            view_state.last_recorded_dot_sample_count += member.sample_count;
+            continue;
+        }
+        for (const builtin_segment_span_t& span : member.segment_spans) {
+            if (span.gpu_count < 2) {
+                continue;
+            }
             ++view_state.last_recorded_line_span_count;
             view_state.last_recorded_line_segment_count +=
-                line_span.line_count - 1u;
+                (span.gpu_count - 1u) * (batch.step_after ? 2u : 1u);
         }
     }
 }
@@ -1,4 +1,5 @@
 #include "series_window_planner.h"
+#include "parallel_for.h"
 
 #include <vnm_plot/core/algo.h>
 #include <vnm_plot/core/plot_config.h>
@@ -207,6 +208,112 @@ bool select_hold_source_index(
     return false;
 }
 
+// Scans snapshot timestamps from `first_index` to the end for non-decreasing
+// order. `scanned` receives the number of samples visited.
+bool scan_timestamps_monotonic(
+    const data_snapshot_t&         snapshot,
+    const erased_access_policy_t&  access,
+    std::size_t                    first_index,
+    std::size_t&                   scanned)
+{
+    scanned = 1;
+    const void* first_sample = snapshot.at(first_index);
+    if (!first_sample) {
+        return false;
+    }
+    std::int64_t prev_ts = access.timestamp(first_sample);
+    for (std::size_t i = first_index + 1u; i < snapshot.count; ++i) {
+        const void* sample = snapshot.at(i);
+        ++scanned;
+        if (!sample) {
+            return false;
+        }
+        const std::int64_t ts = access.timestamp(sample);
+        if (ts < prev_ts) {
+            return false;
+        }
+        prev_ts = ts;
+    }
+    return true;
+}
+
+void record_timestamp_order_extent(
+    const data_snapshot_t&         snapshot,
+    const erased_access_policy_t&  access,
+    timestamp_order_entry_t&       entry)
+{
+    entry.prefix_revision = 0;
+    entry.sample_count    = 0;
+    const void* first_sample = snapshot.at(0);
+    const void* last_sample  = snapshot.count > 0 ? snapshot.at(snapshot.count - 1u) : nullptr;
+    if (!first_sample || !last_sample) {
+        return;
+    }
+    entry.prefix_revision = snapshot.prefix_revision;
+    entry.sample_count    = snapshot.count;
+    entry.first_timestamp = access.timestamp(first_sample);
+    entry.last_timestamp  = access.timestamp(last_sample);
+}
+
+// True when `snapshot` is `entry`'s snapshot with samples appended. The
+// source vouches for that through an unchanged nonzero prefix_revision; the
+// length and end timestamps at the junction are checked on top, so a source
+// that breaks its contract there still gets a full scan.
+bool snapshot_extends_timestamp_order(
+    const data_snapshot_t&         snapshot,
+    const erased_access_policy_t&  access,
+    const timestamp_order_entry_t& entry)
+{
+    if (entry.prefix_revision == 0                          ||
+        snapshot.prefix_revision != entry.prefix_revision   ||
+        entry.sample_count == 0                             ||
+        snapshot.count < entry.sample_count)
+    {
+        return false;
+    }
+    const void* first_sample  = snapshot.at(0);
+    const void* anchor_sample = snapshot.at(entry.sample_count - 1u);
+    return
+        first_sample  != nullptr                                 &&
+        anchor_sample != nullptr                                 &&
+        access.timestamp(first_sample)  == entry.first_timestamp &&
+        access.timestamp(anchor_sample) == entry.last_timestamp;
+}
+
+timestamp_order_entry_t current_timestamp_order(
+    const series_window_planner_state_t& state)
+{
+    timestamp_order_entry_t entry;
+    entry.valid           = state.last_timestamp_order_identity != nullptr;
+    entry.level           = state.last_timestamp_order_level;
+    entry.sequence        = state.last_timestamp_order_sequence;
+    entry.identity        = state.last_timestamp_order_identity;
+    entry.access_key      = state.last_timestamp_order_access_key;
+    entry.source_order    = state.last_timestamp_source_order;
+    entry.monotonic       = state.last_timestamps_monotonic;
+    entry.prefix_revision = state.last_timestamp_order_prefix_revision;
+    entry.sample_count    = state.last_timestamp_order_sample_count;
+    entry.first_timestamp = state.last_timestamp_order_first_ts;
+    entry.last_timestamp  = state.last_timestamp_order_last_ts;
+    return entry;
+}
+
+void store_timestamp_order(
+    series_window_planner_state_t& state,
+    const timestamp_order_entry_t& entry)
+{
+    state.last_timestamp_order_sequence        = entry.sequence;
+    state.last_timestamp_order_identity        = entry.identity;
+    state.last_timestamp_order_access_key      = entry.access_key;
+    state.last_timestamp_source_order          = entry.source_order;
+    state.last_timestamp_order_level           = entry.level;
+    state.last_timestamps_monotonic            = entry.monotonic;
+    state.last_timestamp_order_prefix_revision = entry.prefix_revision;
+    state.last_timestamp_order_sample_count    = entry.sample_count;
+    state.last_timestamp_order_first_ts        = entry.first_timestamp;
+    state.last_timestamp_order_last_ts         = entry.last_timestamp;
+}
+
 } // anonymous namespace
 
 Series_view_plan plan_series_window(const series_window_plan_request_t& request)
@@ -407,6 +514,7 @@ Series_view_plan plan_series_window(const series_window_plan_request_t& request)
             state.last_t_min                 == request.t_min_ns              &&
             state.last_t_max                 == request.t_max_ns              &&
             state.last_width_px              == request.width_px              &&
+            state.last_lod_pps_target        == request.lod_pps_target        &&
             state.last_empty_window_behavior == request.empty_window_behavior &&
             state.last_nonfinite_policy      == request.nonfinite_policy      &&
             state.last_interpolation         == request.interpolation         &&
@@ -592,8 +700,10 @@ Series_view_plan plan_series_window(const series_window_plan_request_t& request)
         }
 
         bool timestamps_monotonic = true;
-        state.last_timestamp_order_scan_performed = false;
-        state.last_timestamp_order_scan_samples   = 0;
+        state.last_timestamp_order_scan_performed   = false;
+        state.last_timestamp_order_scan_incremental = false;
+        state.last_timestamp_order_scan_samples     = 0;
+        state.last_timestamp_order_from_neighbor    = false;
         state.last_timestamp_window_search        = Timestamp_window_search::NONE;
         if (direct_time_window_failed) {
             state.last_timestamp_window_search =
@@ -612,6 +722,7 @@ Series_view_plan plan_series_window(const series_window_plan_request_t& request)
                 state.last_timestamp_order_identity   = current_identity;
                 state.last_timestamp_order_access_key = access_key;
                 state.last_timestamp_source_order     = source_order;
+                state.last_timestamp_order_level      = applied_level;
                 state.last_timestamps_monotonic       = true;
             }
             else
@@ -620,6 +731,7 @@ Series_view_plan plan_series_window(const series_window_plan_request_t& request)
                 state.last_timestamp_order_identity   = current_identity;
                 state.last_timestamp_order_access_key = access_key;
                 state.last_timestamp_source_order     = source_order;
+                state.last_timestamp_order_level      = applied_level;
                 state.last_timestamps_monotonic       = false;
             }
             else {
@@ -627,44 +739,86 @@ Series_view_plan plan_series_window(const series_window_plan_request_t& request)
                     state.last_timestamp_order_sequence   != snapshot.sequence ||
                     state.last_timestamp_order_identity   != current_identity  ||
                     state.last_timestamp_order_access_key != access_key        ||
-                    state.last_timestamp_source_order     != source_order;
+                    state.last_timestamp_source_order     != source_order      ||
+                    state.last_timestamp_order_level      != applied_level;
                 if (need_monotonicity_scan) {
-                    bool is_monotonic = true;
-                    state.last_timestamp_order_scan_performed = true;
-                    const void* first_sample = snapshot.at(0);
-                    ++state.last_timestamp_order_scan_samples;
-                    if (!first_sample) {
-                        is_monotonic = false;
+                    const timestamp_order_entry_t previous = current_timestamp_order(state);
+
+                    timestamp_order_entry_t current;
+                    current.valid        = true;
+                    current.level        = applied_level;
+                    current.sequence     = snapshot.sequence;
+                    current.identity     = current_identity;
+                    current.access_key   = access_key;
+                    current.source_order = source_order;
+
+                    const bool same_level =
+                        previous.valid                            &&
+                        previous.level        == applied_level    &&
+                        previous.identity     == current_identity &&
+                        previous.access_key   == access_key       &&
+                        previous.source_order == source_order;
+                    const timestamp_order_entry_t& neighbor = state.neighbor_timestamp_order;
+                    if (same_level &&
+                        snapshot_extends_timestamp_order(snapshot, access_view, previous))
+                    {
+                        // Growing source: the classified prefix is unchanged,
+                        // so only the appended suffix (joined at the last
+                        // classified sample) needs scanning. An inversion in
+                        // the prefix keeps the result non-monotonic.
+                        state.last_timestamp_order_scan_performed   = true;
+                        state.last_timestamp_order_scan_incremental = true;
+                        current.monotonic = previous.monotonic;
+                        if (current.monotonic) {
+                            current.monotonic = scan_timestamps_monotonic(
+                                snapshot,
+                                access_view,
+                                previous.sample_count - 1u,
+                                state.last_timestamp_order_scan_samples);
+                        }
+                        if (request.profiler) {
+                            request.profiler->record_counter(
+                                "renderer.series_window.monotonicity_incremental_scan_count");
+                            request.profiler->record_observation(
+                                "renderer.series_window.monotonicity_scan_samples",
+                                static_cast<double>(
+                                    state.last_timestamp_order_scan_samples));
+                        }
+                    }
+                    else
+                    if (neighbor.valid                             &&
+                        neighbor.level        == applied_level     &&
+                        neighbor.sequence     == snapshot.sequence &&
+                        neighbor.identity     == current_identity  &&
+                        neighbor.access_key   == access_key        &&
+                        neighbor.source_order == source_order)
+                    {
+                        current.monotonic = neighbor.monotonic;
+                        state.last_timestamp_order_from_neighbor = true;
+                        if (request.profiler) {
+                            request.profiler->record_counter(
+                                "renderer.series_window.timestamp_order_reuse_count");
+                        }
                     }
                     else {
-                        std::int64_t prev_ts = get_timestamp(first_sample);
-                        for (std::size_t i = 1; i < snapshot.count; ++i) {
-                            const void* sample = snapshot.at(i);
-                            ++state.last_timestamp_order_scan_samples;
-                            if (!sample) {
-                                is_monotonic = false;
-                                break;
-                            }
-                            const std::int64_t ts = get_timestamp(sample);
-                            if (ts < prev_ts) {
-                                is_monotonic = false;
-                                break;
-                            }
-                            prev_ts = ts;
+                        state.last_timestamp_order_scan_performed = true;
+                        current.monotonic = scan_timestamps_monotonic(
+                            snapshot, access_view, 0, state.last_timestamp_order_scan_samples);
+                        if (request.profiler) {
+                            request.profiler->record_counter(
+                                "renderer.series_window.monotonicity_scan_count");
+                            request.profiler->record_observation(
+                                "renderer.series_window.monotonicity_scan_samples",
+                                static_cast<double>(
+                                    state.last_timestamp_order_scan_samples));
                         }
                     }
-                    state.last_timestamp_order_sequence   = snapshot.sequence;
-                    state.last_timestamp_order_identity   = current_identity;
-                    state.last_timestamp_order_access_key = access_key;
-                    state.last_timestamp_source_order     = source_order;
-                    state.last_timestamps_monotonic       = is_monotonic;
-                    if (request.profiler) {
-                        request.profiler->record_counter(
-                            "renderer.series_window.monotonicity_scan_count");
-                        request.profiler->record_observation(
-                            "renderer.series_window.monotonicity_scan_samples",
-                            static_cast<double>(
-                                state.last_timestamp_order_scan_samples));
+                    record_timestamp_order_extent(snapshot, access_view, current);
+                    store_timestamp_order(state, current);
+                    // Keep the level this view switched away from, so
+                    // zooming back across the boundary does not rescan it.
+                    if (previous.valid && previous.level != applied_level) {
+                        state.neighbor_timestamp_order = previous;
                     }
                 }
             }
@@ -899,8 +1053,18 @@ Series_view_plan plan_series_window(const series_window_plan_request_t& request)
         }
         const double base_pps = (base_samples > 0)
             ? request.width_px / static_cast<double>(base_samples) : 0.0;
-
-        const std::size_t desired_level = choose_lod_level(scales, base_pps);
+        // Choosing for a pps target of N is choosing for 1 pps at 1/N of
+        // the width.
+        const double lod_pps = request.lod_pps_target > 0.0
+            ? base_pps / request.lod_pps_target
+            : base_pps;
+
+        const bool hold_lod_level =
+            state.has_last_lod_level &&
+            state.cached_data_identity == data_source.identity();
+        const std::size_t desired_level = hold_lod_level
+            ? choose_lod_level(scales, lod_pps, state.last_lod_level, request.lod_hysteresis)
+            : choose_lod_level(scales, lod_pps);
         if (desired_level != applied_level) {
             if (!was_tried(desired_level)) {
                 target_level = desired_level;
@@ -926,6 +1090,7 @@ Series_view_plan plan_series_window(const series_window_plan_request_t& request)
         state.last_t_min                 = request.t_min_ns;
         state.last_t_max                 = request.t_max_ns;
         state.last_width_px              = request.width_px;
+        state.last_lod_pps_target        = request.lod_pps_target;
         state.last_empty_window_behavior = request.empty_window_behavior;
         state.last_nonfinite_policy      = request.nonfinite_policy;
         state.last_interpolation         = request.interpolation;
@@ -996,12 +1161,415 @@ Series_view_plan plan_series_window(const series_window_plan_request_t& request)
         state.last_synthetic_hold_count = plan.synthetic_hold_count;
         state.last_drawable_spans       = plan.drawable_spans;
         state.last_selected_time_order  = selected_time_order;
+
         break;
     }
 
     return plan;
 }
 
+double next_adaptive_lod_bias(
+    double                     bias,
+    double                     prepare_ms,
+    double                     budget_ms,
+    double                     max_bias,
+    bool                       view_moved)
+{
+    if (!(budget_ms > 0.0) || !(max_bias > 0.0) || !std::isfinite(bias)) {
+        return 0.0;
+    }
+
+    if (!view_moved) {
+        bias -= 1.0;
+    }
+    else
+    if (prepare_ms > budget_ms) {
+        // Prepare cost roughly follows the planned sample count, which
+        // halves with every bias step.
+        bias += std::log2(prepare_ms / budget_ms);
+    }
+    else
+    if (prepare_ms < 0.5 * budget_ms) {
+        bias -= 0.25;
+    }
+    return std::clamp(bias, 0.0, max_bias);
+}
+
+bool decimate_window_m4(
+    const sample_window_t&     window,
+    m4_window_t&               out)
+{
+    out = m4_window_t{};
+    if (!window.snapshot                     ||
+        !window.access                       ||
+        window.drawable_spans.empty()        ||
+        !(window.width_px > 0.0f)            ||
+        window.t_max_ns <= window.t_min_ns)
+    {
+        return false;
+    }
+
+    const erased_access_policy_t access = make_erased_access_policy_view(*window.access);
+    if (!access.has_timestamp()) {
+        return false;
+    }
+
+    const long double px_per_ns =
+        static_cast<long double>(window.width_px) /
+        span_ns_as_long_double(window.t_min_ns, window.t_max_ns);
+    const auto column_of = [&](std::int64_t ts_ns) {
+        return static_cast<std::int64_t>(std::floor(
+            span_ns_as_long_double(window.t_min_ns, ts_ns) * px_per_ns));
+    };
+
+    out.spans.reserve(window.drawable_spans.size());
+    bool         have_previous_timestamp = false;
+    std::int64_t previous_timestamp      = 0;
+    for (std::size_t span_index = 0; span_index < window.drawable_spans.size(); ++span_index) {
+        const drawable_sample_span_t& span       = window.drawable_spans[span_index];
+        const bool                    final_span = span_index + 1u == window.drawable_spans.size();
+        const bool                    has_hold   = final_span && window.synthetic_hold_count == 1;
+        if (span.source_count == 0) {
+            out = m4_window_t{};
+            return false;
+        }
+
+        drawable_sample_span_t out_span = span;
+        out_span.gpu_first = out.gpu_count;
+
+        // Per column: first, argmin, argmax, last. Emitted in index order so
+        // the polyline keeps its time order.
+        std::int64_t column       = 0;
+        std::size_t  bucket_first = 0;
+        std::size_t  bucket_min   = 0;
+        std::size_t  bucket_max   = 0;
+        std::size_t  bucket_last  = 0;
+        float        min_y        = 0.0f;
+        float        max_y        = 0.0f;
+        bool         have_bucket  = false;
+        const auto flush_bucket = [&]() {
+            std::array<std::size_t, 4> picks{bucket_first, bucket_min, bucket_max, bucket_last};
+            std::sort(picks.begin(), picks.end());
+            for (std::size_t i = 0; i < picks.size(); ++i) {
+                if (i == 0 || picks[i] != picks[i - 1u]) {
+                    out.source_indices.push_back(picks[i]);
+                }
+            }
+        };
+
+        for (std::size_t i = 0; i < span.source_count; ++i) {
+            const std::size_t index  = span.source_first + i;
+            const void*       sample = window.snapshot.at(index);
+            if (!sample) {
+                out = m4_window_t{};
+                return false;
+            }
+            const std::int64_t ts_ns = access.timestamp(sample);
+            if (have_previous_timestamp && ts_ns < previous_timestamp) {
+                out = m4_window_t{};
+                return false;
+            }
+            previous_timestamp      = ts_ns;
+            have_previous_timestamp = true;
+
+            sample_draw_value_t value;
+            if (read_sample_draw_value(access, sample, window.nonfinite_policy, value) !=
+                sample_draw_status_t::DRAWABLE)
+            {
+                out = m4_window_t{};
+                return false;
+            }
+
+            const std::int64_t sample_column = column_of(ts_ns);
+            if (!have_bucket || sample_column != column) {
+                if (have_bucket) {
+                    flush_bucket();
+                }
+                column       = sample_column;
+                bucket_first = index;
+                bucket_min   = index;
+                bucket_max   = index;
+                min_y        = value.y_min;
+                max_y        = value.y_max;
+                have_bucket  = true;
+            }
+            // Range samples carry their own extent; plain values have
+            // y_min == y_max == y.
+            if (value.y_min < min_y) { min_y = value.y_min; bucket_min = index; }
+            if (value.y_max > max_y) { max_y = value.y_max; bucket_max = index; }
+            bucket_last = index;
+        }
+        flush_bucket();
+
+        if (has_hold) {
+            out.source_indices.push_back(span.source_first + span.source_count - 1u);
+        }
+        out_span.gpu_count = out.source_indices.size() - out_span.gpu_first;
+        out.gpu_count      = out.source_indices.size();
+        out.spans.push_back(out_span);
+    }
+
+    if (out.gpu_count >= window.gpu_count) {
+        out = m4_window_t{};
+        return false;
+    }
+    return true;
+}
+
+bool cull_window_dots(
+    const sample_window_t&     window,
+    m4_window_t&               out)
+{
+    out = m4_window_t{};
+    if (!window.snapshot                     ||
+        !window.access                       ||
+        window.drawable_spans.empty()        ||
+        !std::isfinite(window.width_px)      ||
+        !std::isfinite(window.height_px)     ||
+        !std::isfinite(window.y_offset_px)   ||
+        !(window.width_px  > 0.0f)           ||
+        !(window.height_px > 0.0f)           ||
+        !(window.v_max > window.v_min)       ||
+        window.t_max_ns <= window.t_min_ns)
+    {
+        return false;
+    }
+
+    const erased_access_policy_t access = make_erased_access_policy_view(*window.access);
+    if (!access.has_timestamp()) {
+        return false;
+    }
+
+    // One extra row: a fractional y_offset_px moves the view's rows across
+    // one more pixel boundary.
+    const std::size_t width  = static_cast<std::size_t>(std::ceil(window.width_px));
+    const std::size_t height = static_cast<std::size_t>(std::ceil(window.height_px)) + 1u;
+    if (width > k_density_max_grid_side || height > k_density_max_grid_side) {
+        return false;
+    }
+
+    std::vector<std::uint64_t> occupied;
+    try {
+        occupied.assign((width * height + 63u) / 64u, 0u);
+    }
+    catch (const std::bad_alloc&) {
+        return false;
+    }
+
+    const long double px_per_ns =
+        static_cast<long double>(window.width_px) /
+        span_ns_as_long_double(window.t_min_ns, window.t_max_ns);
+    const double px_per_value =
+        static_cast<double>(window.height_px) /
+        (static_cast<double>(window.v_max) - static_cast<double>(window.v_min));
+    const double first_row = std::floor(static_cast<double>(window.y_offset_px));
+
+    out.spans.reserve(window.drawable_spans.size());
+    for (std::size_t span_index = 0; span_index < window.drawable_spans.size(); ++span_index) {
+        const drawable_sample_span_t& span       = window.drawable_spans[span_index];
+        const bool                    final_span = span_index + 1u == window.drawable_spans.size();
+        const bool                    has_hold   = final_span && window.synthetic_hold_count == 1;
+        if (span.source_count == 0) {
+            out = m4_window_t{};
+            return false;
+        }
+
+        drawable_sample_span_t out_span = span;
+        out_span.gpu_first = out.gpu_count;
+
+        for (std::size_t i = 0; i < span.source_count; ++i) {
+            const std::size_t index  = span.source_first + i;
+            const void*       sample = window.snapshot.at(index);
+            if (!sample) {
+                out = m4_window_t{};
+                return false;
+            }
+
+            sample_draw_value_t value;
+            if (read_sample_draw_value(access, sample, window.nonfinite_policy, value) !=
+                sample_draw_status_t::DRAWABLE)
+            {
+                out = m4_window_t{};
+                return false;
+            }
+
+            const long double x = std::floor(
+                span_ns_as_long_double(window.t_min_ns, access.timestamp(sample)) * px_per_ns);
+            const double y = std::floor(
+                (static_cast<double>(window.v_max) - static_cast<double>(value.y)) * px_per_value +
+                static_cast<double>(window.y_offset_px)) - first_row;
+            if (x >= 0.0L && x < static_cast<long double>(width) &&
+                y >= 0.0  && y < static_cast<double>(height))
+            {
+                const std::size_t cell =
+                    static_cast<std::size_t>(y) * width + static_cast<std::size_t>(x);
+                std::uint64_t&      word = occupied[cell / 64u];
+                const std::uint64_t bit  = std::uint64_t{1} << (cell % 64u);
+                if (word & bit) {
+                    continue;
+                }
+                word |= bit;
+            }
+            out.source_indices.push_back(index);
+        }
+        // Every span keeps a real slot, even when earlier spans already
+        // cover all of its cells.
+        if (out.source_indices.size() == out_span.gpu_first) {
+            out.source_indices.push_back(span.source_first);
+        }
+
+        if (has_hold) {
+            out.source_indices.push_back(span.source_first + span.source_count - 1u);
+        }
+        out_span.gpu_count = out.source_indices.size() - out_span.gpu_first;
+        out.gpu_count      = out.source_indices.size();
+        out.spans.push_back(out_span);
+    }
+
+    if (out.gpu_count >= window.gpu_count) {
+        out = m4_window_t{};
+        return false;
+    }
+    return true;
+}
+
+// Source samples per range below which density binning stays serial. A range
+// is never smaller than the grid, so merging the per-range grids costs no
+// more than binning into them.
+constexpr std::size_t k_density_parallel_min_samples_per_range = 65'536;
+
+bool bin_window_density(
+    const sample_window_t&     window,
+    std::size_t                lod_scale,
+    density_grid_t&            out)
+{
+    out.width          = 0;
+    out.height         = 0;
+    out.max_count      = 0.0f;
+    out.binned_samples = 0;
+    out.counts.clear();
+    if (!window.snapshot                     ||
+        !window.access                       ||
+        window.source_count == 0             ||
+        !std::isfinite(window.width_px)      ||
+        !std::isfinite(window.height_px)     ||
+        !(window.width_px  >= 1.0f)          ||
+        !(window.height_px >= 1.0f)          ||
+        !(window.v_max > window.v_min)       ||
+        window.t_max_ns <= window.t_min_ns)
+    {
+        return false;
+    }
+
+    const erased_access_policy_t access = make_erased_access_policy_view(*window.access);
+    if (!access.has_timestamp()) {
+        return false;
+    }
+
+    const std::size_t width = std::min<std::size_t>(
+        static_cast<std::size_t>(std::ceil(window.width_px)),  k_density_max_grid_side);
+    const std::size_t height = std::min<std::size_t>(
+        static_cast<std::size_t>(std::ceil(window.height_px)), k_density_max_grid_side);
+    const std::size_t cell_count = width * height;
+
+    const std::size_t min_samples_per_range = std::max(
+        k_density_parallel_min_samples_per_range, cell_count);
+    const std::size_t range_count =
+        parallel_range_count(window.source_count, min_samples_per_range);
+
+    // Range 0 bins straight into `out`; every other range into its own grid.
+    std::vector<std::vector<float>> partial_counts;
+    std::vector<std::size_t>        partial_binned(range_count, 0);
+    try {
+        out.counts.assign(cell_count, 0.0f);
+        partial_counts.resize(range_count - 1u);
+        for (auto& counts : partial_counts) {
+            counts.assign(cell_count, 0.0f);
+        }
+    }
+    catch (const std::bad_alloc&) {
+        out.counts.clear();
+        return false;
+    }
+
+    const long double col_per_ns =
+        static_cast<long double>(width) /
+        span_ns_as_long_double(window.t_min_ns, window.t_max_ns);
+    const double row_per_value =
+        static_cast<double>(height) /
+        (static_cast<double>(window.v_max) - static_cast<double>(window.v_min));
+    const double last_row = static_cast<double>(height - 1u);
+    const float  weight   = static_cast<float>(std::max<std::size_t>(lod_scale, 1u));
+    const auto row_of = [&](float y) {
+        return (static_cast<double>(window.v_max) - static_cast<double>(y)) * row_per_value;
+    };
+
+    parallel_for_ranges(window.source_count, min_samples_per_range,
+        [&](std::size_t range, std::size_t first, std::size_t last) {
+            float* const counts = range == 0
+                ? out.counts.data()
+                : partial_counts[range - 1u].data();
+            std::size_t binned = 0;
+            for (std::size_t i = first; i < last; ++i) {
+                const void* sample = window.snapshot.at(window.source_first + i);
+                if (!sample) {
+                    continue;
+                }
+                sample_draw_value_t value;
+                if (read_sample_draw_value(access, sample, window.nonfinite_policy, value) !=
+                    sample_draw_status_t::DRAWABLE)
+                {
+                    continue;
+                }
+
+                const long double column = span_ns_as_long_double(
+                    window.t_min_ns, access.timestamp(sample)) * col_per_ns;
+                if (!(column >= 0.0L) || column >= static_cast<long double>(width)) {
+                    continue;
+                }
+
+                // Range lanes that do not bracket the value (or are absent)
+                // collapse to the value itself.
+                float lo = std::min(value.y_min, value.y_max);
+                float hi = std::max(value.y_min, value.y_max);
+                if (!(lo <= value.y && value.y <= hi)) {
+                    lo = value.y;
+                    hi = value.y;
+                }
+                const double top    = std::floor(row_of(hi));
+                const double bottom = std::min(std::floor(row_of(lo)), last_row);
+                if (!(bottom >= 0.0) || top > last_row) {
+                    continue;
+                }
+                const std::size_t row_first = static_cast<std::size_t>(std::max(top, 0.0));
+                const std::size_t row_last  = static_cast<std::size_t>(bottom);
+                const float       share     =
+                    weight / static_cast<float>(row_last - row_first + 1u);
+                float* cell = counts + row_first * width + static_cast<std::size_t>(column);
+                for (std::size_t row = row_first; row <= row_last; ++row, cell += width) {
+                    *cell += share;
+                }
+                ++binned;
+            }
+            partial_binned[range] = binned;
+        });
+
+    for (const auto& counts : partial_counts) {
+        for (std::size_t cell = 0; cell < cell_count; ++cell) {
+            out.counts[cell] += counts[cell];
+        }
+    }
+    for (const float count : out.counts) {
+        out.max_count = std::max(out.max_count, count);
+    }
+    for (const std::size_t binned : partial_binned) {
+        out.binned_samples += binned;
+    }
+    out.width  = width;
+    out.height = height;
+    return true;
+}
+
 std::size_t stack_timestamp_budget(double width_px, std::size_t layer_count)
 {
     if (layer_count == 0) {
@@ -1301,10 +1869,16 @@ bool prefer_binary_stack_lookup(
         estimated_reads < source.source_count;
 }
 
+// current_first/next_first are the raw offsets of the first sample of the
+// current/next timestamp run of an ascending source; a hold reports
+// source_count.
 struct stack_source_cursor_t
 {
-    const stack_source_view_t* source       = nullptr;
-    std::size_t                raw_offset   = 0;
+    const stack_source_view_t* source        = nullptr;
+    std::size_t                raw_offset    = 0;
+    std::size_t                current_first = 0;
+    std::size_t                next_first    = 0;
+    std::size_t                pending_first = 0;
     bool                       hold_pending = false;
     bool                       with_value   = false;
     bool                       failed       = false;
@@ -1328,11 +1902,12 @@ struct stack_source_cursor_t
         return true;
     }
 
-    bool read_next(stack_point_t& out)
+    bool read_next(stack_point_t& out, std::size_t& out_first)
     {
         if (source->reversed && hold_pending) {
             hold_pending = false;
             out          = source->hold;
+            out_first    = source->source_count;
             return accept(out);
         }
 
@@ -1341,12 +1916,15 @@ struct stack_source_cursor_t
         {
             if (has_pending) {
                 out         = pending;
+                out_first   = pending_first;
                 has_pending = false;
             }
-            else
-            if (!source->read(raw_offset++, with_value, out)) {
-                failed = true;
-                return false;
+            else {
+                out_first = raw_offset;
+                if (!source->read(raw_offset++, with_value, out)) {
+                    failed = true;
+                    return false;
+                }
             }
             while (raw_offset < source->source_count) {
                 stack_point_t candidate;
@@ -1355,8 +1933,9 @@ struct stack_source_cursor_t
                     return false;
                 }
                 if (candidate.t != out.t) {
-                    pending     = candidate;
-                    has_pending = true;
+                    pending       = candidate;
+                    pending_first = raw_offset - 1u;
+                    has_pending   = true;
                     break;
                 }
                 if (with_value) {
@@ -1376,6 +1955,7 @@ struct stack_source_cursor_t
                 failed = true;
                 return false;
             }
+            out_first = raw_offset;
             while (raw_offset > 0) {
                 stack_point_t candidate;
                 if (!source->read(--raw_offset, with_value, candidate)) {
@@ -1394,15 +1974,20 @@ struct stack_source_cursor_t
         if (!source->reversed && hold_pending) {
             hold_pending = false;
             out          = source->hold;
+            out_first    = source->source_count;
             return accept(out);
         }
         return false;
     }
 
-    bool reset(const stack_source_view_t& view, bool read_values)
+    // first_offset starts an ascending cursor part way into the window.
+    bool reset(
+        const stack_source_view_t& view,
+        bool                       read_values,
+        std::size_t                first_offset = 0)
     {
         source       = &view;
-        raw_offset   = view.reversed ? view.source_count : 0;
+        raw_offset   = view.reversed ? view.source_count : first_offset;
         hold_pending = view.has_hold;
         with_value   = read_values;
         failed       = false;
@@ -1410,16 +1995,17 @@ struct stack_source_cursor_t
         emitted      = false;
         has_pending  = false;
         last_t       = 0;
-        has_current  = read_next(current);
-        has_next     = has_current && read_next(next);
+        has_current  = read_next(current, current_first);
+        has_next     = has_current && read_next(next, next_first);
         return has_current && !failed;
     }
 
     void advance()
     {
-        current     = next;
-        has_current = has_next;
-        has_next    = has_current && read_next(next);
+        current       = next;
+        current_first = next_first;
+        has_current   = has_next;
+        has_next      = has_current && read_next(next, next_first);
     }
 };
 
@@ -1460,6 +2046,188 @@ Stack_rejection_reason validated_rejection(
     return reason == Stack_rejection_reason::NONE ? fallback : reason;
 }
 
+// Output samples per grid chunk below which the layer pass stays serial.
+constexpr std::size_t k_stack_parallel_min_samples_per_range = 65'536;
+
+// Fills every layer of `layers` for `timestamps` with the grid split into
+// contiguous chunks composed on separate threads. Each chunk computes all
+// layers of its timestamps in layer order; streaming cursors start at the run
+// holding the chunk's first timestamp and walk up to the next chunk's start,
+// so together they read and order-check every source sample, as the serial
+// pass does. Returns false, with `layers` unspecified, when the grid
+// is too small to split, a streamed source is reversed, or any chunk fails;
+// the caller then runs the serial pass, which owns rejection reasons.
+bool compose_stack_layers_parallel(
+    const std::vector<const Series_view_plan*>&    plans,
+    const std::vector<stack_source_view_t>&        sources,
+    const std::vector<std::int64_t>&               timestamps,
+    bool                                           resampled,
+    std::vector<std::vector<stacked_sample_t>>&    layers,
+    std::size_t&                                   source_read_count)
+{
+    const std::size_t layer_count     = sources.size();
+    const std::size_t timestamp_count = timestamps.size();
+    const std::size_t min_timestamps  = std::max<std::size_t>(
+        1u, k_stack_parallel_min_samples_per_range / std::max<std::size_t>(layer_count, 1u));
+    const std::size_t range_count =
+        parallel_range_count(timestamp_count, min_timestamps);
+    if (layer_count == 0 || range_count <= 1) {
+        return false;
+    }
+
+    std::vector<char> binary_lookup(layer_count, 0);
+    for (std::size_t layer = 0; layer < layer_count; ++layer) {
+        binary_lookup[layer] = resampled &&
+            prefer_binary_stack_lookup(sources[layer], timestamp_count);
+        if (!binary_lookup[layer] && sources[layer].reversed) {
+            return false;
+        }
+    }
+
+    // chunk_first[layer * (range_count + 1) + range] is the raw offset the
+    // streaming cursor of `range` starts at; the last entry bounds the
+    // final chunk.
+    std::size_t              seek_reads = 0;
+    std::vector<std::size_t> chunk_first(layer_count * (range_count + 1u), 0);
+    for (std::size_t layer = 0; layer < layer_count; ++layer) {
+        if (binary_lookup[layer]) {
+            continue;
+        }
+        stack_source_view_t source = sources[layer];
+        source.source_reads        = &seek_reads;
+        std::size_t* first         = &chunk_first[layer * (range_count + 1u)];
+        first[range_count]         = source.logical_count();
+        for (std::size_t range = 1; range < range_count; ++range) {
+            const std::int64_t timestamp = timestamps[
+                parallel_range_begin(timestamp_count, range_count, range)];
+            std::size_t   end = 0;
+            stack_point_t run;
+            if (!upper_bound_timestamp(source, timestamp, end) || end == 0 ||
+                !source.read_logical(end - 1u, false, run)                 ||
+                !lower_bound_timestamp(source, run.t, first[range])        ||
+                first[range] < first[range - 1u])
+            {
+                return false;
+            }
+        }
+    }
+
+    for (auto& layer : layers) {
+        layer.resize(timestamp_count);
+    }
+    std::vector<std::size_t> range_reads(range_count, 0);
+    std::vector<char>        range_failed(range_count, 0);
+    parallel_for_ranges(timestamp_count, min_timestamps,
+        [&](std::size_t range, std::size_t first, std::size_t last) {
+            try {
+                std::vector<stack_source_view_t> local(sources);
+                for (auto& source : local) {
+                    source.source_reads = &range_reads[range];
+                }
+                for (std::size_t layer = 0; layer < layer_count; ++layer) {
+                    const Series_interpolation interpolation = plans[layer]->interpolation;
+                    std::vector<stacked_sample_t>& out = layers[layer];
+                    const auto store = [&](std::size_t sample, float value) {
+                        const float base = layer == 0
+                            ? 0.0f
+                            : layers[layer - 1u][sample].value;
+                        const float cumulative = base + value;
+                        if (!std::isfinite(cumulative)) {
+                            return false;
+                        }
+                        out[sample] = {timestamps[sample], cumulative, base};
+                        return true;
+                    };
+
+                    if (binary_lookup[layer]) {
+                        for (std::size_t sample = first; sample < last; ++sample) {
+                            float value = 0.0f;
+                            if (!binary_stack_value(
+                                    local[layer], interpolation, timestamps[sample], value) ||
+                                !store(sample, value))
+                            {
+                                range_failed[range] = 1;
+                                return;
+                            }
+                        }
+                        continue;
+                    }
+
+                    const std::size_t*    bounds = &chunk_first[layer * (range_count + 1u)];
+                    stack_source_cursor_t cursor;
+                    if (!cursor.reset(local[layer], true, bounds[range])) {
+                        range_failed[range] = 1;
+                        return;
+                    }
+                    for (std::size_t sample = first; sample < last; ++sample) {
+                        const std::int64_t timestamp = timestamps[sample];
+                        while (cursor.has_next && cursor.next.t <= timestamp) {
+                            cursor.advance();
+                        }
+                        if (cursor.failed || cursor.nonmonotonic || !cursor.has_current) {
+                            range_failed[range] = 1;
+                            return;
+                        }
+                        float value = cursor.current.v;
+                        if (interpolation == Series_interpolation::LINEAR &&
+                            cursor.has_next && timestamp > cursor.current.t)
+                        {
+                            const stack_point_t& a = cursor.current;
+                            const stack_point_t& b = cursor.next;
+                            const double position  =
+                                normalized_time_position_ns(a.t, timestamp, b.t);
+                            value = static_cast<float>(a.v + position * (b.v - a.v));
+                        }
+                        if (!store(sample, value)) {
+                            range_failed[range] = 1;
+                            return;
+                        }
+                    }
+
+                    // Walk up to the next chunk's first run so every sample
+                    // is read and order-checked by at least one chunk.
+                    if (range + 1u == range_count) {
+                        while (cursor.has_next) {
+                            cursor.advance();
+                        }
+                    }
+                    else {
+                        const std::size_t bound = bounds[range + 1u];
+                        while (cursor.current_first < bound &&
+                            cursor.has_next && cursor.next_first < bound)
+                        {
+                            cursor.advance();
+                        }
+                        if (cursor.current_first != bound &&
+                            (!cursor.has_next || cursor.next_first != bound))
+                        {
+                            range_failed[range] = 1;
+                            return;
+                        }
+                    }
+                    if (cursor.failed || cursor.nonmonotonic) {
+                        range_failed[range] = 1;
+                        return;
+                    }
+                }
+            }
+            catch (...) {
+                range_failed[range] = 1;
+            }
+        });
+
+    if (std::any_of(range_failed.begin(), range_failed.end(), [](char f) { return f != 0; })) {
+        return false;
+    }
+    range_reads.push_back(seek_reads);
+    for (const std::size_t reads : range_reads) {
+        if (!checked_size_add(source_read_count, reads, source_read_count)) {
+            source_read_count = std::numeric_limits<std::size_t>::max();
+        }
+    }
+    return true;
+}
+
 Stack_rejection_reason compose_stacked_series_impl(
     const std::vector<const Series_view_plan*>&    plans,
     const std::vector<Time_order>*                 selected_time_orders,
@@ -1618,6 +2386,15 @@ Stack_rejection_reason compose_stacked_series_impl(
         stats->resampled       = resampled;
     }
 
+    layers.assign(plans.size(), {});
+    if (compose_stack_layers_parallel(
+            plans, sources, timestamps, resampled, layers, source_read_count))
+    {
+        if (stats) {
+            stats->source_read_count = source_read_count;
+        }
+        return Stack_rejection_reason::NONE;
+    }
     layers.assign(plans.size(), {});
     for (auto& layer : layers) {
         layer.reserve(timestamps.size());
@@ -1727,6 +2504,277 @@ Stack_rejection_reason compose_stacked_series_impl(
     return Stack_rejection_reason::NONE;
 }
 
+stack_member_extent_t make_stack_member_extent(
+    const Series_view_plan&    plan,
+    const stack_source_view_t& source,
+    const stack_point_t&       last)
+{
+    stack_member_extent_t extent;
+    extent.identity         = plan.source ? plan.source->identity() : nullptr;
+    extent.access_key       = make_access_policy_cache_key(plan.access, source.access);
+    extent.lod_level        = plan.lod_level;
+    extent.nonfinite_policy = plan.nonfinite_policy;
+    extent.prefix_revision  = plan.snapshot.snapshot.prefix_revision;
+    extent.last_t           = last.t;
+    extent.last_v           = last.v;
+    return extent;
+}
+
+// Extends `cache` to `plans` when every member only appended samples, as its
+// source vouches through an unchanged nonzero prefix_revision. The cached
+// timestamps end at the oldest member's previous last sample and depend only
+// on unchanged samples, so they stay where they are; the merge and
+// interpolation run past it and the tail is appended to the cached storage,
+// in place while capacity allows. Returns false, leaving `cache` untouched
+// and `members` unspecified, when the composition cannot be extended.
+bool extend_stacked_composition(
+    const std::vector<const Series_view_plan*>&    plans,
+    const std::vector<Time_order>&                 selected_time_orders,
+    stack_composition_cache_t&                     cache,
+    std::size_t                                    timestamp_budget,
+    std::vector<stack_member_extent_t>&            members,
+    stack_composition_stats_t&                     stats)
+{
+    const std::size_t layer_count = plans.size();
+    if (layer_count < 2                          ||
+        cache.resampled                          ||
+        cache.count == 0                         ||
+        cache.members.size() != layer_count      ||
+        cache.layers.size()  != layer_count      ||
+        selected_time_orders.size() != layer_count)
+    {
+        return false;
+    }
+    for (const auto& layer : cache.layers) {
+        if (!layer || layer->size() != cache.first + cache.count) {
+            return false;
+        }
+    }
+
+    std::size_t                      source_read_count = 0;
+    std::vector<stack_source_view_t> sources(layer_count);
+    std::int64_t                     stable_end = 0;
+    members.assign(layer_count, {});
+    for (std::size_t layer = 0; layer < layer_count; ++layer) {
+        if (!plans[layer]) {
+            return false;
+        }
+        const Series_view_plan& plan = *plans[layer];
+        stack_source_view_t&    source = sources[layer];
+        if (plan.interpolation != cache.interpolation ||
+            make_stack_source_view(
+                plan, selected_time_orders[layer], source, &source_read_count) !=
+                Stack_rejection_reason::NONE ||
+            source.reversed)
+        {
+            return false;
+        }
+
+        stack_point_t last;
+        if (!source.read(source.source_count - 1u, true, last)) {
+            return false;
+        }
+        members[layer] = make_stack_member_extent(plan, source, last);
+
+        // The source must promise an append-only change; the previous last
+        // sample is checked on top so a broken promise still recomposes.
+        const stack_member_extent_t& before = cache.members[layer];
+        std::size_t                  end    = 0;
+        stack_point_t                anchor;
+        if (before.identity == nullptr                                ||
+            before.prefix_revision  == 0                               ||
+            before.prefix_revision  != members[layer].prefix_revision  ||
+            before.identity         != members[layer].identity         ||
+            before.access_key       != members[layer].access_key       ||
+            before.lod_level        != members[layer].lod_level        ||
+            before.nonfinite_policy != members[layer].nonfinite_policy ||
+            last.t < before.last_t                                     ||
+            !upper_bound_timestamp(source, before.last_t, end)         ||
+            end == 0                                                   ||
+            end > source.source_count                                  ||
+            !source.read(end - 1u, true, anchor)                       ||
+            anchor.t != before.last_t                                  ||
+            anchor.v != before.last_v)
+        {
+            return false;
+        }
+        stable_end = layer == 0 ? before.last_t : std::min(stable_end, before.last_t);
+    }
+
+    std::int64_t overlap_start = sources.front().first_t;
+    std::int64_t overlap_end   = sources.front().last_t;
+    for (const auto& source : sources) {
+        overlap_start = std::max(overlap_start, source.first_t);
+        overlap_end   = std::min(overlap_end, source.last_t);
+    }
+    const stacked_sample_t* cached_front =
+        cache.layers.front()->data() + cache.first;
+    const stacked_sample_t* cached_end   = cached_front + cache.count;
+    if (overlap_end < overlap_start               ||
+        overlap_start < cached_front->timestamp_ns ||
+        overlap_start > stable_end)
+    {
+        return false;
+    }
+
+    // The cached union ends at the previous overlap end, which is
+    // `stable_end`; only the window start may have moved forward.
+    const auto timestamp_less = [](const stacked_sample_t& sample, std::int64_t t) {
+        return sample.timestamp_ns < t;
+    };
+    const std::size_t reuse_first = static_cast<std::size_t>(
+        std::lower_bound(cached_front, cached_end, overlap_start, timestamp_less) -
+        cached_front);
+    if (reuse_first >= cache.count ||
+        (cached_end - 1)->timestamp_ns != stable_end)
+    {
+        return false;
+    }
+    const std::size_t reuse_count = cache.count - reuse_first;
+
+    // Merge the tail of the timestamp union past `stable_end`.
+    std::vector<std::int64_t>          tail;
+    std::vector<stack_source_cursor_t> merge_cursors(layer_count);
+    for (std::size_t i = 0; i < layer_count; ++i) {
+        std::size_t first = 0;
+        if (!upper_bound_timestamp(sources[i], stable_end, first)) {
+            return false;
+        }
+        merge_cursors[i].reset(sources[i], false, std::min(first, sources[i].source_count));
+        if (merge_cursors[i].failed || merge_cursors[i].nonmonotonic) {
+            return false;
+        }
+    }
+    for (;;) {
+        bool         found = false;
+        std::int64_t next  = 0;
+        for (const auto& cursor : merge_cursors) {
+            if (cursor.has_current && (!found || cursor.current.t < next)) {
+                next  = cursor.current.t;
+                found = true;
+            }
+        }
+        if (!found || next > overlap_end) {
+            break;
+        }
+        if (reuse_count + tail.size() == timestamp_budget) {
+            return false;
+        }
+        tail.push_back(next);
+        for (auto& cursor : merge_cursors) {
+            while (cursor.has_current && cursor.current.t == next) {
+                cursor.advance();
+            }
+            if (cursor.failed || cursor.nonmonotonic) {
+                return false;
+            }
+        }
+    }
+
+    const std::size_t timestamp_count = reuse_count + tail.size();
+    std::size_t       output_samples  = 0;
+    if (tail.empty() ||
+        !checked_size_product(layer_count, timestamp_count, output_samples) ||
+        output_samples > k_stack_max_output_samples_per_view)
+    {
+        return false;
+    }
+
+    // Interpolate the tail of every layer before touching the cache, so a
+    // failure leaves it as it was.
+    std::vector<std::vector<stacked_sample_t>> tails(layer_count);
+    for (std::size_t layer = 0; layer < layer_count; ++layer) {
+        std::vector<stacked_sample_t>& out = tails[layer];
+        out.reserve(tail.size());
+
+        std::size_t end = 0;
+        if (!upper_bound_timestamp(sources[layer], tail.front(), end) || end == 0) {
+            return false;
+        }
+        stack_source_cursor_t cursor;
+        if (!cursor.reset(
+                sources[layer], true, std::min(end - 1u, sources[layer].source_count - 1u)))
+        {
+            return false;
+        }
+        for (std::size_t sample = 0; sample < tail.size(); ++sample) {
+            const std::int64_t timestamp = tail[sample];
+            while (cursor.has_next && cursor.next.t <= timestamp) {
+                cursor.advance();
+            }
+            if (cursor.failed || cursor.nonmonotonic || !cursor.has_current) {
+                return false;
+            }
+            float value = cursor.current.v;
+            if (plans[layer]->interpolation == Series_interpolation::LINEAR &&
+                cursor.has_next && timestamp > cursor.current.t)
+            {
+                const stack_point_t& a = cursor.current;
+                const stack_point_t& b = cursor.next;
+                const double position  =
+                    normalized_time_position_ns(a.t, timestamp, b.t);
+                value = static_cast<float>(a.v + position * (b.v - a.v));
+            }
+            const float base = layer == 0
+                ? 0.0f
+                : tails[layer - 1u][sample].value;
+            const float cumulative = base + value;
+            if (!std::isfinite(cumulative)) {
+                return false;
+            }
+            out.push_back({timestamp, cumulative, base});
+        }
+
+        // Appended samples past the overlap must still be readable and ordered.
+        while (cursor.has_next) {
+            cursor.advance();
+        }
+        if (cursor.failed || cursor.nonmonotonic) {
+            return false;
+        }
+    }
+
+    // When any layer lacks room for the tail, every layer moves to a new
+    // buffer with headroom, dropping samples before the window; earlier
+    // snapshots keep the old buffers alive. Allocation happens before any
+    // layer is modified, and the layers keep sharing one `first`.
+    const std::size_t new_first = cache.first + reuse_first;
+    const bool        regrow    = std::any_of(
+        cache.layers.begin(),
+        cache.layers.end(),
+        [&](const auto& storage) {
+            return storage->capacity() - storage->size() < tail.size();
+        });
+    if (regrow) {
+        std::vector<std::shared_ptr<std::vector<stacked_sample_t>>> grown;
+        grown.reserve(layer_count);
+        for (const auto& storage : cache.layers) {
+            auto replacement = std::make_shared<std::vector<stacked_sample_t>>();
+            replacement->reserve(2u * timestamp_count);
+            replacement->insert(
+                replacement->end(),
+                storage->begin() + static_cast<std::ptrdiff_t>(new_first),
+                storage->end());
+            grown.push_back(std::move(replacement));
+        }
+        cache.layers.swap(grown);
+    }
+    for (std::size_t layer = 0; layer < layer_count; ++layer) {
+        // Within capacity: writes land past every published sample.
+        cache.layers[layer]->insert(
+            cache.layers[layer]->end(), tails[layer].begin(), tails[layer].end());
+    }
+    cache.first = regrow ? 0 : new_first;
+    cache.count = timestamp_count;
+
+    stats.timestamp_count        = timestamp_count;
+    stats.source_read_count      = source_read_count;
+    stats.resampled              = false;
+    stats.extended               = true;
+    stats.reused_timestamp_count = reuse_count;
+    return true;
+}
+
 Stack_rejection_reason compose_stacked_series_checked(
     const std::vector<const Series_view_plan*>&    plans,
     const std::vector<Time_order>*                 selected_time_orders,
@@ -1780,6 +2828,82 @@ Stack_rejection_reason compose_stacked_series(
         plans, &selected_time_orders, layers, timestamp_budget, stats);
 }
 
+Stack_rejection_reason compose_stacked_series(
+    const std::vector<const Series_view_plan*>&    plans,
+    const std::vector<Time_order>&                 selected_time_orders,
+    stack_composition_cache_t&                     cache,
+    std::size_t                                    timestamp_budget,
+    stack_composition_stats_t*                     stats)
+{
+    stack_composition_stats_t                  local_stats;
+    std::vector<std::vector<stacked_sample_t>> layers;
+    std::vector<stack_member_extent_t>         members;
+    bool                                       extended = false;
+    try {
+        extended = extend_stacked_composition(
+            plans, selected_time_orders, cache, timestamp_budget, members, local_stats);
+    }
+    catch (const std::bad_alloc&) {
+    }
+    catch (const std::length_error&) {
+    }
+
+    if (extended) {
+        cache.members = std::move(members);
+        if (stats) {
+            *stats = local_stats;
+        }
+        return Stack_rejection_reason::NONE;
+    }
+
+    local_stats = {};
+    members.clear();
+    const Stack_rejection_reason reason = compose_stacked_series_checked(
+        plans, &selected_time_orders, layers, timestamp_budget, &local_stats);
+    if (reason != Stack_rejection_reason::NONE) {
+        cache = {};
+        if (stats) {
+            *stats = local_stats;
+        }
+        return reason;
+    }
+
+    // Only exact ascending compositions can be extended later.
+    if (!local_stats.resampled) {
+        members.reserve(plans.size());
+        for (std::size_t layer = 0; layer < plans.size(); ++layer) {
+            stack_source_view_t source;
+            stack_point_t       last;
+            if (make_stack_source_view(
+                    *plans[layer], selected_time_orders[layer], source, nullptr) !=
+                    Stack_rejection_reason::NONE ||
+                source.reversed ||
+                !source.read(source.source_count - 1u, true, last))
+            {
+                members.clear();
+                break;
+            }
+            members.push_back(make_stack_member_extent(*plans[layer], source, last));
+        }
+    }
+
+    cache.layers.clear();
+    cache.layers.reserve(layers.size());
+    for (auto& layer : layers) {
+        cache.layers.push_back(
+            std::make_shared<std::vector<stacked_sample_t>>(std::move(layer)));
+    }
+    cache.first         = 0;
+    cache.count         = cache.layers.empty() ? 0 : cache.layers.front()->size();
+    cache.members       = std::move(members);
+    cache.interpolation = plans.front()->interpolation;
+    cache.resampled     = local_stats.resampled;
+    if (stats) {
+        *stats = local_stats;
+    }
+    return Stack_rejection_reason::NONE;
+}
+
 const Data_access_policy& stacked_sample_access()
 {
     static const Data_access_policy access = [] {
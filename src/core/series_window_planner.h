@@ -30,6 +30,26 @@ enum class Timestamp_window_search
     LINEAR,
 };
 
+// Timestamp-order classification of one LOD level's snapshot.
+struct timestamp_order_entry_t
+{
+    bool                       valid        = false;
+    std::size_t                level        = 0;
+    std::uint64_t              sequence     = 0;
+    const void*                identity     = nullptr;
+    access_policy_cache_key_t  access_key;
+    Time_order                 source_order = Time_order::UNKNOWN;
+    bool                       monotonic    = true;
+    // Extent of the classified snapshot. A later snapshot of the same level
+    // is treated as an append, and only its new suffix is scanned, when it
+    // carries the same nonzero data_snapshot_t::prefix_revision, is at least
+    // this long and reproduces both end timestamps.
+    std::uint64_t              prefix_revision = 0;
+    std::size_t                sample_count    = 0;
+    std::int64_t               first_timestamp = 0;
+    std::int64_t               last_timestamp  = 0;
+};
+
 struct series_window_planner_state_t
 {
     static constexpr std::int64_t k_no_timestamp =
@@ -42,7 +62,17 @@ struct series_window_planner_state_t
     const void*                last_timestamp_order_identity       = nullptr;
     access_policy_cache_key_t  last_timestamp_order_access_key;
     Time_order                 last_timestamp_source_order         = Time_order::UNKNOWN;
+    std::size_t                last_timestamp_order_level          = 0;
+    std::uint64_t              last_timestamp_order_prefix_revision = 0;
+    std::size_t                last_timestamp_order_sample_count   = 0;
+    std::int64_t               last_timestamp_order_first_ts       = 0;
+    std::int64_t               last_timestamp_order_last_ts        = 0;
+    // Classification of the LOD level the view last switched away from.
+    // Adopted instead of rescanning when the view switches back to it.
+    timestamp_order_entry_t    neighbor_timestamp_order;
+    bool                       last_timestamp_order_from_neighbor  = false;
     bool                       last_timestamp_order_scan_performed = false;
+    bool                       last_timestamp_order_scan_incremental = false;
     std::size_t                last_timestamp_order_scan_samples   = 0;
     bool                       last_timestamps_monotonic           = true;
     Time_order                 last_selected_time_order            = Time_order::UNKNOWN;
@@ -64,6 +94,7 @@ struct series_window_planner_state_t
     Nonfinite_sample_policy last_nonfinite_policy =
         Nonfinite_sample_policy::BREAK_SEGMENT;
     double                     last_applied_pps          = 0.0;
+    double                     last_lod_pps_target       = 1.0;
     bool                       last_hold_last_forward    = false;
     Series_interpolation       last_interpolation        = Series_interpolation::LINEAR;
     std::size_t                last_source_count         = 0;
@@ -108,11 +139,93 @@ struct series_window_plan_request_t
     Series_interpolation       interpolation        = Series_interpolation::LINEAR;
     Snapshot_requirement       snapshot_requirement = Snapshot_requirement::Optional;
     bool                       has_uploaded_vbo     = false;
+    // LOD hysteresis in pixels per sample; see choose_lod_level().
+    double                     lod_hysteresis       = 0.0;
+    // Pixels per sample the LOD choice aims for; above 1 prefers coarser
+    // levels (adaptive LOD, see next_adaptive_lod_bias()).
+    double                     lod_pps_target       = 1.0;
     Profiler*                  profiler             = nullptr;
 };
 
 Series_view_plan plan_series_window(const series_window_plan_request_t& request);
 
+// Adaptive LOD (Plot_config::adaptive_lod_budget_ms). `bias` is the log2 of
+// the pixels per sample the LOD choice aims for; 0 is full detail. Returns
+// the bias for the next frame given this frame's prepare duration: while the
+// view moves, a frame over `budget_ms` raises it by the log2 of the overrun
+// and a frame under half the budget lowers it by a quarter step; a frame
+// whose view did not move lowers it by a whole step. A budget of 0 returns 0.
+double next_adaptive_lod_bias(
+    double                     bias,
+    double                     prepare_ms,
+    double                     budget_ms,
+    double                     max_bias,
+    bool                       view_moved);
+
+// Windows denser than this many pixels per sample are candidates for M4
+// decimation (at least four samples per pixel column).
+inline constexpr double k_m4_max_pixels_per_sample = 0.25;
+
+// Pixel reduction of a planned window (M4 columns or DOTS cells).
+// `source_indices` holds one snapshot index per GPU slot in draw order;
+// `spans` keeps the source ranges of the input spans with compacted
+// gpu_first/gpu_count. A synthetic hold slot stays the last slot of the
+// final span and maps to its last source sample.
+struct m4_window_t
+{
+    std::vector<std::size_t>               source_indices;
+    std::vector<drawable_sample_span_t>    spans;
+    std::size_t                            gpu_count = 0;
+};
+
+// Reduce every drawable span to the first and last sample of each pixel
+// column plus the samples holding its lowest y_min and highest y_max (M4),
+// so range lanes keep their extrema too. Columns follow the built-in x
+// mapping (t_min_ns..t_max_ns over width_px). Returns false, leaving `out`
+// empty, when the window is not ascending in time or would not shrink.
+bool decimate_window_m4(
+    const sample_window_t&     window,
+    m4_window_t&               out);
+
+// Windows with at least this many samples per pixel column are candidates
+// for DOTS cell culling.
+inline constexpr double k_dots_cull_max_pixels_per_sample = 1.0;
+
+// Keep the first sample of every (x, y) pixel cell its dot centre lands in
+// (Plot_config::dots_pixel_culling). Cells follow the built-in DOTS mapping,
+// including y_offset_px, so the kept dots cover the cells the full window
+// covers. Centres outside the view are never merged. Returns false, leaving
+// `out` empty, when the window would not shrink or its grid is larger than
+// k_density_max_grid_side squared.
+bool cull_window_dots(
+    const sample_window_t&     window,
+    m4_window_t&               out);
+
+// Per-pixel sample density of a planned window (Display_style::DENSITY).
+// `counts` is row-major, width x height, with row 0 at v_max.
+struct density_grid_t
+{
+    std::vector<float>     counts;
+    std::size_t            width          = 0;
+    std::size_t            height         = 0;
+    float                  max_count      = 0.0f;
+    std::size_t            binned_samples = 0;
+};
+
+// Upper bound on either side of a density grid.
+inline constexpr std::size_t k_density_max_grid_side = 4096;
+
+// Bin the window's source samples into one cell per pixel, following the
+// built-in x/y mapping. Every sample adds lod_scale, the number of raw
+// samples it stands for at the planned LOD level; a sample whose range
+// lanes cover several rows spreads that weight evenly over them. Large
+// windows are binned on several threads. Returns false, leaving `out`
+// empty, when the window has no snapshot or no drawable extent.
+bool bin_window_density(
+    const sample_window_t&     window,
+    std::size_t                lod_scale,
+    density_grid_t&            out);
+
 struct stacked_sample_t
 {
     std::int64_t   timestamp_ns = 0;
@@ -124,9 +237,43 @@ inline constexpr std::size_t k_stack_max_output_samples_per_view = 1'048'576;
 
 struct stack_composition_stats_t
 {
-    std::size_t    timestamp_count   = 0;
-    std::size_t    source_read_count = 0;
-    bool           resampled         = false;
+    std::size_t    timestamp_count        = 0;
+    std::size_t    source_read_count      = 0;
+    bool           resampled              = false;
+    // Set when a cached composition was extended instead of rebuilt;
+    // reused_timestamp_count counts the timestamps carried over from it.
+    bool           extended               = false;
+    std::size_t    reused_timestamp_count = 0;
+};
+
+// Identity, append revision and newest real (non-hold) sample of one stack
+// member at the time its group was composed.
+struct stack_member_extent_t
+{
+    const void*                identity         = nullptr;
+    access_policy_cache_key_t  access_key;
+    std::size_t                lod_level        = 0;
+    Nonfinite_sample_policy    nonfinite_policy = Nonfinite_sample_policy::BREAK_SEGMENT;
+    std::uint64_t              prefix_revision  = 0;
+    std::int64_t               last_t           = 0;
+    float                      last_v           = 0.0f;
+};
+
+// Composition of one stack group/view kept between frames. The published
+// output of each layer is `count` samples starting at `first` in its storage.
+// Storage only ever grows past the published samples, so snapshots handed
+// out for earlier frames stay valid while a later frame extends it in place.
+// `members` is filled only for exact, ascending compositions, which are the
+// ones a later frame can extend.
+struct stack_composition_cache_t
+{
+    std::vector<std::shared_ptr<std::vector<stacked_sample_t>>>
+                                       layers;
+    std::size_t                        first         = 0;
+    std::size_t                        count         = 0;
+    std::vector<stack_member_extent_t> members;
+    Series_interpolation               interpolation = Series_interpolation::LINEAR;
+    bool                               resampled     = false;
 };
 
 std::size_t stack_timestamp_budget(
@@ -149,6 +296,20 @@ Stack_rejection_reason compose_stacked_series(
     std::size_t                                    timestamp_budget,
     stack_composition_stats_t*                     stats = nullptr);
 
+// compose_stacked_series() through a per-group cache. When every member kept
+// its source, access, LOD level and interpolation and, by its unchanged
+// nonzero data_snapshot_t::prefix_revision, only appended samples since
+// `cache` was built, the cached timestamps up to the oldest member's previous
+// last sample are kept and only the newer tail is merged, interpolated and
+// appended to the cached storage. Otherwise the group is composed from
+// scratch. `cache` holds the result on success and is cleared on rejection.
+Stack_rejection_reason compose_stacked_series(
+    const std::vector<const Series_view_plan*>&    plans,
+    const std::vector<Time_order>&                 selected_time_orders,
+    stack_composition_cache_t&                     cache,
+    std::size_t                                    timestamp_budget,
+    stack_composition_stats_t*                     stats = nullptr);
+
 const Data_access_policy& stacked_sample_access();
 
 } // namespace detail
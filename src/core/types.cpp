@@ -5,6 +5,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -846,7 +847,7 @@ data_query_result_t<value_range_t> Data_source::query_v_range(
     const data_query_context_t&    query)
 {
     data_query_result_t<value_range_t> result;
-    if (!query.access || !query.access->is_valid()) {
+    if (!query.access || !query.access->is_valid() || query.defer_default_scan) {
         return result;
     }
 
@@ -939,4 +940,59 @@ data_query_result_t<value_range_t> Data_source::query_v_range(
     return result;
 }
 
+data_query_result_t<value_range_t> published_v_range_t::answer(
+    const data_query_context_t&    query) const
+{
+    data_query_result_t<value_range_t> result;
+    if (status != Data_query_status::READY && status != Data_query_status::EMPTY) {
+        return result;
+    }
+    if (sequence == 0                                          ||
+        query.semantics_key.conservative                       ||
+        semantics_key.value    != query.semantics_key.value    ||
+        semantics_key.revision != query.semantics_key.revision ||
+        nonfinite_policy       != query.nonfinite_policy)
+    {
+        return result;
+    }
+    result.status   = status;
+    result.value    = range;
+    result.sequence = sequence;
+    return result;
+}
+
+published_v_range_t compute_published_v_range(
+    const data_snapshot_t&         snapshot,
+    const Data_access_policy&      access,
+    Nonfinite_sample_policy        nonfinite_policy)
+{
+    published_v_range_t published;
+    published.sequence         = snapshot.sequence;
+    published.semantics_key    = detail::make_sample_semantics_key(&access);
+    published.nonfinite_policy = nonfinite_policy;
+    if (published.semantics_key.conservative || !access.is_valid()) {
+        return published;
+    }
+
+    data_query_context_t query;
+    query.access           = &access;
+    query.semantics_key    = published.semantics_key;
+    query.time_window      = {
+        std::numeric_limits<std::int64_t>::min(),
+        std::numeric_limits<std::int64_t>::max()
+    };
+    query.nonfinite_policy = nonfinite_policy;
+
+    value_range_t range;
+    bool          has_value = false;
+    if (snapshot.count != 0 &&
+        !scan_value_range(snapshot, access, query, range, has_value))
+    {
+        return published;
+    }
+    published.status = has_value ? Data_query_status::READY : Data_query_status::EMPTY;
+    published.range  = range;
+    return published;
+}
+
 } // namespace vnm::plot
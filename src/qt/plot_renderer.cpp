@@ -10,16 +10,22 @@
 #include <vnm_plot/rhi/asset_loader.h>
 #include <vnm_plot/rhi/chrome_renderer.h>
 #include <vnm_plot/rhi/font_renderer.h>
+#include <vnm_plot/rhi/pipeline_cache.h>
 #include <vnm_plot/rhi/primitive_renderer.h>
+#include <vnm_plot/rhi/qrhi_series_layer.h>
+#include <vnm_plot/rhi/series_data.h>
 #include <vnm_plot/rhi/series_renderer.h>
 #include <vnm_plot/rhi/text_renderer.h>
+#include "../core/chrome_layer.h"
 #include "../core/frame_range_planner.h"
-#include "../core/label_pane_geometry.h"
+#include "../core/offscreen_layer.h"
 #include "../core/lcd_policy.h"
+#include "../core/plot_frame_helpers.h"
 
 #include <QColor>
 #include <QMatrix4x4>
 #include <QMetaObject>
+#include <QQuickGraphicsConfiguration>
 #include <QQuickWindow>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -29,12 +35,19 @@
 #include <algorithm>
 #include <cmath>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <shared_mutex>
+#include <type_traits>
+#include <vector>
 
 namespace vnm::plot {
 
+using detail::ieee_key_bits;
+using detail::pointer_key;
+
 namespace {
 
 glm::mat4 to_glm_mat4(const QMatrix4x4& matrix)
@@ -52,32 +65,6 @@ glm::vec4 qcolor_to_vec4(const QColor& color)
             static_cast<float>(color.alphaF()));
 }
 
-struct label_pane_opacity_t
-{
-    bool vertical_axis_label_pane_is_opaque   = false;
-    bool horizontal_axis_label_pane_is_opaque = false;
-};
-
-bool color_is_opaque(const glm::vec4& color)
-{
-    return color.a >= detail::k_lcd_opaque_alpha_cutoff;
-}
-
-label_pane_opacity_t label_pane_opacity_for_text(const frame_context_t& ctx)
-{
-    const Color_palette palette = resolved_color_palette(ctx.config, ctx.dark_mode);
-
-    glm::vec4 pane_rect;
-    label_pane_opacity_t opacity;
-    opacity.horizontal_axis_label_pane_is_opaque =
-        color_is_opaque(palette.h_label_background) &&
-        detail::horizontal_axis_label_pane_rect(ctx, pane_rect);
-    opacity.vertical_axis_label_pane_is_opaque =
-        color_is_opaque(palette.v_label_background) &&
-        detail::vertical_axis_label_pane_rect(ctx, pane_rect);
-    return opacity;
-}
-
 #if defined(VNM_PLOT_ENABLE_TEXT)
 bool spans_approx_equal(long double a, long double b)
 {
@@ -87,66 +74,6 @@ bool spans_approx_equal(long double a, long double b)
 }
 #endif
 
-Layout_calculator::parameters_t build_layout_params(
-    float                  v_min,
-    float                  v_max,
-    std::int64_t           t_min_ns,
-    std::int64_t           t_max_ns,
-    int                    win_w,
-    double                 usable_height,
-    double                 vbar_width,
-    double                 preview_height,
-    double                 font_px,
-    const Plot_config&     config,
-    const Font_renderer*   fonts)
-{
-    Layout_calculator::parameters_t params;
-    params.v_min                         = v_min;
-    params.v_max                         = v_max;
-    params.t_min                         = t_min_ns;
-    params.t_max                         = t_max_ns;
-    params.usable_width                  = std::max(0.0, double(win_w) - vbar_width);
-    params.usable_height                 = usable_height;
-    params.vbar_width                    = vbar_width;
-    params.label_visible_height          = usable_height + preview_height;
-    params.adjusted_font_size_in_pixels  = font_px;
-    params.h_label_vertical_nudge_factor = detail::k_h_label_vertical_nudge_px;
-
-    if (fonts) {
-        params.monospace_char_advance_px     = fonts->monospace_advance_px();
-        params.monospace_advance_is_reliable = fonts->monospace_advance_is_reliable();
-        params.measure_text_cache_key        = fonts->text_measure_cache_key();
-        params.measure_text_func             = [fonts](const char* text) {
-            return fonts->measure_text_px(text);
-        };
-    }
-
-    const Plot_config* config_ptr = &config;
-    params.format_timestamp_func = [config_ptr](
-        std::int64_t   ts_ns,
-        std::int64_t   step_ns) -> std::string
-    {
-        if (config_ptr->format_timestamp) {
-            return config_ptr->format_timestamp(ts_ns, step_ns);
-        }
-        return default_format_timestamp(ts_ns, step_ns);
-    };
-    params.format_timestamp_revision     = config.format_timestamp_revision;
-    params.horizontal_axis_left_to_right = config.horizontal_axis_left_to_right;
-    params.format_value_func             = [config_ptr](
-        double                         value,
-        const value_format_context_t&  context) -> std::string
-    {
-        if (config_ptr->format_value) {
-            return config_ptr->format_value(value, context);
-        }
-        return {};
-    };
-    params.format_value_revision = config.format_value_revision;
-    params.profiler              = config.profiler.get();
-    return params;
-}
-
 } // anonymous namespace
 
 struct Plot_renderer::impl_t
@@ -192,6 +119,76 @@ struct Plot_renderer::impl_t
 #endif
     std::chrono::steady_clock::time_point last_render_callback;
     bool series_initialized = false;
+
+    // Pipeline disk cache: the QRhi seeded in initialize(). Windows whose
+    // Qt Quick pipeline cache has a save file load and save through it.
+    QRhi*                          pipeline_cache_rhi = nullptr;
+
+    // Plot_config::skip_unchanged_frames: the inputs of the last rendered
+    // frame, or none when the next frame must render regardless.
+    detail::unchanged_frame_filter_t unchanged_frame;
+
+    // Plot_config::scroll_blit. The series layer lives in scroll_layer;
+    // scroll_key holds what its content depends on apart from the time
+    // window and the samples. The window is snapped to whole pixel steps
+    // from an anchor, and scroll_step is the step of the layer's content.
+    detail::Offscreen_layer        scroll_layer{detail::Offscreen_layer::mode_t::SCROLLING};
+    std::vector<std::uint64_t>     scroll_key;
+    std::vector<std::uint64_t>     next_scroll_key;
+    bool                           scroll_anchored     = false;
+    std::int64_t                   scroll_anchor_t_min = 0;
+    std::int64_t                   scroll_anchor_span  = 0;
+    double                         scroll_anchor_width = 0.0;
+    std::int64_t                   scroll_step         = 0;
+
+    // Plot_config::cache_chrome_layer. The draws of chrome_layer are queued
+    // on chrome_primitives, whose pipelines then stay built for the layer's
+    // render pass instead of alternating with the window's.
+    detail::Chrome_layer           chrome_layer;
+    Primitive_renderer             chrome_primitives;
+
+    // Fills unchanged_frame.key with everything render() reads. Returns false when a
+    // source cannot report its content revision, so the frame cannot be
+    // compared.
+    bool build_frame_key(QRhi* rhi, QRhiRenderTarget* rt, QRhiTexture* color_texture)
+    {
+        const QSize size = rt->pixelSize();
+        const data_config_t& data_cfg = snapshot.data_cfg;
+        std::vector<std::uint64_t>& frame_key = unchanged_frame.key;
+        frame_key.clear();
+        frame_key.insert(frame_key.end(), {
+            pointer_key(rhi),
+            pointer_key(rt),
+            pointer_key(color_texture),
+            static_cast<std::uint64_t>(size.width()),
+            static_cast<std::uint64_t>(size.height()),
+            static_cast<std::uint64_t>(rt->sampleCount()),
+            snapshot.config_revision,
+            snapshot.series_revision,
+            ieee_key_bits(data_cfg.v_min),
+            ieee_key_bits(data_cfg.v_max),
+            ieee_key_bits(data_cfg.v_manual_min),
+            ieee_key_bits(data_cfg.v_manual_max),
+            static_cast<std::uint64_t>(data_cfg.t_min),
+            static_cast<std::uint64_t>(data_cfg.t_max),
+            static_cast<std::uint64_t>(data_cfg.t_available_min),
+            static_cast<std::uint64_t>(data_cfg.t_available_max),
+            ieee_key_bits(data_cfg.vbar_width),
+            static_cast<std::uint64_t>(snapshot.v_auto),
+            static_cast<std::uint64_t>(snapshot.visible_info_flags),
+            ieee_key_bits(snapshot.adjusted_font_px),
+            ieee_key_bits(snapshot.base_label_height_px),
+            ieee_key_bits(snapshot.adjusted_preview_height),
+            ieee_key_bits(snapshot.vbar_width_pixels),
+            ieee_key_bits(snapshot.window_background.r),
+            ieee_key_bits(snapshot.window_background.g),
+            ieee_key_bits(snapshot.window_background.b),
+            ieee_key_bits(snapshot.window_background.a),
+            static_cast<std::uint64_t>(snapshot.auto_lcd_subpixel_order)
+        });
+
+        return detail::append_series_frame_key(frame_key, snapshot.series);
+    }
 };
 
 Plot_renderer::Plot_renderer(const Plot_widget* owner)
@@ -205,6 +202,13 @@ Plot_renderer::~Plot_renderer() = default;
 
 void Plot_renderer::initialize(QRhiCommandBuffer* /*cb*/)
 {
+    if (m_impl->pipeline_cache_rhi != rhi()) {
+        m_impl->pipeline_cache_rhi = rhi();
+        const QQuickWindow* window = m_impl->owner ? m_impl->owner->window() : nullptr;
+        if (!window || window->graphicsConfiguration().pipelineCacheSaveFile().isEmpty()) {
+            load_pipeline_disk_cache(m_impl->pipeline_cache_rhi);
+        }
+    }
     if (!m_impl->series_initialized) {
         m_impl->series.initialize(m_impl->asset_loader);
         m_impl->series_initialized = true;
@@ -279,6 +283,25 @@ void Plot_renderer::render(QRhiCommandBuffer* cb)
     }
     m_impl->last_render_callback = callback_now;
 
+    if (config.skip_unchanged_frames) {
+        const bool comparable = m_impl->build_frame_key(rhi_ptr, rt, colorTexture());
+        if (comparable && m_impl->unchanged_frame.unchanged()) {
+            if (profiler) {
+                profiler->record_counter("qrhi.renderer.unchanged_frame_skip_count");
+            }
+            return;
+        }
+        if (comparable) {
+            m_impl->unchanged_frame.remember();
+        }
+        else {
+            m_impl->unchanged_frame.forget();
+        }
+    }
+    else {
+        m_impl->unchanged_frame.forget();
+    }
+
     VNM_PLOT_PROFILE_SCOPE(profiler, "renderer");
     VNM_PLOT_PROFILE_SCOPE(profiler, "renderer.frame");
 
@@ -307,10 +330,12 @@ void Plot_renderer::render(QRhiCommandBuffer* cb)
     const int win_h = pixel_size.height();
 
     m_impl->primitives.set_profiler(profiler);
+    m_impl->chrome_primitives.set_profiler(profiler);
     const auto log_error = config.log_error;
     const auto log_debug = config.log_debug;
     m_impl->asset_loader.set_log_callback(log_error);
     m_impl->primitives.set_log_callback(log_error);
+    m_impl->chrome_primitives.set_log_callback(log_error);
 
     const double reserved_h = snapshot.base_label_height_px + snapshot.adjusted_preview_height;
     const bool preview_enabled =
@@ -376,12 +401,52 @@ void Plot_renderer::render(QRhiCommandBuffer* cb)
     }
     vbar_width = std::clamp(vbar_width, detail::k_vbar_min_width_px_d, max_vbar_width);
 
+    // Plot_config::scroll_blit: snap the window to whole pixel steps from an
+    // anchor, so consecutive frames differ by a whole-pixel shift. The span
+    // is kept; the shown window moves by less than one pixel.
+    std::int64_t frame_t_min    = snapshot.data_cfg.t_min;
+    std::int64_t frame_t_max    = snapshot.data_cfg.t_max;
+    std::int64_t scroll_step    = 0;
+    bool         scroll_snapped = false;
+    if (config.scroll_blit && rhi_ptr && frame_t_max > frame_t_min) {
+        const std::int64_t span     = frame_t_max - frame_t_min;
+        const double       width_px = double(win_w) - vbar_width;
+        if (width_px >= 1.0) {
+            const double ns_per_px = double(span) / width_px;
+            if (!m_impl->scroll_anchored                  ||
+                m_impl->scroll_anchor_span  != span       ||
+                m_impl->scroll_anchor_width != width_px)
+            {
+                m_impl->scroll_anchored     = true;
+                m_impl->scroll_anchor_t_min = frame_t_min;
+                m_impl->scroll_anchor_span  = span;
+                m_impl->scroll_anchor_width = width_px;
+            }
+            double steps = std::round(static_cast<double>(
+                static_cast<long double>(frame_t_min) -
+                static_cast<long double>(m_impl->scroll_anchor_t_min)) / ns_per_px);
+            if (!(std::abs(steps) < 1.0e12)) {
+                m_impl->scroll_anchor_t_min = frame_t_min;
+                steps = 0.0;
+            }
+            const std::int64_t snapped_t_min =
+                m_impl->scroll_anchor_t_min + std::llround(steps * ns_per_px);
+            frame_t_min    = snapped_t_min;
+            frame_t_max    = snapped_t_min + span;
+            scroll_step    = static_cast<std::int64_t>(steps);
+            scroll_snapped = true;
+        }
+    }
+    else {
+        m_impl->scroll_anchored = false;
+    }
+
     const auto make_cache_key = [&](double width_px) {
         layout_cache_key_t key;
         key.v0                           = v_min;
         key.v1                           = v_max;
-        key.t0                           = snapshot.data_cfg.t_min;
-        key.t1                           = snapshot.data_cfg.t_max;
+        key.t0                           = frame_t_min;
+        key.t1                           = frame_t_max;
         key.viewport_size                = Size_2i{win_w, win_h};
         key.adjusted_reserved_height     = reserved_h;
         key.adjusted_preview_height      = snapshot.adjusted_preview_height;
@@ -395,11 +460,11 @@ void Plot_renderer::render(QRhiCommandBuffer* cb)
     };
 
     const auto calculate_layout = [&](double width_px) {
-        const auto params = build_layout_params(
+        const auto params = detail::build_layout_params(
             v_min,
             v_max,
-            snapshot.data_cfg.t_min,
-            snapshot.data_cfg.t_max,
+            frame_t_min,
+            frame_t_max,
             win_w,
             usable_height,
             width_px,
@@ -472,8 +537,8 @@ void Plot_renderer::render(QRhiCommandBuffer* cb)
     if (m_impl->owner) {
         m_impl->owner->set_rendered_v_range(ctx.v0, ctx.v1);
     }
-    ctx.t0 = snapshot.data_cfg.t_min;
-    ctx.t1 = snapshot.data_cfg.t_max;
+    ctx.t0 = frame_t_min;
+    ctx.t1 = frame_t_max;
     if (m_impl->owner) {
         m_impl->owner->set_rendered_t_range(ctx.t0, ctx.t1);
     }
@@ -521,8 +586,39 @@ void Plot_renderer::render(QRhiCommandBuffer* cb)
             rhi_ptr ? rhi_ptr->nextResourceUpdateBatch() : nullptr;
         ctx.rhi_updates = rhi_updates;
 
+        // Plot_config::scroll_blit: the series render into the scroll layer,
+        // which the main pass composites between the back and front chrome.
+        frame_context_t series_ctx = ctx;
+        const bool scroll_layer_ready =
+            scroll_snapped                                                        &&
+            m_impl->series_initialized                                            &&
+            m_impl->scroll_layer.ensure(rhi_ptr, pixel_size, rhi_updates)         &&
+            m_impl->scroll_layer.prepare_composite(rhi_updates, rt, ctx.pmv);
+        if (scroll_layer_ready) {
+            series_ctx.render_target = m_impl->scroll_layer.render_target();
+        }
+        else {
+            m_impl->scroll_layer.reset();
+            m_impl->scroll_key.clear();
+        }
+
         if (m_impl->series_initialized) {
-            m_impl->series.prepare(ctx, snapshot.series);
+            m_impl->series.prepare(series_ctx, snapshot.series);
+            if (!m_impl->series.last_frame_current()) {
+                m_impl->unchanged_frame.forget();
+            }
+            if (m_impl->series.lod_bias() > 0.0) {
+                // Plot_config::adaptive_lod_budget_ms: a coarsened frame is
+                // followed by more, even without input changes, until the
+                // bias is back at full detail.
+                m_impl->unchanged_frame.forget();
+                if (m_impl->owner) {
+                    QMetaObject::invokeMethod(
+                        const_cast<Plot_widget*>(m_impl->owner),
+                        "update",
+                        Qt::QueuedConnection);
+                }
+            }
             if (m_impl->owner) {
                 m_impl->owner->set_rendered_stack_validity(
                     m_impl->series,
@@ -534,17 +630,92 @@ void Plot_renderer::render(QRhiCommandBuffer* cb)
             }
         }
 
-        const Text_renderer* prepared_text = nullptr;
+        if (scroll_layer_ready) {
+            // Shift the previous layer by the pixel steps the window advanced
+            // and clear what this frame redraws: the scrolled-in strip, or
+            // more when a series changed further left, plus the margin. The
+            // preview band is redrawn every frame.
+            const double usable_w = layout_ptr->usable_width;
+            const double usable_h = layout_ptr->usable_height;
+            auto&        key      = m_impl->next_scroll_key;
+            key.clear();
+            key.insert(key.end(), {
+                pointer_key(rhi_ptr),
+                static_cast<std::uint64_t>(win_w),
+                static_cast<std::uint64_t>(win_h),
+                snapshot.config_revision,
+                snapshot.series_revision,
+                ieee_key_bits(ctx.v0),
+                ieee_key_bits(ctx.v1),
+                ieee_key_bits(usable_w),
+                ieee_key_bits(usable_h),
+                ieee_key_bits(snapshot.adjusted_preview_height),
+                static_cast<std::uint64_t>(m_impl->scroll_anchor_t_min),
+                static_cast<std::uint64_t>(m_impl->scroll_anchor_span)
+            });
+            const std::int64_t shift_px = scroll_step - m_impl->scroll_step;
+            const bool scrollable =
+                m_impl->scroll_layer.has_previous() &&
+                key == m_impl->scroll_key           &&
+                shift_px >= 0                       &&
+                double(shift_px) < usable_w;
+            double redraw_x0 = 0.0;
+            if (scrollable) {
+                const double changed_x = m_impl->series.last_frame_main_changed_x();
+                redraw_x0 = std::max(0.0, std::floor(
+                    std::min(usable_w - double(shift_px), changed_x) - config.scroll_blit_margin_px));
+            }
+
+            const int body_w = static_cast<int>(std::ceil(usable_w));
+            const int body_h = static_cast<int>(std::ceil(usable_h));
+            if (redraw_x0 > 0.0) {
+                const int shift     = static_cast<int>(shift_px);
+                const int redraw_x  = static_cast<int>(redraw_x0);
+                const int preview_y = static_cast<int>(
+                    std::floor(double(win_h) - snapshot.adjusted_preview_height));
+                m_impl->scroll_layer.copy_from_previous(
+                    rhi_updates, QRect(shift, 0, body_w - shift, body_h), QPoint(0, 0));
+                m_impl->scroll_layer.clear(
+                    rhi_updates, QRect(redraw_x, 0, body_w - redraw_x, body_h));
+                if (preview_y < win_h) {
+                    m_impl->scroll_layer.clear(
+                        rhi_updates, QRect(0, preview_y, win_w, win_h - preview_y));
+                }
+            }
+            else {
+                m_impl->scroll_layer.clear(rhi_updates, QRect(0, 0, win_w, win_h));
+            }
+            series_ctx.main_redraw_x0 = redraw_x0;
+            m_impl->scroll_key.swap(key);
+            m_impl->scroll_step = scroll_step;
+            if (profiler) {
+                profiler->record_counter(redraw_x0 > 0.0
+                    ? "qrhi.renderer.scroll_blit.shift_count"
+                    : "qrhi.renderer.scroll_blit.full_redraw_count");
+                profiler->record_observation(
+                    "qrhi.renderer.scroll_blit.redraw_width_px",
+                    std::max(0.0, usable_w - redraw_x0));
+            }
+        }
+
+        const Text_renderer* prepared_text      = nullptr;
+        bool                 label_fades_active = false;
 #if defined(VNM_PLOT_ENABLE_TEXT)
         if (m_impl->text && config.show_text) {
-            const label_pane_opacity_t pane_opacity = label_pane_opacity_for_text(ctx);
+            const detail::label_pane_opacity_t pane_opacity = detail::label_pane_opacity_for_text(ctx);
             const bool fades_active = m_impl->text->prepare(
                 ctx,
                 fade_v_labels,
                 fade_h_labels,
                 pane_opacity.vertical_axis_label_pane_is_opaque,
                 pane_opacity.horizontal_axis_label_pane_is_opaque);
-            prepared_text = m_impl->text.get();
+            prepared_text      = m_impl->text.get();
+            label_fades_active = fades_active;
+            if (fades_active) {
+                // The next callback must advance the fade even though none
+                // of the frame inputs moved.
+                m_impl->unchanged_frame.forget();
+            }
             if (fades_active && m_impl->owner) {
                 QMetaObject::invokeMethod(
                     const_cast<Plot_widget*>(m_impl->owner),
@@ -554,16 +725,50 @@ void Plot_renderer::render(QRhiCommandBuffer* cb)
         }
 #endif
 
+        // Plot_config::cache_chrome_layer: the back chrome is drawn into the
+        // chrome layer only when its inputs changed, and the main pass
+        // composites the layer in its place.
+        frame_context_t chrome_ctx = ctx;
+        bool chrome_layer_ready  = false;
+        bool chrome_layer_redraw = false;
+        if (config.cache_chrome_layer) {
+            chrome_layer_ready = m_impl->chrome_layer.prepare(
+                rhi_ptr, pixel_size, rhi_updates, rt, ctx.pmv);
+        }
+        else {
+            m_impl->chrome_layer.reset();
+        }
+        if (chrome_layer_ready) {
+            detail::chrome_theme_t theme;
+            theme.window_background    = snapshot.window_background;
+            theme.lcd_subpixel_order   = snapshot.auto_lcd_subpixel_order;
+            theme.visible_info_flags   = snapshot.visible_info_flags;
+            theme.base_label_height_px = snapshot.base_label_height_px;
+            theme.prepared_text        = prepared_text;
+            chrome_layer_redraw = m_impl->chrome_layer.needs_redraw(
+                make_cache_key(vbar_width), theme, profiler);
+        }
+
         // Chrome runs in two queueing phases so backgrounds and the main grid
         // stay behind the series while the zero line and preview overlay stay
         // in front. Both phases write to ctx.rhi_updates before beginPass so
         // all uploads are submitted atomically; the checkpoint between them
         // lets record_draws() replay the back-layer slice, then the series
         // renders, then record_draws() replays the front-layer slice.
-        m_impl->chrome.render_grid_and_backgrounds(
-            ctx,
-            m_impl->primitives,
-            prepared_text);
+        if (chrome_layer_redraw) {
+            chrome_ctx.render_target = m_impl->chrome_layer.render_target();
+            m_impl->chrome.render_grid_and_backgrounds(
+                chrome_ctx,
+                m_impl->chrome_primitives,
+                prepared_text);
+        }
+        else
+        if (!chrome_layer_ready) {
+            m_impl->chrome.render_grid_and_backgrounds(
+                ctx,
+                m_impl->primitives,
+                prepared_text);
+        }
         const std::size_t back_layer_end = m_impl->primitives.queued_op_count();
         m_impl->chrome.render_zero_line(ctx, m_impl->primitives);
         if (snapshot.adjusted_preview_height > 0.0) {
@@ -571,9 +776,48 @@ void Plot_renderer::render(QRhiCommandBuffer* cb)
         }
         const std::size_t front_layer_end = m_impl->primitives.queued_op_count();
 
+        if (chrome_layer_redraw) {
+            // The first pass submits the batch, so the chrome layer pass
+            // goes ahead of the series layer pass.
+            cb->beginPass(
+                chrome_ctx.render_target,
+                QColor(0, 0, 0, 0),
+                QRhiDepthStencilClearValue(1.0f, 0),
+                rhi_updates);
+            cb->setViewport(QRhiViewport(0, 0, win_w, win_h));
+            m_impl->chrome_primitives.record_draws(
+                chrome_ctx,
+                m_impl->chrome_primitives.queued_op_count());
+            cb->endPass();
+            m_impl->chrome_primitives.reset_frame();
+            rhi_updates = nullptr;
+            m_impl->chrome_layer.finish_redraw(label_fades_active);
+        }
+
+        if (scroll_layer_ready) {
+            // The layer pass submits the batch; the main pass only draws.
+            cb->beginPass(
+                series_ctx.render_target,
+                QColor(0, 0, 0, 0),
+                QRhiDepthStencilClearValue(1.0f, 0),
+                rhi_updates);
+            cb->setViewport(QRhiViewport(0, 0, win_w, win_h));
+            m_impl->series.render(series_ctx, snapshot.series);
+            cb->endPass();
+            rhi_updates = nullptr;
+        }
+
         cb->beginPass(rt, clear_color, QRhiDepthStencilClearValue(1.0f, 0), rhi_updates);
         cb->setViewport(QRhiViewport(0, 0, win_w, win_h));
+        if (chrome_layer_ready) {
+            m_impl->chrome_layer.record_composite(cb);
+        }
         m_impl->primitives.record_draws(ctx, back_layer_end);
+        if (scroll_layer_ready) {
+            m_impl->scroll_layer.record_composite(cb);
+            m_impl->scroll_layer.finish_frame();
+        }
+        else
         if (m_impl->series_initialized) {
             m_impl->series.render(ctx, snapshot.series);
         }
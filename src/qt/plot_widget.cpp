@@ -4,14 +4,18 @@
 #include <vnm_plot/qt/plot_time_axis.h>
 #include <vnm_plot/core/constants.h>
 #include <vnm_plot/core/algo.h>
+#include <vnm_plot/rhi/pipeline_cache.h>
 #include <vnm_plot/rhi/qrhi_series_layer.h>
 #include <vnm_plot/rhi/series_data.h>
 #include <vnm_plot/rhi/series_renderer.h>
+#include "../core/pipeline_cache_file.h"
 #include "../core/series_window_planner.h"
 
 #include <QGuiApplication>
 #include <QDebug>
+#include <QQuickGraphicsConfiguration>
 #include <QQuickWindow>
+#include <QSGRendererInterface>
 #include <QScreen>
 #include <QWindow>
 
@@ -139,6 +143,38 @@ const char* stack_reason_name(Stack_rejection_reason reason)
     return "NONE";
 }
 
+// Points Qt Quick's pipeline cache of `window` at the library's cache file
+// for the graphics API, so the QRhi Qt Quick creates is seeded from it and
+// saved to it when the scene graph goes away. Only takes effect before the
+// scene graph initializes; a window whose application configured the
+// pipeline cache itself is left alone.
+void configure_pipeline_cache(QQuickWindow* window)
+{
+    if (!window || window->isSceneGraphInitialized() || !pipeline_disk_cache_enabled()) {
+        return;
+    }
+    QQuickGraphicsConfiguration config = window->graphicsConfiguration();
+    if (!config.pipelineCacheSaveFile().isEmpty() || !config.pipelineCacheLoadFile().isEmpty()) {
+        return;
+    }
+
+    const char* backend_name = nullptr;
+    switch (QQuickWindow::graphicsApi()) {
+        case QSGRendererInterface::OpenGL:     backend_name = "OpenGL"; break;
+        case QSGRendererInterface::Vulkan:     backend_name = "Vulkan"; break;
+        case QSGRendererInterface::Direct3D11: backend_name = "D3D11";  break;
+        case QSGRendererInterface::Direct3D12: backend_name = "D3D12";  break;
+        case QSGRendererInterface::Metal:      backend_name = "Metal";  break;
+        default:                               return;
+    }
+
+    const QString path = QString::fromStdU16String(
+        detail::quick_pipeline_cache_file_path(backend_name).u16string());
+    config.setPipelineCacheSaveFile(path);
+    config.setPipelineCacheLoadFile(path);
+    window->setGraphicsConfiguration(config);
+}
+
 } // anonymous namespace
 
 Plot_widget::Plot_widget()
@@ -883,6 +919,7 @@ void Plot_widget::handle_window_changed(QQuickWindow* window)
             });
     }
 
+    configure_pipeline_cache(window);
     invalidate_display_context();
 }
 
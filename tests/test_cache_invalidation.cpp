@@ -27,6 +27,7 @@ using plot::Display_style;
 using plot::Empty_window_behavior;
 using plot::Plot_config;
 using plot::Series_interpolation;
+using plot::Time_order;
 using plot::data_config_t;
 using plot::data_query_context_t;
 using plot::data_query_result_t;
@@ -59,6 +60,12 @@ public:
     int                        snapshot_calls         = 0;
     std::size_t                last_query_lod         = 0;
     data_query_context_t       last_query;
+    Data_query_status          published_status       = Data_query_status::UNSUPPORTED;
+    value_range_t              published_range{0.0f, 0.0f};
+    std::uint64_t              published_sequence     = 1;
+    mutable int                published_calls        = 0;
+    mutable std::size_t        last_published_lod     = 0;
+    Time_order                 order                  = Time_order::UNKNOWN;
 
     snapshot_result_t try_snapshot(std::size_t lod_level) override
     {
@@ -95,9 +102,23 @@ public:
         return result;
     }
 
+    data_query_result_t<value_range_t> query_published_v_range(
+        std::size_t                    lod,
+        const data_query_context_t&    /*query*/) const override
+    {
+        ++published_calls;
+        last_published_lod = lod;
+        data_query_result_t<value_range_t> result;
+        result.status   = published_status;
+        result.sequence = published_sequence;
+        result.value    = published_range;
+        return result;
+    }
+
     std::size_t lod_levels() const override { return levels; }
     std::size_t lod_scale(std::size_t level) const override { return level == 0 ? 1 : 4; }
     std::size_t sample_stride() const override { return sizeof(Test_sample); }
+    Time_order time_order(std::size_t /*lod*/) const override { return order; }
     std::uint64_t current_sequence(std::size_t /*lod_level*/) const override
     {
         return current_sequence_value;
@@ -111,7 +132,10 @@ public:
     std::vector<Test_sample>   samples;
     std::uint64_t              snapshot_sequence      = 1;
     std::uint64_t              current_sequence_value = 1;
+    std::uint64_t              prefix_revision        = 0;
+    std::uint64_t              stream_revision        = 0;
     int                        snapshot_calls         = 0;
+    Time_order                 order                  = Time_order::UNKNOWN;
 
     snapshot_result_t try_snapshot(std::size_t /*lod_level*/) override
     {
@@ -125,6 +149,8 @@ public:
             0,
             std::make_shared<int>(11)
         };
+        snapshot.prefix_revision = prefix_revision;
+        snapshot.stream_revision = stream_revision;
         if (samples.empty()) {
             return {data_snapshot_t{}, snapshot_result_t::Snapshot_status::EMPTY};
         }
@@ -132,6 +158,7 @@ public:
     }
 
     std::size_t sample_stride() const override { return sizeof(Test_sample); }
+    Time_order time_order(std::size_t /*lod*/) const override { return order; }
     std::uint64_t current_sequence(std::size_t /*lod_level*/) const override
     {
         return current_sequence_value;
@@ -349,6 +376,67 @@ bool test_global_lod_auto_range_uses_query_when_no_legacy_range_exists()
     return true;
 }
 
+bool test_global_auto_range_uses_published_range_without_query()
+{
+    auto source = std::make_shared<Query_range_source>();
+    source->levels                 = 2;
+    source->query_status           = Data_query_status::READY;
+    source->query_range            = {-100.0f, 100.0f};
+    source->published_status       = Data_query_status::READY;
+    source->published_range        = {-4.0f, 9.0f};
+    source->published_sequence     = 3;
+    source->current_sequence_value = 3;
+
+    auto series_map = make_series_map(make_stable_series(source));
+    plot::detail::auto_range_cache_t cache;
+    Plot_config config;
+    config.auto_v_range_mode = Auto_v_range_mode::GLOBAL_LOD;
+
+    const auto first = plot::detail::resolve_main_v_range(
+        series_map,
+        make_data_config(),
+        config,
+        true,
+        &cache);
+    const auto second = plot::detail::resolve_main_v_range(
+        series_map,
+        make_data_config(),
+        config,
+        true,
+        &cache);
+
+    TEST_ASSERT(first.first == -4.0f && first.second == 9.0f,
+        "GLOBAL_LOD should use the range the source published");
+    TEST_ASSERT(second.first == -4.0f && second.second == 9.0f,
+        "cached published range should be reused");
+    TEST_ASSERT(source->last_published_lod == 1,
+        "GLOBAL_LOD should ask for the published range of the last LOD level");
+    TEST_ASSERT(source->published_calls == 1,
+        "matching sequence should reuse the cached published range");
+    TEST_ASSERT(source->query_calls == 0 && source->snapshot_calls == 0,
+        "published range should avoid query_v_range and snapshot scans");
+
+    auto visible_source = std::make_shared<Query_range_source>();
+    visible_source->query_status     = Data_query_status::READY;
+    visible_source->query_range      = {1.0f, 2.0f};
+    visible_source->published_status = Data_query_status::READY;
+    visible_source->published_range  = {-4.0f, 9.0f};
+    config.auto_v_range_mode = Auto_v_range_mode::VISIBLE;
+
+    const auto visible = plot::detail::resolve_main_v_range(
+        make_series_map(make_series(visible_source)),
+        make_data_config(),
+        config,
+        true);
+
+    TEST_ASSERT(visible.first == 1.0f && visible.second == 2.0f,
+        "VISIBLE auto-range should not use the global published range");
+    TEST_ASSERT(visible_source->published_calls == 0,
+        "VISIBLE auto-range should not ask for a published range");
+
+    return true;
+}
+
 bool test_unsupported_query_falls_back_to_snapshot_scan()
 {
     auto source = std::make_shared<Query_range_source>();
@@ -439,6 +527,230 @@ bool test_default_query_profiler_counts_snapshot_scan()
     return true;
 }
 
+bool test_incremental_global_auto_range_scans_only_appended_samples()
+{
+    auto profiler = std::make_shared<Counting_profiler>();
+    auto source   = std::make_shared<Snapshot_range_source>();
+    source->samples = {
+        { 0,  6.0f  },
+        { 5,  8.0f  },
+        { 10, 12.0f },
+    };
+    source->prefix_revision = 1;
+
+    auto series    = make_series(source);
+    series->access = make_stable_policy();
+    auto series_map = make_series_map(series);
+    plot::detail::auto_range_cache_t cache;
+    Plot_config config;
+    config.auto_v_range_mode             = Auto_v_range_mode::GLOBAL;
+    config.incremental_global_auto_range = true;
+    config.profiler                      = profiler;
+
+    const auto first = plot::detail::resolve_main_v_range(
+        series_map,
+        make_data_config(),
+        config,
+        true,
+        &cache);
+    TEST_ASSERT(first.first == 6.0f && first.second == 12.0f,
+        "first range should come from a full scan");
+    TEST_ASSERT(profiler->total("renderer.auto_range.scanned_samples") == 3.0,
+        "first range should scan every sample");
+
+    source->samples.push_back({ 15, 20.0f });
+    source->samples.push_back({ 20, -1.0f });
+    source->snapshot_sequence      = 2;
+    source->current_sequence_value = 2;
+    const auto appended = plot::detail::resolve_main_v_range(
+        series_map,
+        make_data_config(),
+        config,
+        true,
+        &cache);
+    TEST_ASSERT(appended.first == -1.0f && appended.second == 20.0f,
+        "appended samples should extend the cached range");
+    TEST_ASSERT(profiler->total("renderer.auto_range.incremental_scan_count") == 1.0,
+        "an append should take the incremental path");
+    TEST_ASSERT(profiler->total("renderer.auto_range.scanned_samples") == 5.0,
+        "an append should scan only the appended samples");
+
+    source->samples[0]             = { 1, 30.0f };
+    source->samples.push_back({ 25, 2.0f });
+    source->snapshot_sequence      = 3;
+    source->current_sequence_value = 3;
+    source->prefix_revision        = 2;
+    const auto edited = plot::detail::resolve_main_v_range(
+        series_map,
+        make_data_config(),
+        config,
+        true,
+        &cache);
+    TEST_ASSERT(edited.first == -1.0f && edited.second == 30.0f,
+        "a changed prefix should be rescanned in full");
+    TEST_ASSERT(profiler->total("renderer.auto_range.incremental_scan_count") == 1.0,
+        "a changed prefix should not take the incremental path");
+    TEST_ASSERT(profiler->total("renderer.auto_range.scanned_samples") == 11.0,
+        "a changed prefix should scan every sample again");
+
+    // An interior edit keeps both scanned end timestamps; only the new
+    // prefix_revision reveals it.
+    source->samples[2]             = { 10, -40.0f };
+    source->samples.push_back({ 30, 3.0f });
+    source->snapshot_sequence      = 4;
+    source->current_sequence_value = 4;
+    source->prefix_revision        = 3;
+    const auto interior = plot::detail::resolve_main_v_range(
+        series_map,
+        make_data_config(),
+        config,
+        true,
+        &cache);
+    TEST_ASSERT(interior.first == -40.0f && interior.second == 30.0f,
+        "an interior edit should be rescanned in full");
+    TEST_ASSERT(profiler->total("renderer.auto_range.incremental_scan_count") == 1.0,
+        "an interior edit should not take the incremental path");
+    TEST_ASSERT(profiler->total("renderer.auto_range.scanned_samples") == 18.0,
+        "an interior edit should scan every sample again");
+
+    // Without an append promise even a plain append is rescanned.
+    source->samples.push_back({ 35, 4.0f });
+    source->snapshot_sequence      = 5;
+    source->current_sequence_value = 5;
+    source->prefix_revision        = 0;
+    const auto unpromised = plot::detail::resolve_main_v_range(
+        series_map,
+        make_data_config(),
+        config,
+        true,
+        &cache);
+    TEST_ASSERT(unpromised.first == -40.0f && unpromised.second == 30.0f,
+        "an unpromised append should keep the full range");
+    TEST_ASSERT(profiler->total("renderer.auto_range.incremental_scan_count") == 1.0,
+        "a zero prefix_revision should not take the incremental path");
+    TEST_ASSERT(profiler->total("renderer.auto_range.scanned_samples") == 26.0,
+        "a zero prefix_revision should scan every sample again");
+
+    return true;
+}
+
+bool test_incremental_global_auto_range_follows_vector_source_appends()
+{
+    auto profiler = std::make_shared<Counting_profiler>();
+    auto source   = std::make_shared<plot::Vector_data_source<Test_sample>>();
+    source->set_data({
+        { 0,  6.0f  },
+        { 5,  8.0f  },
+        { 10, 12.0f },
+    });
+
+    auto series         = std::make_shared<series_data_t>();
+    series->style       = Display_style::LINE;
+    series->data_source = source;
+    series->access      = make_stable_policy();
+    auto series_map = make_series_map(series);
+    plot::detail::auto_range_cache_t cache;
+    Plot_config config;
+    config.auto_v_range_mode             = Auto_v_range_mode::GLOBAL;
+    config.incremental_global_auto_range = true;
+    config.profiler                      = profiler;
+
+    const auto resolve = [&]() {
+        return plot::detail::resolve_main_v_range(
+            series_map,
+            make_data_config(),
+            config,
+            true,
+            &cache);
+    };
+
+    resolve();
+    source->append({{ 15, 20.0f }, { 20, -1.0f }});
+    const auto appended = resolve();
+    TEST_ASSERT(appended.first == -1.0f && appended.second == 20.0f,
+        "appended samples should extend the cached range");
+    TEST_ASSERT(profiler->total("renderer.auto_range.incremental_scan_count") == 1.0,
+        "Vector_data_source::append should take the incremental path");
+    TEST_ASSERT(profiler->total("renderer.auto_range.scanned_samples") == 5.0,
+        "an append should scan only the appended samples");
+
+    source->set_data({
+        { 0,  1.0f },
+        { 5,  2.0f },
+        { 10, 3.0f },
+        { 15, 4.0f },
+        { 20, 5.0f },
+        { 25, 6.0f },
+    });
+    const auto replaced = resolve();
+    TEST_ASSERT(replaced.first == 1.0f && replaced.second == 6.0f,
+        "set_data should be rescanned in full");
+    TEST_ASSERT(profiler->total("renderer.auto_range.incremental_scan_count") == 1.0,
+        "set_data should not take the incremental path");
+
+    return true;
+}
+
+bool test_incremental_auto_ranges_keep_overridden_queries()
+{
+    auto profiler = std::make_shared<Counting_profiler>();
+    auto source   = std::make_shared<Query_range_source>();
+    source->samples = {
+        { 0,  1.0f },
+        { 10, 2.0f },
+    };
+    source->query_status = Data_query_status::READY;
+    source->query_range  = {-3.0f, 9.0f};
+
+    auto series    = make_series(source);
+    series->access = make_stable_policy();
+    auto series_map = make_series_map(series);
+    plot::detail::auto_range_cache_t cache;
+    Plot_config config;
+    config.auto_v_range_mode             = Auto_v_range_mode::GLOBAL;
+    config.incremental_global_auto_range = true;
+    config.profiler                      = profiler;
+
+    const auto global = plot::detail::resolve_main_v_range(
+        series_map,
+        make_data_config(),
+        config,
+        true,
+        &cache);
+    TEST_ASSERT(global.first == -3.0f && global.second == 9.0f,
+        "an overridden query should answer incremental GLOBAL ranges");
+    TEST_ASSERT(source->query_calls == 1,
+        "incremental GLOBAL ranges should ask the overridden query once");
+    TEST_ASSERT(source->snapshot_calls == 0,
+        "an answered query should not be scanned");
+    TEST_ASSERT(profiler->total("renderer.auto_range.query_count") == 1.0,
+        "an answered query should be counted once");
+
+    // Ascending data would otherwise take the sliding tracker.
+    source->order       = Time_order::ASCENDING;
+    source->query_range = {-5.0f, 7.0f};
+    Plot_config visible_config;
+    visible_config.auto_v_range_mode          = Auto_v_range_mode::VISIBLE;
+    visible_config.sliding_visible_auto_range = true;
+    visible_config.profiler                   = profiler;
+
+    plot::detail::auto_range_cache_t visible_cache;
+    const auto visible = plot::detail::resolve_main_v_range(
+        series_map,
+        make_data_config(),
+        visible_config,
+        true,
+        &visible_cache);
+    TEST_ASSERT(visible.first == -5.0f && visible.second == 7.0f,
+        "an overridden query should answer sliding VISIBLE ranges");
+    TEST_ASSERT(source->query_calls == 2,
+        "sliding VISIBLE ranges should ask the overridden query once");
+    TEST_ASSERT(source->snapshot_calls == 0,
+        "an answered query should not feed the sliding tracker");
+
+    return true;
+}
+
 bool test_positive_auto_range_excludes_zero_by_default()
 {
     auto source = std::make_shared<Query_range_source>();
@@ -1199,6 +1511,223 @@ bool test_stacked_auto_range_includes_cumulative_envelope()
     return true;
 }
 
+bool test_parallel_auto_range_matches_sequential_result()
+{
+    std::vector<std::shared_ptr<Snapshot_range_source>> sources;
+    std::map<int, std::shared_ptr<const series_data_t>> series;
+    for (int i = 0; i < 12; ++i) {
+        auto source = std::make_shared<Snapshot_range_source>();
+        source->samples = {
+            { 0,  static_cast<float>(i)        },
+            { 5,  static_cast<float>(i) * 2.0f },
+            { 10, -static_cast<float>(i)       },
+        };
+        auto item    = make_series(source);
+        item->access = make_stable_policy();
+        if (i >= 9) {
+            item->stack_group = 1;
+        }
+        sources.push_back(source);
+        series[i + 1] = item;
+    }
+    auto shared_item = make_series(sources[0]);
+    shared_item->access = make_stable_policy();
+    series[100] = shared_item;
+
+    Plot_config config;
+    config.auto_v_range_mode = Auto_v_range_mode::GLOBAL;
+    const auto sequential = plot::detail::resolve_main_v_range(
+        series,
+        make_data_config(),
+        config,
+        true);
+
+    auto profiler = std::make_shared<Counting_profiler>();
+    plot::detail::auto_range_cache_t cache;
+    config.parallel_auto_range = true;
+    config.profiler            = profiler;
+    const auto parallel = plot::detail::resolve_main_v_range(
+        series,
+        make_data_config(),
+        config,
+        true,
+        &cache);
+
+    TEST_ASSERT(parallel == sequential,
+        "parallel auto-range should merge to the sequential result");
+    TEST_ASSERT(profiler->total("renderer.auto_range.query_count") == 13.0,
+        "observations made on worker threads should reach the profiler");
+    TEST_ASSERT(cache.main_entries.size() == 13,
+        "ranges resolved on worker threads should be cached");
+
+    int snapshot_calls = 0;
+    for (const auto& source : sources) {
+        snapshot_calls += source->snapshot_calls;
+    }
+    const auto cached = plot::detail::resolve_main_v_range(
+        series,
+        make_data_config(),
+        config,
+        true,
+        &cache);
+    int cached_snapshot_calls = 0;
+    for (const auto& source : sources) {
+        cached_snapshot_calls += source->snapshot_calls;
+    }
+    TEST_ASSERT(cached == sequential,
+        "cached ranges should merge to the sequential result");
+    TEST_ASSERT(cached_snapshot_calls == snapshot_calls,
+        "cached ranges should not query sources again");
+
+    return true;
+}
+
+bool test_sliding_visible_auto_range_reads_only_entering_samples()
+{
+    auto profiler = std::make_shared<Counting_profiler>();
+    auto source   = std::make_shared<Snapshot_range_source>();
+    source->order           = Time_order::ASCENDING;
+    source->stream_revision = 1;
+    for (int i = 0; i < 100; ++i) {
+        source->samples.push_back({i, static_cast<float>((i * 37) % 50 - 20)});
+    }
+
+    auto series    = make_series(source);
+    series->access = make_stable_policy();
+    auto series_map = make_series_map(series);
+    plot::detail::auto_range_cache_t cache;
+    Plot_config config;
+    config.auto_v_range_mode          = Auto_v_range_mode::VISIBLE;
+    config.sliding_visible_auto_range = true;
+    config.profiler                   = profiler;
+    Plot_config scan_config;
+    scan_config.auto_v_range_mode = Auto_v_range_mode::VISIBLE;
+
+    const auto resolve_window = [&](std::int64_t t_min, std::int64_t t_max) {
+        data_config_t data_cfg = make_data_config();
+        data_cfg.t_min = t_min;
+        data_cfg.t_max = t_max;
+        const auto tracked = plot::detail::resolve_main_v_range(
+            series_map, data_cfg, config, true, &cache);
+        const auto scanned = plot::detail::resolve_main_v_range(
+            series_map, data_cfg, scan_config, true);
+        return tracked == scanned;
+    };
+
+    TEST_ASSERT(resolve_window(10, 30),
+        "first tracked window should match a full scan");
+    TEST_ASSERT(profiler->total("renderer.auto_range.visible_tracker_rebuild_count") == 1.0,
+        "first window should build the tracker");
+    TEST_ASSERT(profiler->total("renderer.auto_range.scanned_samples") == 21.0,
+        "building should read the samples in the window");
+
+    for (std::int64_t shift = 1; shift <= 20; ++shift) {
+        TEST_ASSERT(resolve_window(10 + shift, 30 + shift),
+            "sliding window should match a full scan");
+    }
+    TEST_ASSERT(profiler->total("renderer.auto_range.visible_tracker_slide_count") == 20.0,
+        "forward moves should slide the tracker");
+    TEST_ASSERT(profiler->total("renderer.auto_range.scanned_samples") == 41.0,
+        "sliding should read only the entering samples");
+
+    source->samples.erase(source->samples.begin(), source->samples.begin() + 35);
+    for (int i = 100; i < 120; ++i) {
+        source->samples.push_back({i, static_cast<float>((i * 53) % 70 - 30)});
+    }
+    source->snapshot_sequence      = 2;
+    source->current_sequence_value = 2;
+    TEST_ASSERT(resolve_window(40, 110),
+        "dropped leading samples and appends should match a full scan");
+    TEST_ASSERT(profiler->total("renderer.auto_range.visible_tracker_slide_count") == 21.0,
+        "dropped leading samples should not force a rebuild");
+
+    TEST_ASSERT(resolve_window(20, 60),
+        "moving back should match a full scan");
+    TEST_ASSERT(profiler->total("renderer.auto_range.visible_tracker_rebuild_count") == 2.0,
+        "moving back should rebuild the tracker");
+
+    return true;
+}
+
+bool test_sliding_visible_auto_range_rebuilds_after_rewrites()
+{
+    auto profiler = std::make_shared<Counting_profiler>();
+    auto source   = std::make_shared<Snapshot_range_source>();
+    source->order = Time_order::ASCENDING;
+    for (int i = 0; i < 40; ++i) {
+        source->samples.push_back({i, static_cast<float>(i % 10)});
+    }
+
+    auto series    = make_series(source);
+    series->access = make_stable_policy();
+    auto series_map = make_series_map(series);
+    plot::detail::auto_range_cache_t cache;
+    Plot_config config;
+    config.auto_v_range_mode          = Auto_v_range_mode::VISIBLE;
+    config.sliding_visible_auto_range = true;
+    config.profiler                   = profiler;
+
+    const auto resolve_window = [&](std::int64_t t_min, std::int64_t t_max) {
+        data_config_t data_cfg = make_data_config();
+        data_cfg.t_min = t_min;
+        data_cfg.t_max = t_max;
+        return plot::detail::resolve_main_v_range(
+            series_map, data_cfg, config, true, &cache);
+    };
+
+    TEST_ASSERT(resolve_window(0, 20) == std::make_pair(0.0f, 9.0f),
+        "first window should cover its samples");
+
+    // Corrected values at the same timestamps: the last sample read is
+    // still where it was, but without a promise the tracker cannot keep
+    // what it read.
+    for (auto& sample : source->samples) {
+        sample.v += 100.0f;
+    }
+    source->snapshot_sequence      = 2;
+    source->current_sequence_value = 2;
+    TEST_ASSERT(resolve_window(1, 21) == std::make_pair(100.0f, 109.0f),
+        "rewritten values should replace the tracked range");
+    TEST_ASSERT(profiler->total("renderer.auto_range.visible_tracker_rebuild_count") == 2.0,
+        "a new sequence without a promise should rebuild the tracker");
+
+    TEST_ASSERT(resolve_window(2, 22) == std::make_pair(100.0f, 109.0f),
+        "an unchanged sequence should slide");
+    TEST_ASSERT(profiler->total("renderer.auto_range.visible_tracker_slide_count") == 1.0,
+        "an unchanged sequence should slide the tracker");
+
+    // Vector_data_source::set_data() starts a new revision, so republishing
+    // corrected values through the stock source rebuilds as well.
+    auto vector_source = std::make_shared<plot::Vector_data_source<Test_sample>>();
+    vector_source->set_data(source->samples, make_stable_policy());
+    series->data_source = vector_source;
+    plot::detail::auto_range_cache_t vector_cache;
+    const auto resolve_vector_window = [&](std::int64_t t_min, std::int64_t t_max) {
+        data_config_t data_cfg = make_data_config();
+        data_cfg.t_min = t_min;
+        data_cfg.t_max = t_max;
+        return plot::detail::resolve_main_v_range(
+            series_map, data_cfg, config, true, &vector_cache);
+    };
+    TEST_ASSERT(resolve_vector_window(0, 20) == std::make_pair(100.0f, 109.0f),
+        "the stock source should be tracked");
+    for (auto& sample : source->samples) {
+        sample.v -= 50.0f;
+    }
+    vector_source->set_data(source->samples, make_stable_policy());
+    TEST_ASSERT(resolve_vector_window(1, 21) == std::make_pair(50.0f, 59.0f),
+        "values republished through set_data should replace the tracked range");
+
+    vector_source->append({{40, -7.0f}}, make_stable_policy());
+    const double slides = profiler->total("renderer.auto_range.visible_tracker_slide_count");
+    TEST_ASSERT(resolve_vector_window(21, 41) == std::make_pair(-7.0f, 59.0f),
+        "an append should reach the tracked range");
+    TEST_ASSERT(profiler->total("renderer.auto_range.visible_tracker_slide_count") == slides + 1.0,
+        "an append to the stock source should slide the tracker");
+
+    return true;
+}
+
 }  // namespace
 
 int main()
@@ -1211,9 +1740,13 @@ int main()
     RUN_TEST(test_visible_auto_range_uses_source_query_without_snapshot_fallback);
     RUN_TEST(test_member_pointer_query_uses_stable_semantics_key);
     RUN_TEST(test_global_lod_auto_range_uses_query_when_no_legacy_range_exists);
+    RUN_TEST(test_global_auto_range_uses_published_range_without_query);
     RUN_TEST(test_unsupported_query_falls_back_to_snapshot_scan);
     RUN_TEST(test_ready_query_profiler_counts_query_without_scan);
     RUN_TEST(test_default_query_profiler_counts_snapshot_scan);
+    RUN_TEST(test_incremental_global_auto_range_scans_only_appended_samples);
+    RUN_TEST(test_incremental_global_auto_range_follows_vector_source_appends);
+    RUN_TEST(test_incremental_auto_ranges_keep_overridden_queries);
     RUN_TEST(test_positive_auto_range_excludes_zero_by_default);
     RUN_TEST(test_negative_auto_range_excludes_zero_by_default);
     RUN_TEST(test_nonnegative_auto_range_floor_policy_includes_zero);
@@ -1236,6 +1769,9 @@ int main()
     RUN_TEST(test_frame_range_planner_preserves_step_after_visible_scan);
     RUN_TEST(test_manual_range_skips_queries);
     RUN_TEST(test_stacked_auto_range_includes_cumulative_envelope);
+    RUN_TEST(test_parallel_auto_range_matches_sequential_result);
+    RUN_TEST(test_sliding_visible_auto_range_reads_only_entering_samples);
+    RUN_TEST(test_sliding_visible_auto_range_rebuilds_after_rewrites);
 
     std::cout << "Results: " << passed << " passed, " << failed << " failed" << std::endl;
 
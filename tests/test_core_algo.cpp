@@ -11,7 +11,9 @@
 #include <vnm_plot/rhi/text_renderer.h>
 #include "../src/core/label_fade_tracker.h"
 #include "../src/core/lcd_policy.h"
+#include "../src/core/parallel_for.h"
 
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <cstddef>
@@ -1328,6 +1330,46 @@ bool test_plot_config_default_lcd_request_is_auto_but_fails_closed()
     return true;
 }
 
+bool test_parallel_for_ranges_cover_every_item_once()
+{
+    const auto covers_once = [](std::size_t item_count, std::size_t min_items) {
+        std::vector<int>         hits(item_count, 0);
+        std::atomic<std::size_t> calls{0};
+        const std::size_t ranges = plot::detail::parallel_for_ranges(
+            item_count,
+            min_items,
+            [&](std::size_t, std::size_t first, std::size_t last) {
+                ++calls;
+                for (std::size_t i = first; i < last; ++i) {
+                    ++hits[i];
+                }
+            });
+        for (int hit : hits) {
+            if (hit != 1) {
+                return false;
+            }
+        }
+        return ranges == calls.load();
+    };
+
+    TEST_ASSERT(covers_once(0, 4), "empty range should be accepted");
+    TEST_ASSERT(covers_once(7, 4), "small range should run as one range");
+    TEST_ASSERT(covers_once(1000, 3), "split ranges should tile the item range");
+    TEST_ASSERT(
+        plot::detail::parallel_range_count(7, 4) == 1,
+        "ranges below twice the minimum should not split");
+    TEST_ASSERT(
+        plot::detail::parallel_range_count(1000, 0) == 1,
+        "zero minimum should disable splitting");
+    TEST_ASSERT(
+        plot::detail::parallel_range_begin(10, 3, 0) == 0 &&
+        plot::detail::parallel_range_begin(10, 3, 1) == 4 &&
+        plot::detail::parallel_range_begin(10, 3, 2) == 7 &&
+        plot::detail::parallel_range_begin(10, 3, 3) == 10,
+        "range boundaries should distribute the remainder to leading ranges");
+    return true;
+}
+
 } // namespace
 
 int main()
@@ -1367,6 +1409,7 @@ int main()
     RUN_TEST(test_built_in_label_backgrounds_are_opaque_for_lcd);
     RUN_TEST(test_grid_lcd_order_selection);
     RUN_TEST(test_plot_config_default_lcd_request_is_auto_but_fails_closed);
+    RUN_TEST(test_parallel_for_ranges_cover_every_item_once);
 
     std::cout << "Results: " << passed << " passed, " << failed << " failed" << std::endl;
     return failed > 0 ? 1 : 0;
@@ -649,6 +649,130 @@ bool test_lod_scales_match_compute_lod_scales_and_clamp_minimum()
     return true;
 }
 
+bool test_vector_source_publishes_global_range_for_its_access()
+{
+    plot::Data_access_policy access = make_value_access();
+    access.set_semantics_key(k_query_semantics_key, 1);
+
+    plot::Vector_data_source<sample_t> source;
+    source.set_data(
+        {
+            { 0, 3.0f  },
+            { 1, -4.0f },
+            { 2, 9.0f  },
+        },
+        access);
+
+    int value_calls = 0;
+    plot::Data_access_policy counting_access = make_value_access(nullptr, &value_calls);
+    counting_access.set_semantics_key(k_query_semantics_key, 1);
+    const auto query = make_query(counting_access, 1, 1);
+    const auto published = source.query_published_v_range(0, query);
+    TEST_ASSERT(published.status == plot::Data_query_status::READY,
+        "set_data with an access policy should publish a global range");
+    TEST_ASSERT(published.value.min == -4.0f && published.value.max == 9.0f,
+        "published range should cover every sample regardless of the time window");
+    TEST_ASSERT(published.sequence == source.current_sequence(0),
+        "published range should carry the sequence it describes");
+    TEST_ASSERT(value_calls == 0,
+        "published range should be answered without reading samples");
+
+    TEST_ASSERT(source.query_published_v_range(1, query).status ==
+            plot::Data_query_status::UNSUPPORTED,
+        "levels the source does not have should not report a published range");
+
+    auto replace_query = query;
+    replace_query.nonfinite_policy = plot::Nonfinite_sample_policy::REPLACE_WITH_ZERO;
+    TEST_ASSERT(source.query_published_v_range(0, replace_query).status ==
+            plot::Data_query_status::UNSUPPORTED,
+        "a range published under another nonfinite policy should not be used");
+
+    auto other_query = query;
+    other_query.semantics_key.revision = 2;
+    TEST_ASSERT(source.query_published_v_range(0, other_query).status ==
+            plot::Data_query_status::UNSUPPORTED,
+        "a range published under other semantics should not be used");
+
+    source.set_data({{ 0, 1.0f }});
+    TEST_ASSERT(source.query_published_v_range(0, query).status ==
+            plot::Data_query_status::UNSUPPORTED,
+        "set_data without an access policy should not publish a range");
+
+    return true;
+}
+
+bool test_vector_source_append_keeps_prefix_revision()
+{
+    plot::Data_access_policy access = make_value_access();
+    access.set_semantics_key(k_query_semantics_key, 1);
+    const auto query = make_query(access, 1, 1);
+
+    plot::Vector_data_source<sample_t> source;
+    source.set_data({{ 0, 3.0f }, { 1, -4.0f }}, access);
+    const auto first = source.try_snapshot(0).snapshot;
+    TEST_ASSERT(first.prefix_revision != 0,
+        "set_data should start an append promise");
+
+    source.append({{ 2, 9.0f }, { 3, 1.0f }}, access);
+    const auto appended = source.try_snapshot(0).snapshot;
+    TEST_ASSERT(appended.count == 4 && appended.sequence != first.sequence,
+        "append should publish the combined data as a new sequence");
+    TEST_ASSERT(appended.prefix_revision == first.prefix_revision,
+        "append should keep the prefix revision");
+    const auto published = source.query_published_v_range(0, query);
+    TEST_ASSERT(published.status == plot::Data_query_status::READY &&
+                published.value.min == -4.0f && published.value.max == 9.0f &&
+                published.sequence == appended.sequence,
+        "append should extend the published range");
+    TEST_ASSERT(source.time_order(0) == plot::Time_order::ASCENDING,
+        "an ascending append should keep ASCENDING");
+
+    source.append({{ 2, 0.0f }}, access);
+    TEST_ASSERT(source.time_order(0) == plot::Time_order::UNORDERED,
+        "an append that goes back in time should report UNORDERED");
+    TEST_ASSERT(source.try_snapshot(0).snapshot.prefix_revision == first.prefix_revision,
+        "an out-of-order append is still an append");
+
+    source.append({{ 5, 2.0f }});
+    TEST_ASSERT(source.query_published_v_range(0, query).status ==
+            plot::Data_query_status::UNSUPPORTED &&
+            source.time_order(0) == plot::Time_order::UNKNOWN,
+        "append without an access policy should drop the published range and order");
+
+    source.set_data({{ 0, 1.0f }});
+    const auto replaced = source.try_snapshot(0).snapshot;
+    TEST_ASSERT(replaced.prefix_revision != 0 &&
+                replaced.prefix_revision != first.prefix_revision,
+        "set_data should start a new prefix revision");
+
+    return true;
+}
+
+bool test_vector_source_reports_ascending_order_for_sorted_data()
+{
+    const plot::Data_access_policy access = make_value_access();
+
+    plot::Vector_data_source<sample_t> source;
+    TEST_ASSERT(source.time_order(0) == plot::Time_order::UNKNOWN,
+        "an empty source should not claim an order");
+
+    source.set_data({{ 0, 1.0f }, { 5, 2.0f }, { 5, 3.0f }, { 9, 4.0f }}, access);
+    TEST_ASSERT(source.time_order(0) == plot::Time_order::ASCENDING,
+        "non-decreasing timestamps should report ASCENDING");
+    TEST_ASSERT(source.time_order(1) == plot::Time_order::UNKNOWN,
+        "levels the source does not have should not report an order");
+
+    source.set_data({{ 0, 1.0f }, { 7, 2.0f }, { 3, 3.0f }}, access);
+    TEST_ASSERT(source.time_order(0) == plot::Time_order::UNORDERED,
+        "an out-of-order timestamp should not report ASCENDING");
+
+    source.set_data({{ 0, 1.0f }, { 1, 2.0f }});
+    TEST_ASSERT(source.time_order(0) == plot::Time_order::UNKNOWN,
+        "set_data without an access policy should not claim an order");
+
+    return true;
+}
+
 } // namespace
 
 int main()
@@ -680,6 +804,9 @@ int main()
     RUN_TEST(test_hold_forward_skip_uses_latest_drawable_pre_window_sample);
     RUN_TEST(test_hold_forward_reject_window_fails_on_nonfinite_held_candidate);
     RUN_TEST(test_lod_scales_match_compute_lod_scales_and_clamp_minimum);
+    RUN_TEST(test_vector_source_publishes_global_range_for_its_access);
+    RUN_TEST(test_vector_source_reports_ascending_order_for_sorted_data);
+    RUN_TEST(test_vector_source_append_keeps_prefix_revision);
 
     std::cout << "Results: " << passed << " passed, " << failed << " failed" << std::endl;
     return failed > 0 ? 1 : 0;
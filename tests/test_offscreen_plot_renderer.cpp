@@ -0,0 +1,438 @@
+// vnm_plot headless offscreen renderer tests
+
+#include "test_macros.h"
+
+#include <vnm_plot/core/access_policy.h>
+#include <vnm_plot/core/plot_config.h>
+#include <vnm_plot/core/types.h>
+#include <vnm_plot/rhi/offscreen_plot_renderer.h>
+#include <vnm_plot/rhi/pipeline_cache.h>
+#include <vnm_plot/rhi/series_data.h>
+
+#include <QGuiApplication>
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace plot = vnm::plot;
+
+namespace {
+
+struct sample_t
+{
+    std::int64_t   timestamp_ns = 0;
+    float          value        = 0.0f;
+};
+
+std::map<int, std::shared_ptr<const plot::series_data_t>> make_series_map(float slope)
+{
+    std::vector<sample_t> samples;
+    for (int i = 0; i < 64; ++i) {
+        samples.push_back({std::int64_t(i) * 100'000'000LL, slope * float(i)});
+    }
+
+    auto series         = std::make_shared<plot::rhi_series_data_t>();
+    series->style       = plot::Display_style::LINE;
+    series->data_source = std::make_shared<plot::Vector_data_source<sample_t>>(std::move(samples));
+    series->access      = plot::make_access_policy<sample_t>(
+        &sample_t::timestamp_ns,
+        &sample_t::value).erase();
+
+    std::map<int, std::shared_ptr<const plot::series_data_t>> series_map;
+    series_map[1] = series;
+    return series_map;
+}
+
+// `count` samples of a noisy wave over the same 6.4 s as make_series_map(),
+// dense enough for M4 to decimate a 160 px wide view.
+std::map<int, std::shared_ptr<const plot::series_data_t>> make_dense_series_map(
+    plot::Display_style style,
+    int                 count)
+{
+    std::vector<sample_t> samples;
+    std::uint32_t         noise = 12345u;
+    for (int i = 0; i < count; ++i) {
+        noise = noise * 1'664'525u + 1'013'904'223u;
+        const float jitter = float(noise >> 8) / float(1u << 24) - 0.5f;
+        samples.push_back({
+            std::int64_t(i) * 6'400'000'000LL / count,
+            16.0f + 8.0f * std::sin(float(i) * 0.002f) + 6.0f * jitter
+        });
+    }
+
+    auto series         = std::make_shared<plot::rhi_series_data_t>();
+    series->style       = style;
+    series->data_source = std::make_shared<plot::Vector_data_source<sample_t>>(std::move(samples));
+    series->access      = plot::make_access_policy<sample_t>(
+        &sample_t::timestamp_ns,
+        &sample_t::value).erase();
+
+    std::map<int, std::shared_ptr<const plot::series_data_t>> series_map;
+    series_map[1] = series;
+    return series_map;
+}
+
+plot::offscreen_view_t make_view(int width, int height)
+{
+    plot::offscreen_view_t view;
+    view.width                    = width;
+    view.height                   = height;
+    view.data_cfg.t_min           = 0;
+    view.data_cfg.t_max           = 6'400'000'000LL;
+    view.data_cfg.t_available_min = 0;
+    view.data_cfg.t_available_max = 6'400'000'000LL;
+    return view;
+}
+
+class Counting_profiler final : public plot::Profiler
+{
+public:
+    void begin_scope(const char* name) override
+    {
+        ++scopes[name ? name : ""];
+    }
+    void end_scope() override {}
+    void record_observation(const char* name, double value) override
+    {
+        observations[name ? name : ""] += value;
+    }
+
+    std::map<std::string, int>    scopes;
+    std::map<std::string, double> observations;
+};
+
+bool test_pixel_checksum_matches_benchmark()
+{
+    TEST_ASSERT(plot::pixel_checksum(nullptr, 0) == 1'469'598'103'934'665'603ull,
+        "an empty input must hash to the seed");
+    const std::uint8_t a = 'a';
+    TEST_ASSERT(plot::pixel_checksum(&a, 1) == 0x44bd8ad473cd9906ull,
+        "one byte must be xored in, then multiplied by the FNV prime");
+    return true;
+}
+
+bool test_render_before_initialize_fails()
+{
+    plot::Offscreen_plot_renderer renderer;
+    plot::Plot_config             config;
+    plot::offscreen_image_t       image;
+    std::string                   error_message;
+    TEST_ASSERT(!renderer.render(make_view(64, 32), {}, config, image, error_message),
+        "render must fail before initialize");
+    TEST_ASSERT(!error_message.empty(), "the failure must be reported");
+    return true;
+}
+
+bool test_null_backend_reads_back_full_frames()
+{
+    plot::Offscreen_plot_renderer renderer;
+    std::string                   error_message;
+    TEST_ASSERT(renderer.initialize(plot::offscreen_backend_t::NULL_BACKEND, error_message),
+        "Null backend must initialize: " << error_message);
+    TEST_ASSERT(!renderer.initialize(plot::offscreen_backend_t::NULL_BACKEND, error_message),
+        "a second initialize must be rejected");
+
+    plot::Plot_config       config;
+    plot::offscreen_image_t image;
+    const auto              series = make_series_map(0.5f);
+
+    TEST_ASSERT(renderer.render(make_view(160, 90), series, config, image, error_message),
+        "first frame must render: " << error_message);
+    TEST_ASSERT(image.width == 160 && image.height == 90, "image must match the view size");
+    TEST_ASSERT(image.pixels.size() == std::size_t(160) * 90 * 4, "image must hold RGBA8 rows");
+
+    // A resized view recreates the target but keeps the renderers.
+    config.preview_height_px = 20.0;
+    TEST_ASSERT(renderer.render(make_view(96, 128), series, config, image, error_message),
+        "resized frame must render: " << error_message);
+    TEST_ASSERT(image.width == 96 && image.height == 128, "image must follow the resize");
+    TEST_ASSERT(image.pixels.size() == std::size_t(96) * 128 * 4, "resized image must hold RGBA8 rows");
+
+    TEST_ASSERT(!renderer.render(make_view(0, 10), series, config, image, error_message),
+        "an empty view must be rejected");
+    return true;
+}
+
+bool test_skip_unchanged_frames_returns_last_image()
+{
+    plot::Offscreen_plot_renderer renderer;
+    std::string                   error_message;
+    TEST_ASSERT(renderer.initialize(plot::offscreen_backend_t::NULL_BACKEND, error_message),
+        "Null backend must initialize: " << error_message);
+
+    auto profiler = std::make_shared<Counting_profiler>();
+    plot::Plot_config config;
+    config.skip_unchanged_frames = true;
+    config.profiler              = profiler;
+    const auto series   = make_series_map(0.5f);
+    const auto drawn    = [&] { return profiler->scopes["renderer.frame"]; };
+    const auto skipped  = [&] {
+        return profiler->observations["qrhi.renderer.unchanged_frame_skip_count"];
+    };
+
+    plot::offscreen_view_t  view = make_view(120, 80);
+    view.config_revision         = 1;
+    plot::offscreen_image_t first;
+    plot::offscreen_image_t second;
+    TEST_ASSERT(renderer.render(view, series, config, first, error_message),
+        "first frame must render: " << error_message);
+    TEST_ASSERT(drawn() == 1 && skipped() == 0.0, "the first frame must be drawn");
+
+    TEST_ASSERT(renderer.render(view, series, config, second, error_message),
+        "unchanged frame must succeed: " << error_message);
+    TEST_ASSERT(drawn() == 1 && skipped() == 1.0,
+        "the same frame again must be skipped and counted");
+    TEST_ASSERT(second.width == first.width && second.height == first.height &&
+        second.pixels == first.pixels,
+        "a skipped frame must return the last image");
+
+    view.data_cfg.t_min = 100'000'000LL;
+    TEST_ASSERT(renderer.render(view, series, config, second, error_message),
+        "moved frame must render: " << error_message);
+    TEST_ASSERT(drawn() == 2 && skipped() == 1.0, "a moved view must be drawn");
+
+    auto* source = static_cast<plot::Vector_data_source<sample_t>*>(
+        series.at(1)->main_source());
+    source->set_data({{0, 1.0f}, {6'400'000'000LL, 2.0f}});
+    TEST_ASSERT(renderer.render(view, series, config, second, error_message),
+        "frame with new data must render: " << error_message);
+    TEST_ASSERT(drawn() == 3 && skipped() == 1.0, "new source content must be drawn");
+
+    view.config_revision = 2;
+    TEST_ASSERT(renderer.render(view, series, config, second, error_message),
+        "frame with a new config must render: " << error_message);
+    TEST_ASSERT(renderer.render(view, series, config, second, error_message),
+        "unchanged frame must succeed: " << error_message);
+    TEST_ASSERT(drawn() == 4 && skipped() == 2.0,
+        "a config revision must be drawn once, then skipped");
+
+    view.config_revision = 0;
+    TEST_ASSERT(renderer.render(view, series, config, second, error_message),
+        "frame without a config revision must render: " << error_message);
+    TEST_ASSERT(renderer.render(view, series, config, second, error_message),
+        "frame without a config revision must render: " << error_message);
+    TEST_ASSERT(drawn() == 6 && skipped() == 2.0,
+        "frames without a config revision must always be drawn");
+    return true;
+}
+
+// Renders real pixels when a GPU or software rasterizer backend is around,
+// and checks them through pixel_checksum(), as the benchmark's
+// --pixel-checksum does. Skipped when no such backend initializes.
+bool test_real_backend_renders_series_pixels()
+{
+    plot::Offscreen_plot_renderer renderer;
+    std::string                   error_message;
+    bool                          initialized = false;
+    for (const auto backend : {plot::offscreen_backend_t::OPENGL, plot::offscreen_backend_t::VULKAN}) {
+        if (renderer.initialize(backend, error_message)) {
+            initialized = true;
+            break;
+        }
+    }
+    if (!initialized) {
+        std::cout << "(skipped: no OpenGL or Vulkan backend: " << error_message << ") ";
+        return true;
+    }
+
+    plot::Plot_config config;
+    config.show_text = false;
+    const plot::offscreen_view_t view = make_view(160, 90);
+    const auto checksum_of = [&](
+        const std::map<int, std::shared_ptr<const plot::series_data_t>>& series,
+        std::uint64_t& checksum) -> bool
+    {
+        plot::offscreen_image_t image;
+        if (!renderer.render(view, series, config, image, error_message) ||
+            image.pixels.size() != std::size_t(view.width) * std::size_t(view.height) * 4)
+        {
+            return false;
+        }
+        checksum = plot::pixel_checksum(image.pixels.data(), image.pixels.size());
+        return true;
+    };
+
+    const auto rising  = make_series_map(0.5f);
+    const auto falling = make_series_map(-0.5f);
+    std::uint64_t empty_checksum   = 0;
+    std::uint64_t rising_checksum  = 0;
+    std::uint64_t repeat_checksum  = 0;
+    std::uint64_t falling_checksum = 0;
+    TEST_ASSERT(checksum_of({}, empty_checksum), "empty frame must render: " << error_message);
+    TEST_ASSERT(checksum_of(rising, rising_checksum), "series frame must render: " << error_message);
+    TEST_ASSERT(checksum_of(rising, repeat_checksum), "repeated frame must render: " << error_message);
+    TEST_ASSERT(checksum_of(falling, falling_checksum), "other series must render: " << error_message);
+
+    TEST_ASSERT(rising_checksum == repeat_checksum,
+        "the same frame must produce the same pixels");
+    TEST_ASSERT(rising_checksum != empty_checksum,
+        "a series must change the rendered pixels");
+    TEST_ASSERT(rising_checksum != falling_checksum,
+        "different series data must produce different pixels");
+    return true;
+}
+
+// M4 keeps each pixel column's first, last, lowest and highest sample, so
+// on a real backend the decimated LINE and AREA frames cover the same rows
+// in every column as the undecimated ones. Coverage is compared per column
+// rather than bit for bit: the line shader antialiases and blends, and
+// fewer overlapping segments change the blended edge values. Skipped when
+// no such backend initializes.
+bool test_m4_decimation_keeps_column_coverage()
+{
+    plot::Offscreen_plot_renderer renderer;
+    std::string                   error_message;
+    bool                          initialized = false;
+    for (const auto backend : {plot::offscreen_backend_t::OPENGL, plot::offscreen_backend_t::VULKAN}) {
+        if (renderer.initialize(backend, error_message)) {
+            initialized = true;
+            break;
+        }
+    }
+    if (!initialized) {
+        std::cout << "(skipped: no OpenGL or Vulkan backend: " << error_message << ") ";
+        return true;
+    }
+
+    auto profiler = std::make_shared<Counting_profiler>();
+    plot::Plot_config config;
+    config.show_text = false;
+    config.profiler  = profiler;
+    plot::offscreen_view_t view = make_view(160, 90);
+    view.data_cfg.v_min = 0.0f;
+    view.data_cfg.v_max = 32.0f;
+
+    plot::offscreen_image_t background;
+    TEST_ASSERT(renderer.render(view, {}, config, background, error_message),
+        "empty frame must render: " << error_message);
+
+    // First and last row of each column that differs from the empty frame,
+    // or {-1, -1} for an untouched column.
+    const auto column_extents = [&](const plot::offscreen_image_t& image) {
+        std::vector<std::pair<int, int>> extents(std::size_t(image.width), {-1, -1});
+        for (int y = 0; y < image.height; ++y) {
+            for (int x = 0; x < image.width; ++x) {
+                const std::size_t at = (std::size_t(y) * std::size_t(image.width) + std::size_t(x)) * 4;
+                if (std::memcmp(&image.pixels[at], &background.pixels[at], 4) == 0) {
+                    continue;
+                }
+                auto& extent = extents[std::size_t(x)];
+                if (extent.first < 0) {
+                    extent.first = y;
+                }
+                extent.second = y;
+            }
+        }
+        return extents;
+    };
+
+    for (const auto style : {plot::Display_style::LINE, plot::Display_style::AREA}) {
+        const auto series = make_dense_series_map(style, 40'000);
+
+        config.m4_decimation = false;
+        plot::offscreen_image_t full;
+        TEST_ASSERT(renderer.render(view, series, config, full, error_message),
+            "undecimated frame must render: " << error_message);
+
+        profiler->observations.clear();
+        config.m4_decimation = true;
+        plot::offscreen_image_t decimated;
+        TEST_ASSERT(renderer.render(view, series, config, decimated, error_message),
+            "decimated frame must render: " << error_message);
+        TEST_ASSERT(profiler->observations["renderer.frame.m4_decimated_view_count"] > 0.0,
+            "the dense window must be decimated");
+
+        TEST_ASSERT(plot::pixel_checksum(full.pixels.data(), full.pixels.size()) !=
+            plot::pixel_checksum(background.pixels.data(), background.pixels.size()),
+            "the series must change the rendered pixels");
+
+        const auto full_extents      = column_extents(full);
+        const auto decimated_extents = column_extents(decimated);
+        for (std::size_t x = 0; x < full_extents.size(); ++x) {
+            const auto& a = full_extents[x];
+            const auto& b = decimated_extents[x];
+            TEST_ASSERT((a.first < 0) == (b.first < 0),
+                "column " << x << " must be drawn in both frames or in neither");
+            TEST_ASSERT(std::abs(a.first - b.first) <= 1 && std::abs(a.second - b.second) <= 1,
+                "column " << x << " must cover the same rows within a pixel: ["
+                    << a.first << ", " << a.second << "] vs ["
+                    << b.first << ", " << b.second << "]");
+        }
+    }
+    return true;
+}
+
+bool test_instances_render_concurrently()
+{
+    constexpr int k_threads = 4;
+    constexpr int k_frames  = 8;
+
+    std::atomic<int>         failures{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < k_threads; ++t) {
+        threads.emplace_back([t, &failures] {
+            plot::Offscreen_plot_renderer renderer;
+            std::string                   error_message;
+            if (!renderer.initialize(plot::offscreen_backend_t::NULL_BACKEND, error_message)) {
+                ++failures;
+                return;
+            }
+            plot::Plot_config       config;
+            plot::offscreen_image_t image;
+            const auto              series = make_series_map(float(t + 1));
+            for (int frame = 0; frame < k_frames; ++frame) {
+                if (!renderer.render(make_view(80 + frame, 60), series, config, image, error_message) ||
+                    image.pixels.size() != std::size_t(80 + frame) * 60 * 4)
+                {
+                    ++failures;
+                    return;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    TEST_ASSERT(failures.load() == 0, "every thread must render all of its frames");
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    // The OpenGL backend needs an application and a platform; offscreen
+    // keeps the test independent of a display.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QGuiApplication app(argc, argv);
+
+    std::cout << "Offscreen plot renderer tests" << std::endl;
+
+    // Keep test runs from writing pipeline cache files.
+    plot::set_pipeline_disk_cache_enabled(false);
+
+    int passed = 0;
+    int failed = 0;
+
+    RUN_TEST(test_pixel_checksum_matches_benchmark);
+    RUN_TEST(test_render_before_initialize_fails);
+    RUN_TEST(test_null_backend_reads_back_full_frames);
+    RUN_TEST(test_skip_unchanged_frames_returns_last_image);
+    RUN_TEST(test_real_backend_renders_series_pixels);
+    RUN_TEST(test_m4_decimation_keeps_column_coverage);
+    RUN_TEST(test_instances_render_concurrently);
+
+    std::cout << "Results: " << passed << " passed, " << failed << " failed" << std::endl;
+    return failed > 0 ? 1 : 0;
+}
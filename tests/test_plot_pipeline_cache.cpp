@@ -0,0 +1,140 @@
+// vnm_plot Plot_widget pipeline disk cache tests
+
+#include "test_macros.h"
+
+#include <vnm_plot/qt/plot_widget.h>
+#include <vnm_plot/rhi/pipeline_cache.h>
+
+#include "../src/core/pipeline_cache_file.h"
+
+#include <QByteArray>
+#include <QDir>
+#include <QEventLoop>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QQuickGraphicsConfiguration>
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <rhi/qrhi.h>
+
+#include <iostream>
+#include <memory>
+
+namespace plot = vnm::plot;
+
+namespace {
+
+struct window_run_t
+{
+    bool           rendered                 = false;
+    bool           pipeline_cache_supported = false;
+    QByteArray     backend_name;
+    QByteArray     initial_data;   // pipeline cache data right after QRhi creation
+    QString        save_file;      // Qt Quick's pipeline cache save file
+};
+
+// Shows a window holding a Plot_widget until its first frame is swapped,
+// then destroys it, which lets Qt Quick save its pipeline cache.
+window_run_t run_plot_window()
+{
+    window_run_t run;
+    auto window = std::make_unique<QQuickWindow>();
+    window->resize(96, 64);
+
+    auto* widget = new plot::Plot_widget;
+    widget->setParent(window->contentItem());
+    widget->setParentItem(window->contentItem());
+    widget->setSize(QSizeF(96.0, 64.0));
+    run.save_file = window->graphicsConfiguration().pipelineCacheSaveFile();
+
+    QEventLoop loop;
+    QObject::connect(window.get(), &QQuickWindow::sceneGraphInitialized, [&] {
+        if (QRhi* rhi = window->rhi()) {
+            run.pipeline_cache_supported = rhi->isFeatureSupported(QRhi::PipelineCache);
+            run.backend_name             = rhi->backendName();
+            run.initial_data             = rhi->pipelineCacheData();
+        }
+    });
+    QObject::connect(window.get(), &QQuickWindow::frameSwapped, &loop, [&] {
+        run.rendered = true;
+        loop.quit();
+    });
+    QObject::connect(window.get(), &QQuickWindow::sceneGraphError, &loop, &QEventLoop::quit);
+    QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+
+    window->show();
+    loop.exec();
+    window.reset();
+    QCoreApplication::processEvents();
+    return run;
+}
+
+// Plot_widget cannot save through the library's own cache file, as Qt Quick
+// creates the QRhi without QRhi::EnablePipelineCacheDataSave. It points
+// Qt Quick's pipeline cache at the cache directory instead: the first window
+// saves it, the next one starts from it. Skipped when the scene graph does
+// not render or its backend has no pipeline cache.
+bool test_plot_widget_persists_qt_quick_pipeline_cache()
+{
+    plot::set_pipeline_disk_cache_enabled(false);
+    const window_run_t baseline = run_plot_window();
+    plot::set_pipeline_disk_cache_enabled(true);
+    TEST_ASSERT(baseline.save_file.isEmpty(),
+        "a disabled disk cache must leave Qt Quick's pipeline cache alone");
+    if (!baseline.rendered || !baseline.pipeline_cache_supported) {
+        std::cout << "(skipped: no scene graph backend with a pipeline cache) ";
+        return true;
+    }
+
+    const window_run_t first = run_plot_window();
+    TEST_ASSERT(first.rendered, "the first window must render");
+    const QString expected_file = QString::fromStdU16String(
+        plot::detail::quick_pipeline_cache_file_path(first.backend_name.constData()).u16string());
+    TEST_ASSERT(first.save_file == expected_file,
+        "Plot_widget must point Qt Quick's pipeline cache at the library cache file");
+    TEST_ASSERT(QFileInfo(first.save_file).size() > 0,
+        "destroying the window must save the pipeline cache");
+
+    const window_run_t second = run_plot_window();
+    TEST_ASSERT(second.rendered, "the second window must render");
+    TEST_ASSERT(second.save_file == expected_file, "every window must use the same cache file");
+    TEST_ASSERT(second.initial_data.size() > baseline.initial_data.size(),
+        "the next window must start from the saved pipeline cache");
+
+    // Qt Quick persists the data, so the library writes no file of its own.
+    const QStringList own_files = QFileInfo(first.save_file).dir().entryList(
+        {QStringLiteral("qrhi_pipeline_cache_v1_") + QString::fromLatin1(first.backend_name) + QStringLiteral("_*")},
+        QDir::Files);
+    TEST_ASSERT(own_files.isEmpty(), "the library must not save the window's QRhi a second time");
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    // Offscreen keeps the test independent of a display; the basic render
+    // loop renders and saves on this thread.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    qputenv("QSG_RENDER_LOOP", "basic");
+
+    // Keep cache files out of the user's cache directory.
+    QTemporaryDir cache_home;
+    qputenv("XDG_CACHE_HOME", cache_home.path().toLocal8Bit());
+
+    QGuiApplication app(argc, argv);
+
+    std::cout << "Plot widget pipeline cache tests" << std::endl;
+
+    int passed = 0;
+    int failed = 0;
+
+    RUN_TEST(test_plot_widget_persists_qt_quick_pipeline_cache);
+
+    std::cout << "Results: " << passed << " passed, " << failed << " failed" << std::endl;
+    return failed > 0 ? 1 : 0;
+}
@@ -5,6 +5,8 @@
 #include <vnm_plot/core/access_policy.h>
 #include <vnm_plot/rhi/asset_loader.h>
 #include <vnm_plot/core/plot_config.h>
+#include "../src/core/chrome_layer.h"
+#include "../src/core/series_window_planner.h"
 #define private public
 #include <vnm_plot/rhi/series_renderer.h>
 #undef private
@@ -15,13 +17,18 @@
 #include <QSize>
 #include <rhi/qrhi.h>
 
+#include <chrono>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <map>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -459,6 +466,35 @@ public:
         return true;
     }
 
+    // Reads the first `byte_count` bytes of `buffer` back in a frame of its own.
+    bool read_back_buffer(
+        QRhiBuffer*    buffer,
+        std::size_t    byte_count,
+        QByteArray&    data,
+        std::string&   error_message)
+    {
+        if (!buffer || byte_count > buffer->size()) {
+            error_message = "buffer to read back is missing or too small";
+            return false;
+        }
+        QRhiCommandBuffer* command_buffer = nullptr;
+        if (m_rhi->beginOffscreenFrame(&command_buffer) != QRhi::FrameOpSuccess || !command_buffer) {
+            error_message = "QRhi beginOffscreenFrame failed";
+            return false;
+        }
+        QRhiReadbackResult       result;
+        QRhiResourceUpdateBatch* updates = m_rhi->nextResourceUpdateBatch();
+        updates->readBackBuffer(buffer, 0, static_cast<quint32>(byte_count), &result);
+        command_buffer->resourceUpdate(updates);
+        m_rhi->endOffscreenFrame();
+        data = result.data;
+        if (static_cast<std::size_t>(data.size()) != byte_count) {
+            error_message = "buffer readback returned the wrong size";
+            return false;
+        }
+        return true;
+    }
+
 private:
     std::unique_ptr<QRhi> m_rhi;
     std::unique_ptr<QRhiRenderBuffer> m_color_buffer;
@@ -555,7 +591,6 @@ bool assert_compact_upload_state(
     const plot::Series_renderer&       renderer,
     int                                series_id,
     const layer_event_t&               prepare,
-    std::size_t                        expected_line_window_sample_count,
     std::string_view                   label)
 {
     constexpr std::size_t k_gpu_sample_bytes = sizeof(float) * 4u;
@@ -574,10 +609,6 @@ bool assert_compact_upload_state(
     TEST_ASSERT(view_state.last_sample_upload_bytes <
         prepare.snapshot_count * k_gpu_sample_bytes,
         std::string(label) + " upload bytes must not scale with full snapshot count");
-    TEST_ASSERT(
-        view_state.last_line_window_sample_count ==
-            expected_line_window_sample_count,
-        std::string(label) + " line-window sample count mismatch");
     TEST_ASSERT(view_state.last_sample_buffer,
         std::string(label) + " compact VBO should exist");
     TEST_ASSERT(prepare.sample_buffer == view_state.last_sample_buffer,
@@ -694,7 +725,7 @@ bool test_layer_only_zero_style_prepare_record_order()
     TEST_ASSERT(view_state.last_primitive_prepare_count == 0,
         "custom-only drawable layers must not prepare built-in primitives");
     if (!assert_compact_upload_state(
-            renderer, 7, events[low_prepare], 0, "custom-only low layer"))
+            renderer, 7, events[low_prepare], "custom-only low layer"))
     {
         return false;
     }
@@ -866,7 +897,7 @@ bool test_builtin_upload_stages_visible_window_only()
         "linear visible upload should stage one GPU sample per source sample");
 
     if (!assert_compact_upload_state(
-            renderer, series_id, *prepare, prepare->gpu_count, "linear line"))
+            renderer, series_id, *prepare, "linear line"))
     {
         return false;
     }
@@ -957,6 +988,121 @@ bool test_builtin_upload_reuses_vbo_capacity_headroom()
     return true;
 }
 
+bool test_streaming_sample_buffer_uploads_only_appended_tail()
+{
+    constexpr std::int64_t k_second_ns        = 1'000'000'000LL;
+    constexpr std::int64_t k_step_ns          = k_second_ns / 10;
+    constexpr std::size_t  k_gpu_sample_bytes = sizeof(float) * 4u;
+
+    std::vector<layer_event_t> events;
+    int create_count = 0;
+    auto layer = std::make_shared<Recording_layer>(
+        "stream-upload", 1, 20, events, create_count);
+    auto source = std::make_shared<Test_source>();
+    std::vector<test_sample_t> samples;
+    samples.reserve(1024);
+    for (std::size_t i = 0; i < 1024; ++i) {
+        samples.push_back({
+            static_cast<std::int64_t>(i) * k_step_ns,
+            static_cast<float>(i % 10)
+        });
+    }
+    source->set_samples(std::move(samples));
+
+    auto series = make_line_plus_layer_series(source, {layer});
+    std::map<int, std::shared_ptr<const plot::series_data_t>> series_map;
+    const int series_id = 39;
+    series_map[series_id] = series;
+
+    plot::Asset_loader asset_loader;
+    plot::Series_renderer renderer;
+    renderer.initialize(asset_loader);
+
+    Offscreen_rhi_fixture rhi_fixture;
+    std::string error_message;
+    TEST_ASSERT(rhi_fixture.initialize(error_message), error_message);
+
+    plot::Plot_config config;
+    config.streaming_sample_buffers = true;
+    const plot::frame_layout_result_t layout = make_layout();
+    plot::frame_context_t ctx = make_context(layout, config);
+    ctx.t0                                   = 40LL * k_second_ns;
+    ctx.t1                                   = 50LL * k_second_ns;
+    ctx.t_available_min                      = ctx.t0;
+    ctx.t_available_max                      = ctx.t1;
+
+    TEST_ASSERT(
+        rhi_fixture.render_layer_frame(renderer, ctx, series_map, events, error_message),
+        error_message);
+    const layer_event_t* first_prepare = find_prepare_event(events, "stream-upload");
+    TEST_ASSERT(first_prepare && first_prepare->gpu_count > 0,
+        "first streaming frame should plan a drawable GPU window");
+    TEST_ASSERT(first_prepare->sample_buffer_first_sample == 0,
+        "first streaming frame should start at the beginning of the buffer");
+
+    auto state_it = renderer.m_vbo_states.find(series_id);
+    TEST_ASSERT(state_it != renderer.m_vbo_states.end(),
+        "expected renderer VBO state for streaming test");
+    const auto& view_state = state_it->second.main_view;
+    TEST_ASSERT(view_state.rhi_vbo_dynamic,
+        "streaming sample buffers should allocate a Dynamic VBO");
+    TEST_ASSERT(view_state.last_sample_upload_bytes ==
+        first_prepare->gpu_count * k_gpu_sample_bytes,
+        "first streaming frame should upload the whole window");
+    const std::size_t first_capacity   = view_state.rhi_vbo_capacity_bytes;
+    const std::size_t first_generation = view_state.last_vbo_generation;
+    TEST_ASSERT(first_capacity >= 2u * first_prepare->gpu_count * k_gpu_sample_bytes,
+        "streaming VBO should reserve room for the window to slide");
+
+    // Slide by half a second; the snapped view origin stays at 40 s.
+    events.clear();
+    ctx.t0              = 40LL * k_second_ns + k_second_ns / 2;
+    ctx.t1              = 50LL * k_second_ns + k_second_ns / 2;
+    ctx.t_available_min = ctx.t0;
+    ctx.t_available_max = ctx.t1;
+    TEST_ASSERT(
+        rhi_fixture.render_layer_frame(renderer, ctx, series_map, events, error_message),
+        error_message);
+    const layer_event_t* second_prepare = find_prepare_event(events, "stream-upload");
+    TEST_ASSERT(second_prepare && second_prepare->gpu_count > 0,
+        "second streaming frame should plan a drawable GPU window");
+    TEST_ASSERT(second_prepare->t_origin_ns == first_prepare->t_origin_ns,
+        "half-second slide should keep the snapped view origin");
+    TEST_ASSERT(view_state.sample_base > 0,
+        "appended window should advance the first GPU slot");
+    TEST_ASSERT(second_prepare->sample_buffer_first_sample == view_state.sample_base,
+        "layer sample buffer should start at the streaming base slot");
+    TEST_ASSERT(view_state.last_sample_upload_bytes > 0 &&
+        view_state.last_sample_upload_bytes <
+            second_prepare->gpu_count * k_gpu_sample_bytes / 2u,
+        "appended window should upload only its new tail");
+    TEST_ASSERT(view_state.rhi_vbo_capacity_bytes == first_capacity,
+        "streaming VBO capacity should stay stable while sliding");
+    TEST_ASSERT(view_state.last_vbo_generation == first_generation,
+        "streaming VBO must not be reallocated while sliding");
+
+    // Slide again: the kept samples stay where the last frame staged them
+    // and only the staging start advances.
+    const auto* const staged_before = view_state.staging.data();
+    events.clear();
+    ctx.t0              += k_second_ns / 2;
+    ctx.t1              += k_second_ns / 2;
+    ctx.t_available_min = ctx.t0;
+    ctx.t_available_max = ctx.t1;
+    TEST_ASSERT(
+        rhi_fixture.render_layer_frame(renderer, ctx, series_map, events, error_message),
+        error_message);
+    TEST_ASSERT(view_state.staging.data() > staged_before &&
+        view_state.staging.data() < staged_before + view_state.staging.size(),
+        "sliding should advance the staging start instead of moving kept samples");
+    TEST_ASSERT(view_state.last_sample_upload_bytes > 0 &&
+        view_state.last_sample_upload_bytes <
+            view_state.staging.size() * k_gpu_sample_bytes / 2u,
+        "the second slide should upload only its new tail");
+
+    return true;
+}
+
 bool test_combined_builtin_uploads_samples_once_per_view()
 {
     constexpr std::int64_t k_second_ns        = 1'000'000'000LL;
@@ -1022,12 +1168,6 @@ bool test_combined_builtin_uploads_samples_once_per_view()
     TEST_ASSERT(view_state.last_sample_upload_bytes ==
         prepare->gpu_count * k_gpu_sample_bytes,
         "combined style upload bytes must match one compact GPU window");
-    TEST_ASSERT(view_state.last_line_window_sample_count == prepare->gpu_count,
-        "combined style LINE primitive should still prepare its padded window");
-    const auto* const first_line_window_staging_data =
-        view_state.line_window_staging.data();
-    TEST_ASSERT(first_line_window_staging_data,
-        "combined style LINE primitive should allocate reusable line-window scratch");
 
     events.clear();
     TEST_ASSERT(
@@ -1041,13 +1181,8 @@ bool test_combined_builtin_uploads_samples_once_per_view()
         "combined primitive prepare count must describe the current frame");
     TEST_ASSERT(view_state.last_sample_upload_count == 1,
         "combined sample upload count must describe the current frame");
-    TEST_ASSERT(view_state.last_line_window_upload_count == 0,
-        "unchanged custom-layer snapshots must reuse LINE geometry");
     TEST_ASSERT(view_state.last_staged_sample_count == second_prepare->gpu_count,
         "second combined frame must stage the shared compact GPU window");
-    TEST_ASSERT(
-        view_state.line_window_staging.data() == first_line_window_staging_data,
-        "same-size LINE prepare should reuse the same line-window scratch allocation");
 
     return true;
 }
@@ -1391,11 +1526,9 @@ bool test_nonfinite_break_and_skip_split_drawable_spans()
             "AREA rendering should break only for BREAK_SEGMENT and compact SKIP gaps");
         TEST_ASSERT(view_state.last_recorded_dot_sample_count == 4,
             "DOTS rendering should draw only compact valid samples");
-        TEST_ASSERT(view_state.last_line_window_sample_count == 4,
-            "LINE padded windows should be built per drawable span");
 
         if (!assert_compact_upload_state(
-                renderer, test_case.series_id, *prepare, 4, test_case.layer_id))
+                renderer, test_case.series_id, *prepare, test_case.layer_id))
         {
             return false;
         }
@@ -1845,8 +1978,6 @@ bool test_non_rhi_prepare_invalidates_prior_upload_before_fast_path()
     TEST_ASSERT(state_it->second.main_view.has_uploaded_vbo &&
         state_it->second.main_view.last_staged_sample_count > 1,
         "initial QRhi frame should upload multiple samples");
-    TEST_ASSERT(!state_it->second.main_view.line_window_geometry_dirty,
-        "initial QRhi LINE frame should cache its geometry");
 
     plot::frame_context_t non_rhi_ctx = make_context(layout, config);
     non_rhi_ctx.t0              = 10LL * k_second_ns;
@@ -1856,8 +1987,6 @@ bool test_non_rhi_prepare_invalidates_prior_upload_before_fast_path()
     renderer.prepare(non_rhi_ctx, series_map);
     TEST_ASSERT(!state_it->second.main_view.has_uploaded_vbo,
         "non-RHI prepare must invalidate the previous upload for its planned window");
-    TEST_ASSERT(state_it->second.main_view.line_window_geometry_dirty,
-        "QRhi transitions must invalidate cached LINE geometry");
 
     events.clear();
     TEST_ASSERT(
@@ -1868,8 +1997,6 @@ bool test_non_rhi_prepare_invalidates_prior_upload_before_fast_path()
         "QRhi frame after non-RHI prepare should upload its own VBO");
     TEST_ASSERT(state_it->second.main_view.last_sample_upload_count == 1,
         "QRhi frame after non-RHI prepare must not reuse the old upload");
-    TEST_ASSERT(state_it->second.main_view.last_line_window_upload_count == 1,
-        "QRhi frame after non-RHI prepare must rebuild LINE geometry");
     TEST_ASSERT(state_it->second.main_view.last_staged_sample_count == 2,
         "QRhi frame after non-RHI prepare should stage the new expanded window");
     TEST_ASSERT(state_it->second.main_view.staging[0].y == 2.0f &&
@@ -2481,7 +2608,7 @@ bool test_builtin_upload_stages_visible_windows_for_dots_and_area()
             "visible dots/area upload should stage one GPU sample per source sample");
 
         if (!assert_compact_upload_state(
-                renderer, test_case.series_id, *prepare, 0, test_case.layer_id))
+                renderer, test_case.series_id, *prepare, test_case.layer_id))
         {
             return false;
         }
@@ -2548,7 +2675,7 @@ bool test_builtin_upload_stages_single_synthetic_hold_sample()
         "hold-forward upload should stage one real and one synthetic GPU sample");
 
     if (!assert_compact_upload_state(
-            renderer, series_id, *prepare, 3, "hold-forward line"))
+            renderer, series_id, *prepare, "hold-forward line"))
     {
         return false;
     }
@@ -2629,7 +2756,7 @@ bool test_builtin_upload_stages_hold_windows_for_dots_and_area()
             "hold-forward dots/area upload should stage real and synthetic samples");
 
         if (!assert_compact_upload_state(
-                renderer, test_case.series_id, *prepare, 0, test_case.layer_id))
+                renderer, test_case.series_id, *prepare, test_case.layer_id))
         {
             return false;
         }
@@ -3526,13 +3653,12 @@ bool test_stacked_sum_overlay_uses_top_geometry_and_theme()
         top_state->second.main_view.staging.front().y == 12.0f &&
         top_state->second.main_view.staging.back().y == 18.0f,
         "stack sum overlay must reuse the final cumulative layer geometry");
-    TEST_ASSERT(top_state->second.main_view.last_sample_upload_count == 1 &&
-        top_state->second.main_view.last_line_window_upload_count == 1,
-        "AREA-only stack top and sum overlay must share one sample and LINE upload");
+    TEST_ASSERT(top_state->second.main_view.last_sample_upload_count == 1,
+        "AREA-only stack top and sum overlay must share one sample upload");
     const auto line_top_state = renderer.m_vbo_states.find(50);
     TEST_ASSERT(line_top_state != renderer.m_vbo_states.end() &&
-        line_top_state->second.main_view.last_line_window_upload_count == 1,
-        "LINE stack top and sum overlay must not duplicate the LINE-window upload");
+        line_top_state->second.main_view.last_sample_upload_count == 1,
+        "LINE stack top and sum overlay must not duplicate the sample upload");
 
     bool lower_component_color_preserved = false;
     for (std::size_t i = 0; i < renderer.m_last_recorded_draw_series_ids.size(); ++i) {
@@ -3552,14 +3678,13 @@ bool test_stacked_sum_overlay_uses_top_geometry_and_theme()
     TEST_ASSERT(
         rhi_fixture.render_layer_frame(renderer, ctx, series_map, events, error_message),
         error_message);
-    TEST_ASSERT(top_state->second.main_view.last_line_window_upload_count == 0 &&
-        top_state->second.preview_view.last_line_window_upload_count == 0 &&
+    TEST_ASSERT(top_state->second.main_view.last_sample_upload_count == 0 &&
         top_state->second.main_view.last_recorded_line_segment_count > 0 &&
         top_state->second.preview_view.last_recorded_line_segment_count > 0,
-        "unchanged AREA stack overlays must draw in main and preview without LINE uploads");
-    TEST_ASSERT(line_top_state->second.main_view.last_line_window_upload_count == 0 &&
-        line_top_state->second.preview_view.last_line_window_upload_count == 0,
-        "unchanged ordinary LINE and sum overlay must share retained geometry");
+        "unchanged AREA stack overlays must draw in main and preview without uploads");
+    TEST_ASSERT(line_top_state->second.main_view.last_sample_upload_count == 0 &&
+        line_top_state->second.main_view.last_recorded_line_segment_count > 0,
+        "unchanged ordinary LINE and sum overlay must share retained samples");
     const glm::vec4 light_sum_color(
         25.0f / 255.0f, 32.0f / 255.0f, 51.0f / 255.0f, 1.0f);
     for (std::size_t i = 0; i < renderer.m_last_recorded_stack_sum_overlays.size(); ++i) {
@@ -3582,15 +3707,15 @@ bool test_stacked_sum_overlay_uses_top_geometry_and_theme()
     TEST_ASSERT(
         rhi_fixture.render_layer_frame(renderer, ctx, series_map, events, error_message),
         error_message);
-    TEST_ASSERT(top_state->second.main_view.last_line_window_upload_count == 1 &&
-        top_state->second.preview_view.last_line_window_upload_count == 1 &&
-        top_state->second.main_view.line_window_staging.front().y == 112.0f,
-        "changed stack geometry must rebuild each AREA sum overlay once");
+    TEST_ASSERT(top_state->second.main_view.last_sample_upload_count == 1 &&
+        top_state->second.main_view.staging.front().y == 112.0f &&
+        top_state->second.preview_view.last_recorded_line_segment_count > 0,
+        "changed stack geometry must re-upload each AREA sum overlay once");
 
     return true;
 }
 
-bool test_line_geometry_reuses_and_rebuilds_after_area_only_change()
+bool test_line_draws_compact_samples_after_area_only_change()
 {
     constexpr std::int64_t k_second_ns = 1'000'000'000LL;
     auto source = std::make_shared<Test_source>();
@@ -3624,14 +3749,15 @@ bool test_line_geometry_reuses_and_rebuilds_after_area_only_change()
         renderer, ctx, series_map, events, error_message), error_message);
     auto state = renderer.m_vbo_states.find(1);
     TEST_ASSERT(state != renderer.m_vbo_states.end() &&
-        state->second.main_view.last_line_window_upload_count == 1,
-        "cold LINE frame should upload its geometry once");
+        state->second.main_view.last_sample_upload_count == 1 &&
+        state->second.main_view.last_recorded_line_segment_count > 0,
+        "cold LINE frame should upload its compact samples once");
 
     TEST_ASSERT(rhi_fixture.render_layer_frame(
         renderer, ctx, series_map, events, error_message), error_message);
-    TEST_ASSERT(state->second.main_view.last_line_window_upload_count == 0 &&
+    TEST_ASSERT(state->second.main_view.last_sample_upload_count == 0 &&
         state->second.main_view.last_recorded_line_segment_count > 0,
-        "unchanged LINE frame should draw without a geometry upload");
+        "unchanged LINE frame should draw without an upload");
 
     series->style = plot::Display_style::AREA;
     source->set_samples({
@@ -3642,16 +3768,920 @@ bool test_line_geometry_reuses_and_rebuilds_after_area_only_change()
     });
     TEST_ASSERT(rhi_fixture.render_layer_frame(
         renderer, ctx, series_map, events, error_message), error_message);
-    TEST_ASSERT(state->second.main_view.last_line_window_upload_count == 0,
-        "AREA-only changed frame should not upload unused LINE geometry");
+    TEST_ASSERT(state->second.main_view.last_sample_upload_count == 1 &&
+        state->second.main_view.last_recorded_line_segment_count == 0,
+        "AREA-only changed frame should upload samples without drawing LINE");
 
     series->style = plot::Display_style::LINE;
     TEST_ASSERT(rhi_fixture.render_layer_frame(
         renderer, ctx, series_map, events, error_message), error_message);
     TEST_ASSERT(state->second.main_view.last_sample_upload_count == 0 &&
-        state->second.main_view.last_line_window_upload_count == 1 &&
-        state->second.main_view.line_window_staging.front().y == 10.0f,
-        "re-enabled LINE must rebuild from geometry changed during AREA-only rendering");
+        state->second.main_view.staging.front().y == 10.0f &&
+        state->second.main_view.last_recorded_line_segment_count > 0,
+        "re-enabled LINE must draw the samples uploaded during AREA-only rendering");
+
+    return true;
+}
+
+bool test_density_reuses_binned_grid_across_color_changes()
+{
+    constexpr std::int64_t k_second_ns = 1'000'000'000LL;
+    auto source = std::make_shared<Test_source>();
+    source->set_samples({
+        { 0LL,               1.0f},
+        { 1LL * k_second_ns, 2.0f},
+        { 2LL * k_second_ns, 3.0f},
+        { 3LL * k_second_ns, 4.0f}
+    });
+
+    auto series         = std::make_shared<plot::series_data_t>();
+    series->style       = plot::Display_style::DENSITY;
+    series->data_source = source;
+    series->access      = make_access_policy();
+    std::map<int, std::shared_ptr<const plot::series_data_t>> series_map;
+    series_map[1] = series;
+
+    plot::Asset_loader asset_loader;
+    plot::Series_renderer renderer;
+    renderer.initialize(asset_loader);
+    Offscreen_rhi_fixture rhi_fixture;
+    std::string error_message;
+    TEST_ASSERT(rhi_fixture.initialize(error_message), error_message);
+
+    plot::Plot_config config;
+    const plot::frame_layout_result_t layout = make_layout();
+    plot::frame_context_t ctx = make_context(layout, config);
+    std::vector<layer_event_t> events;
+
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    auto state = renderer.m_vbo_states.find(1);
+    TEST_ASSERT(state != renderer.m_vbo_states.end() &&
+        state->second.main_view.last_density_bin_count           == 1 &&
+        state->second.main_view.last_density_upload_bytes        >  0 &&
+        state->second.main_view.last_recorded_density_draw_count == 1 &&
+        state->second.main_view.last_sample_upload_count         == 0,
+        "cold DENSITY frame should bin and draw the grid without a sample upload");
+
+    series->color = glm::vec4(0.9f, 0.2f, 0.1f, 0.5f);
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    TEST_ASSERT(state->second.main_view.last_density_bin_count           == 0 &&
+        state->second.main_view.last_density_upload_bytes        == 0 &&
+        state->second.main_view.last_recorded_density_draw_count == 1,
+        "colour-only change should redraw the cached grid without rebinning");
+    TEST_ASSERT(!renderer.m_last_recorded_draw_colors.empty() &&
+        renderer.m_last_recorded_draw_colors.back() == series->color,
+        "DENSITY draw should carry the new series colour");
+
+    source->set_samples({
+        { 0LL,               4.0f},
+        { 1LL * k_second_ns, 3.0f},
+        { 2LL * k_second_ns, 2.0f},
+        { 3LL * k_second_ns, 1.0f}
+    });
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    TEST_ASSERT(state->second.main_view.last_density_bin_count           == 1 &&
+        state->second.main_view.last_recorded_density_draw_count == 1,
+        "changed samples should rebin the grid");
+
+    return true;
+}
+
+class Observation_profiler : public plot::Profiler
+{
+public:
+    void begin_scope(const char*) override {}
+    void end_scope() override {}
+    void record_observation(const char* name, double value) override
+    {
+        last[name] = value;
+        ++counts[name];
+    }
+
+    std::map<std::string, double>      last;
+    std::map<std::string, std::size_t> counts;
+};
+
+bool test_scroll_blit_reports_region_changed_by_appends()
+{
+    constexpr std::int64_t k_second_ns = 1'000'000'000LL;
+    std::vector<test_sample_t> samples;
+    for (std::int64_t i = 0; i < 8; ++i) {
+        samples.push_back({i * k_second_ns, static_cast<float>(i)});
+    }
+    auto source = std::make_shared<Test_source>();
+    source->set_samples(samples);
+
+    auto series         = std::make_shared<plot::series_data_t>();
+    series->style       = plot::Display_style::LINE;
+    series->data_source = source;
+    series->access      = make_access_policy();
+    std::map<int, std::shared_ptr<const plot::series_data_t>> series_map;
+    series_map[1] = series;
+
+    plot::Asset_loader asset_loader;
+    plot::Series_renderer renderer;
+    renderer.initialize(asset_loader);
+    Offscreen_rhi_fixture rhi_fixture;
+    std::string error_message;
+    TEST_ASSERT(rhi_fixture.initialize(error_message), error_message);
+
+    plot::Plot_config config;
+    config.scroll_blit = true;
+    const plot::frame_layout_result_t layout = make_layout();
+    plot::frame_context_t ctx = make_context(layout, config);
+    ctx.t0              = 5LL * k_second_ns;
+    ctx.t1              = 8LL * k_second_ns;
+    ctx.t_available_max = 9LL * k_second_ns;
+    std::vector<layer_event_t> events;
+
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    TEST_ASSERT(renderer.last_frame_main_changed_x() == 0.0,
+        "the first scroll-blit frame should redraw the whole body");
+
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    TEST_ASSERT(std::isinf(renderer.last_frame_main_changed_x()),
+        "an unchanged source should leave the body unchanged");
+
+    samples.push_back({8LL * k_second_ns, 8.0f});
+    source->set_samples(samples);
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    TEST_ASSERT(std::abs(renderer.last_frame_main_changed_x() - 160.0) < 1.0e-6,
+        "an append should change the body from the previous last sample onwards");
+
+    samples[8].value = 2.0f;
+    samples.push_back({9LL * k_second_ns, 9.0f});
+    source->set_samples(samples);
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    TEST_ASSERT(renderer.last_frame_main_changed_x() == 0.0,
+        "an edited previous last sample should redraw the whole body");
+
+    return true;
+}
+
+// Plot_config::cache_chrome_layer: frames that only change the series reuse
+// the chrome layer; a change of its layout or of any theme input redraws
+// it, and so does every frame after a redraw made while label fades ran.
+bool test_chrome_layer_redraws_only_for_changed_layout_or_theme()
+{
+    Offscreen_rhi_fixture rhi_fixture;
+    std::string error_message;
+    TEST_ASSERT(rhi_fixture.initialize(error_message), error_message);
+    QRhi* const rhi = rhi_fixture.rhi();
+
+    auto profiler = std::make_shared<Observation_profiler>();
+    const auto redraws = [&] { return profiler->counts["qrhi.renderer.chrome_layer.redraw_count"]; };
+    const auto reuses  = [&] { return profiler->counts["qrhi.renderer.chrome_layer.reuse_count"]; };
+
+    plot::detail::Chrome_layer chrome_layer;
+    plot::layout_cache_key_t   layout;
+    layout.v1            = 10.0f;
+    layout.t1            = 3'000'000'000LL;
+    layout.viewport_size = plot::Size_2i(320, 180);
+    const int first_text  = 0;
+    const int second_text = 0;
+    plot::detail::chrome_theme_t theme;
+    theme.visible_info_flags   = plot::k_visible_info_all;
+    theme.base_label_height_px = 14.0;
+    theme.prepared_text        = &first_text;
+
+    // One host frame: the layer pass runs only when the layer is redrawn.
+    const auto render_frame = [&](bool label_fades_active) {
+        QRhiCommandBuffer* cb = nullptr;
+        if (rhi->beginOffscreenFrame(&cb) != QRhi::FrameOpSuccess || !cb) {
+            return false;
+        }
+        QRhiResourceUpdateBatch* updates = rhi->nextResourceUpdateBatch();
+        const bool ready = chrome_layer.prepare(
+            rhi, QSize(320, 180), updates, rhi_fixture.render_target(), glm::mat4(1.0f));
+        if (ready && chrome_layer.needs_redraw(layout, theme, profiler.get())) {
+            cb->beginPass(
+                chrome_layer.render_target(),
+                QColor(0, 0, 0, 0),
+                QRhiDepthStencilClearValue(1.0f, 0),
+                updates);
+            cb->endPass();
+            chrome_layer.finish_redraw(label_fades_active);
+        }
+        else {
+            cb->resourceUpdate(updates);
+        }
+        rhi->endOffscreenFrame();
+        return ready;
+    };
+
+    TEST_ASSERT(render_frame(false), "chrome layer must be usable on the Null backend");
+    TEST_ASSERT(redraws() == 1 && reuses() == 0, "the first frame must draw the layer");
+    TEST_ASSERT(render_frame(false), "data-only frame must render");
+    TEST_ASSERT(redraws() == 1 && reuses() == 1,
+        "a frame that changes neither layout nor theme must reuse the layer");
+
+    layout.t0 += 500'000'000LL;
+    layout.t1 += 500'000'000LL;
+    TEST_ASSERT(render_frame(false), "moved frame must render");
+    TEST_ASSERT(redraws() == 2 && reuses() == 1, "a layout change must redraw the layer");
+    TEST_ASSERT(render_frame(false), "unchanged frame must render");
+    TEST_ASSERT(redraws() == 2 && reuses() == 2, "the new layout must then be reused");
+
+    const std::vector<std::pair<const char*, std::function<void()>>> theme_changes = {
+        {"window background", [&] { theme.window_background.r = 0.5f; }},
+        {"LCD order",         [&] { theme.lcd_subpixel_order = plot::lcd_subpixel_order_t::RGB; }},
+        {"info flags",        [&] { theme.visible_info_flags = plot::k_visible_info_time_range; }},
+        {"label height",      [&] { theme.base_label_height_px = 18.0; }},
+        {"prepared text",     [&] { theme.prepared_text = &second_text; }},
+    };
+    for (const auto& [name, change] : theme_changes) {
+        const std::size_t redraws_before = redraws();
+        const std::size_t reuses_before  = reuses();
+        change();
+        TEST_ASSERT(render_frame(false), "frame with a new " << name << " must render");
+        TEST_ASSERT(redraws() == redraws_before + 1 && reuses() == reuses_before,
+            "a new " << name << " must redraw the layer");
+        TEST_ASSERT(render_frame(false), "unchanged frame must render");
+        TEST_ASSERT(redraws() == redraws_before + 1 && reuses() == reuses_before + 1,
+            "the layer drawn for the new " << name << " must then be reused");
+    }
+
+    // Label fades start when the view moves; the layer then follows them.
+    const std::size_t redraws_before = redraws();
+    const std::size_t reuses_before  = reuses();
+    layout.t0 += 500'000'000LL;
+    layout.t1 += 500'000'000LL;
+    TEST_ASSERT(render_frame(true) && render_frame(true), "fading frames must render");
+    TEST_ASSERT(redraws() == redraws_before + 2 && reuses() == reuses_before,
+        "every frame must redraw the layer while label fades run");
+    TEST_ASSERT(render_frame(false), "frame after the fades must render");
+    TEST_ASSERT(redraws() == redraws_before + 3 && reuses() == reuses_before,
+        "the first frame after the fades must redraw the faded layer");
+    TEST_ASSERT(render_frame(false), "settled frame must render");
+    TEST_ASSERT(redraws() == redraws_before + 3 && reuses() == reuses_before + 1,
+        "a settled layer must be reused again");
+
+    chrome_layer.reset();
+    TEST_ASSERT(render_frame(false), "frame after a reset must render");
+    TEST_ASSERT(redraws() == redraws_before + 4,
+        "a reset layer must be drawn again");
+    return true;
+}
+
+bool test_preview_borrows_main_sample_buffer_for_shared_window()
+{
+    constexpr std::int64_t k_second_ns        = 1'000'000'000LL;
+    constexpr std::size_t  k_gpu_sample_bytes = sizeof(float) * 4u;
+
+    auto source = std::make_shared<Test_source>();
+    std::vector<test_sample_t> samples;
+    samples.reserve(200);
+    for (std::size_t i = 0; i < 200; ++i) {
+        samples.push_back({
+            static_cast<std::int64_t>(i) * k_second_ns,
+            static_cast<float>(i % 10)
+        });
+    }
+    source->set_samples(std::move(samples));
+
+    auto series         = std::make_shared<plot::series_data_t>();
+    series->style       = plot::Display_style::LINE;
+    series->data_source = source;
+    series->access      = make_access_policy();
+    std::map<int, std::shared_ptr<const plot::series_data_t>> series_map;
+    series_map[1] = series;
+
+    plot::Asset_loader asset_loader;
+    plot::Series_renderer renderer;
+    renderer.initialize(asset_loader);
+    Offscreen_rhi_fixture rhi_fixture;
+    std::string error_message;
+    TEST_ASSERT(rhi_fixture.initialize(error_message), error_message);
+
+    plot::Plot_config config;
+    config.share_view_sample_buffers = true;
+    const plot::frame_layout_result_t layout = make_layout();
+    plot::frame_context_t ctx = make_context(layout, config);
+    ctx.t0                      = 50LL * k_second_ns;
+    ctx.t1                      = 150LL * k_second_ns;
+    ctx.t_available_min         = 0;
+    ctx.t_available_max         = 199LL * k_second_ns;
+    ctx.adjusted_preview_height = 40.0;
+    ctx.preview_v0              = 0.0f;
+    ctx.preview_v1              = 10.0f;
+    std::vector<layer_event_t> events;
+
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    auto state = renderer.m_vbo_states.find(1);
+    TEST_ASSERT(state != renderer.m_vbo_states.end(),
+        "expected renderer VBO state for shared-window test");
+    const auto& main_view    = state->second.main_view;
+    const auto& preview_view = state->second.preview_view;
+    TEST_ASSERT(main_view.samples_shared && preview_view.samples_borrowed,
+        "same-LOD main and preview windows should share one sample buffer");
+    TEST_ASSERT(main_view.last_sample_upload_count == 1 &&
+        preview_view.last_sample_upload_count == 0,
+        "shared windows should be uploaded once, by the main view");
+    TEST_ASSERT(main_view.last_sample_upload_bytes ==
+        preview_view.shared_gpu_count * k_gpu_sample_bytes,
+        "main view should upload the containing preview window");
+    TEST_ASSERT(main_view.sample_base > 0 && preview_view.sample_base == 0,
+        "zoomed main view should draw from inside the shared window");
+    TEST_ASSERT(preview_view.rhi_vbo_capacity_bytes == 0,
+        "borrowing preview view must not keep a sample VBO of its own");
+    TEST_ASSERT(main_view.last_recorded_line_segment_count > 0 &&
+        preview_view.last_recorded_line_segment_count > 0,
+        "both views should draw from the shared buffer");
+
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    TEST_ASSERT(preview_view.samples_borrowed &&
+        main_view.last_sample_upload_count == 0 &&
+        preview_view.last_sample_upload_count == 0,
+        "unchanged shared windows should draw without uploads");
+
+    config.share_view_sample_buffers = false;
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    TEST_ASSERT(!preview_view.samples_borrowed &&
+        preview_view.last_sample_upload_count == 1 &&
+        preview_view.rhi_vbo_capacity_bytes > 0,
+        "disabling sharing should give the preview view its own upload");
+
+    return true;
+}
+
+bool test_batched_line_series_record_one_draw()
+{
+    constexpr std::int64_t k_second_ns  = 1'000'000'000LL;
+    constexpr std::size_t  k_series_count = 3;
+
+    std::map<int, std::shared_ptr<const plot::series_data_t>> series_map;
+    std::vector<std::shared_ptr<plot::series_data_t>> series_list;
+    for (std::size_t s = 0; s < k_series_count; ++s) {
+        auto source = std::make_shared<Test_source>();
+        std::vector<test_sample_t> samples;
+        samples.reserve(64);
+        for (std::size_t i = 0; i < 64; ++i) {
+            samples.push_back({
+                static_cast<std::int64_t>(i) * k_second_ns,
+                static_cast<float>((i + s) % 10)
+            });
+        }
+        source->set_samples(std::move(samples));
+
+        auto series         = std::make_shared<plot::series_data_t>();
+        series->style       = plot::Display_style::LINE;
+        series->data_source = source;
+        series->access      = make_access_policy();
+        series->color       = glm::vec4(0.2f * static_cast<float>(s), 0.5f, 1.0f, 1.0f);
+        series_list.push_back(series);
+        series_map[static_cast<int>(s) + 1] = series;
+    }
+
+    plot::Asset_loader asset_loader;
+    plot::Series_renderer renderer;
+    renderer.initialize(asset_loader);
+    Offscreen_rhi_fixture rhi_fixture;
+    std::string error_message;
+    TEST_ASSERT(rhi_fixture.initialize(error_message), error_message);
+
+    plot::Plot_config config;
+    config.batch_series_draws = true;
+    const plot::frame_layout_result_t layout = make_layout();
+    plot::frame_context_t ctx = make_context(layout, config);
+    ctx.t0              = 10LL * k_second_ns;
+    ctx.t1              = 50LL * k_second_ns;
+    ctx.t_available_min = 0;
+    ctx.t_available_max = 63LL * k_second_ns;
+    std::vector<layer_event_t> events;
+
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    TEST_ASSERT(renderer.m_last_recorded_batch_draw_count == 1,
+        "same-style series over one view should record a single batched draw");
+    TEST_ASSERT(renderer.m_last_recorded_draw_series_ids.size() == k_series_count,
+        "batched members should still be reported in draw order");
+    TEST_ASSERT(renderer.m_last_recorded_batched_series_count == k_series_count &&
+        renderer.m_last_batch_upload_count == 1,
+        "every series should be packed into the batch");
+    for (int id = 1; id <= static_cast<int>(k_series_count); ++id) {
+        const auto state = renderer.m_vbo_states.find(id);
+        TEST_ASSERT(state != renderer.m_vbo_states.end() &&
+            state->second.main_view.last_recorded_line_segment_count > 0,
+            "batched members should count their drawn segments");
+        TEST_ASSERT(state->second.main_view.last_sample_upload_count == 0 &&
+            state->second.main_view.sample_upload_pending,
+            "batched members should not also upload their own sample VBO");
+    }
+
+    series_list[1]->color = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    TEST_ASSERT(renderer.m_last_recorded_batch_draw_count == 1 &&
+        renderer.m_last_batch_upload_count == 0,
+        "a color change should not repack the batch samples");
+    TEST_ASSERT(renderer.m_last_recorded_draw_colors.size() == k_series_count &&
+        renderer.m_last_recorded_draw_colors[1] == series_list[1]->color,
+        "batched members should record their own colors");
+
+    config.batch_series_draws = false;
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    TEST_ASSERT(renderer.m_last_recorded_batch_draw_count == 0 &&
+        renderer.m_last_recorded_draw_series_ids.size() == k_series_count,
+        "disabling batching should draw every series on its own");
+    for (int id = 1; id <= static_cast<int>(k_series_count); ++id) {
+        const auto& main_view = renderer.m_vbo_states.find(id)->second.main_view;
+        TEST_ASSERT(main_view.last_sample_upload_count == 1 &&
+            !main_view.sample_upload_pending &&
+            main_view.last_recorded_line_segment_count > 0,
+            "a member drawn on its own should write its pending sample VBO once");
+    }
+
+    return true;
+}
+
+// Batches pack each member from its own staging. Both a main view drawing
+// from inside the window it shares with the preview and a streaming view
+// whose appends advance it place the samples past slot 0 of the GPU buffer.
+bool test_batched_dots_pack_each_view_from_its_own_window()
+{
+    constexpr std::int64_t k_second_ns    = 1'000'000'000LL;
+    constexpr std::int64_t k_step_ns      = k_second_ns / 10;
+    constexpr std::size_t  k_series_count = 2;
+    constexpr std::size_t  k_sample_count = 2000;
+
+    std::vector<std::shared_ptr<Test_source>> sources;
+    std::vector<std::vector<test_sample_t>>   samples(k_series_count);
+    std::map<int, std::shared_ptr<const plot::series_data_t>> series_map;
+    const auto sample_value = [](std::size_t s, std::size_t i) {
+        return static_cast<float>(s * 10000u + i);
+    };
+    const auto append_samples = [&](std::size_t s, std::size_t first, std::size_t end) {
+        for (std::size_t i = first; i < end; ++i) {
+            samples[s].push_back({static_cast<std::int64_t>(i) * k_step_ns, sample_value(s, i)});
+        }
+        sources[s]->set_samples(samples[s]);
+    };
+    for (std::size_t s = 0; s < k_series_count; ++s) {
+        sources.push_back(std::make_shared<Test_source>());
+        append_samples(s, 0, k_sample_count);
+
+        auto series         = std::make_shared<plot::series_data_t>();
+        series->style       = plot::Display_style::DOTS;
+        series->data_source = sources[s];
+        series->access      = make_access_policy();
+        series_map[static_cast<int>(s) + 1] = series;
+    }
+
+    const plot::frame_layout_result_t layout = make_layout();
+    const auto make_view_context = [&](const plot::Plot_config& config) {
+        plot::frame_context_t ctx = make_context(layout, config);
+        ctx.t0                      = 50LL * k_second_ns;
+        ctx.t1                      = 150LL * k_second_ns;
+        ctx.t_available_min         = 0;
+        ctx.t_available_max         = static_cast<std::int64_t>(k_sample_count - 1u) * k_step_ns;
+        ctx.v1                      = 20000.0f;
+        ctx.adjusted_preview_height = 40.0;
+        ctx.preview_v0              = 0.0f;
+        ctx.preview_v1              = 20000.0f;
+        return ctx;
+    };
+
+    // Every member's block of the uploaded batch VBO holds its planned
+    // window in order, tagged with its slot; the main band packs first.
+    const auto packed_matches_views = [&](
+        const plot::Series_renderer& renderer,
+        Offscreen_rhi_fixture&       rhi_fixture,
+        plot::Series_view_kind       view_kind)
+    {
+        const std::size_t batch_index = view_kind == plot::Series_view_kind::MAIN ? 0u : 1u;
+        std::size_t instance_count = 0;
+        QRhiBuffer* vbo = renderer.draw_batch_vbo(batch_index, instance_count);
+        QByteArray  bytes;
+        std::string error_message;
+        if (!rhi_fixture.read_back_buffer(
+                vbo, instance_count * sizeof(plot::Series_renderer::gpu_sample_t), bytes, error_message))
+        {
+            return false;
+        }
+        std::vector<plot::Series_renderer::gpu_sample_t> packed(instance_count);
+        std::memcpy(packed.data(), bytes.constData(), static_cast<std::size_t>(bytes.size()));
+        std::size_t offset = 0;
+        for (std::size_t s = 0; s < k_series_count; ++s) {
+            const auto& vbo_state = renderer.m_vbo_states.find(static_cast<int>(s) + 1)->second;
+            const auto& view      = view_kind == plot::Series_view_kind::MAIN
+                ? vbo_state.main_view
+                : vbo_state.preview_view;
+            const auto& planner   = *view.planner;
+            if (planner.last_count == 0 || offset + planner.last_count > packed.size()) {
+                return false;
+            }
+            for (std::size_t i = 0; i < planner.last_count; ++i) {
+                const auto& sample = packed[offset + i];
+                if (sample.y_min != static_cast<float>(s)) {
+                    return false;
+                }
+                if (i < planner.last_source_count &&
+                    sample.y != sample_value(s, planner.last_first + i))
+                {
+                    return false;
+                }
+            }
+            offset += planner.last_count;
+        }
+        return offset == packed.size();
+    };
+
+    {
+        plot::Asset_loader asset_loader;
+        plot::Series_renderer renderer;
+        renderer.initialize(asset_loader);
+        Offscreen_rhi_fixture rhi_fixture;
+        std::string error_message;
+        TEST_ASSERT(rhi_fixture.initialize(error_message), error_message);
+
+        plot::Plot_config config;
+        config.batch_series_draws        = true;
+        config.share_view_sample_buffers = true;
+        plot::frame_context_t ctx = make_view_context(config);
+        std::vector<layer_event_t> events;
+
+        TEST_ASSERT(rhi_fixture.render_layer_frame(
+            renderer, ctx, series_map, events, error_message), error_message);
+        const auto& main_view = renderer.m_vbo_states.find(1)->second.main_view;
+        TEST_ASSERT(main_view.samples_shared && main_view.sample_base > 0,
+            "the main view should draw from inside the shared preview window");
+        TEST_ASSERT(renderer.m_last_recorded_batch_draw_count == 2 &&
+            renderer.m_last_batch_upload_count == 2,
+            "main and preview bands should each pack one batch");
+        TEST_ASSERT(packed_matches_views(renderer, rhi_fixture, plot::Series_view_kind::MAIN),
+            "the shared main batch should pack each member's own window");
+        TEST_ASSERT(packed_matches_views(renderer, rhi_fixture, plot::Series_view_kind::PREVIEW),
+            "the shared preview batch should pack each member's own window");
+    }
+
+    {
+        plot::Asset_loader asset_loader;
+        plot::Series_renderer renderer;
+        renderer.initialize(asset_loader);
+        Offscreen_rhi_fixture rhi_fixture;
+        std::string error_message;
+        TEST_ASSERT(rhi_fixture.initialize(error_message), error_message);
+
+        plot::Plot_config config;
+        config.batch_series_draws       = true;
+        config.streaming_sample_buffers = true;
+        plot::frame_context_t ctx = make_view_context(config);
+        std::vector<layer_event_t> events;
+
+        TEST_ASSERT(rhi_fixture.render_layer_frame(
+            renderer, ctx, series_map, events, error_message), error_message);
+        TEST_ASSERT(renderer.m_vbo_states.find(1)->second.main_view.sample_base == 0,
+            "the first streaming frame should start at slot 0");
+
+        // Append and slide by half a second; the snapped main origin stays
+        // at 50 s, so the streaming window advances its first GPU slot.
+        for (std::size_t s = 0; s < k_series_count; ++s) {
+            append_samples(s, k_sample_count, k_sample_count + 20u);
+        }
+        ctx.t0              += k_second_ns / 2;
+        ctx.t1              += k_second_ns / 2;
+        ctx.t_available_max += 20 * k_step_ns;
+        TEST_ASSERT(rhi_fixture.render_layer_frame(
+            renderer, ctx, series_map, events, error_message), error_message);
+        TEST_ASSERT(renderer.m_vbo_states.find(1)->second.main_view.sample_base > 0,
+            "the appended main window should start past slot 0");
+        TEST_ASSERT(renderer.m_last_recorded_batch_draw_count == 2 &&
+            renderer.m_last_batch_upload_count == 2,
+            "appended windows should repack both batches");
+        TEST_ASSERT(packed_matches_views(renderer, rhi_fixture, plot::Series_view_kind::MAIN),
+            "the streaming main batch should pack each member's own window");
+        TEST_ASSERT(packed_matches_views(renderer, rhi_fixture, plot::Series_view_kind::PREVIEW),
+            "the streaming preview batch should pack each member's own window");
+    }
+
+    return true;
+}
+
+bool test_gpu_buffer_budget_evicts_least_recently_drawn_series()
+{
+    constexpr std::int64_t k_second_ns    = 1'000'000'000LL;
+    constexpr std::size_t  k_series_count = 3;
+
+    std::map<int, std::shared_ptr<const plot::series_data_t>> series_map;
+    std::vector<std::shared_ptr<plot::series_data_t>> series_list;
+    for (std::size_t s = 0; s < k_series_count; ++s) {
+        auto source = std::make_shared<Test_source>();
+        std::vector<test_sample_t> samples;
+        samples.reserve(64);
+        for (std::size_t i = 0; i < 64; ++i) {
+            samples.push_back({
+                static_cast<std::int64_t>(i) * k_second_ns,
+                static_cast<float>((i + s) % 10)
+            });
+        }
+        source->set_samples(std::move(samples));
+
+        auto series         = std::make_shared<plot::series_data_t>();
+        series->style       = plot::Display_style::LINE;
+        series->data_source = source;
+        series->access      = make_access_policy();
+        series_list.push_back(series);
+        series_map[static_cast<int>(s) + 1] = series;
+    }
+
+    plot::Asset_loader asset_loader;
+    plot::Series_renderer renderer;
+    renderer.initialize(asset_loader);
+    Offscreen_rhi_fixture rhi_fixture;
+    std::string error_message;
+    TEST_ASSERT(rhi_fixture.initialize(error_message), error_message);
+
+    auto profiler = std::make_shared<Observation_profiler>();
+    plot::Plot_config config;
+    config.profiler = profiler;
+    const plot::frame_layout_result_t layout = make_layout();
+    plot::frame_context_t ctx = make_context(layout, config);
+    ctx.t0              = 10LL * k_second_ns;
+    ctx.t1              = 50LL * k_second_ns;
+    ctx.t_available_min = 0;
+    ctx.t_available_max = 63LL * k_second_ns;
+    std::vector<layer_event_t> events;
+
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    const double resident_bytes = profiler->last["renderer.frame.gpu_resident_bytes"];
+    TEST_ASSERT(resident_bytes > 0.0, "drawn series should report resident GPU bytes");
+
+    // Series 1 stops drawing one frame before series 2; without a budget
+    // both keep their buffers.
+    series_list[0]->enabled = false;
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    series_list[1]->enabled = false;
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    TEST_ASSERT(renderer.m_vbo_states[1].main_view.rhi &&
+        renderer.m_vbo_states[2].main_view.rhi,
+        "an unlimited budget should keep hidden series' buffers");
+    TEST_ASSERT(profiler->last["renderer.frame.gpu_resident_bytes"] == resident_bytes,
+        "hidden series should still count as resident");
+
+    // Releasing one series fits the budget; the least recently drawn goes.
+    config.gpu_buffer_budget_bytes = static_cast<std::size_t>(resident_bytes) - 1u;
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    TEST_ASSERT(!renderer.m_vbo_states[1].main_view.rhi,
+        "the least recently drawn series should be evicted first");
+    TEST_ASSERT(renderer.m_vbo_states[2].main_view.rhi &&
+        renderer.m_vbo_states[3].main_view.rhi,
+        "eviction should stop once the budget is met");
+    TEST_ASSERT(profiler->counts["renderer.frame.gpu_budget_eviction_count"] == 1,
+        "the eviction should be reported");
+    TEST_ASSERT(profiler->last["renderer.frame.gpu_resident_bytes"] <=
+        static_cast<double>(config.gpu_buffer_budget_bytes),
+        "resident bytes should drop under the budget");
+
+    // A budget below the drawn series alone still keeps them.
+    series_list[0]->enabled = true;
+    config.gpu_buffer_budget_bytes = 1;
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    TEST_ASSERT(renderer.m_vbo_states[1].main_view.has_uploaded_vbo &&
+        renderer.m_vbo_states[3].main_view.rhi,
+        "drawn series should upload again and keep their buffers");
+    TEST_ASSERT(!renderer.m_vbo_states[2].main_view.rhi,
+        "the remaining hidden series should be evicted");
+    TEST_ASSERT(profiler->counts["renderer.frame.gpu_budget_exceeded_count"] == 1,
+        "a frame over budget on its own draws should be reported");
+    TEST_ASSERT(renderer.m_last_recorded_draw_series_ids.size() == 2,
+        "both visible series should still draw");
+
+    return true;
+}
+
+bool test_gpu_buffer_shrinks_after_underused_frames()
+{
+    constexpr std::int64_t k_second_ns        = 1'000'000'000LL;
+    constexpr std::size_t  k_sample_count     = 4096;
+    constexpr std::size_t  k_gpu_sample_bytes = sizeof(float) * 4u;
+
+    auto source = std::make_shared<Test_source>();
+    std::vector<test_sample_t> samples;
+    samples.reserve(k_sample_count);
+    for (std::size_t i = 0; i < k_sample_count; ++i) {
+        samples.push_back({
+            static_cast<std::int64_t>(i) * k_second_ns,
+            static_cast<float>(i % 10)
+        });
+    }
+    source->set_samples(std::move(samples));
+
+    auto series         = std::make_shared<plot::series_data_t>();
+    series->style       = plot::Display_style::LINE;
+    series->data_source = source;
+    series->access      = make_access_policy();
+    std::map<int, std::shared_ptr<const plot::series_data_t>> series_map;
+    series_map[1] = series;
+
+    plot::Asset_loader asset_loader;
+    plot::Series_renderer renderer;
+    renderer.initialize(asset_loader);
+    Offscreen_rhi_fixture rhi_fixture;
+    std::string error_message;
+    TEST_ASSERT(rhi_fixture.initialize(error_message), error_message);
+
+    auto profiler = std::make_shared<Observation_profiler>();
+    plot::Plot_config config;
+    config.profiler                 = profiler;
+    config.gpu_buffer_shrink_frames = 3;
+    const plot::frame_layout_result_t layout = make_layout();
+    plot::frame_context_t ctx = make_context(layout, config);
+    ctx.t0              = 0;
+    ctx.t1              = 4000LL * k_second_ns;
+    ctx.t_available_min = 0;
+    ctx.t_available_max = static_cast<std::int64_t>(k_sample_count - 1u) * k_second_ns;
+    std::vector<layer_event_t> events;
+
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    const auto& view_state = renderer.m_vbo_states.find(1)->second.main_view;
+    const std::size_t grown_capacity   = view_state.rhi_vbo_capacity_bytes;
+    const std::size_t grown_generation = view_state.last_vbo_generation;
+    TEST_ASSERT(grown_capacity >= 4000u * k_gpu_sample_bytes,
+        "the wide window should grow the sample buffer");
+    // Sample and uniform buffers share the counter; only the sample buffer
+    // is reallocated below.
+    const std::size_t grown_allocations =
+        profiler->counts["renderer.frame.gpu_buffer_allocation_count"];
+    TEST_ASSERT(grown_allocations > 0, "the wide window should allocate its buffers");
+
+    // Narrow windows moving by a second re-upload every frame at a small
+    // fraction of the capacity. The first marks the buffer underused; the
+    // buffer is kept until the mark is gpu_buffer_shrink_frames old.
+    const auto render_narrow = [&](std::int64_t first_second) {
+        ctx.t0 = (100LL + first_second) * k_second_ns;
+        ctx.t1 = (200LL + first_second) * k_second_ns;
+        return rhi_fixture.render_layer_frame(
+            renderer, ctx, series_map, events, error_message);
+    };
+    for (std::int64_t frame = 0; frame < 3; ++frame) {
+        TEST_ASSERT(render_narrow(frame), error_message);
+        TEST_ASSERT(view_state.rhi_vbo_capacity_bytes == grown_capacity &&
+            view_state.last_vbo_generation == grown_generation,
+            "an underused buffer should be kept for gpu_buffer_shrink_frames frames");
+        TEST_ASSERT(view_state.last_sample_upload_count == 1,
+            "each narrow frame should upload its moved window");
+    }
+    TEST_ASSERT(profiler->counts["renderer.frame.gpu_buffer_shrink_count"] == 0 &&
+        profiler->counts["renderer.frame.gpu_buffer_allocation_count"] == grown_allocations,
+        "nothing should be reallocated before the shrink is due");
+
+    TEST_ASSERT(render_narrow(3), error_message);
+    TEST_ASSERT(profiler->counts["renderer.frame.gpu_buffer_shrink_count"] == 1,
+        "the shrink should be reported once it is due");
+    TEST_ASSERT(profiler->counts["renderer.frame.gpu_buffer_allocation_count"] ==
+            grown_allocations + 1u &&
+        view_state.last_vbo_generation == grown_generation + 1u,
+        "the shrunk buffer should be allocated once more");
+    TEST_ASSERT(view_state.rhi_vbo_capacity_bytes < grown_capacity / 4u &&
+        view_state.rhi_vbo_capacity_bytes >= 100u * k_gpu_sample_bytes,
+        "the shrunk buffer should fit the narrow window");
+
+    // Right-sized again, the buffer stays put.
+    TEST_ASSERT(render_narrow(4), error_message);
+    TEST_ASSERT(profiler->counts["renderer.frame.gpu_buffer_allocation_count"] ==
+            grown_allocations + 1u &&
+        profiler->counts["renderer.frame.gpu_buffer_shrink_count"] == 1,
+        "a right-sized buffer should not be reallocated");
+
+    return true;
+}
+
+struct async_prepare_log_t
+{
+    int                    async_count          = 0;
+    int                    prepare_count        = 0;
+    int                    prepare_before_async = 0;
+    std::thread::id        async_thread;
+    std::size_t            async_source_count   = 0;
+    std::size_t            prepare_source_count = 0;
+};
+
+class Async_layer_state final : public plot::Qrhi_series_layer_state
+{
+public:
+    explicit Async_layer_state(async_prepare_log_t& log)
+    :
+        m_log(log)
+    {}
+
+    bool has_async_prepare() const override { return true; }
+
+    void prepare_async(const plot::qrhi_series_async_prepare_context_t& ctx) override
+    {
+        // Long enough that a prepare() that did not wait would see no result.
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        m_log.async_thread       = std::this_thread::get_id();
+        m_log.async_source_count = ctx.window.source_count;
+        m_pending                = true;
+        ++m_log.async_count;
+    }
+
+    bool prepare(const plot::qrhi_series_prepare_context_t& ctx) override
+    {
+        if (!m_pending) {
+            ++m_log.prepare_before_async;
+        }
+        m_pending = false;
+        m_log.prepare_source_count = ctx.window.source_count;
+        ++m_log.prepare_count;
+        return true;
+    }
+
+    void record(const plot::qrhi_series_record_context_t&) override {}
+
+private:
+    async_prepare_log_t&   m_log;
+    bool                   m_pending = false;
+};
+
+class Async_layer final : public plot::Qrhi_series_layer
+{
+public:
+    explicit Async_layer(async_prepare_log_t& log)
+    :
+        m_log(log)
+    {}
+
+    std::string_view id()       const override { return "async"; }
+    std::uint64_t    revision() const override { return 1; }
+    int              z_order()  const override { return 0; }
+
+    bool draws_view(plot::Series_view_kind view_kind) const override
+    {
+        return view_kind == plot::Series_view_kind::MAIN;
+    }
+
+    std::unique_ptr<plot::Qrhi_series_layer_state> create_state(QRhi&) const override
+    {
+        return std::make_unique<Async_layer_state>(m_log);
+    }
+
+private:
+    async_prepare_log_t&   m_log;
+};
+
+bool test_async_layer_prepare_completes_before_prepare()
+{
+    async_prepare_log_t log;
+    auto source = std::make_shared<Test_source>();
+    auto series = make_line_plus_layer_series(source, {std::make_shared<Async_layer>(log)});
+    std::map<int, std::shared_ptr<const plot::series_data_t>> series_map;
+    series_map[1] = series;
+
+    plot::Asset_loader asset_loader;
+    plot::Series_renderer renderer;
+    renderer.initialize(asset_loader);
+    Offscreen_rhi_fixture rhi_fixture;
+    std::string error_message;
+    TEST_ASSERT(rhi_fixture.initialize(error_message), error_message);
+
+    auto profiler = std::make_shared<Observation_profiler>();
+    plot::Plot_config config;
+    config.profiler            = profiler;
+    config.async_layer_prepare = true;
+    const plot::frame_layout_result_t layout = make_layout();
+    plot::frame_context_t ctx = make_context(layout, config);
+    std::vector<layer_event_t> events;
+
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    TEST_ASSERT(log.async_count == 1 && log.prepare_count == 1,
+        "the async stage and prepare should each run once");
+    TEST_ASSERT(log.prepare_before_async == 0,
+        "prepare must wait for the async stage of its draw");
+    TEST_ASSERT(log.async_thread != std::this_thread::get_id(),
+        "the async stage should run off the render thread");
+    TEST_ASSERT(log.async_source_count == log.prepare_source_count &&
+        log.async_source_count > 0,
+        "the async stage should see the planned window");
+    TEST_ASSERT(profiler->last["renderer.frame.async_layer_prepare_count"] == 1.0,
+        "started async stages should be reported");
+
+    config.async_layer_prepare = false;
+    TEST_ASSERT(rhi_fixture.render_layer_frame(
+        renderer, ctx, series_map, events, error_message), error_message);
+    TEST_ASSERT(log.async_count == 2 && log.prepare_count == 2 &&
+        log.prepare_before_async == 0,
+        "without a worker the stage should run inline before prepare");
+    TEST_ASSERT(log.async_thread == std::this_thread::get_id(),
+        "the inline stage should run on the render thread");
 
     return true;
 }
@@ -3670,6 +4700,7 @@ int main()
     RUN_TEST(test_custom_sample_buffer_not_reused_when_current_access_cannot_stage);
     RUN_TEST(test_builtin_upload_stages_visible_window_only);
     RUN_TEST(test_builtin_upload_reuses_vbo_capacity_headroom);
+    RUN_TEST(test_streaming_sample_buffer_uploads_only_appended_tail);
     RUN_TEST(test_combined_builtin_uploads_samples_once_per_view);
     RUN_TEST(test_direct_member_policy_uses_member_dispatch_in_renderer_staging);
     RUN_TEST(test_access_policy_change_reuploads_builtin_samples);
@@ -3701,7 +4732,16 @@ int main()
     RUN_TEST(test_layer_state_recreated_for_program_identity_changes);
     RUN_TEST(test_range_only_access_skips_builtin_value_styles);
     RUN_TEST(test_stacked_sum_overlay_uses_top_geometry_and_theme);
-    RUN_TEST(test_line_geometry_reuses_and_rebuilds_after_area_only_change);
+    RUN_TEST(test_line_draws_compact_samples_after_area_only_change);
+    RUN_TEST(test_density_reuses_binned_grid_across_color_changes);
+    RUN_TEST(test_scroll_blit_reports_region_changed_by_appends);
+    RUN_TEST(test_chrome_layer_redraws_only_for_changed_layout_or_theme);
+    RUN_TEST(test_preview_borrows_main_sample_buffer_for_shared_window);
+    RUN_TEST(test_batched_line_series_record_one_draw);
+    RUN_TEST(test_batched_dots_pack_each_view_from_its_own_window);
+    RUN_TEST(test_gpu_buffer_budget_evicts_least_recently_drawn_series);
+    RUN_TEST(test_gpu_buffer_shrinks_after_underused_frames);
+    RUN_TEST(test_async_layer_prepare_completes_before_prepare);
 
     std::cout << "Results: " << passed << " passed, " << failed << " failed" << std::endl;
     return failed > 0 ? 1 : 0;
@@ -6,12 +6,15 @@
 #include <vnm_plot/core/series_builder.h>
 #include <vnm_plot/core/series_window.h>
 #include <vnm_plot/core/types.h>
+#include <vnm_plot/rhi/pipeline_cache.h>
 #include <vnm_plot/rhi/qrhi_series_layer.h>
 #include <vnm_plot/rhi/series_builder.h>
 #include <vnm_plot/rhi/series_data.h>
 
 #include <glm/mat4x4.hpp>
 
+#include <rhi/qrhi.h>
+
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -470,6 +473,27 @@ bool test_make_series_view_uniform_values()
     return true;
 }
 
+bool test_pipeline_disk_cache_skips_disabled_and_empty_rhi()
+{
+    QRhiNullInitParams params;
+    std::unique_ptr<QRhi> rhi(QRhi::create(QRhi::Null, &params, QRhi::EnablePipelineCacheDataSave));
+    TEST_ASSERT(rhi != nullptr, "failed to create QRhi Null backend");
+
+    const bool was_enabled = plot::pipeline_disk_cache_enabled();
+    plot::set_pipeline_disk_cache_enabled(false);
+    TEST_ASSERT(!plot::pipeline_disk_cache_enabled(), "disabling the pipeline disk cache must stick");
+    TEST_ASSERT(!plot::load_pipeline_disk_cache(rhi.get()), "a disabled cache must not load");
+    TEST_ASSERT(!plot::save_pipeline_disk_cache(rhi.get()), "a disabled cache must not save");
+
+    plot::set_pipeline_disk_cache_enabled(true);
+    TEST_ASSERT(!plot::load_pipeline_disk_cache(nullptr), "a null QRhi must not load");
+    TEST_ASSERT(!plot::save_pipeline_disk_cache(rhi.get()),
+        "a QRhi without pipeline cache data must not write a file");
+
+    plot::set_pipeline_disk_cache_enabled(was_enabled);
+    return true;
+}
+
 } // namespace
 
 int main()
@@ -484,6 +508,7 @@ int main()
     RUN_TEST(test_qrhi_layer_api_surface_can_be_implemented);
     RUN_TEST(test_core_plan_types_are_usable);
     RUN_TEST(test_make_series_view_uniform_values);
+    RUN_TEST(test_pipeline_disk_cache_skips_disabled_and_empty_rhi);
 
     std::cout << "Results: " << passed << " passed, " << failed << " failed" << std::endl;
     return failed > 0 ? 1 : 0;
@@ -2,13 +2,19 @@
 
 #include "test_macros.h"
 
+#include "../src/core/pipeline_cache_file.h"
 #include "../src/core/rhi_helpers.h"
+#include "../src/core/rhi_shared_resources.h"
+
+#include <rhi/qrhi.h>
 
 #include <cstddef>
 #include <cmath>
 #include <cstdint>
+#include <filesystem>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <vector>
 
 namespace plot = vnm::plot;
@@ -131,6 +137,10 @@ bool test_embedded_shaders_retain_required_glsl_profiles()
         "plot_dot_quad.frag.qsb",
         "plot_area.vert.qsb",
         "plot_area.frag.qsb",
+        "plot_density.vert.qsb",
+        "plot_density.frag.qsb",
+        "plot_layer_composite.vert.qsb",
+        "plot_layer_composite.frag.qsb",
     };
 #if defined(VNM_PLOT_ENABLE_TEXT)
     shaders.push_back("msdf_text.vert.qsb");
@@ -161,6 +171,151 @@ bool test_embedded_shaders_retain_required_glsl_profiles()
     return true;
 }
 
+bool test_shared_resources_are_reused_per_rhi()
+{
+    QRhiNullInitParams params;
+    std::unique_ptr<QRhi> rhi(QRhi::create(QRhi::Null, &params));
+    TEST_ASSERT(rhi != nullptr, "failed to create QRhi Null backend");
+
+    std::unique_ptr<QRhiTexture> color(rhi->newTexture(
+        QRhiTexture::RGBA8, QSize(16, 16), 1, QRhiTexture::RenderTarget));
+    TEST_ASSERT(color && color->create(), "color texture must be created");
+    std::unique_ptr<QRhiTextureRenderTarget> rt(
+        rhi->newTextureRenderTarget(QRhiTextureRenderTargetDescription(color.get())));
+    std::unique_ptr<QRhiRenderPassDescriptor> rpd(rt->newCompatibleRenderPassDescriptor());
+    rt->setRenderPassDescriptor(rpd.get());
+    TEST_ASSERT(rt->create(), "render target must be created");
+
+    auto shared = plot::detail::Rhi_shared_resources::acquire(rhi.get());
+    TEST_ASSERT(shared != nullptr, "acquire must create a registry");
+    TEST_ASSERT(plot::detail::Rhi_shared_resources::acquire(rhi.get()) == shared,
+        "renderers on the same QRhi must share one registry");
+    TEST_ASSERT(plot::detail::Rhi_shared_resources::acquire(nullptr) == nullptr,
+        "a null QRhi has no registry");
+
+    int builds = 0;
+    const auto build = [&](QRhiRenderPassDescriptor* build_rpd, int sample_count) {
+        ++builds;
+        plot::detail::alpha_blended_pipeline_desc_t desc;
+        desc.vert      = plot::detail::load_qsb("generic_rect.vert.qsb");
+        desc.frag      = plot::detail::load_qsb("generic_rect.frag.qsb");
+        desc.ubo_bytes = 64;
+        desc.vlayout.setBindings({QRhiVertexInputBinding(2 * sizeof(float))});
+        desc.vlayout.setAttributes({QRhiVertexInputAttribute(0, 0, QRhiVertexInputAttribute::Float2, 0)});
+        return plot::detail::build_alpha_blended_pipeline(rhi.get(), build_rpd, sample_count, desc);
+    };
+    QRhiGraphicsPipeline* first  = shared->pipeline("test.rect", rt.get(), build);
+    QRhiGraphicsPipeline* second = shared->pipeline("test.rect", rt.get(), build);
+    TEST_ASSERT(first != nullptr, "pipeline must be built");
+    TEST_ASSERT(first == second && builds == 1,
+        "the same pipeline and target format must build once");
+    TEST_ASSERT(shared->pipeline_count() == 1, "one pipeline must be registered");
+
+    QRhiSampler* sampler = shared->clamp_sampler(QRhiSampler::Nearest);
+    TEST_ASSERT(sampler != nullptr && sampler == shared->clamp_sampler(QRhiSampler::Nearest),
+        "samplers must be shared");
+    TEST_ASSERT(shared->clamp_sampler(QRhiSampler::Linear) != sampler,
+        "each filter must get its own sampler");
+
+    QRhiResourceUpdateBatch* updates = rhi->nextResourceUpdateBatch();
+    QRhiBuffer* quad = shared->unit_quad_vbo(updates);
+    TEST_ASSERT(quad != nullptr && quad == shared->unit_quad_vbo(nullptr),
+        "the unit quad must be uploaded once");
+
+    const std::vector<std::uint8_t> rgba(std::size_t(8) * 8 * 4, 0xff);
+    auto atlas = shared->font_atlas(7, 8, rgba.data(), updates);
+    TEST_ASSERT(atlas != nullptr, "font atlas must be created");
+    TEST_ASSERT(shared->font_atlas(7, 8, nullptr, nullptr) == atlas,
+        "a held font atlas must be shared without another upload");
+    TEST_ASSERT(shared->font_atlas(8, 8, nullptr, nullptr) == nullptr,
+        "an unknown font atlas needs pixels");
+    updates->release();
+
+    atlas.reset();
+    std::weak_ptr<plot::detail::Rhi_shared_resources> weak = shared;
+    shared.reset();
+    TEST_ASSERT(weak.expired(), "the registry must go with its last holder");
+    auto fresh = plot::detail::Rhi_shared_resources::acquire(rhi.get());
+    TEST_ASSERT(fresh != nullptr && fresh->pipeline_count() == 0,
+        "a released registry must be recreated empty");
+    return true;
+}
+
+bool test_shared_resources_are_released_with_their_rhi()
+{
+    QRhiNullInitParams params;
+    std::unique_ptr<QRhi> rhi(QRhi::create(QRhi::Null, &params));
+    TEST_ASSERT(rhi != nullptr, "failed to create QRhi Null backend");
+
+    auto shared = plot::detail::Rhi_shared_resources::acquire(rhi.get());
+    TEST_ASSERT(shared != nullptr, "acquire must create a registry");
+    TEST_ASSERT(shared->clamp_sampler(QRhiSampler::Nearest) != nullptr,
+        "sampler must be created");
+    QRhiResourceUpdateBatch* updates = rhi->nextResourceUpdateBatch();
+    TEST_ASSERT(shared->unit_quad_vbo(updates) != nullptr, "unit quad must be created");
+    updates->release();
+
+    // The holder outlives the QRhi, as a renderer torn down after its window.
+    rhi.reset();
+    TEST_ASSERT(shared->rhi() == nullptr,
+        "destroying the QRhi must detach its registry");
+    TEST_ASSERT(shared->clamp_sampler(QRhiSampler::Nearest) == nullptr &&
+        shared->unit_quad_vbo(nullptr) == nullptr,
+        "a detached registry must hand out nothing");
+
+    // A new QRhi may reuse the address; it must never see the old registry.
+    std::unique_ptr<QRhi> next(QRhi::create(QRhi::Null, &params));
+    TEST_ASSERT(next != nullptr, "failed to create QRhi Null backend");
+    auto fresh = plot::detail::Rhi_shared_resources::acquire(next.get());
+    TEST_ASSERT(fresh != nullptr && fresh != shared && fresh->rhi() == next.get(),
+        "a new QRhi must get a new registry");
+    return true;
+}
+
+bool test_pipeline_cache_file_round_trips()
+{
+    const std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "vnm_plot_test_pipeline_cache";
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    TEST_ASSERT(std::filesystem::create_directories(dir, ec), "temp cache directory must be created");
+    const std::filesystem::path path = dir / "pipeline_cache.bin";
+
+    plot::detail::pipeline_cache_digest_t digest{};
+    for (std::size_t i = 0; i < digest.size(); ++i) {
+        digest[i] = static_cast<std::uint8_t>(i * 7u + 1u);
+    }
+    QByteArray data(4096, Qt::Uninitialized);
+    for (qsizetype i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<char>((i * 31) & 0xff);
+    }
+
+    TEST_ASSERT(plot::detail::load_pipeline_cache_file(path, digest).isEmpty(),
+        "a missing file must load no data");
+    TEST_ASSERT(plot::detail::save_pipeline_cache_file(path, digest, data),
+        "pipeline cache data must be saved");
+    TEST_ASSERT(plot::detail::load_pipeline_cache_file(path, digest) == data,
+        "saved data must load back unchanged");
+
+    plot::detail::pipeline_cache_digest_t other_digest = digest;
+    other_digest[0] ^= 0xffu;
+    TEST_ASSERT(plot::detail::load_pipeline_cache_file(path, other_digest).isEmpty(),
+        "a file written for another device or shader set must be ignored");
+
+    data[0] = static_cast<char>(data[0] ^ 0x5a);
+    TEST_ASSERT(plot::detail::save_pipeline_cache_file(path, digest, data) &&
+        plot::detail::load_pipeline_cache_file(path, digest) == data,
+        "a second save must replace the file");
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1, ec);
+    TEST_ASSERT(!ec, "cache file must be truncated");
+    TEST_ASSERT(plot::detail::load_pipeline_cache_file(path, digest).isEmpty(),
+        "a truncated file must load no data");
+
+    std::filesystem::remove_all(dir, ec);
+    return true;
+}
+
 } // namespace
 
 int main()
@@ -177,6 +332,9 @@ int main()
     RUN_TEST(test_qrhi_buffer_offset_checks_scaled_offsets);
     RUN_TEST(test_view_seconds_subtracts_before_floating_conversion);
     RUN_TEST(test_embedded_shaders_retain_required_glsl_profiles);
+    RUN_TEST(test_shared_resources_are_reused_per_rhi);
+    RUN_TEST(test_shared_resources_are_released_with_their_rhi);
+    RUN_TEST(test_pipeline_cache_file_round_trips);
 
     std::cout << "Passed: " << passed << ", Failed: " << failed << std::endl;
     return failed == 0 ? 0 : 1;
@@ -12,12 +12,16 @@
 #include <vnm_plot/core/plot_config.h>
 #include <vnm_plot/core/time_units.h>
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cmath>
 #include <cstdint>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -64,6 +68,7 @@ public:
     std::weak_ptr<void>        last_hold;
     std::vector<std::size_t>   scale_values     = {1};
     plot::Time_order           order            = plot::Time_order::UNKNOWN;
+    uint64_t                   prefix_revision  = 1;
 
     snapshot_result_t try_snapshot(size_t lod_level) override
     {
@@ -82,6 +87,7 @@ public:
             0,
             hold
         };
+        snapshot.prefix_revision = prefix_revision;
         if (samples.empty()) {
             return {data_snapshot_t{}, snapshot_result_t::Snapshot_status::EMPTY};
         }
@@ -297,7 +303,9 @@ plot::Series_view_plan plan_two_level_lod_width(
     plot::detail::series_window_planner_state_t&   state,
     plot::detail::Series_window_snapshot_cache&    cache,
     std::uint64_t                                  frame_id,
-    double                                         width_px)
+    double                                         width_px,
+    double                                         lod_hysteresis = 0.0,
+    double                                         lod_pps_target = 1.0)
 {
     plot::detail::series_window_plan_request_t request;
     request.planner_state  = &state;
@@ -311,6 +319,8 @@ plot::Series_view_plan plan_two_level_lod_width(
     request.t_origin_ns    = 0;
     request.width_px       = width_px;
     request.style          = Display_style::LINE;
+    request.lod_hysteresis = lod_hysteresis;
+    request.lod_pps_target = lod_pps_target;
     return plot::detail::plan_series_window(request);
 }
 
@@ -849,6 +859,207 @@ bool test_unknown_and_unordered_time_order_run_defensive_scan()
         "UNORDERED");
 }
 
+// A source without declared order that only grows is classified once; later
+// frames scan just the appended suffix joined at the last classified sample.
+bool test_growing_unknown_order_source_scans_only_appended_suffix()
+{
+    auto source = make_single_level_source(
+        { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 },
+        plot::Time_order::UNKNOWN);
+
+    const Data_access_policy       access = make_policy();
+    const std::vector<std::size_t> scales = {1};
+    plot::detail::series_window_planner_state_t state;
+    plot::detail::Series_window_snapshot_cache cache;
+    std::uint64_t frame_id = 1;
+
+    const auto plan_frame = [&]() {
+        plot::detail::series_window_plan_request_t request;
+        request.planner_state  = &state;
+        request.snapshot_cache = &cache;
+        request.frame_id       = frame_id++;
+        request.data_source    = source.get();
+        request.access         = &access;
+        request.scales         = &scales;
+        request.t_min_ns       = 0;
+        request.t_max_ns       = 100;
+        request.width_px       = 200.0;
+        request.style          = Display_style::LINE;
+        return plot::detail::plan_series_window(request);
+    };
+    const auto append = [&](std::int64_t t) {
+        source->samples.push_back({t, 1.0f});
+    };
+
+    plan_frame();
+    TEST_ASSERT(state.last_timestamp_order_scan_performed &&
+                !state.last_timestamp_order_scan_incremental,
+        "first frame scans the whole snapshot");
+    TEST_ASSERT(state.last_timestamp_order_scan_samples == 10,
+        "first frame visits every sample");
+
+    for (std::int64_t t = 10; t < 15; ++t) {
+        append(t);
+    }
+    ++source->sequence;
+    plan_frame();
+    TEST_ASSERT(state.last_timestamp_order_scan_incremental,
+        "appending keeps the classified prefix");
+    TEST_ASSERT(state.last_timestamp_order_scan_samples == 6,
+        "incremental scan visits the join sample and the appended suffix");
+    TEST_ASSERT(state.last_timestamps_monotonic,
+        "ascending appends stay monotonic");
+
+    append(3);
+    ++source->sequence;
+    plan_frame();
+    TEST_ASSERT(state.last_timestamp_order_scan_incremental &&
+                !state.last_timestamps_monotonic,
+        "an appended inversion is found by the incremental scan");
+
+    append(20);
+    ++source->sequence;
+    plan_frame();
+    TEST_ASSERT(state.last_timestamp_order_scan_incremental &&
+                state.last_timestamp_order_scan_samples == 0,
+        "a non-monotonic prefix needs no further scanning");
+    TEST_ASSERT(!state.last_timestamps_monotonic,
+        "a non-monotonic prefix keeps the result non-monotonic");
+
+    source->samples[0].t = -5;
+    ++source->sequence;
+    ++source->prefix_revision;
+    plan_frame();
+    TEST_ASSERT(state.last_timestamp_order_scan_performed &&
+                !state.last_timestamp_order_scan_incremental,
+        "a rewritten prefix forces a full scan");
+    TEST_ASSERT(state.last_timestamp_order_scan_samples == 16 &&
+                !state.last_timestamps_monotonic,
+        "the full scan restarts at the first sample and stops at the inversion");
+
+    return true;
+}
+
+// Vector_data_source keeps its prefix revision across append(), so a growing
+// stock source without a declared order is classified incrementally.
+bool test_vector_source_appends_extend_timestamp_order()
+{
+    auto source = std::make_shared<plot::Vector_data_source<Test_sample>>();
+    std::vector<Test_sample> samples;
+    for (std::int64_t t = 0; t < 10; ++t) {
+        samples.push_back({t, 1.0f});
+    }
+    source->set_data(samples);
+
+    const Data_access_policy       access = make_policy();
+    const std::vector<std::size_t> scales = {1};
+    plot::detail::series_window_planner_state_t state;
+    plot::detail::Series_window_snapshot_cache cache;
+    std::uint64_t frame_id = 1;
+
+    const auto plan_frame = [&]() {
+        plot::detail::series_window_plan_request_t request;
+        request.planner_state  = &state;
+        request.snapshot_cache = &cache;
+        request.frame_id       = frame_id++;
+        request.data_source    = source.get();
+        request.access         = &access;
+        request.scales         = &scales;
+        request.t_min_ns       = 0;
+        request.t_max_ns       = 100;
+        request.width_px       = 200.0;
+        request.style          = Display_style::LINE;
+        return plot::detail::plan_series_window(request);
+    };
+
+    plan_frame();
+    TEST_ASSERT(state.last_timestamp_order_scan_performed &&
+                !state.last_timestamp_order_scan_incremental,
+        "first frame scans the whole snapshot");
+
+    source->append({{10, 1.0f}, {11, 1.0f}});
+    plan_frame();
+    TEST_ASSERT(state.last_timestamp_order_scan_incremental &&
+                state.last_timestamp_order_scan_samples == 3,
+        "an append scans only the join sample and the appended samples");
+    TEST_ASSERT(state.last_timestamps_monotonic,
+        "ascending appends stay monotonic");
+
+    samples.push_back({5, 1.0f});
+    source->set_data(samples);
+    plan_frame();
+    TEST_ASSERT(state.last_timestamp_order_scan_performed &&
+                !state.last_timestamp_order_scan_incremental,
+        "set_data replaces the content and forces a full scan");
+    TEST_ASSERT(!state.last_timestamps_monotonic,
+        "the full scan finds the inversion");
+
+    return true;
+}
+
+// Appends are only trusted on the source's word: a rewrite that keeps both
+// end timestamps, or a source that makes no append promise, is scanned whole.
+bool test_timestamp_order_extension_requires_append_contract()
+{
+    auto source = make_single_level_source(
+        { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 },
+        plot::Time_order::UNKNOWN);
+
+    const Data_access_policy       access = make_policy();
+    const std::vector<std::size_t> scales = {1};
+    plot::detail::series_window_planner_state_t state;
+    plot::detail::Series_window_snapshot_cache cache;
+    std::uint64_t frame_id = 1;
+
+    const auto plan_frame = [&]() {
+        plot::detail::series_window_plan_request_t request;
+        request.planner_state  = &state;
+        request.snapshot_cache = &cache;
+        request.frame_id       = frame_id++;
+        request.data_source    = source.get();
+        request.access         = &access;
+        request.scales         = &scales;
+        request.t_min_ns       = 0;
+        request.t_max_ns       = 100;
+        request.width_px       = 200.0;
+        request.style          = Display_style::LINE;
+        return plot::detail::plan_series_window(request);
+    };
+
+    plan_frame();
+
+    // Swap two interior samples: the ends still match, the order does not.
+    std::swap(source->samples[3].t, source->samples[6].t);
+    source->samples.push_back({10, 1.0f});
+    ++source->sequence;
+    ++source->prefix_revision;
+    plan_frame();
+    TEST_ASSERT(state.last_timestamp_order_scan_performed &&
+                !state.last_timestamp_order_scan_incremental,
+        "a changed prefix revision forces a full scan");
+    TEST_ASSERT(!state.last_timestamps_monotonic,
+        "the full scan finds the interior inversion");
+
+    source->prefix_revision = 0;
+    source->samples = {};
+    for (std::int64_t t = 0; t < 10; ++t) {
+        source->samples.push_back({t, 1.0f});
+    }
+    ++source->sequence;
+    plan_frame();
+    source->samples.push_back({10, 1.0f});
+    ++source->sequence;
+    plan_frame();
+    TEST_ASSERT(state.last_timestamp_order_scan_performed &&
+                !state.last_timestamp_order_scan_incremental,
+        "a source without an append promise is scanned whole");
+    TEST_ASSERT(state.last_timestamp_order_scan_samples == 11 &&
+                state.last_timestamps_monotonic,
+        "the whole scan visits every sample");
+
+    return true;
+}
+
 bool test_descending_time_order_uses_linear_window_search()
 {
     auto data_source = make_single_level_source(
@@ -1460,6 +1671,138 @@ bool test_lod_selection_has_no_hysteresis()
     return true;
 }
 
+// With hysteresis the planner keeps the current level inside a band around
+// the raw midpoint, so narrowing and widening near the boundary does not flip
+// levels.
+bool test_lod_hysteresis_holds_level_near_boundary()
+{
+    const std::vector<std::size_t> scales = {1, 4};
+    TEST_ASSERT(plot::detail::choose_lod_level(scales, 0.39, 0, 0.0) == 1,
+        "zero hysteresis selects like the plain chooser");
+    TEST_ASSERT(plot::detail::choose_lod_level(scales, 0.39, 0, 0.25) == 0,
+        "hysteresis keeps the finer level just past the raw midpoint");
+    TEST_ASSERT(plot::detail::choose_lod_level(scales, 0.30, 0, 0.25) == 1,
+        "hysteresis switches coarser once outside the band");
+    TEST_ASSERT(plot::detail::choose_lod_level(scales, 0.44, 1, 0.25) == 1,
+        "hysteresis keeps the coarser level just past the raw midpoint");
+    TEST_ASSERT(plot::detail::choose_lod_level(scales, 0.50, 1, 0.25) == 0,
+        "hysteresis switches finer once outside the band");
+
+    Two_level_source source;
+    fill_lod_samples(source);
+
+    const Data_access_policy access = make_policy();
+    plot::detail::series_window_planner_state_t state;
+    plot::detail::Series_window_snapshot_cache cache;
+    std::uint64_t frame_id = 1;
+
+    const double      widths[]          = {50.0, 39.0, 30.0, 44.0, 50.0};
+    const std::size_t expected_levels[] = {0, 0, 1, 1, 0};
+    for (std::size_t i = 0; i < std::size(widths); ++i) {
+        const auto plan = plan_two_level_lod_width(
+            source, access, scales, state, cache, frame_id++, widths[i], 0.25);
+        TEST_ASSERT(plan.lod_level == expected_levels[i],
+            "planner LOD level should follow the hysteresis band");
+    }
+
+    return true;
+}
+
+// Switching back to the level a view left reuses that level's timestamp
+// order classification instead of scanning it again.
+bool test_lod_switch_back_reuses_timestamp_order()
+{
+    Two_level_source source;
+    fill_lod_samples(source);
+
+    const Data_access_policy       access = make_policy();
+    const std::vector<std::size_t> scales = {1, 4};
+    plot::detail::series_window_planner_state_t state;
+    plot::detail::Series_window_snapshot_cache cache;
+    std::uint64_t frame_id = 1;
+
+    auto plan = plan_two_level_lod_width(
+        source, access, scales, state, cache, frame_id++, 50.0);
+    TEST_ASSERT(plan.lod_level == 0, "wide plan should use the full-resolution level");
+    TEST_ASSERT(state.last_timestamp_order_scan_performed,
+        "first plan of an unordered source scans its level");
+
+    plan = plan_two_level_lod_width(
+        source, access, scales, state, cache, frame_id++, 30.0);
+    TEST_ASSERT(plan.lod_level == 1, "narrow plan switches to the coarser level");
+    TEST_ASSERT(state.last_timestamp_order_scan_performed &&
+                !state.last_timestamp_order_from_neighbor,
+        "a level not seen before is scanned");
+    TEST_ASSERT(source.snapshot_calls[1] == 1,
+        "only the switching frame snapshots the coarser level");
+
+    plan = plan_two_level_lod_width(
+        source, access, scales, state, cache, frame_id++, 50.0);
+    TEST_ASSERT(plan.lod_level == 0, "wide plan switches back to the finer level");
+    TEST_ASSERT(!state.last_timestamp_order_scan_performed &&
+                state.last_timestamp_order_from_neighbor,
+        "switching back reuses the classification of the level left behind");
+
+    return true;
+}
+
+// A pixels-per-sample target above 1 (adaptive LOD) moves the choice to
+// coarser levels, and dropping it back restores full detail.
+bool test_lod_pps_target_biases_towards_coarser_levels()
+{
+    Two_level_source source;
+    fill_lod_samples(source);
+
+    const Data_access_policy       access = make_policy();
+    const std::vector<std::size_t> scales = {1, 4};
+    plot::detail::series_window_planner_state_t state;
+    plot::detail::Series_window_snapshot_cache cache;
+    std::uint64_t frame_id = 1;
+
+    auto plan = plan_two_level_lod_width(
+        source, access, scales, state, cache, frame_id++, 50.0);
+    TEST_ASSERT(plan.lod_level == 0, "unbiased plan should use the full-resolution level");
+
+    plan = plan_two_level_lod_width(
+        source, access, scales, state, cache, frame_id++, 50.0, 0.0, 4.0);
+    TEST_ASSERT(plan.lod_level == 1, "a 4 px/sample target should switch to the coarser level");
+    TEST_ASSERT(std::abs(plan.pixels_per_sample - 2.0) < 1e-9,
+        "the plan should report the real pixels per sample of the applied level");
+
+    plan = plan_two_level_lod_width(
+        source, access, scales, state, cache, frame_id++, 50.0);
+    TEST_ASSERT(plan.lod_level == 0, "clearing the target should restore full detail");
+
+    return true;
+}
+
+bool test_adaptive_lod_bias_follows_prepare_time()
+{
+    using plot::detail::next_adaptive_lod_bias;
+
+    TEST_ASSERT(next_adaptive_lod_bias(2.0, 100.0, 0.0, 3.0, true) == 0.0,
+        "a zero budget turns the bias off");
+    TEST_ASSERT(next_adaptive_lod_bias(0.0, 32.0, 8.0, 3.0, true) == 2.0,
+        "a 4x overrun should raise the bias by two steps");
+    TEST_ASSERT(next_adaptive_lod_bias(2.0, 40.0, 8.0, 3.0, true) == 3.0,
+        "the bias should stop at the configured maximum");
+    TEST_ASSERT(next_adaptive_lod_bias(3.0, 6.0, 8.0, 3.0, true) == 3.0,
+        "a moving frame within budget should hold the bias");
+    TEST_ASSERT(next_adaptive_lod_bias(3.0, 2.0, 8.0, 3.0, true) == 2.75,
+        "a moving frame well under budget should lower the bias a little");
+
+    double bias = 3.0;
+    int    idle_frames = 0;
+    while (bias > 0.0 && idle_frames < 10) {
+        bias = next_adaptive_lod_bias(bias, 50.0, 8.0, 3.0, false);
+        ++idle_frames;
+    }
+    TEST_ASSERT(bias == 0.0 && idle_frames == 3,
+        "a still view should return to full detail within max_bias frames");
+
+    return true;
+}
+
 bool test_stacking_composes_different_timestamps_from_independent_lods()
 {
     Two_level_source lower_source;
@@ -1967,6 +2310,346 @@ bool test_stacking_binary_lookup_matches_streaming_fallback()
     return true;
 }
 
+bool test_stacking_cache_extends_appended_samples()
+{
+    Single_level_source lower_source;
+    Single_level_source upper_source;
+    for (std::int64_t t = 0; t < 200; t += 2) {
+        lower_source.samples.push_back({t, static_cast<float>(t % 7)});
+    }
+    for (std::int64_t t = 1; t < 200; t += 3) {
+        upper_source.samples.push_back({t, static_cast<float>(t % 5) + 1.0f});
+    }
+
+    const Data_access_policy access = make_policy();
+    const auto make_plan = [&access](Single_level_source& source) {
+        plot::Series_view_plan plan;
+        plan.source            = &source;
+        plan.access            = &access;
+        plan.snapshot.snapshot = {
+            source.samples.data(), source.samples.size(), sizeof(Test_sample),
+            source.sequence};
+        plan.snapshot.snapshot.prefix_revision = source.prefix_revision;
+        plan.snapshot.sequence = source.sequence;
+        plan.source_count      = source.samples.size();
+        plan.gpu_count         = source.samples.size();
+        plan.drawable_spans    = {{0, source.samples.size(), 0, source.samples.size()}};
+        plan.interpolation     = plot::Series_interpolation::LINEAR;
+        return plan;
+    };
+    const std::vector<plot::Time_order> orders(2, plot::Time_order::ASCENDING);
+    const auto layers_match = [](
+        const plot::detail::stack_composition_cache_t&                   cache,
+        const std::vector<std::vector<plot::detail::stacked_sample_t>>&  expected)
+    {
+        if (cache.layers.size() != expected.size()) {
+            return false;
+        }
+        for (std::size_t layer = 0; layer < expected.size(); ++layer) {
+            const auto* actual = cache.layers[layer]->data() + cache.first;
+            if (cache.count != expected[layer].size()) {
+                return false;
+            }
+            for (std::size_t i = 0; i < cache.count; ++i) {
+                if (actual[i].timestamp_ns != expected[layer][i].timestamp_ns ||
+                    actual[i].value        != expected[layer][i].value        ||
+                    actual[i].base         != expected[layer][i].base)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    plot::detail::stack_composition_cache_t           cache;
+    plot::detail::stack_composition_stats_t          stats;
+    std::vector<std::vector<plot::detail::stacked_sample_t>> expected;
+    auto lower_plan = make_plan(lower_source);
+    auto upper_plan = make_plan(upper_source);
+    TEST_ASSERT(plot::detail::compose_stacked_series(
+        {&lower_plan, &upper_plan}, orders, cache, 4096u, &stats) ==
+            plot::Stack_rejection_reason::NONE,
+        "initial cached composition should succeed");
+    TEST_ASSERT(!stats.extended && cache.members.size() == 2,
+        "an exact ascending composition should record extendable members");
+
+    for (std::int64_t t = 200; t < 260; t += 2) {
+        lower_source.samples.push_back({t, static_cast<float>(t % 7)});
+    }
+    for (std::int64_t t = 202; t < 260; t += 3) {
+        upper_source.samples.push_back({t, static_cast<float>(t % 5) + 1.0f});
+    }
+    ++lower_source.sequence;
+    ++upper_source.sequence;
+    lower_plan = make_plan(lower_source);
+    upper_plan = make_plan(upper_source);
+    TEST_ASSERT(plot::detail::compose_stacked_series(
+        {&lower_plan, &upper_plan}, orders, cache, 4096u, &stats) ==
+            plot::Stack_rejection_reason::NONE,
+        "appended composition should succeed");
+    TEST_ASSERT(stats.extended && stats.reused_timestamp_count > 100,
+        "appending samples should extend the cached prefix");
+    TEST_ASSERT(plot::detail::compose_stacked_series(
+        {&lower_plan, &upper_plan}, orders, expected, 4096u) ==
+            plot::Stack_rejection_reason::NONE,
+        "full reference composition should succeed");
+    TEST_ASSERT(layers_match(cache, expected),
+        "extended composition must equal a full recomposition");
+
+    // A further append lands in the storage's headroom: the samples already
+    // published stay where they are, untouched.
+    const auto                                 storage   = cache.layers.front();
+    const std::size_t                          published = cache.first + cache.count;
+    const std::vector<plot::detail::stacked_sample_t> published_samples(
+        storage->begin(), storage->begin() + static_cast<std::ptrdiff_t>(published));
+    const auto* const                          published_data = storage->data();
+    lower_source.samples.push_back({260, 3.0f});
+    upper_source.samples.push_back({262, 2.0f});
+    ++lower_source.sequence;
+    ++upper_source.sequence;
+    lower_plan = make_plan(lower_source);
+    upper_plan = make_plan(upper_source);
+    TEST_ASSERT(plot::detail::compose_stacked_series(
+        {&lower_plan, &upper_plan}, orders, cache, 4096u, &stats) ==
+            plot::Stack_rejection_reason::NONE && stats.extended,
+        "a second append should extend again");
+    TEST_ASSERT(cache.layers.front() == storage && storage->data() == published_data,
+        "an append within capacity should extend the storage in place");
+    TEST_ASSERT(std::equal(
+            published_samples.begin(), published_samples.end(), storage->begin(),
+            [](const auto& a, const auto& b) {
+                return a.timestamp_ns == b.timestamp_ns && a.value == b.value && a.base == b.base;
+            }),
+        "extending in place must not modify published samples");
+    TEST_ASSERT(plot::detail::compose_stacked_series(
+        {&lower_plan, &upper_plan}, orders, expected, 4096u) ==
+            plot::Stack_rejection_reason::NONE,
+        "full reference composition should succeed");
+    TEST_ASSERT(layers_match(cache, expected),
+        "an in-place extension must equal a full recomposition");
+
+    // Rewriting an interior sample keeps the last one; only the source's
+    // prefix revision tells the cache the prefix changed.
+    lower_source.samples[10].v += 1.0f;
+    lower_source.samples.push_back({264, 1.0f});
+    ++lower_source.sequence;
+    ++lower_source.prefix_revision;
+    lower_plan = make_plan(lower_source);
+    TEST_ASSERT(plot::detail::compose_stacked_series(
+        {&lower_plan, &upper_plan}, orders, cache, 4096u, &stats) ==
+            plot::Stack_rejection_reason::NONE,
+        "recomposition after an interior rewrite should succeed");
+    TEST_ASSERT(!stats.extended,
+        "a changed prefix revision must force a full recomposition");
+    TEST_ASSERT(plot::detail::compose_stacked_series(
+        {&lower_plan, &upper_plan}, orders, expected, 4096u) ==
+            plot::Stack_rejection_reason::NONE,
+        "full reference composition should succeed");
+    TEST_ASSERT(layers_match(cache, expected),
+        "recomposed cache must reflect the interior rewrite");
+
+    upper_source.samples.back().v += 1.0f;
+    ++upper_source.sequence;
+    ++upper_source.prefix_revision;
+    upper_plan = make_plan(upper_source);
+    TEST_ASSERT(plot::detail::compose_stacked_series(
+        {&lower_plan, &upper_plan}, orders, cache, 4096u, &stats) ==
+            plot::Stack_rejection_reason::NONE,
+        "rewritten composition should succeed");
+    TEST_ASSERT(!stats.extended,
+        "a rewritten last sample must force a full recomposition");
+    TEST_ASSERT(plot::detail::compose_stacked_series(
+        {&lower_plan, &upper_plan}, orders, expected, 4096u) ==
+            plot::Stack_rejection_reason::NONE,
+        "full reference composition should succeed");
+    TEST_ASSERT(layers_match(cache, expected),
+        "recomposed cache must equal a full recomposition");
+    return true;
+}
+
+// The stock source's append() keeps the prefix revision its snapshots carry,
+// so a stack over appending Vector_data_sources extends the composition.
+bool test_stacking_cache_extends_vector_source_appends()
+{
+    using Source = plot::Vector_data_source<Test_sample>;
+    Source lower_source;
+    Source upper_source;
+    std::vector<Test_sample> lower_samples;
+    std::vector<Test_sample> upper_samples;
+    for (std::int64_t t = 0; t < 200; t += 2) {
+        lower_samples.push_back({t, static_cast<float>(t % 7)});
+    }
+    for (std::int64_t t = 1; t < 200; t += 3) {
+        upper_samples.push_back({t, static_cast<float>(t % 5) + 1.0f});
+    }
+    lower_source.set_data(lower_samples);
+    upper_source.set_data(upper_samples);
+
+    const Data_access_policy access = make_policy();
+    const auto make_plan = [&access](Source& source) {
+        plot::Series_view_plan plan;
+        plan.source            = &source;
+        plan.access            = &access;
+        plan.snapshot.snapshot = source.snapshot(0);
+        plan.snapshot.sequence = plan.snapshot.snapshot.sequence;
+        plan.source_count      = plan.snapshot.snapshot.count;
+        plan.gpu_count         = plan.snapshot.snapshot.count;
+        plan.drawable_spans    = {{0, plan.source_count, 0, plan.source_count}};
+        plan.interpolation     = plot::Series_interpolation::LINEAR;
+        return plan;
+    };
+    const std::vector<plot::Time_order> orders(2, plot::Time_order::ASCENDING);
+
+    plot::detail::stack_composition_cache_t                  cache;
+    plot::detail::stack_composition_stats_t                  stats;
+    std::vector<std::vector<plot::detail::stacked_sample_t>> expected;
+    auto lower_plan = make_plan(lower_source);
+    auto upper_plan = make_plan(upper_source);
+    TEST_ASSERT(plot::detail::compose_stacked_series(
+        {&lower_plan, &upper_plan}, orders, cache, 4096u, &stats) ==
+            plot::Stack_rejection_reason::NONE && !stats.extended,
+        "initial composition should succeed");
+
+    std::vector<Test_sample> lower_appended;
+    std::vector<Test_sample> upper_appended;
+    for (std::int64_t t = 200; t < 260; t += 2) {
+        lower_appended.push_back({t, static_cast<float>(t % 7)});
+    }
+    for (std::int64_t t = 202; t < 260; t += 3) {
+        upper_appended.push_back({t, static_cast<float>(t % 5) + 1.0f});
+    }
+    lower_source.append(lower_appended);
+    upper_source.append(upper_appended);
+    lower_plan = make_plan(lower_source);
+    upper_plan = make_plan(upper_source);
+    TEST_ASSERT(plot::detail::compose_stacked_series(
+        {&lower_plan, &upper_plan}, orders, cache, 4096u, &stats) ==
+            plot::Stack_rejection_reason::NONE,
+        "appended composition should succeed");
+    TEST_ASSERT(stats.extended,
+        "Vector_data_source appends should extend the cached composition");
+    TEST_ASSERT(plot::detail::compose_stacked_series(
+        {&lower_plan, &upper_plan}, orders, expected, 4096u) ==
+            plot::Stack_rejection_reason::NONE,
+        "full reference composition should succeed");
+    TEST_ASSERT(expected.size() == 2 && cache.count == expected[0].size(),
+        "extended composition should cover every appended timestamp");
+    for (std::size_t layer = 0; layer < expected.size(); ++layer) {
+        const auto* actual = cache.layers[layer]->data() + cache.first;
+        for (std::size_t i = 0; i < cache.count; ++i) {
+            TEST_ASSERT(actual[i].timestamp_ns == expected[layer][i].timestamp_ns &&
+                        actual[i].value        == expected[layer][i].value        &&
+                        actual[i].base         == expected[layer][i].base,
+                "extended composition must equal a full recomposition");
+        }
+    }
+
+    lower_samples.insert(lower_samples.end(), lower_appended.begin(), lower_appended.end());
+    lower_samples[10].v += 1.0f;
+    lower_source.set_data(lower_samples);
+    lower_plan = make_plan(lower_source);
+    TEST_ASSERT(plot::detail::compose_stacked_series(
+        {&lower_plan, &upper_plan}, orders, cache, 4096u, &stats) ==
+            plot::Stack_rejection_reason::NONE && !stats.extended,
+        "set_data should force a full recomposition");
+
+    return true;
+}
+
+bool test_stacking_chunked_layers_match_reference()
+{
+    constexpr std::size_t k_layers = 6;
+    constexpr std::size_t k_count  = 40'000;
+    const Data_access_policy access = make_policy();
+    std::vector<std::vector<Test_sample>> samples(k_layers);
+    for (std::size_t layer = 0; layer < k_layers; ++layer) {
+        samples[layer].reserve(k_count);
+        for (std::size_t i = 0; i < k_count; ++i) {
+            samples[layer].push_back({
+                static_cast<std::int64_t>(i * 3u + layer % 3u),
+                static_cast<float>((i * (layer + 1u)) % 23u)});
+        }
+    }
+    const auto make_plans = [&](std::vector<plot::Series_view_plan>& storage) {
+        storage.assign(k_layers, {});
+        std::vector<const plot::Series_view_plan*> plans;
+        for (std::size_t layer = 0; layer < k_layers; ++layer) {
+            auto& plan             = storage[layer];
+            plan.access            = &access;
+            plan.snapshot.snapshot = {
+                samples[layer].data(), samples[layer].size(), sizeof(Test_sample), 1};
+            plan.snapshot.sequence = 1;
+            plan.source_count      = samples[layer].size();
+            plan.gpu_count         = samples[layer].size();
+            plan.drawable_spans    = {{0, samples[layer].size(), 0, samples[layer].size()}};
+            plan.interpolation     = plot::Series_interpolation::LINEAR;
+            plans.push_back(&plan);
+        }
+        return plans;
+    };
+    const auto reference = [&](const std::vector<std::int64_t>& timestamps) {
+        std::vector<std::vector<plot::detail::stacked_sample_t>> layers(k_layers);
+        for (std::size_t layer = 0; layer < k_layers; ++layer) {
+            const auto& source = samples[layer];
+            for (std::size_t i = 0; i < timestamps.size(); ++i) {
+                const std::int64_t t = timestamps[i];
+                const auto next = std::upper_bound(
+                    source.begin(), source.end(), t,
+                    [](std::int64_t value, const Test_sample& sample) { return value < sample.t; });
+                const auto current = std::prev(next);
+                float value = current->v;
+                if (next != source.end() && t > current->t) {
+                    const double position = plot::detail::normalized_time_position_ns(
+                        current->t, t, next->t);
+                    value = static_cast<float>(current->v + position * (next->v - current->v));
+                }
+                const float base = layer == 0 ? 0.0f : layers[layer - 1u][i].value;
+                layers[layer].push_back({t, base + value, base});
+            }
+        }
+        return layers;
+    };
+    const auto timestamps_of = [](
+        const std::vector<std::vector<plot::detail::stacked_sample_t>>& layers)
+    {
+        std::vector<std::int64_t> timestamps;
+        for (const auto& sample : layers.front()) {
+            timestamps.push_back(sample.timestamp_ns);
+        }
+        return timestamps;
+    };
+
+    std::vector<plot::Series_view_plan> storage;
+    auto plans = make_plans(storage);
+    const std::vector<plot::Time_order> orders(k_layers, plot::Time_order::ASCENDING);
+    plot::detail::stack_composition_stats_t stats;
+    std::vector<std::vector<plot::detail::stacked_sample_t>> layers;
+    TEST_ASSERT(plot::detail::compose_stacked_series(
+        plans, orders, layers, 174'762u, &stats) == plot::Stack_rejection_reason::NONE,
+        "large exact stack should compose");
+    TEST_ASSERT(!stats.resampled && layers.front().size() == 3u * (k_count - 1u) - 1u,
+        "large exact stack should keep the whole timestamp union");
+    TEST_ASSERT(same_stacked_layers(layers, reference(timestamps_of(layers))),
+        "large exact stack should match the reference composition");
+
+    TEST_ASSERT(plot::detail::compose_stacked_series(
+        plans, orders, layers, 50'000u, &stats) == plot::Stack_rejection_reason::NONE,
+        "large resampled stack should compose");
+    TEST_ASSERT(stats.resampled && layers.front().size() == 50'000u,
+        "large resampled stack should fill its budget");
+    TEST_ASSERT(same_stacked_layers(layers, reference(timestamps_of(layers))),
+        "large resampled stack should match the reference composition");
+
+    samples[4][k_count * 3u / 4u].v = std::numeric_limits<float>::quiet_NaN();
+    plans = make_plans(storage);
+    TEST_ASSERT(plot::detail::compose_stacked_series(
+        plans, orders, layers, 174'762u, &stats) ==
+            plot::Stack_rejection_reason::INCOMPATIBLE_DATA,
+        "an undrawable sample late in one layer should still reject the stack");
+    return true;
+}
+
 bool test_stacking_bounds_independent_timestamp_grids()
 {
     constexpr std::size_t k_layer_count       = 32;
@@ -2637,6 +3320,342 @@ bool test_render_skips_invalid_series()
     return true;
 }
 
+// Per pixel column of the GPU slots of `window` (mapped through
+// `gpu_source_indices` when the window is decimated): the lowest y_min, the
+// highest y_max and the first and last source index. The hold slot is
+// skipped.
+struct column_extremes_t
+{
+    float          y_min = 0.0f;
+    float          y_max = 0.0f;
+    std::size_t    first = 0;
+    std::size_t    last  = 0;
+
+    bool operator==(const column_extremes_t&) const = default;
+};
+
+std::map<std::int64_t, column_extremes_t> column_extremes(
+    const plot::sample_window_t&                     window,
+    const std::vector<plot::drawable_sample_span_t>& spans,
+    const std::vector<std::size_t>*                  gpu_source_indices)
+{
+    std::map<std::int64_t, column_extremes_t> columns;
+    const long double px_per_ns =
+        static_cast<long double>(window.width_px) /
+        static_cast<long double>(window.t_max_ns - window.t_min_ns);
+    for (std::size_t span_index = 0; span_index < spans.size(); ++span_index) {
+        const plot::drawable_sample_span_t& span = spans[span_index];
+        const bool has_hold =
+            span_index + 1u == spans.size() && window.synthetic_hold_count == 1;
+        const std::size_t slots = has_hold ? span.gpu_count - 1u : span.gpu_count;
+        for (std::size_t slot = 0; slot < slots; ++slot) {
+            const std::size_t index = gpu_source_indices
+                ? (*gpu_source_indices)[span.gpu_first + slot]
+                : span.source_first + slot;
+            const void* sample = window.snapshot.at(index);
+            const std::int64_t column = static_cast<std::int64_t>(std::floor(
+                static_cast<long double>(window.access->get_timestamp(sample) - window.t_min_ns) *
+                px_per_ns));
+            const auto [low, high] = window.access->get_range(sample);
+            auto found = columns.find(column);
+            if (found == columns.end()) {
+                columns[column] = {low, high, index, index};
+                continue;
+            }
+            found->second.y_min = std::min(found->second.y_min, low);
+            found->second.y_max = std::max(found->second.y_max, high);
+            found->second.first = std::min(found->second.first, index);
+            found->second.last  = std::max(found->second.last,  index);
+        }
+    }
+    return columns;
+}
+
+bool test_m4_decimation_keeps_column_extremes()
+{
+    // 500 samples per pixel column; odd timestamps never fall on a column
+    // boundary, so the test and the decimator agree on columns.
+    std::vector<Test_sample> samples(100000);
+    std::uint32_t rng   = 12345u;
+    float         value = 0.0f;
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        rng   = rng * 1664525u + 1013904223u;
+        value += static_cast<float>(static_cast<int>(rng >> 24) - 128) / 64.0f;
+        samples[i].t = static_cast<std::int64_t>(2 * i + 1);
+        samples[i].v = value;
+    }
+
+    const Data_access_policy access = make_policy();
+
+    plot::sample_window_t window;
+    window.snapshot.data   = samples.data();
+    window.snapshot.count  = samples.size();
+    window.snapshot.stride = sizeof(Test_sample);
+    window.access          = &access;
+    window.t_min_ns        = 0;
+    window.t_max_ns        = 200000;
+    window.width_px        = 200.0f;
+    window.source_first    = 0;
+    window.source_count    = samples.size();
+    window.hold_last_forward    = true;
+    window.hold_timestamp_ns    = window.t_max_ns;
+    window.synthetic_hold_count = 1;
+
+    // Two spans around a dropped run of samples, hold slot on the last one.
+    plot::drawable_sample_span_t first_span;
+    first_span.source_first = 0;
+    first_span.source_count = 40000;
+    first_span.gpu_first    = 0;
+    first_span.gpu_count    = 40000;
+    plot::drawable_sample_span_t second_span;
+    second_span.source_first = 40010;
+    second_span.source_count = samples.size() - 40010u;
+    second_span.gpu_first    = first_span.gpu_count;
+    second_span.gpu_count    = second_span.source_count + 1u;
+    window.drawable_spans = {first_span, second_span};
+    window.gpu_count      = first_span.gpu_count + second_span.gpu_count;
+
+    window.v_min = samples[0].v;
+    window.v_max = samples[0].v;
+    for (const Test_sample& sample : samples) {
+        window.v_min = std::min(window.v_min, sample.v);
+        window.v_max = std::max(window.v_max, sample.v);
+    }
+
+    plot::detail::m4_window_t m4;
+    TEST_ASSERT(plot::detail::decimate_window_m4(window, m4),
+        "expected a dense ascending window to decimate");
+    TEST_ASSERT(m4.spans.size() == window.drawable_spans.size(),
+        "expected decimation to keep the span structure");
+    TEST_ASSERT(m4.gpu_count == m4.source_indices.size(),
+        "expected one source index per decimated GPU slot");
+    TEST_ASSERT(m4.gpu_count <= 2u * 4u * 200u + 1u,
+        "expected at most four samples per column and span plus the hold slot");
+
+    TEST_ASSERT(column_extremes(window, window.drawable_spans, nullptr) ==
+            column_extremes(window, m4.spans, &m4.source_indices),
+        "expected M4 decimation to keep each column's first, last, minimum and maximum");
+
+    std::vector<Test_sample> unordered = samples;
+    std::swap(unordered[10].t, unordered[20].t);
+    window.snapshot.data = unordered.data();
+    TEST_ASSERT(!plot::detail::decimate_window_m4(window, m4),
+        "expected non-ascending windows to be left undecimated");
+    TEST_ASSERT(m4.source_indices.empty() && m4.spans.empty() && m4.gpu_count == 0,
+        "expected a rejected decimation to leave its output empty");
+
+    return true;
+}
+
+bool test_m4_decimation_keeps_range_lane_extremes()
+{
+    // Band samples whose widest extent is not at the value extremes.
+    std::vector<Test_sample> samples(20000);
+    std::uint32_t rng = 777u;
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        rng = rng * 1664525u + 1013904223u;
+        samples[i].t = static_cast<std::int64_t>(2 * i + 1);
+        samples[i].v = static_cast<float>(rng >> 20) / 256.0f;
+    }
+
+    Data_access_policy access = make_policy();
+    access.get_range = [](const void* sample) {
+        const auto* typed = static_cast<const Test_sample*>(sample);
+        const float half_width = static_cast<float>(typed->t % 97) / 8.0f;
+        return std::make_pair(typed->v - half_width, typed->v + half_width);
+    };
+
+    plot::sample_window_t window;
+    window.snapshot.data   = samples.data();
+    window.snapshot.count  = samples.size();
+    window.snapshot.stride = sizeof(Test_sample);
+    window.access          = &access;
+    window.t_min_ns        = 0;
+    window.t_max_ns        = 40000;
+    window.width_px        = 100.0f;
+    window.source_first    = 0;
+    window.source_count    = samples.size();
+
+    plot::drawable_sample_span_t span;
+    span.source_first     = 0;
+    span.source_count     = samples.size();
+    span.gpu_first        = 0;
+    span.gpu_count        = samples.size();
+    window.drawable_spans = {span};
+    window.gpu_count      = span.gpu_count;
+    window.v_min          = -20.0f;
+    window.v_max          = 40.0f;
+
+    plot::detail::m4_window_t m4;
+    TEST_ASSERT(plot::detail::decimate_window_m4(window, m4),
+        "expected a dense band window to decimate");
+    TEST_ASSERT(column_extremes(window, window.drawable_spans, nullptr) ==
+            column_extremes(window, m4.spans, &m4.source_indices),
+        "expected M4 decimation to keep each column's lowest y_min and highest y_max");
+
+    return true;
+}
+
+bool test_dots_culling_keeps_every_occupied_cell()
+{
+    // 500 samples per pixel column on a 200 x 50 pixel view.
+    std::vector<Test_sample> samples(100000);
+    std::uint32_t rng = 54321u;
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        rng = rng * 1664525u + 1013904223u;
+        samples[i].t = static_cast<std::int64_t>(2 * i + 1);
+        samples[i].v = static_cast<float>(rng >> 16) / 65536.0f;
+    }
+
+    const Data_access_policy access = make_policy();
+
+    plot::sample_window_t window;
+    window.snapshot.data   = samples.data();
+    window.snapshot.count  = samples.size();
+    window.snapshot.stride = sizeof(Test_sample);
+    window.access          = &access;
+    window.t_min_ns        = 0;
+    window.t_max_ns        = 200000;
+    window.v_min           = 0.0f;
+    window.v_max           = 1.0f;
+    window.width_px        = 200.0f;
+    window.height_px       = 50.0f;
+    window.y_offset_px     = 0.5f;
+    window.source_first    = 0;
+    window.source_count    = samples.size();
+    window.hold_last_forward    = true;
+    window.hold_timestamp_ns    = window.t_max_ns;
+    window.synthetic_hold_count = 1;
+
+    plot::drawable_sample_span_t first_span;
+    first_span.source_first = 0;
+    first_span.source_count = 40000;
+    first_span.gpu_first    = 0;
+    first_span.gpu_count    = 40000;
+    plot::drawable_sample_span_t second_span;
+    second_span.source_first = 40010;
+    second_span.source_count = samples.size() - 40010u;
+    second_span.gpu_first    = first_span.gpu_count;
+    second_span.gpu_count    = second_span.source_count + 1u;
+    window.drawable_spans = {first_span, second_span};
+    window.gpu_count      = first_span.gpu_count + second_span.gpu_count;
+
+    const auto cell_of = [&](std::size_t index) {
+        const Test_sample& sample = samples[index];
+        const auto x = static_cast<std::int64_t>(std::floor(
+            static_cast<double>(sample.t) / 200000.0 * 200.0));
+        const auto y = static_cast<std::int64_t>(std::floor(
+            (1.0 - static_cast<double>(sample.v)) * 50.0 + 0.5));
+        return std::make_pair(x, y);
+    };
+
+    plot::detail::m4_window_t culled;
+    TEST_ASSERT(plot::detail::cull_window_dots(window, culled),
+        "expected a dense DOTS window to be culled");
+    TEST_ASSERT(culled.spans.size() == window.drawable_spans.size(),
+        "expected culling to keep the span structure");
+    TEST_ASSERT(culled.gpu_count == culled.source_indices.size(),
+        "expected one source index per culled GPU slot");
+    TEST_ASSERT(culled.gpu_count <= 200u * 51u + 2u + 1u,
+        "expected at most one dot per cell, one per span and the hold slot");
+
+    std::set<std::pair<std::int64_t, std::int64_t>> full_cells;
+    for (const plot::drawable_sample_span_t& span : window.drawable_spans) {
+        for (std::size_t i = 0; i < span.source_count; ++i) {
+            full_cells.insert(cell_of(span.source_first + i));
+        }
+    }
+    std::set<std::pair<std::int64_t, std::int64_t>> culled_cells;
+    for (std::size_t span_index = 0; span_index < culled.spans.size(); ++span_index) {
+        const plot::drawable_sample_span_t& span = culled.spans[span_index];
+        const bool        hold_span  = span_index + 1u == culled.spans.size();
+        const std::size_t real_slots = span.gpu_count - (hold_span ? 1u : 0u);
+        TEST_ASSERT(real_slots > 0, "expected every span to keep a real slot");
+        std::size_t next_index = span.source_first;
+        for (std::size_t slot = 0; slot < real_slots; ++slot) {
+            const std::size_t index = culled.source_indices[span.gpu_first + slot];
+            TEST_ASSERT(index >= next_index && index < span.source_first + span.source_count,
+                "expected culled slots to keep source order inside their span");
+            culled_cells.insert(cell_of(index));
+            next_index = index + 1u;
+        }
+    }
+    TEST_ASSERT(full_cells == culled_cells,
+        "expected culling to keep a dot in exactly the cells of the full window");
+
+    window.v_max = window.v_min;
+    TEST_ASSERT(!plot::detail::cull_window_dots(window, culled),
+        "expected an empty value range to be left alone");
+    TEST_ASSERT(culled.source_indices.empty() && culled.spans.empty() && culled.gpu_count == 0,
+        "expected a rejected cull to leave its output empty");
+
+    return true;
+}
+
+bool test_density_binning_counts_lod_weighted_samples()
+{
+    // 3000 samples per pixel column cycling through 50 values, one per row,
+    // so every cell of the 100 x 50 grid receives exactly 60 samples. Large
+    // enough to be binned on several ranges and merged.
+    std::vector<Test_sample> samples(300000);
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        samples[i].t = static_cast<std::int64_t>(2 * i + 1);
+        samples[i].v = static_cast<float>(i % 50u) + 0.5f;
+    }
+
+    const Data_access_policy access = make_policy();
+
+    plot::sample_window_t window;
+    window.snapshot.data   = samples.data();
+    window.snapshot.count  = samples.size();
+    window.snapshot.stride = sizeof(Test_sample);
+    window.access          = &access;
+    window.t_min_ns        = 0;
+    window.t_max_ns        = 600000;
+    window.v_min           = 0.0f;
+    window.v_max           = 50.0f;
+    window.width_px        = 100.0f;
+    window.height_px       = 50.0f;
+    window.source_first    = 0;
+    window.source_count    = samples.size();
+    window.gpu_count       = samples.size();
+
+    constexpr std::size_t lod_scale = 4;
+    plot::detail::density_grid_t grid;
+    TEST_ASSERT(plot::detail::bin_window_density(window, lod_scale, grid),
+        "expected a populated window to bin");
+    TEST_ASSERT(grid.width == 100u && grid.height == 50u,
+        "expected one grid cell per pixel");
+    TEST_ASSERT(grid.binned_samples == samples.size(),
+        "expected every in-window sample to be binned");
+    TEST_ASSERT(grid.counts.size() == grid.width * grid.height,
+        "expected a dense row-major grid");
+    for (const float count : grid.counts) {
+        TEST_ASSERT(count == 60.0f * static_cast<float>(lod_scale),
+            "expected each cell to hold its samples weighted by the LOD scale");
+    }
+    TEST_ASSERT(grid.max_count == 60.0f * static_cast<float>(lod_scale),
+        "expected max_count to match the fullest cell");
+
+    // Narrow the value range to the top band: the samples at 49.5 land in
+    // its middle row and everything below v_min is dropped.
+    window.v_min = 49.0f;
+    TEST_ASSERT(plot::detail::bin_window_density(window, 1, grid),
+        "expected a narrowed value range to bin");
+    TEST_ASSERT(grid.binned_samples == samples.size() / 50u,
+        "expected samples outside the value range to be dropped");
+    TEST_ASSERT(grid.counts[25u * grid.width] == 60.0f && grid.counts[0] == 0.0f,
+        "expected rows to map linearly from v_max at row 0");
+
+    window.snapshot = {};
+    TEST_ASSERT(!plot::detail::bin_window_density(window, 1, grid),
+        "expected a window without a snapshot to be rejected");
+    TEST_ASSERT(grid.counts.empty() && grid.width == 0 && grid.binned_samples == 0,
+        "expected a rejected binning to leave its output empty");
+
+    return true;
+}
+
 }  // namespace
 
 int main()
@@ -2648,6 +3667,9 @@ int main()
 
     RUN_TEST(test_ascending_time_order_skips_monotonicity_scan);
     RUN_TEST(test_unknown_and_unordered_time_order_run_defensive_scan);
+    RUN_TEST(test_growing_unknown_order_source_scans_only_appended_suffix);
+    RUN_TEST(test_vector_source_appends_extend_timestamp_order);
+    RUN_TEST(test_timestamp_order_extension_requires_append_contract);
     RUN_TEST(test_descending_time_order_uses_linear_window_search);
     RUN_TEST(test_descending_time_order_does_not_hold_oldest_sample);
     RUN_TEST(test_direct_time_window_query_drives_renderer_window);
@@ -2669,11 +3691,18 @@ int main()
     RUN_TEST(test_preview_honors_hold_last_forward);
     RUN_TEST(test_lod_level_separation);
     RUN_TEST(test_lod_selection_has_no_hysteresis);
+    RUN_TEST(test_lod_hysteresis_holds_level_near_boundary);
+    RUN_TEST(test_lod_switch_back_reuses_timestamp_order);
+    RUN_TEST(test_lod_pps_target_biases_towards_coarser_levels);
+    RUN_TEST(test_adaptive_lod_bias_follows_prepare_time);
     RUN_TEST(test_stacking_composes_different_timestamps_from_independent_lods);
     RUN_TEST(test_stacking_interpolates_sub_256ns_epoch_intervals);
     RUN_TEST(test_stacking_cursor_matches_equivalent_source_representations);
     RUN_TEST(test_stacking_binary_lookup_bounds_source_reads);
     RUN_TEST(test_stacking_binary_lookup_matches_streaming_fallback);
+    RUN_TEST(test_stacking_cache_extends_appended_samples);
+    RUN_TEST(test_stacking_cache_extends_vector_source_appends);
+    RUN_TEST(test_stacking_chunked_layers_match_reference);
     RUN_TEST(test_stacking_bounds_independent_timestamp_grids);
     RUN_TEST(test_stacking_bounded_grid_handles_interpolation_and_integer_extremes);
     RUN_TEST(test_stacking_uses_separate_view_budgets_and_invalidates_resized_cache);
@@ -2684,6 +3713,10 @@ int main()
     RUN_TEST(test_upload_invalidates_when_origin_changes_across_snap_bucket);
     RUN_TEST(test_renderer_assigns_distinct_origins_to_main_and_preview);
     RUN_TEST(test_render_skips_invalid_series);
+    RUN_TEST(test_m4_decimation_keeps_column_extremes);
+    RUN_TEST(test_m4_decimation_keeps_range_lane_extremes);
+    RUN_TEST(test_dots_culling_keeps_every_occupied_cell);
+    RUN_TEST(test_density_binning_counts_lod_weighted_samples);
 
     std::cout << "Results: " << passed << " passed, " << failed << " failed" << std::endl;
 